@@ -103,6 +103,21 @@ namespace weave::commandline
         std::vector<std::pair<std::size_t, std::string_view>> _values{};
         std::vector<std::string_view> _arguments{};
 
+    private:
+        // Values are stored only for options which take them, so they are looked up by index of the option name.
+        [[nodiscard]] std::optional<std::string_view> GetValueAt(size_t index) const
+        {
+            for (auto const& [nameIndex, value] : _values)
+            {
+                if (nameIndex == index)
+                {
+                    return value;
+                }
+            }
+
+            return std::nullopt;
+        }
+
     public:
         [[nodiscard]] std::optional<std::string_view> GetCommand() const
         {
@@ -126,7 +141,7 @@ namespace weave::commandline
             if (it != _names.cend())
             {
                 auto index = std::distance(_names.cbegin(), it);
-                return _values[index].second;
+                return GetValueAt(static_cast<size_t>(index));
             }
 
             return std::nullopt;
@@ -139,7 +154,7 @@ namespace weave::commandline
             if (it != _names.cend())
             {
                 auto index = std::distance(_names.cbegin(), it);
-                return _values[index].second;
+                return GetValueAt(static_cast<size_t>(index));
             }
 
             return std::nullopt;
@@ -152,7 +167,7 @@ namespace weave::commandline
             if (it != _names.cend())
             {
                 auto index = std::distance(_names.cbegin(), it);
-                return _values[index].second;
+                return GetValueAt(static_cast<size_t>(index));
             }
 
             return std::nullopt;
@@ -165,7 +180,7 @@ namespace weave::commandline
             if (it != _names.cend())
             {
                 auto index = std::distance(_names.cbegin(), it);
-                return _values[index].second;
+                return GetValueAt(static_cast<size_t>(index));
             }
 
             return std::nullopt;
@@ -177,8 +192,8 @@ namespace weave::commandline
 
             if (it != _names.crend())
             {
-                auto index = std::distance(_names.crbegin(), it);
-                return _values[index].second;
+                auto index = std::distance(it, _names.crend()) - 1;
+                return GetValueAt(static_cast<size_t>(index));
             }
 
             return std::nullopt;
@@ -190,8 +205,8 @@ namespace weave::commandline
 
             if (it != _names.crend())
             {
-                auto index = std::distance(_names.crbegin(), it);
-                return _values[index].second;
+                auto index = std::distance(it, _names.crend()) - 1;
+                return GetValueAt(static_cast<size_t>(index));
             }
 
             return std::nullopt;
@@ -208,7 +223,7 @@ namespace weave::commandline
                 if (nt == _names.cend())
                 {
                     auto index = std::distance(_names.cbegin(), it);
-                    return _values[index].second;
+                    return GetValueAt(static_cast<size_t>(index));
                 }
             }
 
@@ -226,7 +241,7 @@ namespace weave::commandline
                 if (nt == _names.cend())
                 {
                     auto index = std::distance(_names.cbegin(), it);
-                    return _values[index].second;
+                    return GetValueAt(static_cast<size_t>(index));
                 }
             }
 
@@ -0,0 +1,179 @@
+#include "weave/driver/Frontend.hxx"
+#include "weave/filesystem/FileSystem.hxx"
+#include "weave/syntax/Parser.hxx"
+#include "weave/syntax/StaticSyntaxWalker.hxx"
+#include "weave/threading/Runnable.hxx"
+#include "weave/threading/Thread.hxx"
+#include "weave/time/Instant.hxx"
+#include "weave/Unicode.hxx"
+
+#include <atomic>
+
+namespace weave::driver::impl
+{
+    class ErrorReporter final : public syntax::StaticSyntaxWalker<ErrorReporter>
+    {
+    public:
+        source::DiagnosticSink& Diagnostic;
+
+    public:
+        explicit ErrorReporter(source::DiagnosticSink& diagnostic)
+            : Diagnostic(diagnostic)
+        {
+        }
+
+        void OnToken(syntax::SyntaxToken* token)
+        {
+            if (token->IsMissing())
+            {
+                this->Diagnostic.AddError(token->Source, fmt::format("Expected '{}'", syntax::GetSpelling(token->Kind)));
+            }
+        }
+
+        void OnUnexpectedNodesSyntax(syntax::UnexpectedNodesSyntax* node)
+        {
+            auto first = static_cast<syntax::SyntaxToken*>(node->Nodes.GetElement(0));
+            auto last = static_cast<syntax::SyntaxToken*>(node->Nodes.GetElement(node->Nodes.GetCount() - 1));
+            auto source = source::Combine(first->Source, last->Source);
+            this->Diagnostic.AddError(source, fmt::format("Unexpected tokens"));
+        }
+    };
+
+    void ParseSourceFile(SourceFileUnit& unit, FrontendOptions const& options, profiler::Profiler& profiler)
+    {
+        profiler::EventScope scope{profiler, "frontend", unit.Path.c_str()};
+
+        time::Instant const started = time::Instant::Now();
+
+        if (auto file = filesystem::ReadTextFile(unit.Path); file.has_value())
+        {
+            source::SourceText const& text = unit.Text.emplace(std::move(*file));
+
+            std::string_view const content = text.GetContentView();
+
+            if (char const* const invalid = unicode::FindInvalid(content.data(), content.data() + content.size()); invalid != (content.data() + content.size()))
+            {
+                // Lexer would stop at the first invalid byte anyway; report whole file as broken instead.
+                uint32_t const offset = static_cast<uint32_t>(invalid - content.data());
+                unit.Diagnostic.AddError(source::SourceSpan{{offset}, {offset + 1}}, "source file is not valid UTF-8");
+            }
+            else
+            {
+                ParseCacheKey key{};
+
+                if (options.Cache != nullptr)
+                {
+                    key = ParseCache::ComputeKey(content);
+                    unit.Root = options.Cache->Load(key, unit.Factory, unit.Diagnostic);
+                }
+
+                if (unit.Root == nullptr)
+                {
+                    syntax::Parser parser{&unit.Diagnostic, &unit.Factory, text, options.TokenStream};
+                    unit.Root = parser.ParseSourceFile();
+                    unit.PeakTokenCount = parser.GetTokenStream().GetPeakCount();
+
+                    syntax::Validate(unit.Root, &unit.Diagnostic);
+
+                    ErrorReporter reporter{unit.Diagnostic};
+                    reporter.Dispatch(unit.Root);
+
+                    if (options.Cache != nullptr)
+                    {
+                        options.Cache->Store(key, unit.Factory, unit.Diagnostic, unit.Root);
+                    }
+                }
+
+                if (options.FlattenSyntaxTree)
+                {
+                    unit.Flat = syntax::FlatSyntaxTree{unit.Root};
+                }
+            }
+
+            source::FormatDiagnostics(unit.Messages, text, unit.Diagnostic, 1000);
+        }
+        else
+        {
+            unit.Messages.emplace_back(fmt::format("Failed to open file: {}", unit.Path));
+        }
+
+        unit.Elapsed = started.QueryElapsed();
+    }
+
+    class FrontendWorker final : public threading::Runnable
+    {
+    private:
+        std::span<std::unique_ptr<SourceFileUnit> const> _units;
+        std::atomic_size_t& _next;
+        FrontendOptions const& _options;
+        profiler::Profiler& _profiler;
+
+    public:
+        FrontendWorker(
+            std::span<std::unique_ptr<SourceFileUnit> const> units,
+            std::atomic_size_t& next,
+            FrontendOptions const& options,
+            profiler::Profiler& profiler)
+            : _units{units}
+            , _next{next}
+            , _options{options}
+            , _profiler{profiler}
+        {
+        }
+
+    protected:
+        void Execute() override
+        {
+            // Files are claimed one at a time - file sizes vary too much for a static partition to balance well.
+            for (size_t index = this->_next.fetch_add(1, std::memory_order_relaxed);
+                 index < this->_units.size();
+                 index = this->_next.fetch_add(1, std::memory_order_relaxed))
+            {
+                ParseSourceFile(*this->_units[index], this->_options, this->_profiler);
+            }
+        }
+    };
+}
+
+namespace weave::driver
+{
+    void ParseSourceFiles(
+        std::span<std::unique_ptr<SourceFileUnit> const> units,
+        size_t workers,
+        FrontendOptions const& options,
+        profiler::Profiler& profiler)
+    {
+        profiler::EventScope scope{profiler, "frontend", "ParseSourceFiles"};
+
+        std::atomic_size_t next{0};
+
+        workers = std::clamp<size_t>(workers, 1, std::max<size_t>(units.size(), 1));
+
+        std::vector<impl::FrontendWorker> runnables{};
+        runnables.reserve(workers);
+
+        for (size_t i = 0; i < workers; ++i)
+        {
+            runnables.emplace_back(units, next, options, profiler);
+        }
+
+        std::vector<threading::Thread> threads{};
+        threads.reserve(workers - 1);
+
+        for (size_t i = 1; i < workers; ++i)
+        {
+            threads.emplace_back(threading::ThreadStart{
+                .Name = "weave-frontend",
+                .Callback = &runnables[i],
+            });
+        }
+
+        // Calling thread participates as well.
+        runnables.front().Run();
+
+        for (threading::Thread& thread : threads)
+        {
+            thread.Join();
+        }
+    }
+}
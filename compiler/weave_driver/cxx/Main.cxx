@@ -21,6 +21,7 @@
 #include "weave/filesystem/DirectoryEnumerator.hxx"
 #include "weave/filesystem/FileWriter.hxx"
 #include "weave/profiler/Profiler.hxx"
+#include "weave/memory/MemoryAccounting.hxx"
 #include "weave/threading/Yield.hxx"
 #include "weave/time/DateTime.hxx"
 #include "weave/time/DateTimeOffset.hxx"
@@ -33,14 +34,17 @@
 
 #include "weave/syntax/Lexer.hxx"
 #include "weave/syntax/Parser.hxx"
-#include "weave/syntax/Visitor.hxx"
+#include "weave/syntax/StaticSyntaxWalker.hxx"
+
+#include "weave/driver/Frontend.hxx"
+#include "weave/driver/ParseCache.hxx"
+#include "weave/filesystem/Path.hxx"
 
 #include <atomic>
 
 #if defined(WIN32)
 WEAVE_EXTERNAL_HEADERS_BEGIN
 #include <Windows.h>
-#include <psapi.h>
 WEAVE_EXTERNAL_HEADERS_END
 #endif
 
@@ -67,52 +71,7 @@ namespace weave::driver
     };
 }
 
-class TreeLinearizer : public weave::syntax::SyntaxWalker
-{
-private:
-    std::vector<weave::syntax::SyntaxKind> _kinds{};
-
-public:
-    void OnDefault(weave::syntax::SyntaxNode* node) override
-    {
-        this->_kinds.push_back(node->Kind);
-    }
-
-    std::span<weave::syntax::SyntaxKind const> GetKinds() const
-    {
-        return this->_kinds;
-    }
-};
-
-class ErrorReporter final : public weave::syntax::SyntaxWalker
-{
-public:
-    weave::source::DiagnosticSink& Diagnostic;
-
-public:
-    explicit ErrorReporter(weave::source::DiagnosticSink& diagnostic)
-        : Diagnostic(diagnostic)
-    {
-    }
-
-    void OnToken(weave::syntax::SyntaxToken* token) override
-    {
-        if (token->IsMissing())
-        {
-            this->Diagnostic.AddError(token->Source, fmt::format("Expected '{}'", weave::syntax::GetSpelling(token->Kind)));
-        }
-    }
-
-    void OnUnexpectedNodesSyntax(weave::syntax::UnexpectedNodesSyntax* node) override
-    {
-        auto first = static_cast<weave::syntax::SyntaxToken*>(node->Nodes.GetElement(0));
-        auto last = static_cast<weave::syntax::SyntaxToken*>(node->Nodes.GetElement(node->Nodes.GetCount() - 1));
-        auto source = weave::source::Combine(first->Source, last->Source);
-        this->Diagnostic.AddError(source, fmt::format("Unexpected tokens"));
-    }
-};
-
-class SyntaxTreeStructurePrinter final : public weave::syntax::SyntaxWalker
+class SyntaxTreeStructurePrinter final : public weave::syntax::StaticSyntaxWalker<SyntaxTreeStructurePrinter>
 {
 private:
     void Indent()
@@ -123,24 +82,22 @@ private:
     weave::source::SourceText const& _text;
 
 public:
-    SyntaxTreeStructurePrinter(weave::source::SourceText const& text)
-        : SyntaxWalker{true}
+    SyntaxTreeStructurePrinter(weave::source::SourceText const& text, weave::syntax::SyntaxFactory& factory)
+        : StaticSyntaxWalker{&factory}
         , _text{text}
     {
     }
 
 public:
-    void OnDefault(weave::syntax::SyntaxNode* node) override
+    void OnDefault(weave::syntax::SyntaxNode* node)
     {
         Indent();
         fmt::println("{}", weave::syntax::GetName(node->Kind));
-
-        SyntaxWalker::OnDefault(node);
     }
 
-    void OnToken(weave::syntax::SyntaxToken* token) override
+    void OnToken(weave::syntax::SyntaxToken* token)
     {
-        // this->Dispatch(token->LeadingTrivia.GetNode());
+        // this->Dispatch(this->Trivia->GetLeadingTrivia(token).GetNode());
         Indent();
         auto startPosition = this->_text.GetLinePosition(token->Source.Start);
         auto endPosition = this->_text.GetLinePosition(token->Source.End);
@@ -153,10 +110,10 @@ public:
             token->IsMissing() ? " missing" : "",
             (not token->IsMissing()) ? this->_text.GetText(token->Source) : "");
 
-        // this->Dispatch(token->TrailingTrivia.GetNode());
+        // this->Dispatch(this->Trivia->GetTrailingTrivia(token).GetNode());
     }
 
-    void OnTrivia(weave::syntax::SyntaxTrivia* trivia) override
+    void OnTrivia(weave::syntax::SyntaxTrivia* trivia)
     {
         Indent();
         auto startPosition = this->_text.GetLinePosition(trivia->Source.Start);
@@ -280,6 +237,12 @@ namespace xxx
         {
             bool PrintSyntaxTree{};
             bool PrintSemanticTree{};
+            bool FlattenSyntaxTree{};
+            std::string TracePath{};
+            bool MemoryReport{};
+            std::string MemoryReportPath{};
+            weave::syntax::TokenStreamMode TokenStream{weave::syntax::TokenStreamMode::Streaming};
+            uint64_t ParseCacheSize{256};
         } Experimental{};
 
         void Apply(weave::commandline::ArgumentParseResult const& arguments)
@@ -378,6 +341,29 @@ namespace xxx
             this->Emit.AssemblyHeader = arguments.Contains("-e:assembly-header");
             this->Experimental.PrintSyntaxTree = arguments.Contains("-x:print-syntax-tree");
             this->Experimental.PrintSemanticTree = arguments.Contains("-x:print-semantic-tree");
+            this->Experimental.FlattenSyntaxTree = arguments.Contains("-x:flatten-syntax-tree");
+
+            if (auto const parsed = weave::commandline::TryParseFilePath(arguments.GetValue("-x:trace")))
+            {
+                this->Experimental.TracePath = *parsed;
+            }
+
+            this->Experimental.MemoryReport = arguments.Contains("-x:memory-report");
+
+            if (auto const parsed = weave::commandline::TryParseFilePath(arguments.GetValue("-x:memory-report-json")))
+            {
+                this->Experimental.MemoryReportPath = *parsed;
+            }
+
+            if (auto const parsed = TryParseTokenStreamMode(arguments.GetValue("-x:token-stream")))
+            {
+                this->Experimental.TokenStream = *parsed;
+            }
+
+            if (auto const parsed = weave::commandline::TryParseUInt64(arguments.GetValue("-x:parse-cache-size")))
+            {
+                this->Experimental.ParseCacheSize = *parsed;
+            }
 
             for (auto const& path : arguments.GetPositional())
             {
@@ -435,6 +421,29 @@ namespace xxx
             return {};
         }
 
+        static std::optional<weave::syntax::TokenStreamMode> TryParseTokenStreamMode(std::optional<std::string_view> const& value)
+        {
+            if (value)
+            {
+                if (*value == "eager")
+                {
+                    return weave::syntax::TokenStreamMode::Eager;
+                }
+
+                if (*value == "streaming")
+                {
+                    return weave::syntax::TokenStreamMode::Streaming;
+                }
+
+                if (*value == "background")
+                {
+                    return weave::syntax::TokenStreamMode::Background;
+                }
+            }
+
+            return {};
+        }
+
         static std::optional<TargetPlatform> TryParseTargetPlatform(std::optional<std::string_view> const& value)
         {
             if (value)
@@ -579,6 +588,12 @@ int main(int argc, char* argv[])
 
     argumentParser.AddOption("-x:print-syntax-tree",        "Print syntax tree");
     argumentParser.AddOption("-x:print-semantic-tree",      "Print semantic tree");
+    argumentParser.AddOption("-x:flatten-syntax-tree",      "Flatten syntax tree after parsing");
+    argumentParser.AddOption("-x:trace",                    "Write profiler trace to file", "path");
+    argumentParser.AddOption("-x:token-stream",             "Token stream mode", "value");
+    argumentParser.AddOption("-x:memory-report",            "Print memory usage report");
+    argumentParser.AddOption("-x:memory-report-json",       "Write memory usage report as JSON to file", "path");
+    argumentParser.AddOption("-x:parse-cache-size",         "Maximum size of parse cache in MiB", "value");
 
     xxx::CompilerOptions options{};
 
@@ -604,309 +619,134 @@ int main(int argc, char* argv[])
             return EXIT_FAILURE;
         }
 
-        // if (files.size() > 1)
-        //{
-        //     fmt::println(stderr, "Too many files specified");
-        //     return EXIT_FAILURE;
-        // }
+        profiler::Profiler profiler{};
 
         auto parsing_timing = time::Instant::Now();
-        if (auto file = filesystem::ReadTextFile(files.front()); file.has_value())
-        {
-            source::SourceText text{std::move(*file)};
-            source::DiagnosticSink diagnostic{"<source>"};
-            syntax::SyntaxFactory factory{};
-
-            syntax::Parser parser{&diagnostic, &factory, text};
-
-            if (options.Experimental.PrintSyntaxTree)
-            {
-                auto* root = parser.ParseSourceFile();
-                {
-                    SyntaxTreeStructurePrinter printer{text};
-                    printer.Dispatch(root);
-                }
-                {
-                    weave::syntax::Validate(root, &diagnostic);
-
-                    ErrorReporter error{diagnostic};
-                    error.Dispatch(root);
-                    std::vector<std::string> diag{};
-                    source::FormatDiagnostics(diag, text, diagnostic, 1000);
-
-                    for (std::string const& item : diag)
-                    {
-                        fmt::println(stderr, "{}", item);
-                    }
-                }
-
-                fflush(stdout);
-                fflush(stderr);
-                return EXIT_SUCCESS;
-            }
-
-            class TokenPrintingWalker : public syntax::SyntaxWalker
-            {
-            private:
-                source::SourceText const& _text;
-
-            public:
-                TokenPrintingWalker(source::SourceText const& text)
-                    : _text{text}
-                {
-                }
-
-                void OnToken(syntax::SyntaxToken* token) override
-                {
-                    this->Dispatch(token->LeadingTrivia.GetNode());
-
-                    // if ((token->Kind == syntax::SyntaxKind::OpenBraceToken) or (token->Kind == syntax::SyntaxKind::CloseBraceToken))
-                    //{
-                    //     fmt::print("{}", GetSpelling(token->Kind));
-                    // }
-                    // else
-                    if (token->IsMissing())
-                    {
-                        fmt::print("/*missing:'{}'*/", weave::syntax::GetSpelling(token->Kind));
-                    }
-                    else
-                    {
-                        fmt::print("{}", _text.GetText(token->Source));
-                    }
-
-                    this->Dispatch(token->TrailingTrivia.GetNode());
-                }
-
-                void OnTrivia(syntax::SyntaxTrivia* trivia) override
-                {
-                    fmt::print("{}", _text.GetText(trivia->Source));
-                }
-
-                void OnUnexpectedNodesSyntax(syntax::UnexpectedNodesSyntax* node) override
-                {
-                    fmt::print("/*>>>");
-                    // fmt::print("\u001b[41m");
-                    SyntaxWalker::OnUnexpectedNodesSyntax(node);
-                    fmt::print("<<<*/");
-                    // fmt::print("\u001b[0m");
-                }
-            };
-
-            class GX : public syntax::SyntaxWalker
-            {
-            private:
-                void Indent()
-                {
-                    fmt::print("{:{}}", "", this->Depth * 4);
-                }
 
-            public:
-                GX(source::SourceText& text)
-                    : _text{text}
-                {
-                }
-                source::SourceText& _text;
-
-            public:
-                void OnNamespaceDeclarationSyntax(syntax::NamespaceDeclarationSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnNamespaceDeclarationSyntax(node);
-                }
-
-                void OnStructDeclarationSyntax(syntax::StructDeclarationSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnStructDeclarationSyntax(node);
-                }
-
-                void OnConceptDeclarationSyntax(syntax::ConceptDeclarationSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnConceptDeclarationSyntax(node);
-                }
+        std::vector<std::unique_ptr<driver::SourceFileUnit>> units{};
+        units.reserve(files.size());
 
-                void OnExtendDeclarationSyntax(syntax::ExtendDeclarationSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnExtendDeclarationSyntax(node);
-                }
-
-                void OnFunctionDeclarationSyntax(syntax::FunctionDeclarationSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnFunctionDeclarationSyntax(node);
-                }
-
-                void OnDefault(syntax::SyntaxNode* node) override
-                {
-                    Indent();
-                    fmt::println("{} {}", __func__, syntax::GetSpelling(node->Kind));
-                    SyntaxWalker::OnDefault(node);
-                }
-
-                void OnSyntaxList(syntax::SyntaxList* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnSyntaxList(node);
-                }
+        for (std::string const& path : files)
+        {
+            auto& unit = units.emplace_back(std::make_unique<driver::SourceFileUnit>());
+            unit->Path = path;
 
-                void OnBlockStatementSyntax(syntax::BlockStatementSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnBlockStatementSyntax(node);
-                }
+            // Single file invocations keep anonymous source name, so syntax test baselines do not depend on
+            // location of the repository.
+            unit->Diagnostic.Path = (files.size() == 1) ? "<source>" : path;
+        }
 
-                void OnParameterListSyntax(syntax::ParameterListSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnParameterListSyntax(node);
-                }
+        // Parsed syntax trees are cached together with other immediate files.
+        std::optional<driver::ParseCache> cache{};
 
-                void OnParameterSyntax(syntax::ParameterSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnParameterSyntax(node);
-                }
+        if (not options.Output.ImmediatePath.empty())
+        {
+            std::string cachePath = options.Output.ImmediatePath;
+            filesystem::path::Push(cachePath, "parse-cache");
 
-                void OnArgumentListSyntax(syntax::ArgumentListSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnArgumentListSyntax(node);
-                }
+            // Directories may already exist; failure to create them is detected when writing entries.
+            (void)filesystem::Directory::Create(options.Output.ImmediatePath);
+            (void)filesystem::Directory::Create(cachePath);
 
-                void OnEmptyStatementSyntax(syntax::EmptyStatementSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnEmptyStatementSyntax(node);
-                }
+            cache.emplace(std::move(cachePath), options.Experimental.ParseCacheSize << 20u);
+        }
 
-                void OnExpressionStatementSyntax(syntax::ExpressionStatementSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnExpressionStatementSyntax(node);
-                }
+        driver::FrontendOptions const frontend{
+            .TokenStream = options.Experimental.TokenStream,
+            .FlattenSyntaxTree = options.Experimental.FlattenSyntaxTree,
+            .Cache = cache.has_value() ? &*cache : nullptr,
+        };
 
-                void OnToken(syntax::SyntaxToken* token) override
-                {
-                    this->Dispatch(token->LeadingTrivia.GetNode());
+        driver::ParseSourceFiles(units, threading::GetLogicalProcessorCount(), frontend, profiler);
 
-                    Indent();
-                    fmt::println("{} `{}`", __func__, GetName(token->Kind), _text.GetText(token->Source));
+        if (cache.has_value())
+        {
+            cache->Trim();
+        }
 
-                    this->Dispatch(token->TrailingTrivia.GetNode());
-                }
+        profiler.RecordPageHeap();
 
-                void OnTrivia(weave::syntax::SyntaxTrivia* trivia) override
-                {
-                    Indent();
-                    fmt::println("{}::LeadingTrivia `{}`", __func__, GetSpelling(trivia->Kind));
-                }
+        bool failed = false;
 
-                void OnIncompleteDeclarationSyntax(syntax::IncompleteDeclarationSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnIncompleteDeclarationSyntax(node);
-                }
+        for (auto const& unit : units)
+        {
+            if (not unit->Text.has_value())
+            {
+                failed = true;
+            }
+            else if (options.Experimental.PrintSyntaxTree and (unit->Root != nullptr))
+            {
+                SyntaxTreeStructurePrinter printer{*unit->Text, unit->Factory};
+                printer.Dispatch(unit->Root);
+            }
 
-                // void OnArgumentSyntax(syntax::ArgumentSyntax* node) override
-                //{
-                //     Indent();
-                //     fmt::println("{}", __func__);
-                //     SyntaxWalker::OnArgumentSyntax(node);
-                // }
+            for (std::string const& item : unit->Messages)
+            {
+                fmt::println(stderr, "{}", item);
+            }
 
-                void OnArrowExpressionClauseSyntax(syntax::ArrowExpressionClauseSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnArrowExpressionClauseSyntax(node);
-                }
+            if (options.Verbose)
+            {
+                fmt::println("{}: {} us, peak tokens: {}", unit->Path, unit->Elapsed.ToMicroseconds(), unit->PeakTokenCount);
 
-                void OnAssignmentExpressionSyntax(syntax::AssignmentExpressionSyntax* node) override
+                if (options.Experimental.FlattenSyntaxTree)
                 {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnAssignmentExpressionSyntax(node);
+                    fmt::println("flat syntax tree: {} nodes, {} bytes", unit->Flat.GetNodes().size(), unit->Flat.GetMemoryUsage());
                 }
 
-                void OnElseClauseSyntax(syntax::ElseClauseSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnElseClauseSyntax(node);
-                }
+                unit->Factory.DebugDump();
+            }
+        }
 
-                void OnUnexpectedNodesSyntax(syntax::UnexpectedNodesSyntax* node) override
-                {
-                    Indent();
-                    fmt::println("{}", __func__);
-                    SyntaxWalker::OnUnexpectedNodesSyntax(node);
-                }
+        if (not options.Experimental.PrintSyntaxTree)
+        {
+            fmt::println("parsing took: {}", parsing_timing.QueryElapsed());
+        }
 
-                // void OnQualifiedNameSyntax(syntax::QualifiedNameSyntax* node) override
-                //{
-                //     Indent();
-                //     fmt::println("{} `.`", __func__);
-                //
-                //     SyntaxWalker::OnQualifiedNameSyntax(node);
-                // }
-            };
+        if (options.Verbose and cache.has_value())
+        {
+            driver::ParseCacheStatistics const statistics = cache->GetStatistics();
+            fmt::println("parse cache: {} hits, {} misses, {} stored, {} evicted, {} failed",
+                statistics.Hits, statistics.Misses, statistics.Stored, statistics.Evicted, statistics.Failed);
+        }
 
-            auto cu2 = parser.ParseSourceFile();
-            fmt::println("------");
+        if (not options.Experimental.TracePath.empty())
+        {
+            if (auto handle = filesystem::FileHandle::Create(options.Experimental.TracePath, filesystem::FileMode::CreateAlways, filesystem::FileAccess::Write))
             {
-                ErrorReporter rr{diagnostic};
-                rr.Dispatch(cu2);
+                filesystem::FileWriter writer{*handle};
+                profiler.Serialize(writer);
             }
-            /*fmt::println("-------");
-            {
-                TreeLinearizer printer{};
-                printer.Dispatch(cu2);
-                for (auto k : printer.GetKinds())
-                {
-                    fmt::println("{}", GetName(k));
-                }
-            }*/
-            fmt::println("-------");
+            else
             {
-                TokenPrintingWalker printer{text};
-                printer.Dispatch(cu2);
+                fmt::println(stderr, "Failed to write trace file: {}", options.Experimental.TracePath);
             }
-            fmt::println("-------");
-            GX gx{text};
-            gx.Dispatch(cu2);
-            fmt::println("-------");
+        }
 
-            std::vector<std::string> diag{};
-            source::FormatDiagnostics(diag, text, diagnostic, 1000);
+        if (options.Experimental.MemoryReport)
+        {
+            fmt::print("{}", memory::MemoryAccounting::FormatReport());
+        }
 
-            for (std::string const& item : diag)
+        if (not options.Experimental.MemoryReportPath.empty())
+        {
+            if (auto handle = filesystem::FileHandle::Create(options.Experimental.MemoryReportPath, filesystem::FileMode::CreateAlways, filesystem::FileAccess::Write))
             {
-                fmt::println(stderr, "{}", item);
+                filesystem::FileWriter writer{*handle};
+                (void)filesystem::Write(writer, memory::MemoryAccounting::FormatReportJson());
+            }
+            else
+            {
+                fmt::println(stderr, "Failed to write memory report: {}", options.Experimental.MemoryReportPath);
             }
-
-            factory.DebugDump();
         }
-        else
+
+        if (failed)
         {
-            fmt::println(stderr, "Failed to open file: {}", files.front());
+            fflush(stdout);
+            fflush(stderr);
+            return EXIT_FAILURE;
         }
-
-        fmt::println("parsing took: {}", parsing_timing.QueryElapsed());
     }
     else
     {
@@ -915,24 +755,6 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
-#if defined(WIN32) && false
-    HANDLE hProcess = GetCurrentProcess();
-    PROCESS_MEMORY_COUNTERS pmc{sizeof(pmc)};
-
-    if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc)))
-    {
-        fmt::println("PageFaultCount: {}", pmc.PageFaultCount);
-        fmt::println("PeakWorkingSetSize: {} ({})", filesystem::FormatBinarySize(pmc.PeakWorkingSetSize), pmc.PeakWorkingSetSize);
-        fmt::println("WorkingSetSize: {} ({})", filesystem::FormatBinarySize(pmc.WorkingSetSize), pmc.WorkingSetSize);
-        fmt::println("QuotaPeakPagedPoolUsage: {} ({})", filesystem::FormatBinarySize(pmc.QuotaPeakPagedPoolUsage), pmc.QuotaPeakPagedPoolUsage);
-        fmt::println("QuotaPagedPoolUsage: {} ({})", filesystem::FormatBinarySize(pmc.QuotaPagedPoolUsage), pmc.QuotaPagedPoolUsage);
-        fmt::println("QuotaPeakNonPagedPoolUsage: {} ({})", filesystem::FormatBinarySize(pmc.QuotaPeakNonPagedPoolUsage), pmc.QuotaPeakNonPagedPoolUsage);
-        fmt::println("QuotaNonPagedPoolUsage: {} ({})", filesystem::FormatBinarySize(pmc.QuotaNonPagedPoolUsage), pmc.QuotaNonPagedPoolUsage);
-        fmt::println("PagefileUsage: {} ({})", filesystem::FormatBinarySize(pmc.PagefileUsage), pmc.PagefileUsage);
-        fmt::println("PeakPagefileUsage: {} ({})", filesystem::FormatBinarySize(pmc.PeakPagefileUsage), pmc.PeakPagefileUsage);
-    }
-#endif
-
     fflush(stdout);
 
     return 0;
@@ -0,0 +1,403 @@
+#include "weave/driver/ParseCache.hxx"
+#include "weave/bitwise/CompressedInteger.hxx"
+#include "weave/bugcheck/Assert.hxx"
+#include "weave/filesystem/DirectoryEnumerator.hxx"
+#include "weave/filesystem/FileHandle.hxx"
+#include "weave/filesystem/FileInfo.hxx"
+#include "weave/filesystem/FileSystem.hxx"
+#include "weave/filesystem/Path.hxx"
+#include "weave/hash/Sha256.hxx"
+#include "weave/syntax/SyntaxSerializer.hxx"
+#include "weave/time/Instant.hxx"
+#include "weave/Bitwise.hxx"
+#include "weave/Version.hxx"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace weave::driver::impl
+{
+    // "WVPC"
+    inline constexpr uint32_t ParseCacheSignature = 0x43505657u;
+
+    // Incremented on every change of entry layout. Layout of syntax tree is versioned separately by serializer.
+    inline constexpr uint32_t ParseCacheVersion = 1u;
+
+    inline constexpr std::string_view ParseCacheExtension = ".wpc";
+    inline constexpr std::string_view ParseCacheTemporaryExtension = ".tmp";
+
+    // Temporary files older than this were left by process which did not finish writing the entry.
+    inline constexpr time::Duration ParseCacheTemporaryLifetime{.Seconds = 60 * 60, .Nanoseconds = 0};
+
+    class ParseCacheWriter final
+    {
+    private:
+        std::vector<std::byte>& _output;
+
+    public:
+        explicit ParseCacheWriter(std::vector<std::byte>& output)
+            : _output{output}
+        {
+        }
+
+        void WriteUInt32(uint32_t value)
+        {
+            size_t const offset = this->_output.size();
+            this->_output.resize(offset + sizeof(value));
+            bitwise::StoreUnalignedLittleEndian(this->_output.data() + offset, value);
+        }
+
+        void WriteUnsigned(uint64_t value)
+        {
+            uint8_t buffer[16];
+            size_t const processed = bitwise::EncodeUnsigned(value, std::begin(buffer), std::end(buffer));
+            WEAVE_ASSERT(processed != 0);
+            this->WriteBytes(std::as_bytes(std::span{buffer}.first(processed)));
+        }
+
+        void WriteBytes(std::span<std::byte const> value)
+        {
+            this->_output.insert(this->_output.end(), value.begin(), value.end());
+        }
+    };
+
+    class ParseCacheReader final
+    {
+    private:
+        std::span<std::byte const> _input;
+
+    public:
+        explicit ParseCacheReader(std::span<std::byte const> input)
+            : _input{input}
+        {
+        }
+
+        [[nodiscard]] std::span<std::byte const> GetRemaining() const
+        {
+            return this->_input;
+        }
+
+        [[nodiscard]] bool ReadUInt32(uint32_t& value)
+        {
+            if (this->_input.size() < sizeof(value))
+            {
+                return false;
+            }
+
+            value = bitwise::LoadUnalignedLittleEndian<uint32_t>(this->_input.data());
+            this->_input = this->_input.subspan(sizeof(value));
+            return true;
+        }
+
+        [[nodiscard]] bool ReadUnsigned(uint64_t& value)
+        {
+            uint8_t const* const first = reinterpret_cast<uint8_t const*>(this->_input.data());
+            size_t const processed = bitwise::DecodeUnsigned(value, first, first + this->_input.size());
+
+            if (processed == 0)
+            {
+                return false;
+            }
+
+            this->_input = this->_input.subspan(processed);
+            return true;
+        }
+
+        [[nodiscard]] bool ReadBytes(std::span<std::byte const>& value, size_t size)
+        {
+            if (this->_input.size() < size)
+            {
+                return false;
+            }
+
+            value = this->_input.first(size);
+            this->_input = this->_input.subspan(size);
+            return true;
+        }
+    };
+
+    bool ReadDiagnostics(ParseCacheReader& reader, std::vector<source::DiagnosticSink::Entry>& items)
+    {
+        uint64_t count{};
+
+        if (not reader.ReadUnsigned(count))
+        {
+            return false;
+        }
+
+        // Each entry takes at least four bytes.
+        if (count > (reader.GetRemaining().size() / 4))
+        {
+            return false;
+        }
+
+        items.reserve(count);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            uint64_t level{};
+            uint64_t start{};
+            uint64_t end{};
+            uint64_t length{};
+            std::span<std::byte const> message{};
+
+            if (not reader.ReadUnsigned(level) or
+                not reader.ReadUnsigned(start) or
+                not reader.ReadUnsigned(end) or
+                not reader.ReadUnsigned(length) or
+                not reader.ReadBytes(message, length))
+            {
+                return false;
+            }
+
+            if ((level > static_cast<uint64_t>(source::DiagnosticLevel::Hint)) or (start > end) or (end > UINT32_MAX))
+            {
+                return false;
+            }
+
+            items.push_back(source::DiagnosticSink::Entry{
+                .Source = source::SourceSpan{{static_cast<uint32_t>(start)}, {static_cast<uint32_t>(end)}},
+                .Level = static_cast<source::DiagnosticLevel>(level),
+                .Message = std::string{reinterpret_cast<char const*>(message.data()), message.size()},
+            });
+        }
+
+        return true;
+    }
+
+    struct ParseCacheEntry final
+    {
+        std::string Path;
+        time::DateTime LastWriteTime;
+        uint64_t Size;
+    };
+}
+
+namespace weave::driver
+{
+    ParseCache::ParseCache(std::string directory, uint64_t limit)
+        : _directory{std::move(directory)}
+        , _limit{limit}
+    {
+    }
+
+    ParseCacheKey ParseCache::ComputeKey(std::string_view content)
+    {
+        hash::Sha256 context;
+        hash::Sha256Initialize(context);
+
+        // Trees produced by different builds of compiler are not compatible, even when the source is the same.
+        std::string_view const version = "weave-parse-cache:" WEAVE_LANG_VERSION ":" WEAVE_PROJECT_HASH ":";
+        hash::Sha256Update(context, std::as_bytes(std::span{version}));
+        hash::Sha256Update(context, std::as_bytes(std::span{content}));
+
+        return hash::Sha256Finalize(context);
+    }
+
+    syntax::SourceFileSyntax* ParseCache::Load(
+        ParseCacheKey const& key,
+        syntax::SyntaxFactory& factory,
+        source::DiagnosticSink& diagnostic)
+    {
+        std::string const path = this->GetEntryPath(key);
+
+        if (auto const content = filesystem::ReadBinaryFile(path))
+        {
+            impl::ParseCacheReader reader{*content};
+
+            uint32_t signature{};
+            uint32_t version{};
+            std::span<std::byte const> storedKey{};
+            std::vector<source::DiagnosticSink::Entry> items{};
+
+            if (reader.ReadUInt32(signature) and (signature == impl::ParseCacheSignature) and
+                reader.ReadUInt32(version) and (version == impl::ParseCacheVersion) and
+                reader.ReadBytes(storedKey, key.size()) and std::ranges::equal(storedKey, std::as_bytes(std::span{key})) and
+                impl::ReadDiagnostics(reader, items))
+            {
+                if (syntax::SourceFileSyntax* const root = syntax::DeserializeSyntaxTree(factory, reader.GetRemaining()))
+                {
+                    diagnostic.Items.insert(
+                        diagnostic.Items.end(),
+                        std::make_move_iterator(items.begin()),
+                        std::make_move_iterator(items.end()));
+
+                    // Mark entry as recently used; failure only makes it a candidate for earlier eviction.
+                    (void)filesystem::File::Touch(path);
+
+                    this->_hits.fetch_add(1, std::memory_order_relaxed);
+                    return root;
+                }
+            }
+        }
+
+        this->_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    void ParseCache::Store(
+        ParseCacheKey const& key,
+        syntax::SyntaxFactory const& factory,
+        source::DiagnosticSink const& diagnostic,
+        syntax::SourceFileSyntax* root)
+    {
+        std::vector<std::byte> buffer{};
+        impl::ParseCacheWriter writer{buffer};
+
+        writer.WriteUInt32(impl::ParseCacheSignature);
+        writer.WriteUInt32(impl::ParseCacheVersion);
+        writer.WriteBytes(std::as_bytes(std::span{key}));
+        writer.WriteUnsigned(diagnostic.Items.size());
+
+        for (source::DiagnosticSink::Entry const& item : diagnostic.Items)
+        {
+            writer.WriteUnsigned(std::to_underlying(item.Level));
+            writer.WriteUnsigned(item.Source.Start.Offset);
+            writer.WriteUnsigned(item.Source.End.Offset);
+            writer.WriteUnsigned(item.Message.size());
+            writer.WriteBytes(std::as_bytes(std::span{item.Message}));
+        }
+
+        syntax::SerializeSyntaxTree(buffer, factory, root);
+
+        std::string const path = this->GetEntryPath(key);
+
+        // Other processes may write the same entry concurrently; each one uses its own temporary file, and the last
+        // move wins with identical content.
+        std::string const temporary = fmt::format("{}.{:x}-{:x}.tmp",
+            path,
+            time::Instant::Now().SinceEpoch().ToNanoseconds(),
+            this->_sequence.fetch_add(1, std::memory_order_relaxed));
+
+        bool written = false;
+
+        if (auto handle = filesystem::FileHandle::Create(temporary, filesystem::FileMode::CreateNew, filesystem::FileAccess::Write))
+        {
+            auto const processed = handle->Write(buffer, 0);
+            written = processed.has_value() and (*processed == buffer.size());
+            written = handle->Close().has_value() and written;
+        }
+
+        if (written and filesystem::File::Move(temporary, path).has_value())
+        {
+            this->_stored.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            (void)filesystem::File::Remove(temporary);
+            this->_failed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void ParseCache::Trim()
+    {
+        std::vector<impl::ParseCacheEntry> entries{};
+        uint64_t total = 0;
+
+        time::DateTime const expired = time::DateTime::UtcNow() - impl::ParseCacheTemporaryLifetime;
+
+        filesystem::DirectoryEnumerator enumerator{this->_directory};
+
+        while (auto const item = enumerator.Next())
+        {
+            if (not item->has_value())
+            {
+                break;
+            }
+
+            filesystem::DirectoryEntry const& entry = item->value();
+
+            std::string_view const extension = filesystem::path::GetExtension(entry.Path);
+            bool const temporary = (extension == impl::ParseCacheTemporaryExtension);
+
+            if (temporary or (extension == impl::ParseCacheExtension))
+            {
+                std::string path = this->_directory;
+                filesystem::path::Push(path, filesystem::path::GetFilename(entry.Path));
+
+                // Type of entry is not reported by all file systems; it is checked after querying file info instead.
+                if (auto const info = filesystem::FileInfo::FromPath(path); info.has_value() and (info->Type == filesystem::FileType::File))
+                {
+                    uint64_t const size = static_cast<uint64_t>(info->Size);
+
+                    if (temporary)
+                    {
+                        // Temporary files being written right now still take space, but only the owner may remove them.
+                        if ((info->LastWriteTime.Inner < expired.Inner) and filesystem::File::Remove(path).has_value())
+                        {
+                            this->_evicted.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        else
+                        {
+                            total += size;
+                        }
+                    }
+                    else
+                    {
+                        total += size;
+                        entries.push_back(impl::ParseCacheEntry{
+                            .Path = std::move(path),
+                            .LastWriteTime = info->LastWriteTime,
+                            .Size = size,
+                        });
+                    }
+                }
+            }
+        }
+
+        if (total <= this->_limit)
+        {
+            return;
+        }
+
+        std::ranges::sort(entries, [](impl::ParseCacheEntry const& left, impl::ParseCacheEntry const& right)
+        {
+            return left.LastWriteTime < right.LastWriteTime;
+        });
+
+        for (impl::ParseCacheEntry const& entry : entries)
+        {
+            if (total <= this->_limit)
+            {
+                break;
+            }
+
+            if (filesystem::File::Remove(entry.Path).has_value())
+            {
+                total -= entry.Size;
+                this->_evicted.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    ParseCacheStatistics ParseCache::GetStatistics() const
+    {
+        return ParseCacheStatistics{
+            .Hits = this->_hits.load(std::memory_order_relaxed),
+            .Misses = this->_misses.load(std::memory_order_relaxed),
+            .Stored = this->_stored.load(std::memory_order_relaxed),
+            .Evicted = this->_evicted.load(std::memory_order_relaxed),
+            .Failed = this->_failed.load(std::memory_order_relaxed),
+        };
+    }
+
+    std::string ParseCache::GetEntryPath(ParseCacheKey const& key) const
+    {
+        std::string result = this->_directory;
+
+        std::string name{};
+        name.reserve(key.size() * 2 + impl::ParseCacheExtension.size());
+
+        for (uint8_t const value : key)
+        {
+            fmt::format_to(std::back_inserter(name), "{:02x}", value);
+        }
+
+        name += impl::ParseCacheExtension;
+
+        filesystem::path::Push(result, name);
+        return result;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "weave/driver/ParseCache.hxx"
+#include "weave/source/SourceText.hxx"
+#include "weave/source/Diagnostic.hxx"
+#include "weave/syntax/FlatSyntaxTree.hxx"
+#include "weave/syntax/SyntaxFactory.hxx"
+#include "weave/syntax/SyntaxTree.hxx"
+#include "weave/syntax/TokenStream.hxx"
+#include "weave/profiler/Profiler.hxx"
+#include "weave/time/Duration.hxx"
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace weave::driver
+{
+    /// \brief Holds everything produced by the front-end for a single source file.
+    ///
+    /// \note Each unit owns its own syntax factory, diagnostic sink and source text, so units may be processed by
+    ///       different threads without any synchronization.
+    struct SourceFileUnit final
+    {
+        /// \brief The path to the source file.
+        std::string Path{};
+
+        /// \brief The source text. Empty when the file could not be read.
+        std::optional<source::SourceText> Text{};
+
+        source::DiagnosticSink Diagnostic{};
+
+        syntax::SyntaxFactory Factory{};
+
+        /// \brief The parsed syntax tree. Null when the source is not valid UTF-8.
+        syntax::SourceFileSyntax* Root{};
+
+        /// \brief The flattened syntax tree. Empty unless requested by frontend options.
+        syntax::FlatSyntaxTree Flat{};
+
+        /// \brief Formatted diagnostic messages.
+        std::vector<std::string> Messages{};
+
+        /// \brief Time spent lexing, parsing and validating this file, or loading it from the parse cache.
+        time::Duration Elapsed{};
+
+        /// \brief Maximum number of tokens buffered by the parser. Zero when loaded from the parse cache.
+        size_t PeakTokenCount{};
+    };
+
+    struct FrontendOptions final
+    {
+        /// \brief The way tokens are provided to the parser.
+        syntax::TokenStreamMode TokenStream{syntax::TokenStreamMode::Streaming};
+
+        /// \brief Whether to flatten parsed syntax trees for later phases.
+        bool FlattenSyntaxTree{};
+
+        /// \brief The cache of parsed syntax trees. Sources are always parsed when null.
+        ParseCache* Cache{};
+    };
+
+    /// \brief Lexes, parses and validates all provided units.
+    ///
+    /// \param units        The units to process. Results are stored in the units, so the caller can report them in
+    ///                     input order regardless of the order in which workers finished.
+    /// \param workers      The maximum number of worker threads. The calling thread is always used as one of them.
+    /// \param options      The options controlling processing of each unit.
+    /// \param profiler     The profiler receiving per-file events.
+    void ParseSourceFiles(
+        std::span<std::unique_ptr<SourceFileUnit> const> units,
+        size_t workers,
+        FrontendOptions const& options,
+        profiler::Profiler& profiler);
+}
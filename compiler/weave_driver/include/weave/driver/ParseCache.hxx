@@ -0,0 +1,89 @@
+#pragma once
+#include "weave/source/Diagnostic.hxx"
+#include "weave/syntax/SyntaxFactory.hxx"
+#include "weave/syntax/SyntaxTree.hxx"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace weave::driver
+{
+    /// \brief Key of the parse cache entry.
+    using ParseCacheKey = std::array<uint8_t, 32>;
+
+    /// \brief Counters of parse cache operations.
+    struct ParseCacheStatistics final
+    {
+        size_t Hits{};
+        size_t Misses{};
+        size_t Stored{};
+        size_t Evicted{};
+        size_t Failed{};
+    };
+
+    /// \brief Content-addressed on-disk cache of parsed syntax trees.
+    ///
+    /// \details Entries are stored in a single directory, one file per entry, named after SHA-256 of the source
+    ///          content and version of the compiler. Each entry holds diagnostics reported while parsing the source and
+    ///          the serialized syntax tree.
+    ///
+    ///          Entries are written to temporary files first and then moved over the final name, so concurrent
+    ///          compiler processes never observe partially written entries. Last write time of an entry is refreshed
+    ///          on every hit, and least recently used entries are evicted when size of the cache exceeds the limit.
+    ///
+    /// \note Loading and storing entries is thread safe; trimming must not run concurrently with other operations.
+    class ParseCache final
+    {
+    private:
+        std::string _directory;
+        uint64_t _limit;
+
+        std::atomic_size_t _hits{};
+        std::atomic_size_t _misses{};
+        std::atomic_size_t _stored{};
+        std::atomic_size_t _evicted{};
+        std::atomic_size_t _failed{};
+
+        // Distinguishes temporary files written by concurrent workers.
+        std::atomic_uint64_t _sequence{};
+
+    public:
+        /// \param directory    The directory containing cache entries. Must exist.
+        /// \param limit        The maximum total size of cache entries, in bytes.
+        ParseCache(std::string directory, uint64_t limit);
+
+    public:
+        /// \brief Computes key of the entry for the provided source content.
+        [[nodiscard]] static ParseCacheKey ComputeKey(std::string_view content);
+
+        /// \brief Loads cached syntax tree and diagnostics.
+        ///
+        /// \return Root of the restored tree, or `nullptr` when the entry does not exist or is malformed. Diagnostic
+        ///         sink is left unchanged on failure.
+        [[nodiscard]] syntax::SourceFileSyntax* Load(
+            ParseCacheKey const& key,
+            syntax::SyntaxFactory& factory,
+            source::DiagnosticSink& diagnostic);
+
+        /// \brief Stores syntax tree and diagnostics reported for it.
+        void Store(
+            ParseCacheKey const& key,
+            syntax::SyntaxFactory const& factory,
+            source::DiagnosticSink const& diagnostic,
+            syntax::SourceFileSyntax* root);
+
+        /// \brief Evicts least recently used entries until size of the cache fits the limit.
+        ///
+        /// \details Temporary files left by processes which did not finish writing an entry are removed once they are
+        ///          old enough. Recent temporary files count against the limit, but are never removed.
+        void Trim();
+
+        [[nodiscard]] ParseCacheStatistics GetStatistics() const;
+
+    private:
+        [[nodiscard]] std::string GetEntryPath(ParseCacheKey const& key) const;
+    };
+}
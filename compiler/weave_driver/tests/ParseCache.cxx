@@ -0,0 +1,327 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/driver/ParseCache.hxx"
+#include "weave/filesystem/DirectoryEnumerator.hxx"
+#include "weave/filesystem/FileInfo.hxx"
+#include "weave/filesystem/FileSystem.hxx"
+#include "weave/filesystem/Path.hxx"
+#include "weave/syntax/SyntaxSerializer.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "Helpers.hxx"
+
+namespace
+{
+    std::vector<std::string> ListFiles(std::string const& directory)
+    {
+        using namespace weave::filesystem;
+
+        std::vector<std::string> result{};
+        DirectoryEnumerator enumerator{directory};
+
+        while (auto const item = enumerator.Next())
+        {
+            if (item->has_value() and (item->value().Type != FileType::Directory))
+            {
+                result.emplace_back(path::GetFilename(item->value().Path));
+            }
+        }
+
+        std::ranges::sort(result);
+        return result;
+    }
+
+    // Creates empty cache directory for the test, removing files left by previous runs.
+    std::string PrepareDirectory(std::string_view name)
+    {
+        using namespace weave::filesystem;
+
+        std::string result{WEAVE_DRIVER_TESTS_DIRECTORY};
+        (void)Directory::Create(result);
+
+        path::Push(result, name);
+
+        if (FileInfo::FromPath(result).has_value())
+        {
+            for (std::string const& file : ListFiles(result))
+            {
+                std::string path = result;
+                path::Push(path, file);
+                (void)File::Remove(path);
+            }
+
+            REQUIRE(Directory::Remove(result).has_value());
+        }
+
+        REQUIRE(Directory::Create(result).has_value());
+        return result;
+    }
+
+    std::string GetEntryName(weave::driver::ParseCacheKey const& key)
+    {
+        std::string result{};
+
+        for (uint8_t const value : key)
+        {
+            result += fmt::format("{:02x}", value);
+        }
+
+        return result + ".wpc";
+    }
+
+    std::vector<std::byte> Serialize(helpers::ParsedTree const& tree)
+    {
+        std::vector<std::byte> result{};
+        weave::syntax::SerializeSyntaxTree(result, tree.Factory, tree.Root);
+        return result;
+    }
+
+    // Invalid literals are reported, so entries hold diagnostics too.
+    std::string_view const SampleSource = "public function f(a: int32) -> int32 { return a * 2; }\nfunction g() { var x = 0b12 + ; 'ab'; }\n";
+}
+
+TEST_CASE("ParseCache - store and load")
+{
+    using namespace weave;
+
+    std::string const directory = PrepareDirectory("store-and-load");
+    driver::ParseCache cache{directory, 1u << 20u};
+
+    helpers::ParsedTree const parsed{std::string{SampleSource}};
+    driver::ParseCacheKey const key = driver::ParseCache::ComputeKey(parsed.Text.GetContentView());
+    REQUIRE(parsed.Root != nullptr);
+    REQUIRE_FALSE(parsed.Diagnostic.Items.empty());
+
+    cache.Store(key, parsed.Factory, parsed.Diagnostic, parsed.Root);
+    REQUIRE(ListFiles(directory) == std::vector{GetEntryName(key)});
+
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+
+    syntax::SourceFileSyntax* const root = cache.Load(key, factory, diagnostic);
+    REQUIRE(root != nullptr);
+
+    std::vector<std::byte> restored{};
+    syntax::SerializeSyntaxTree(restored, factory, root);
+    REQUIRE(restored == Serialize(parsed));
+
+    REQUIRE(diagnostic.Items.size() == parsed.Diagnostic.Items.size());
+
+    for (size_t i = 0; i < diagnostic.Items.size(); ++i)
+    {
+        CHECK(diagnostic.Items[i].Message == parsed.Diagnostic.Items[i].Message);
+        CHECK(diagnostic.Items[i].Level == parsed.Diagnostic.Items[i].Level);
+        CHECK(diagnostic.Items[i].Source.Start.Offset == parsed.Diagnostic.Items[i].Source.Start.Offset);
+        CHECK(diagnostic.Items[i].Source.End.Offset == parsed.Diagnostic.Items[i].Source.End.Offset);
+    }
+
+    driver::ParseCacheStatistics const statistics = cache.GetStatistics();
+    REQUIRE(statistics.Stored == 1);
+    REQUIRE(statistics.Hits == 1);
+    REQUIRE(statistics.Misses == 0);
+    REQUIRE(statistics.Failed == 0);
+}
+
+TEST_CASE("ParseCache - key mismatch")
+{
+    using namespace weave;
+
+    std::string const directory = PrepareDirectory("key-mismatch");
+    driver::ParseCache cache{directory, 1u << 20u};
+
+    helpers::ParsedTree const parsed{std::string{SampleSource}};
+    driver::ParseCacheKey const key = driver::ParseCache::ComputeKey(parsed.Text.GetContentView());
+    cache.Store(key, parsed.Factory, parsed.Diagnostic, parsed.Root);
+
+    driver::ParseCacheKey const other = driver::ParseCache::ComputeKey("struct T { }\n");
+    REQUIRE(other != key);
+
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+
+    SECTION("Missing entry")
+    {
+        REQUIRE(cache.Load(other, factory, diagnostic) == nullptr);
+    }
+
+    SECTION("Entry stored under other name")
+    {
+        std::string source = directory;
+        filesystem::path::Push(source, GetEntryName(key));
+
+        std::string destination = directory;
+        filesystem::path::Push(destination, GetEntryName(other));
+
+        REQUIRE(filesystem::File::Move(source, destination).has_value());
+        REQUIRE(cache.Load(other, factory, diagnostic) == nullptr);
+    }
+
+    REQUIRE(diagnostic.Items.empty());
+    REQUIRE(cache.GetStatistics().Misses == 1);
+}
+
+TEST_CASE("ParseCache - corrupt entries are ignored")
+{
+    using namespace weave;
+
+    std::string const directory = PrepareDirectory("corrupt-entries");
+    driver::ParseCache cache{directory, 1u << 20u};
+
+    helpers::ParsedTree const parsed{std::string{SampleSource}};
+    driver::ParseCacheKey const key = driver::ParseCache::ComputeKey(parsed.Text.GetContentView());
+    cache.Store(key, parsed.Factory, parsed.Diagnostic, parsed.Root);
+
+    std::string path = directory;
+    filesystem::path::Push(path, GetEntryName(key));
+
+    std::vector<std::byte> const content = filesystem::ReadBinaryFile(path).value();
+
+    auto load = [&](std::span<std::byte const> corrupted)
+    {
+        REQUIRE(filesystem::WriteBinaryFile(path, corrupted).has_value());
+
+        source::DiagnosticSink diagnostic{"<source>"};
+        syntax::SyntaxFactory factory{};
+
+        syntax::SourceFileSyntax* const root = cache.Load(key, factory, diagnostic);
+
+        // Sink is left unchanged, so caller may parse the source instead.
+        REQUIRE(diagnostic.Items.empty());
+        return root;
+    };
+
+    SECTION("Empty")
+    {
+        REQUIRE(load({}) == nullptr);
+    }
+
+    SECTION("Truncated")
+    {
+        for (size_t size : {size_t{4}, size_t{40}, content.size() / 2, content.size() - 1})
+        {
+            REQUIRE(load(std::span{content}.first(size)) == nullptr);
+        }
+    }
+
+    SECTION("Bad signature")
+    {
+        std::vector<std::byte> corrupted = content;
+        corrupted[0] ^= std::byte{0xFF};
+        REQUIRE(load(corrupted) == nullptr);
+    }
+
+    SECTION("Bad version")
+    {
+        std::vector<std::byte> corrupted = content;
+        corrupted[4] ^= std::byte{0xFF};
+        REQUIRE(load(corrupted) == nullptr);
+    }
+
+    SECTION("Garbage after header")
+    {
+        std::vector<std::byte> corrupted{content.begin(), content.begin() + 40};
+        corrupted.resize(content.size(), std::byte{0xFF});
+        REQUIRE(load(corrupted) == nullptr);
+    }
+
+    REQUIRE(cache.GetStatistics().Hits == 0);
+}
+
+#if defined(__linux__)
+
+namespace
+{
+    void SetLastWriteTime(std::string const& path, time_t age)
+    {
+        struct timespec const times[2]{
+            {.tv_sec = 0, .tv_nsec = UTIME_OMIT},
+            {.tv_sec = time(nullptr) - age, .tv_nsec = 0},
+        };
+
+        REQUIRE(utimensat(AT_FDCWD, path.c_str(), times, 0) == 0);
+    }
+}
+
+TEST_CASE("ParseCache - trim evicts least recently used entries")
+{
+    using namespace weave;
+
+    std::string const directory = PrepareDirectory("trim");
+
+    std::vector<std::string> names{};
+    uint64_t size = 0;
+
+    {
+        driver::ParseCache cache{directory, 1u << 20u};
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+            helpers::ParsedTree const parsed{fmt::format("{}function f{}() {{ }}\n", SampleSource, i)};
+            driver::ParseCacheKey const key = driver::ParseCache::ComputeKey(parsed.Text.GetContentView());
+            cache.Store(key, parsed.Factory, parsed.Diagnostic, parsed.Root);
+            names.push_back(GetEntryName(key));
+        }
+    }
+
+    // Entries were used in order 2, 0, 3, 1 - from the least recently used.
+    std::array<size_t, 4> const order{2, 0, 3, 1};
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        std::string path = directory;
+        filesystem::path::Push(path, names[order[i]]);
+
+        SetLastWriteTime(path, static_cast<time_t>(100 - (10 * i)));
+        size = std::max<uint64_t>(size, static_cast<uint64_t>(filesystem::FileInfo::FromPath(path)->Size));
+    }
+
+    // Only two entries fit.
+    driver::ParseCache cache{directory, (size * 2) + (size / 2)};
+    cache.Trim();
+
+    std::vector<std::string> expected{names[3], names[1]};
+    std::ranges::sort(expected);
+
+    REQUIRE(ListFiles(directory) == expected);
+    REQUIRE(cache.GetStatistics().Evicted == 2);
+
+    // Cache fits the limit now; trimming again does nothing.
+    cache.Trim();
+    REQUIRE(ListFiles(directory) == expected);
+}
+
+TEST_CASE("ParseCache - trim removes stale temporary files")
+{
+    using namespace weave;
+
+    std::string const directory = PrepareDirectory("trim-temporary");
+
+    std::string stale = directory;
+    filesystem::path::Push(stale, "0123.wpc.1-0.tmp");
+
+    std::string recent = directory;
+    filesystem::path::Push(recent, "0123.wpc.2-1.tmp");
+
+    std::vector<std::byte> const content(1000, std::byte{0xCC});
+    REQUIRE(filesystem::WriteBinaryFile(stale, content).has_value());
+    REQUIRE(filesystem::WriteBinaryFile(recent, content).has_value());
+
+    SetLastWriteTime(stale, 2 * 60 * 60);
+
+    driver::ParseCache cache{directory, 1u << 20u};
+    cache.Trim();
+
+    REQUIRE(ListFiles(directory) == std::vector<std::string>{"0123.wpc.2-1.tmp"});
+    REQUIRE(cache.GetStatistics().Evicted == 1);
+}
+
+#endif
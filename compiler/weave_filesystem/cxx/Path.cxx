@@ -215,7 +215,8 @@ namespace weave::filesystem::path
             return path.substr(separator + 1);
         }
 
-        return {};
+        // Path without separators is a filename.
+        return path;
     }
 
     std::string_view GetFilenameWithoutExtension(std::string_view path)
@@ -5,6 +5,7 @@
 WEAVE_EXTERNAL_HEADERS_BEGIN
 
 #include <dirent.h>
+#include <sys/stat.h>
 
 WEAVE_EXTERNAL_HEADERS_END
 
@@ -42,4 +43,34 @@ namespace weave::filesystem::impl
 
         }
     }
+
+    constexpr FileType ConvertModeToFileType(mode_t mode)
+    {
+        switch (mode & S_IFMT)
+        {
+        default:
+            return FileType::Unknown;
+
+        case S_IFIFO:
+            return FileType::NamedPipe;
+
+        case S_IFCHR:
+            return FileType::CharacterDevice;
+
+        case S_IFDIR:
+            return FileType::Directory;
+
+        case S_IFBLK:
+            return FileType::BlockDevice;
+
+        case S_IFREG:
+            return FileType::File;
+
+        case S_IFLNK:
+            return FileType::SymbolicLink;
+
+        case S_IFSOCK:
+            return FileType::Socket;
+        }
+    }
 }
@@ -187,6 +187,19 @@ namespace weave::filesystem
         return std::unexpected(platform::impl::SystemErrorFromErrno(errno));
     }
 
+    std::expected<void, platform::SystemError> FileHandle::Flush()
+    {
+        impl::PlatformFileHandle const& native = this->AsPlatform();
+        WEAVE_ASSERT(native.FileDescriptor >= 0);
+
+        if (fsync(native.FileDescriptor) == 0)
+        {
+            return {};
+        }
+
+        return std::unexpected(platform::impl::SystemErrorFromErrno(errno));
+    }
+
     std::expected<int64_t, platform::SystemError> FileHandle::GetLength() const
     {
         impl::PlatformFileHandle const& native = this->AsPlatform();
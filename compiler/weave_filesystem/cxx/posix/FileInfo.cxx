@@ -3,17 +3,33 @@
 
 #include "Common.hxx"
 
+#include <string>
+
 namespace weave::filesystem
 {
     std::optional<FileInfo> FileInfo::FromPath(std::string_view path)
     {
-        (void)path;
+        struct stat st{};
+
+        if (stat(std::string{path}.c_str(), &st) == 0)
+        {
+            // Creation time is not reported by stat; time of last status change is the closest approximation.
+            return FileInfo{
+                .CreationTime = time::impl::FromNative(st.st_ctim, time::DateTimeKind::Utc),
+                .LastAccessTime = time::impl::FromNative(st.st_atim, time::DateTimeKind::Utc),
+                .LastWriteTime = time::impl::FromNative(st.st_mtim, time::DateTimeKind::Utc),
+                .Size = static_cast<int64_t>(st.st_size),
+                .Type = impl::ConvertModeToFileType(st.st_mode),
+                .Readonly = (st.st_mode & S_IWUSR) == 0,
+            };
+        }
+
         return {};
     }
 
     bool FileInfo::Exists(std::string_view path)
     {
-        (void)path;
-        return false;
+        struct stat st{};
+        return stat(std::string{path}.c_str(), &st) == 0;
     }
 }
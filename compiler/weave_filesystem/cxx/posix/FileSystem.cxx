@@ -0,0 +1,71 @@
+#include "weave/filesystem/FileSystem.hxx"
+#include "weave/platform/SystemError.hxx"
+
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace weave::filesystem
+{
+    std::expected<void, platform::SystemError> File::Remove(
+        std::string_view path)
+    {
+        if (unlink(std::string{path}.c_str()) != 0)
+        {
+            return std::unexpected(platform::impl::SystemErrorFromErrno(errno));
+        }
+
+        return {};
+    }
+
+    std::expected<void, platform::SystemError> File::Move(
+        std::string_view existing,
+        std::string_view destination)
+    {
+        if (rename(std::string{existing}.c_str(), std::string{destination}.c_str()) != 0)
+        {
+            return std::unexpected(platform::impl::SystemErrorFromErrno(errno));
+        }
+
+        return {};
+    }
+
+    std::expected<void, platform::SystemError> File::Touch(
+        std::string_view path)
+    {
+        if (utimensat(AT_FDCWD, std::string{path}.c_str(), nullptr, 0) != 0)
+        {
+            return std::unexpected(platform::impl::SystemErrorFromErrno(errno));
+        }
+
+        return {};
+    }
+}
+
+namespace weave::filesystem
+{
+    std::expected<void, platform::SystemError> Directory::Create(
+        std::string_view path)
+    {
+        if (mkdir(std::string{path}.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) != 0)
+        {
+            return std::unexpected(platform::impl::SystemErrorFromErrno(errno));
+        }
+
+        return {};
+    }
+
+    std::expected<void, platform::SystemError> Directory::Remove(
+        std::string_view path)
+    {
+        if (rmdir(std::string{path}.c_str()) != 0)
+        {
+            return std::unexpected(platform::impl::SystemErrorFromErrno(errno));
+        }
+
+        return {};
+    }
+}
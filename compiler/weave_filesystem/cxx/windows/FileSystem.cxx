@@ -102,6 +102,66 @@ namespace weave::filesystem
 
         return std::unexpected(platform::SystemError::InvalidArgument);
     }
+
+    std::expected<void, platform::SystemError> File::Move(
+        std::string_view existing,
+        std::string_view destination)
+    {
+        platform::windows::win32_FilePathW wExisting{};
+        platform::windows::win32_FilePathW wDestination{};
+
+        if (platform::windows::win32_WidenString(wExisting, existing) and platform::windows::win32_WidenString(wDestination, destination))
+        {
+            if (MoveFileExW(wExisting.data(), wDestination.data(), MOVEFILE_REPLACE_EXISTING) == FALSE)
+            {
+                return std::unexpected(platform::impl::SystemErrorFromWin32Error(GetLastError()));
+            }
+
+            return {};
+        }
+
+        return std::unexpected(platform::SystemError::InvalidArgument);
+    }
+
+    std::expected<void, platform::SystemError> File::Touch(
+        std::string_view path)
+    {
+        platform::windows::win32_FilePathW wPath{};
+
+        if (platform::windows::win32_WidenString(wPath, path))
+        {
+            HANDLE const hFile = CreateFileW(
+                wPath.data(),
+                FILE_WRITE_ATTRIBUTES,
+                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                nullptr,
+                OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL,
+                nullptr);
+
+            if (hFile == INVALID_HANDLE_VALUE)
+            {
+                return std::unexpected(platform::impl::SystemErrorFromWin32Error(GetLastError()));
+            }
+
+            FILETIME ftNow{};
+            GetSystemTimeAsFileTime(&ftNow);
+
+            BOOL const result = SetFileTime(hFile, nullptr, nullptr, &ftNow);
+            DWORD const dwError = GetLastError();
+
+            CloseHandle(hFile);
+
+            if (result == FALSE)
+            {
+                return std::unexpected(platform::impl::SystemErrorFromWin32Error(dwError));
+            }
+
+            return {};
+        }
+
+        return std::unexpected(platform::SystemError::InvalidArgument);
+    }
 }
 
 namespace weave::filesystem
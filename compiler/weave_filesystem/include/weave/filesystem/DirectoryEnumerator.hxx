@@ -18,6 +18,7 @@ namespace weave::filesystem::impl
 #if defined(WIN32)
         void* Native[1];
 #elif defined(__linux__)
+        void* Native[1];
 #else
 #error "Not implemented"
 #endif
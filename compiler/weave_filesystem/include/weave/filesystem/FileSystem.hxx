@@ -37,6 +37,17 @@ namespace weave::filesystem
 
         static std::expected<void, platform::SystemError> Remove(
             std::string_view path);
+
+        /// \brief Moves file to destination, replacing existing file.
+        ///
+        /// \details Move within the same volume is atomic; other processes see either the old or the new file.
+        static std::expected<void, platform::SystemError> Move(
+            std::string_view existing,
+            std::string_view destination);
+
+        /// \brief Sets last write time of the file to the current time.
+        static std::expected<void, platform::SystemError> Touch(
+            std::string_view path);
     };
 
     class Directory
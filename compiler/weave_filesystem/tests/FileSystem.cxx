@@ -0,0 +1,158 @@
+#include "weave/platform/Compiler.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "weave/filesystem/DirectoryEnumerator.hxx"
+#include "weave/filesystem/FileInfo.hxx"
+#include "weave/filesystem/FileSystem.hxx"
+#include "weave/filesystem/Path.hxx"
+
+namespace
+{
+    // Creates empty directory for the test, removing files left by previous runs.
+    std::string PrepareDirectory(std::string_view name)
+    {
+        using namespace weave::filesystem;
+
+        std::string result{WEAVE_FILESYSTEM_TESTS_DIRECTORY};
+        (void)Directory::Create(result);
+
+        path::Push(result, name);
+
+        if (FileInfo::FromPath(result).has_value())
+        {
+            DirectoryEnumerator enumerator{result};
+
+            while (auto const item = enumerator.Next())
+            {
+                if (item->has_value() and (item->value().Type != FileType::Directory))
+                {
+                    std::string file = result;
+                    path::Push(file, path::GetFilename(item->value().Path));
+                    (void)File::Remove(file);
+                }
+            }
+
+            REQUIRE(Directory::Remove(result).has_value());
+        }
+
+        REQUIRE(Directory::Create(result).has_value());
+        return result;
+    }
+}
+
+TEST_CASE("FileSystem - directory create")
+{
+    using namespace weave::filesystem;
+
+    std::string const root = PrepareDirectory("directory-create");
+    auto const info = FileInfo::FromPath(root);
+    REQUIRE(info.has_value());
+    REQUIRE(info->Type == FileType::Directory);
+
+    // Existing directory is reported as error.
+    REQUIRE_FALSE(Directory::Create(root).has_value());
+}
+
+TEST_CASE("FileSystem - file info")
+{
+    using namespace weave::filesystem;
+
+    std::string const root = PrepareDirectory("file-info");
+
+    std::string path = root;
+    path::Push(path, "file.bin");
+
+    REQUIRE_FALSE(FileInfo::FromPath(path).has_value());
+
+    std::vector<std::byte> const content(1234, std::byte{0x5A});
+    REQUIRE(WriteBinaryFile(path, content).has_value());
+
+    auto const info = FileInfo::FromPath(path);
+    REQUIRE(info.has_value());
+    REQUIRE(info->Type == FileType::File);
+    REQUIRE(info->Size == 1234);
+}
+
+TEST_CASE("FileSystem - file move")
+{
+    using namespace weave::filesystem;
+
+    std::string const root = PrepareDirectory("file-move");
+
+    std::string source = root;
+    path::Push(source, "source.txt");
+
+    std::string destination = root;
+    path::Push(destination, "destination.txt");
+
+    SECTION("Move to new name")
+    {
+        REQUIRE(WriteTextFile(source, "first").has_value());
+        REQUIRE(File::Move(source, destination).has_value());
+
+        REQUIRE_FALSE(FileInfo::FromPath(source).has_value());
+        REQUIRE(ReadTextFile(destination).value() == "first");
+    }
+
+    SECTION("Move replaces existing file")
+    {
+        REQUIRE(WriteTextFile(destination, "old").has_value());
+        REQUIRE(WriteTextFile(source, "new").has_value());
+        REQUIRE(File::Move(source, destination).has_value());
+
+        REQUIRE_FALSE(FileInfo::FromPath(source).has_value());
+        REQUIRE(ReadTextFile(destination).value() == "new");
+    }
+
+    SECTION("Missing source")
+    {
+        REQUIRE_FALSE(File::Move(source, destination).has_value());
+    }
+}
+
+#if defined(__linux__)
+
+TEST_CASE("FileSystem - file touch")
+{
+    using namespace weave::filesystem;
+
+    std::string const root = PrepareDirectory("file-touch");
+
+    std::string path = root;
+    path::Push(path, "file.txt");
+
+    REQUIRE(WriteTextFile(path, "content").has_value());
+
+    // Move last write time one day back.
+    struct timespec const times[2]{
+        {.tv_sec = 0, .tv_nsec = UTIME_OMIT},
+        {.tv_sec = time(nullptr) - (24 * 60 * 60), .tv_nsec = 0},
+    };
+
+    REQUIRE(utimensat(AT_FDCWD, path.c_str(), times, 0) == 0);
+
+    auto const before = FileInfo::FromPath(path);
+    REQUIRE(before.has_value());
+
+    REQUIRE(File::Touch(path).has_value());
+
+    auto const after = FileInfo::FromPath(path);
+    REQUIRE(after.has_value());
+    REQUIRE(after->LastWriteTime > before->LastWriteTime);
+    REQUIRE(ReadTextFile(path).value() == "content");
+
+    path::Push(path, "missing");
+    REQUIRE_FALSE(File::Touch(path).has_value());
+}
+
+#endif
@@ -284,6 +284,13 @@ TEST_CASE("Path - GetExtension")
         REQUIRE(path::GetExtension(path) == ".txt");
     }
 
+    SECTION("Filename without directory")
+    {
+        std::string const path = "filename.txt";
+
+        REQUIRE(path::GetExtension(path) == ".txt");
+    }
+
     SECTION("Extension from last path segment")
     {
         std::string const path = "path/to.some/file.txt";
@@ -337,6 +344,13 @@ TEST_CASE("Path - GetFilename")
 
         REQUIRE(path::GetFilename(path) == "filename.txt");
     }
+
+    SECTION("Filename without directory")
+    {
+        std::string const path = "filename.txt";
+
+        REQUIRE(path::GetFilename(path) == "filename.txt");
+    }
 }
 
 TEST_CASE("Path - GetFilenameWithoutExtension")
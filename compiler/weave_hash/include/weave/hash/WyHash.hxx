@@ -0,0 +1,316 @@
+#pragma once
+#include "weave/platform/Compiler.hxx"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <span>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <intrin.h>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#endif
+
+// Implementation of wyhash (final version 4) by Wang Yi, with default secret.
+//
+// Reference: https://github.com/wangyi-fudan/wyhash
+
+namespace weave::hash::impl
+{
+    inline constexpr std::array<uint64_t, 4> WyHashSecret{
+        0xa0761d6478bd642fu,
+        0xe7037ed1a0b428dbu,
+        0x8ebc6af09c88c6e3u,
+        0x589965cc75374cc3u,
+    };
+
+    // Computes full 128-bit product of `a` and `b`; low half is stored in `a`, high half in `b`.
+    constexpr void WyMultiply(uint64_t& a, uint64_t& b)
+    {
+        if consteval
+        {
+            uint64_t const ha = a >> 32;
+            uint64_t const hb = b >> 32;
+            uint64_t const la = static_cast<uint32_t>(a);
+            uint64_t const lb = static_cast<uint32_t>(b);
+
+            uint64_t const rh = ha * hb;
+            uint64_t const rm0 = ha * lb;
+            uint64_t const rm1 = hb * la;
+            uint64_t const rl = la * lb;
+
+            uint64_t const t = rl + (rm0 << 32);
+            uint64_t const lo = t + (rm1 << 32);
+            uint64_t const carry = static_cast<uint64_t>(t < rl) + static_cast<uint64_t>(lo < t);
+            uint64_t const hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+
+            a = lo;
+            b = hi;
+        }
+        else
+        {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t const r = static_cast<__uint128_t>(a) * b;
+            a = static_cast<uint64_t>(r);
+            b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            a = _umul128(a, b, &b);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+            uint64_t const hi = __umulh(a, b);
+            a = a * b;
+            b = hi;
+#else
+#error "Not implemented"
+#endif
+        }
+    }
+
+    [[nodiscard]] constexpr uint64_t WyMix(uint64_t a, uint64_t b)
+    {
+        WyMultiply(a, b);
+        return a ^ b;
+    }
+
+    [[nodiscard]] constexpr uint64_t WyRead8(char const* p)
+    {
+        if consteval
+        {
+            uint64_t result{};
+
+            for (size_t i = 0; i < 8; ++i)
+            {
+                result |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (i * 8);
+            }
+
+            return result;
+        }
+        else
+        {
+            uint64_t result;
+            std::memcpy(&result, p, sizeof(result));
+
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                result = std::byteswap(result);
+            }
+
+            return result;
+        }
+    }
+
+    [[nodiscard]] constexpr uint64_t WyRead4(char const* p)
+    {
+        if consteval
+        {
+            uint64_t result{};
+
+            for (size_t i = 0; i < 4; ++i)
+            {
+                result |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (i * 8);
+            }
+
+            return result;
+        }
+        else
+        {
+            uint32_t result;
+            std::memcpy(&result, p, sizeof(result));
+
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                result = std::byteswap(result);
+            }
+
+            return result;
+        }
+    }
+
+    [[nodiscard]] constexpr uint64_t WyRead3(char const* p, size_t k)
+    {
+        return (static_cast<uint64_t>(static_cast<unsigned char>(p[0])) << 16)
+            | (static_cast<uint64_t>(static_cast<unsigned char>(p[k >> 1])) << 8)
+            | static_cast<uint64_t>(static_cast<unsigned char>(p[k - 1]));
+    }
+
+    [[nodiscard]] constexpr uint64_t WyFinish(uint64_t a, uint64_t b, uint64_t seed, size_t length)
+    {
+        a ^= WyHashSecret[1];
+        b ^= seed;
+        WyMultiply(a, b);
+        return WyMix(a ^ WyHashSecret[0] ^ length, b ^ WyHashSecret[1]);
+    }
+
+    // Hashes inputs up to 16 bytes long.
+    [[nodiscard]] constexpr uint64_t WyHashShort(char const* p, size_t length, uint64_t seed)
+    {
+        uint64_t a{};
+        uint64_t b{};
+
+        if (length >= 4)
+        {
+            size_t const offset = (length >> 3) << 2;
+            a = (WyRead4(p) << 32) | WyRead4(p + offset);
+            b = (WyRead4(p + length - 4) << 32) | WyRead4(p + length - 4 - offset);
+        }
+        else if (length > 0)
+        {
+            a = WyRead3(p, length);
+        }
+
+        return WyFinish(a, b, seed, length);
+    }
+}
+
+namespace weave::hash
+{
+    /// \brief Fast non-cryptographic 64-bit hash, processing input 8 bytes at a time.
+    ///
+    /// \details Streaming updates produce exactly the same value as the one-shot functions. Hashing strings is
+    ///          usable in constant expressions.
+    struct WyHash64 final
+    {
+    private:
+        static constexpr size_t StripeSize = 48;
+        static constexpr size_t HistorySize = 16;
+
+    private:
+        uint64_t _seed{};
+        uint64_t _see1{};
+        uint64_t _see2{};
+        size_t _length{};
+        size_t _buffered{};
+
+        // Last 16 bytes of already processed stripe, followed by unprocessed input.
+        std::array<char, HistorySize + StripeSize> _buffer{};
+
+    public:
+        constexpr WyHash64()
+            : WyHash64{0}
+        {
+        }
+
+        explicit constexpr WyHash64(uint64_t seed)
+        {
+            this->_seed = seed ^ impl::WyMix(seed ^ impl::WyHashSecret[0], impl::WyHashSecret[1]);
+            this->_see1 = this->_seed;
+            this->_see2 = this->_seed;
+        }
+
+    private:
+        static constexpr void ProcessStripe(char const* p, uint64_t& seed, uint64_t& see1, uint64_t& see2)
+        {
+            seed = impl::WyMix(impl::WyRead8(p) ^ impl::WyHashSecret[1], impl::WyRead8(p + 8) ^ seed);
+            see1 = impl::WyMix(impl::WyRead8(p + 16) ^ impl::WyHashSecret[2], impl::WyRead8(p + 24) ^ see1);
+            see2 = impl::WyMix(impl::WyRead8(p + 32) ^ impl::WyHashSecret[3], impl::WyRead8(p + 40) ^ see2);
+        }
+
+        // Hashes remaining `length` bytes starting at `p`; at least 16 bytes before `p + length` must be readable.
+        [[nodiscard]] static constexpr uint64_t FinishLong(char const* p, size_t length, size_t total, uint64_t seed)
+        {
+            while (length > 16)
+            {
+                seed = impl::WyMix(impl::WyRead8(p) ^ impl::WyHashSecret[1], impl::WyRead8(p + 8) ^ seed);
+                p += 16;
+                length -= 16;
+            }
+
+            return impl::WyFinish(impl::WyRead8(p + length - 16), impl::WyRead8(p + length - 8), seed, total);
+        }
+
+    public:
+        constexpr WyHash64& Update(std::string_view value)
+        {
+            char const* p = value.data();
+            size_t length = value.size();
+
+            this->_length += length;
+
+            while (length != 0)
+            {
+                size_t const count = std::min(length, StripeSize - this->_buffered);
+                std::copy_n(p, count, this->_buffer.data() + HistorySize + this->_buffered);
+
+                p += count;
+                length -= count;
+                this->_buffered += count;
+
+                if (this->_buffered == StripeSize)
+                {
+                    // At least 48 bytes remain, so one-shot hash would process this stripe too.
+                    ProcessStripe(this->_buffer.data() + HistorySize, this->_seed, this->_see1, this->_see2);
+                    std::copy_n(this->_buffer.data() + StripeSize, HistorySize, this->_buffer.data());
+                    this->_buffered = 0;
+                }
+            }
+
+            return *this;
+        }
+
+        WyHash64& Update(std::span<std::byte const> value)
+        {
+            return this->Update(std::string_view{reinterpret_cast<char const*>(value.data()), value.size()});
+        }
+
+        [[nodiscard]] constexpr uint64_t Finalize() const
+        {
+            char const* const p = this->_buffer.data() + HistorySize;
+
+            if (this->_length <= 16)
+            {
+                return impl::WyHashShort(p, this->_length, this->_seed);
+            }
+
+            uint64_t seed = this->_seed;
+
+            if (this->_length >= StripeSize)
+            {
+                seed ^= this->_see1 ^ this->_see2;
+            }
+
+            return FinishLong(p, this->_buffered, this->_length, seed);
+        }
+
+        [[nodiscard]] static constexpr uint64_t FromString(std::string_view value, uint64_t seed = 0)
+        {
+            char const* p = value.data();
+            size_t length = value.size();
+
+            seed ^= impl::WyMix(seed ^ impl::WyHashSecret[0], impl::WyHashSecret[1]);
+
+            if (length <= 16)
+            {
+                return impl::WyHashShort(p, length, seed);
+            }
+
+            if (length >= StripeSize)
+            {
+                uint64_t see1 = seed;
+                uint64_t see2 = seed;
+
+                do
+                {
+                    ProcessStripe(p, seed, see1, see2);
+                    p += StripeSize;
+                    length -= StripeSize;
+                } while (length >= StripeSize);
+
+                seed ^= see1 ^ see2;
+            }
+
+            return FinishLong(p, length, value.size(), seed);
+        }
+
+        [[nodiscard]] static uint64_t FromBuffer(std::span<std::byte const> value, uint64_t seed = 0)
+        {
+            return FromString(std::string_view{reinterpret_cast<char const*>(value.data()), value.size()}, seed);
+        }
+    };
+}
@@ -0,0 +1,210 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/hash/WyHash.hxx"
+#include "weave/hash/Fnv1a.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include <fmt/format.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    std::vector<std::string> MakeIdentifiers(size_t count)
+    {
+        std::vector<std::string> result{};
+        result.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            result.push_back(fmt::format("identifier_{}", i));
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE("WyHash - reference values")
+{
+    using namespace weave::hash;
+
+    static_assert(WyHash64::FromString("", 0) == 0x0409638ee2bde459u);
+    static_assert(WyHash64::FromString("abcdefghijklmnopqrstuvwxyz", 4) == 0x7a43afb61d7f5f40u);
+
+    CHECK(WyHash64::FromString("", 0) == 0x0409638ee2bde459u);
+    CHECK(WyHash64::FromString("a", 1) == 0xa8412d091b5fe0a9u);
+    CHECK(WyHash64::FromString("abc", 2) == 0x32dd92e4b2915153u);
+    CHECK(WyHash64::FromString("message digest", 3) == 0x8619124089a3a16bu);
+    CHECK(WyHash64::FromString("abcdefghijklmnopqrstuvwxyz", 4) == 0x7a43afb61d7f5f40u);
+    CHECK(WyHash64::FromString("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 5) == 0xff42329b90e50d58u);
+    CHECK(WyHash64::FromString("12345678901234567890123456789012345678901234567890123456789012345678901234567890", 6) == 0xc39cab13b115aad3u);
+}
+
+TEST_CASE("WyHash - streaming matches one-shot")
+{
+    using namespace weave::hash;
+
+    std::string input{};
+
+    for (size_t i = 0; i < 300; ++i)
+    {
+        input.push_back(static_cast<char>((i * 131) ^ (i >> 3)));
+    }
+
+    for (size_t length = 0; length <= input.size(); ++length)
+    {
+        std::string_view const value = std::string_view{input}.substr(0, length);
+        uint64_t const expected = WyHash64::FromString(value, 42);
+
+        for (size_t chunk : {size_t{1}, size_t{7}, size_t{16}, size_t{47}, size_t{48}, size_t{49}, size_t{300}})
+        {
+            WyHash64 hash{42};
+
+            for (size_t offset = 0; offset < length; offset += chunk)
+            {
+                hash.Update(value.substr(offset, chunk));
+            }
+
+            REQUIRE(hash.Finalize() == expected);
+        }
+
+        REQUIRE(WyHash64::FromBuffer(std::as_bytes(std::span{value}), 42) == expected);
+    }
+}
+
+TEST_CASE("WyHash - distribution")
+{
+    using namespace weave::hash;
+
+    std::vector<std::string> const identifiers = MakeIdentifiers(1u << 16u);
+
+    SECTION("No collisions")
+    {
+        std::unordered_set<uint64_t> hashes{};
+
+        for (std::string const& identifier : identifiers)
+        {
+            hashes.insert(WyHash64::FromString(identifier));
+        }
+
+        REQUIRE(hashes.size() == identifiers.size());
+    }
+
+    SECTION("Buckets from low and high bits are uniform")
+    {
+        constexpr size_t buckets = 1024;
+        constexpr double expected = static_cast<double>(1u << 16u) / buckets;
+
+        std::vector<size_t> low(buckets);
+        std::vector<size_t> high(buckets);
+
+        for (std::string const& identifier : identifiers)
+        {
+            uint64_t const hash = WyHash64::FromString(identifier);
+            ++low[hash % buckets];
+            ++high[hash >> 54u];
+        }
+
+        auto chiSquare = [&](std::vector<size_t> const& counts)
+        {
+            double result = 0.0;
+
+            for (size_t count : counts)
+            {
+                double const delta = static_cast<double>(count) - expected;
+                result += (delta * delta) / expected;
+            }
+
+            return result;
+        };
+
+        // 1023 degrees of freedom; critical value for p = 0.001 is about 1170.
+        CHECK(chiSquare(low) < 1170.0);
+        CHECK(chiSquare(high) < 1170.0);
+    }
+
+    SECTION("Avalanche")
+    {
+        // Flipping any input bit should flip each output bit with probability close to 1/2.
+        std::vector<size_t> flips(64);
+        size_t samples = 0;
+
+        for (size_t length : {size_t{3}, size_t{8}, size_t{13}, size_t{32}, size_t{100}})
+        {
+            for (size_t seed = 0; seed < 64; ++seed)
+            {
+                std::string input = fmt::format("{:0>{}}", seed * 0x9E3779B97F4A7C15u, length).substr(0, length);
+                uint64_t const original = WyHash64::FromString(input);
+
+                for (size_t bit = 0; bit < (length * 8); ++bit)
+                {
+                    input[bit / 8] ^= static_cast<char>(1u << (bit % 8));
+                    uint64_t const changed = original ^ WyHash64::FromString(input);
+                    input[bit / 8] ^= static_cast<char>(1u << (bit % 8));
+
+                    for (size_t i = 0; i < 64; ++i)
+                    {
+                        flips[i] += (changed >> i) & 1u;
+                    }
+
+                    ++samples;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < 64; ++i)
+        {
+            double const probability = static_cast<double>(flips[i]) / static_cast<double>(samples);
+            CHECK(probability > 0.47);
+            CHECK(probability < 0.53);
+        }
+    }
+}
+
+TEST_CASE("WyHash - benchmark", "[.benchmark]")
+{
+    using namespace weave::hash;
+
+    std::vector<std::string> const identifiers = MakeIdentifiers(1024);
+    std::string const text(1u << 20u, 'x');
+
+    BENCHMARK("identifiers - fnv1a")
+    {
+        uint64_t result{};
+
+        for (std::string const& identifier : identifiers)
+        {
+            result ^= Fnv1a64::FromString(identifier);
+        }
+
+        return result;
+    };
+
+    BENCHMARK("identifiers - wyhash")
+    {
+        uint64_t result{};
+
+        for (std::string const& identifier : identifiers)
+        {
+            result ^= WyHash64::FromString(identifier);
+        }
+
+        return result;
+    };
+
+    BENCHMARK("1 MiB - fnv1a")
+    {
+        return Fnv1a64::FromString(text);
+    };
+
+    BENCHMARK("1 MiB - wyhash")
+    {
+        return WyHash64::FromString(text);
+    };
+}
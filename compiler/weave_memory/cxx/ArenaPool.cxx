@@ -0,0 +1,437 @@
+#include "weave/memory/ArenaPool.hxx"
+#include "weave/memory/PageAllocator.hxx"
+#include "weave/memory/PageHeap.hxx"
+#include "weave/bugcheck/BugCheck.hxx"
+#include "weave/bugcheck/Assert.hxx"
+
+namespace weave::memory::impl
+{
+    constexpr void PushBack(ArenaSegmentList& list, ArenaSegment* segment)
+    {
+        segment->Next = nullptr;
+
+        if (list.Head == nullptr)
+        {
+            list.Head = segment;
+        }
+        else
+        {
+            list.Tail->Next = segment;
+        }
+
+        list.Tail = segment;
+        ++list.Count;
+        list.Size += segment->Size;
+    }
+
+    constexpr void PushFront(ArenaSegmentList& list, ArenaSegment* segment)
+    {
+        segment->Next = list.Head;
+
+        if (list.Head == nullptr)
+        {
+            list.Tail = segment;
+        }
+
+        list.Head = segment;
+        ++list.Count;
+        list.Size += segment->Size;
+    }
+
+    constexpr ArenaSegment* PopFront(ArenaSegmentList& list)
+    {
+        ArenaSegment* const result = list.Head;
+
+        if (result != nullptr)
+        {
+            list.Head = result->Next;
+
+            if (list.Head == nullptr)
+            {
+                list.Tail = nullptr;
+            }
+
+            --list.Count;
+            list.Size -= result->Size;
+            result->Next = nullptr;
+        }
+
+        return result;
+    }
+
+    constexpr void Splice(ArenaSegmentList& list, ArenaSegmentList& other)
+    {
+        if (other.Head != nullptr)
+        {
+            if (list.Head == nullptr)
+            {
+                list.Head = other.Head;
+            }
+            else
+            {
+                list.Tail->Next = other.Head;
+            }
+
+            list.Tail = other.Tail;
+            list.Count += other.Count;
+            list.Size += other.Size;
+
+            other = {};
+        }
+    }
+}
+
+namespace weave::memory
+{
+    bool SealedArena::Contains(void const* pointer) const
+    {
+        if (this->_record != nullptr)
+        {
+            std::byte const* const address = static_cast<std::byte const*>(pointer);
+
+            for (impl::ArenaSegment const* segment = this->_record->Segments.Head; segment != nullptr; segment = segment->Next)
+            {
+                std::byte const* const first = reinterpret_cast<std::byte const*>(segment + 1);
+                std::byte const* const last = reinterpret_cast<std::byte const*>(segment) + segment->Size;
+
+                if ((first <= address) and (address < last))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void SealedArena::Append(SealedArena&& other)
+    {
+        if (other._record == nullptr)
+        {
+            return;
+        }
+
+        if (this->_record == nullptr)
+        {
+            *this = std::move(other);
+            return;
+        }
+
+        WEAVE_ASSERT(this->_pool == other._pool);
+
+        this->_pool->Merge(this->_record, std::exchange(other._record, {}));
+        other._pool = nullptr;
+    }
+
+    Allocation ThreadArena::AllocateImpl(Layout const& layout)
+    {
+        size_t const payload = this->_pool->_segment_size - sizeof(impl::ArenaSegment);
+
+        if (layout.Size > (payload / 4))
+        {
+            // Large allocation gets its own segment, placed before the current one.
+            size_t const size = bitwise::AlignUp(sizeof(impl::ArenaSegment), layout.Alignment) + layout.Size;
+
+            impl::ArenaSegment* const segment = this->_pool->AllocateSegment(size);
+
+            impl::PushFront(this->_segments, segment);
+
+            std::byte* const result = bitwise::AlignUp(reinterpret_cast<std::byte*>(segment + 1), layout.Alignment);
+
+            ASAN_UNPOISON_MEMORY_REGION(result, layout.Size);
+
+            return Allocation{
+                .Address = result,
+                .Size = layout.Size,
+            };
+        }
+
+        if (this->_cache.Head == nullptr)
+        {
+            this->_cache = this->_pool->Refill(ArenaPool::RefillCount);
+        }
+
+        impl::ArenaSegment* const segment = impl::PopFront(this->_cache);
+        impl::PushBack(this->_segments, segment);
+
+        this->_last = reinterpret_cast<std::byte*>(segment + 1);
+        this->_end = reinterpret_cast<std::byte*>(segment) + segment->Size;
+
+        // Restart allocation - this time it should work
+        return this->Allocate(layout);
+    }
+
+    SealedArena ThreadArena::Seal()
+    {
+        this->_last = nullptr;
+        this->_end = nullptr;
+
+        return this->_pool->Seal(std::exchange(this->_segments, {}));
+    }
+
+    ArenaPool::ArenaPool(size_t segment_size)
+        : _segment_size{bitwise::AlignUp(segment_size, PageSize)}
+    {
+    }
+
+    ArenaPool::~ArenaPool()
+    {
+        // Everything is released by walking segment lists; no arena is used by other threads at this point.
+        auto release = [this](impl::ArenaSegmentList& list)
+        {
+            while (impl::ArenaSegment* const segment = impl::PopFront(list))
+            {
+                this->DeallocateSegment(segment);
+            }
+        };
+
+        ThreadLocalRegistry::Entry* entry = this->_arenas.GetFirst();
+
+        while (entry != nullptr)
+        {
+            ThreadLocalRegistry::Entry* const next = entry->Next;
+            ThreadArena* const arena = static_cast<ThreadArena*>(entry);
+            release(arena->_segments);
+            release(arena->_cache);
+            delete arena;
+            entry = next;
+        }
+
+        impl::SealedArenaRecord* record = this->_sealed;
+
+        while (record != nullptr)
+        {
+            impl::SealedArenaRecord* const next = record->Next;
+            release(record->Segments);
+            delete record;
+            record = next;
+        }
+
+        release(this->_free);
+
+        WEAVE_ASSERT(this->_segments.load(std::memory_order_relaxed) == 0);
+    }
+
+    impl::ArenaSegment* ArenaPool::AllocateSegment(size_t size)
+    {
+        size = bitwise::AlignUp(size, PageSize);
+
+        void* const memory = PageHeap::Get().Allocate(size);
+
+        if (memory == nullptr)
+        {
+            WEAVE_BUGCHECK("Out of memory");
+        }
+
+        this->_reserved.fetch_add(size, std::memory_order_relaxed);
+        this->_segments.fetch_add(1, std::memory_order_relaxed);
+
+        if (MemoryArena* const arena = this->_arena.load(std::memory_order_relaxed); arena != nullptr)
+        {
+            arena->Allocated(size);
+        }
+
+        impl::ArenaSegment* const result = new (memory) impl::ArenaSegment{nullptr, size};
+
+        ASAN_POISON_MEMORY_REGION(result + 1, size - sizeof(impl::ArenaSegment));
+
+        return result;
+    }
+
+    void ArenaPool::DeallocateSegment(impl::ArenaSegment* segment)
+    {
+        size_t const size = segment->Size;
+
+        this->_reserved.fetch_sub(size, std::memory_order_relaxed);
+        this->_segments.fetch_sub(1, std::memory_order_relaxed);
+
+        if (MemoryArena* const arena = this->_arena.load(std::memory_order_relaxed); arena != nullptr)
+        {
+            arena->Deallocated(size);
+        }
+
+        ASAN_UNPOISON_MEMORY_REGION(segment, size);
+
+        PageHeap::Get().Deallocate(segment);
+    }
+
+    impl::ArenaSegmentList ArenaPool::Refill(size_t count)
+    {
+        impl::ArenaSegmentList result{};
+
+        {
+            threading::CriticalSection::Lock lock{this->_lock};
+
+            while ((result.Count < count) and (this->_free.Head != nullptr))
+            {
+                impl::PushBack(result, impl::PopFront(this->_free));
+            }
+        }
+
+        this->_refills.fetch_add(1, std::memory_order_relaxed);
+
+        // Page heap has its own lock, so new segments are allocated outside of the pool lock.
+        while (result.Count < count)
+        {
+            impl::PushBack(result, this->AllocateSegment(this->_segment_size));
+        }
+
+        return result;
+    }
+
+    void ArenaPool::Recycle(impl::ArenaSegmentList segments)
+    {
+        impl::ArenaSegmentList reusable{};
+
+        while (impl::ArenaSegment* const segment = impl::PopFront(segments))
+        {
+            if (segment->Size == this->_segment_size)
+            {
+                ASAN_POISON_MEMORY_REGION(segment + 1, segment->Size - sizeof(impl::ArenaSegment));
+                impl::PushBack(reusable, segment);
+            }
+            else
+            {
+                this->DeallocateSegment(segment);
+            }
+        }
+
+        threading::CriticalSection::Lock lock{this->_lock};
+        impl::Splice(this->_free, reusable);
+    }
+
+    SealedArena ArenaPool::Seal(impl::ArenaSegmentList segments)
+    {
+        if (segments.Head == nullptr)
+        {
+            return {};
+        }
+
+        impl::SealedArenaRecord* const record = new impl::SealedArenaRecord{
+            .Previous = nullptr,
+            .Next = nullptr,
+            .Segments = segments,
+        };
+
+        threading::CriticalSection::Lock lock{this->_lock};
+
+        record->Next = this->_sealed;
+
+        if (this->_sealed != nullptr)
+        {
+            this->_sealed->Previous = record;
+        }
+
+        this->_sealed = record;
+        ++this->_sealed_count;
+
+        return SealedArena{this, record};
+    }
+
+    void ArenaPool::UnlinkSealed(impl::SealedArenaRecord* record)
+    {
+        if (record->Previous != nullptr)
+        {
+            record->Previous->Next = record->Next;
+        }
+        else
+        {
+            this->_sealed = record->Next;
+        }
+
+        if (record->Next != nullptr)
+        {
+            record->Next->Previous = record->Previous;
+        }
+
+        --this->_sealed_count;
+    }
+
+    void ArenaPool::Merge(impl::SealedArenaRecord* target, impl::SealedArenaRecord* source)
+    {
+        {
+            threading::CriticalSection::Lock lock{this->_lock};
+
+            this->UnlinkSealed(source);
+
+            impl::Splice(target->Segments, source->Segments);
+        }
+
+        delete source;
+    }
+
+    ThreadArena& ArenaPool::GetThreadArena()
+    {
+        if (ThreadLocalRegistry::Entry* const entry = this->_arenas.Find(); entry != nullptr)
+        {
+            return *static_cast<ThreadArena*>(entry);
+        }
+
+        ThreadArena* const arena = new ThreadArena{this};
+        this->_arenas.Register(arena);
+        return *arena;
+    }
+
+    void ArenaPool::Release(SealedArena&& arena)
+    {
+        WEAVE_ASSERT((arena._pool == nullptr) or (arena._pool == this));
+
+        impl::SealedArenaRecord* const record = std::exchange(arena._record, {});
+        arena._pool = nullptr;
+
+        if (record == nullptr)
+        {
+            return;
+        }
+
+        {
+            threading::CriticalSection::Lock lock{this->_lock};
+            this->UnlinkSealed(record);
+        }
+
+        this->Recycle(record->Segments);
+
+        delete record;
+    }
+
+    void ArenaPool::Trim()
+    {
+        impl::ArenaSegmentList segments{};
+
+        {
+            threading::CriticalSection::Lock lock{this->_lock};
+            segments = std::exchange(this->_free, {});
+        }
+
+        while (impl::ArenaSegment* const segment = impl::PopFront(segments))
+        {
+            this->DeallocateSegment(segment);
+        }
+    }
+
+    void ArenaPool::QueryStatistics(ArenaPoolStatistics& statistics) const
+    {
+        statistics.Reserved = this->_reserved.load(std::memory_order_relaxed);
+        statistics.Segments = this->_segments.load(std::memory_order_relaxed);
+        statistics.Refills = this->_refills.load(std::memory_order_relaxed);
+
+        threading::CriticalSection::Lock lock{this->_lock};
+        statistics.FreeSegments = this->_free.Count;
+        statistics.SealedArenas = this->_sealed_count;
+    }
+
+    void ArenaPool::SetArena(MemoryArena* arena)
+    {
+        size_t const reserved = this->_reserved.load(std::memory_order_relaxed);
+
+        if (MemoryArena* const previous = this->_arena.exchange(arena, std::memory_order_relaxed); previous != nullptr)
+        {
+            previous->Deallocated(reserved);
+        }
+
+        if (arena != nullptr)
+        {
+            arena->Allocated(reserved);
+        }
+    }
+}
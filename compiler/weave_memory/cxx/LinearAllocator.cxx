@@ -1,6 +1,10 @@
 #include "weave/memory/LinearAllocator.hxx"
+#include "weave/memory/PageAllocator.hxx"
+#include "weave/memory/PageHeap.hxx"
+#include "weave/bugcheck/BugCheck.hxx"
 #include "weave/bugcheck/Assert.hxx"
 
+#include <algorithm>
 #include <utility>
 
 namespace weave::memory
@@ -15,11 +19,52 @@ namespace weave::memory
         , _segment_size{segment_size}
     {
         Segment* const segment = AllocateSegment(this->_segment_size);
-        this->_end = reinterpret_cast<std::byte*>(segment) + this->_segment_size;
+        this->_end = reinterpret_cast<std::byte*>(segment) + segment->Size;
 
         PushBack(this->_list, segment);
     }
 
+    LinearAllocator::LinearAllocator(size_t segment_size, size_t reservation_size)
+        : _end{nullptr}
+        , _segment_size{bitwise::AlignUp(segment_size, PageSize)}
+    {
+        size_t const size = bitwise::AlignUp(reservation_size, PageGranularity);
+
+        std::byte* const reservation = (size > this->_segment_size)
+            ? static_cast<std::byte*>(PageReserve(size))
+            : nullptr;
+
+        if ((reservation != nullptr) and PageCommit(reservation, this->_segment_size))
+        {
+            this->_reservation = reservation;
+            this->_reservation_size = size;
+            this->_allocated_segments_size = this->_segment_size;
+
+            std::byte* const last = reservation + sizeof(Segment);
+            Segment* const segment = new (reservation) Segment{nullptr, nullptr, last, 0};
+
+            ASAN_POISON_MEMORY_REGION(last, this->_segment_size - sizeof(Segment));
+
+            this->_end = reservation + this->_segment_size;
+            this->_committed = this->_end;
+
+            PushBack(this->_list, segment);
+        }
+        else
+        {
+            if (reservation != nullptr)
+            {
+                PageRelease(reservation, size);
+            }
+
+            // Address space is not available, use heap segments instead.
+            Segment* const segment = AllocateSegment(this->_segment_size);
+            this->_end = reinterpret_cast<std::byte*>(segment) + segment->Size;
+
+            PushBack(this->_list, segment);
+        }
+    }
+
     LinearAllocator::~LinearAllocator()
     {
         Segment* current = this->_list.Head;
@@ -27,7 +72,7 @@ namespace weave::memory
         while (current != nullptr)
         {
             Segment* const back = current->ForwardLink;
-            ::operator delete(current);
+            this->ReleaseSegment(current);
             current = back;
         }
     }
@@ -37,6 +82,10 @@ namespace weave::memory
         , _end{std::exchange(other._end, {})}
         , _segment_size{other._segment_size}
         , _allocated_segments_size{other._allocated_segments_size}
+        , _reservation{std::exchange(other._reservation, {})}
+        , _committed{std::exchange(other._committed, {})}
+        , _reservation_size{std::exchange(other._reservation_size, {})}
+        , _arena{std::exchange(other._arena, {})}
     {
     }
 
@@ -53,26 +102,124 @@ namespace weave::memory
 
     LinearAllocator::Segment* LinearAllocator::AllocateSegment(size_t size)
     {
-        this->_allocated_segments_size += size;
-
         static_assert(alignof(Segment) <= alignof(std::max_align_t));
 
-        // use process heap for such allocations
-        std::byte* const memory = static_cast<std::byte*>(::operator new(size));
+        std::byte* memory{};
+
+        if (size_t const paged = bitwise::AlignUp(size, PageSize); paged >= PagedSegmentThreshold)
+        {
+            // Large segments use whole pages anyway, so get them from the page heap.
+            memory = static_cast<std::byte*>(PageHeap::Get().Allocate(paged));
+
+            if (memory == nullptr)
+            {
+                WEAVE_BUGCHECK("Out of memory");
+            }
+
+            size = paged;
+        }
+        else
+        {
+            // use process heap for such allocations
+            memory = static_cast<std::byte*>(::operator new(size));
+        }
+
         WEAVE_ASSERT(bitwise::IsAligned(memory, alignof(Segment)));
         std::byte* const last = memory + sizeof(Segment);
 
+        this->_allocated_segments_size += size;
+
+        if (this->_arena != nullptr)
+        {
+            this->_arena->Allocated(size);
+        }
+
         // ReSharper disable once CppDFAMemoryLeak
         // This is not a leak - segments are released in destructor.
-        Segment* const result = new (memory) Segment{nullptr, nullptr, last};
+        Segment* const result = new (memory) Segment{nullptr, nullptr, last, size};
 
         ASAN_POISON_MEMORY_REGION(last, size - sizeof(Segment));
 
         return result;
     }
 
+    void LinearAllocator::ReleaseSegment(Segment* segment)
+    {
+        if (reinterpret_cast<std::byte*>(segment) == this->_reservation)
+        {
+            if (this->_arena != nullptr)
+            {
+                this->_arena->Deallocated(static_cast<size_t>(this->_committed - this->_reservation));
+            }
+
+            PageRelease(this->_reservation, this->_reservation_size);
+        }
+        else
+        {
+            this->_allocated_segments_size -= segment->Size;
+
+            if (this->_arena != nullptr)
+            {
+                this->_arena->Deallocated(segment->Size);
+            }
+
+            if (segment->Size >= PagedSegmentThreshold)
+            {
+                PageHeap::Get().Deallocate(segment);
+            }
+            else
+            {
+                ::operator delete(segment);
+            }
+        }
+    }
+
+    bool LinearAllocator::TryCommit(std::byte* last)
+    {
+        size_t const required = static_cast<size_t>(last - this->_reservation);
+
+        if (required > this->_reservation_size)
+        {
+            return false;
+        }
+
+        size_t const committed = static_cast<size_t>(this->_committed - this->_reservation);
+        size_t const steps = ((required - committed) + this->_segment_size - 1) / this->_segment_size;
+        size_t const size = std::min(steps * this->_segment_size, this->_reservation_size - committed);
+
+        if (not PageCommit(this->_committed, size))
+        {
+            return false;
+        }
+
+        ASAN_POISON_MEMORY_REGION(this->_committed, size);
+
+        this->_committed += size;
+        this->_end = this->_committed;
+        this->_allocated_segments_size += size;
+
+        if (this->_arena != nullptr)
+        {
+            this->_arena->Allocated(size);
+        }
+        return true;
+    }
+
     Allocation LinearAllocator::AllocateImpl(Layout const& layout)
     {
+        if ((this->_reservation != nullptr) and (reinterpret_cast<std::byte*>(this->_list.Tail) == this->_reservation))
+        {
+            // Still allocating from reserved range - commit more of it.
+            std::byte* const last = bitwise::AlignUp(this->_list.Tail->Last, layout.Alignment) + layout.Size;
+
+            if (this->TryCommit(last))
+            {
+                return this->Allocate(layout);
+            }
+
+            // Reservation is exhausted, continue with heap segments.
+        }
+
         if (this->NeedsSeparateSegment(layout.Size))
         {
             // Compute size of segment.
@@ -100,12 +247,27 @@ namespace weave::memory
         PushBack(this->_list, segment);
 
         // Remember last allocation point.
-        this->_end = reinterpret_cast<std::byte*>(segment) + this->_segment_size;
+        this->_end = reinterpret_cast<std::byte*>(segment) + segment->Size;
 
         // Restart allocation - this time it should work
         return this->Allocate(layout);
     }
 
+    void LinearAllocator::SetArena(MemoryArena* arena)
+    {
+        if (this->_arena != nullptr)
+        {
+            this->_arena->Deallocated(this->_allocated_segments_size);
+        }
+
+        this->_arena = arena;
+
+        if (this->_arena != nullptr)
+        {
+            this->_arena->Allocated(this->_allocated_segments_size);
+        }
+    }
+
     void LinearAllocator::QueryMemoryUsage(size_t& allocated, size_t& reserved) const
     {
         Segment* current = this->_list.Head;
@@ -118,4 +280,110 @@ namespace weave::memory
 
         reserved += this->_allocated_segments_size;
     }
+
+    void LinearAllocator::Rewind(Marker const& marker)
+    {
+        Segment* const current = marker.Current;
+
+        // End of memory used in reserved range. Once it is exhausted, all committed pages may have been used.
+        std::byte* used = nullptr;
+
+        if (reinterpret_cast<std::byte*>(current) == this->_reservation)
+        {
+            used = (this->_list.Tail == current) ? current->Last : this->_committed;
+        }
+
+        // Release separate segments inserted before the marked one.
+        for (Segment* segment = current->BackLink; segment != marker.Previous;)
+        {
+            Segment* const back = segment->BackLink;
+            this->ReleaseSegment(segment);
+            segment = back;
+        }
+
+        current->BackLink = marker.Previous;
+
+        if (marker.Previous != nullptr)
+        {
+            marker.Previous->ForwardLink = current;
+        }
+        else
+        {
+            this->_list.Head = current;
+        }
+
+        // Release all segments after the marked one.
+        for (Segment* segment = current->ForwardLink; segment != nullptr;)
+        {
+            Segment* const forward = segment->ForwardLink;
+            this->ReleaseSegment(segment);
+            segment = forward;
+        }
+
+        current->ForwardLink = nullptr;
+        current->Last = marker.Last;
+
+        this->_list.Tail = current;
+        this->_end = (reinterpret_cast<std::byte*>(current) == this->_reservation)
+            ? this->_committed
+            : reinterpret_cast<std::byte*>(current) + current->Size;
+
+        if (used != nullptr)
+        {
+            std::byte* const first = bitwise::AlignUp(marker.Last, PageSize);
+            std::byte* const last = std::min(bitwise::AlignUp(used, PageSize), this->_committed);
+
+            if ((first < last) and (static_cast<size_t>(last - first) >= RewindDiscardThreshold))
+            {
+                PageDiscard(first, static_cast<size_t>(last - first));
+            }
+        }
+
+        ASAN_POISON_MEMORY_REGION(current->Last, this->_end - current->Last);
+    }
+
+    void LinearAllocator::Reset()
+    {
+        Segment* current = this->_list.Head;
+
+        while (current != nullptr)
+        {
+            Segment* const back = current->ForwardLink;
+
+            if (reinterpret_cast<std::byte*>(current) != this->_reservation)
+            {
+                this->ReleaseSegment(current);
+            }
+
+            current = back;
+        }
+
+        this->_list = {};
+
+        if (this->_reservation != nullptr)
+        {
+            // Keep committed pages, but return their physical memory.
+            std::byte* const last = this->_reservation + sizeof(Segment);
+            Segment* const segment = new (this->_reservation) Segment{nullptr, nullptr, last, 0};
+
+            this->_end = this->_committed;
+            this->_allocated_segments_size = static_cast<size_t>(this->_committed - this->_reservation);
+
+            std::byte* const first = bitwise::AlignUp(last, PageSize);
+            PageDiscard(first, static_cast<size_t>(this->_end - first));
+
+            ASAN_POISON_MEMORY_REGION(last, this->_end - last);
+
+            PushBack(this->_list, segment);
+        }
+        else
+        {
+            this->_allocated_segments_size = 0;
+
+            Segment* const segment = AllocateSegment(this->_segment_size);
+            this->_end = reinterpret_cast<std::byte*>(segment) + segment->Size;
+
+            PushBack(this->_list, segment);
+        }
+    }
 }
@@ -0,0 +1,198 @@
+#include "weave/memory/MemoryAccounting.hxx"
+#include "weave/memory/PageHeap.hxx"
+#include "weave/threading/CriticalSection.hxx"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <memory>
+
+namespace weave::memory::impl
+{
+    struct MemoryArenaRegistry final
+    {
+        threading::CriticalSection Lock{};
+        std::vector<std::unique_ptr<MemoryArena>> Arenas{};
+    };
+
+    MemoryArenaRegistry& GetMemoryArenaRegistry()
+    {
+        // Never destroyed, so allocators with static or thread storage duration can report releases at exit.
+        static MemoryArenaRegistry* const instance = new MemoryArenaRegistry{};
+        return *instance;
+    }
+
+    size_t GetHistogramBucket(size_t size)
+    {
+        return std::min<size_t>(static_cast<size_t>(std::bit_width(size | 1u)) - 1, MemoryHistogramBuckets - 1);
+    }
+}
+
+namespace weave::memory
+{
+    void MemoryArena::Allocated(size_t size)
+    {
+        size_t const current = this->_current.fetch_add(size, std::memory_order_relaxed) + size;
+        size_t peak = this->_peak.load(std::memory_order_relaxed);
+
+        while ((peak < current) and not this->_peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+        {
+        }
+
+        this->_segments.fetch_add(1, std::memory_order_relaxed);
+        this->_histogram[impl::GetHistogramBucket(size)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void MemoryArena::Deallocated(size_t size)
+    {
+        this->_current.fetch_sub(size, std::memory_order_relaxed);
+        this->_released_segments.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void MemoryArena::QueryStatistics(MemoryArenaStatistics& statistics) const
+    {
+        statistics.Name = this->_name;
+        statistics.Current = this->_current.load(std::memory_order_relaxed);
+        statistics.Peak = this->_peak.load(std::memory_order_relaxed);
+        statistics.Segments = this->_segments.load(std::memory_order_relaxed);
+        statistics.ReleasedSegments = this->_released_segments.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < MemoryHistogramBuckets; ++i)
+        {
+            statistics.Histogram[i] = this->_histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    MemoryArena& MemoryAccounting::GetArena(std::string_view name)
+    {
+        impl::MemoryArenaRegistry& registry = impl::GetMemoryArenaRegistry();
+
+        threading::CriticalSection::Lock lock{registry.Lock};
+
+        for (std::unique_ptr<MemoryArena> const& arena : registry.Arenas)
+        {
+            if (arena->_name == name)
+            {
+                return *arena;
+            }
+        }
+
+        return *registry.Arenas.emplace_back(std::make_unique<MemoryArena>(name));
+    }
+
+    std::vector<MemoryArenaStatistics> MemoryAccounting::QueryStatistics()
+    {
+        impl::MemoryArenaRegistry& registry = impl::GetMemoryArenaRegistry();
+
+        std::vector<MemoryArenaStatistics> result{};
+
+        {
+            threading::CriticalSection::Lock lock{registry.Lock};
+
+            result.resize(registry.Arenas.size());
+
+            for (size_t i = 0; i < registry.Arenas.size(); ++i)
+            {
+                registry.Arenas[i]->QueryStatistics(result[i]);
+            }
+        }
+
+        std::sort(result.begin(), result.end(), [](MemoryArenaStatistics const& left, MemoryArenaStatistics const& right)
+            {
+                return left.Name < right.Name;
+            });
+
+        return result;
+    }
+
+    std::string MemoryAccounting::FormatReport()
+    {
+        fmt::memory_buffer buffer{};
+        auto out = std::back_inserter(buffer);
+
+        fmt::format_to(out, "{:<32} {:>14} {:>14} {:>12} {:>12}\n", "arena", "current", "peak", "segments", "released");
+
+        for (MemoryArenaStatistics const& arena : QueryStatistics())
+        {
+            fmt::format_to(out, "{:<32} {:>14} {:>14} {:>12} {:>12}\n", arena.Name, arena.Current, arena.Peak, arena.Segments, arena.ReleasedSegments);
+        }
+
+        PageHeapStatistics heap{};
+        PageHeap::Get().QueryStatistics(heap);
+
+        fmt::format_to(out, "page heap: (allocated: {}, free: {}, reserved: {}, fragmentation: {:.3f})\n",
+            heap.Allocated,
+            heap.Free,
+            heap.Reserved,
+            heap.GetFragmentation());
+
+        if (ProcessMemoryUsage process{}; QueryProcessMemoryUsage(process))
+        {
+            fmt::format_to(out, "process: (resident: {}, peak resident: {})\n", process.Resident, process.PeakResident);
+        }
+
+        return fmt::to_string(buffer);
+    }
+
+    std::string MemoryAccounting::FormatReportJson()
+    {
+        fmt::memory_buffer buffer{};
+        auto out = std::back_inserter(buffer);
+
+        fmt::format_to(out, R"__({{ "arenas": [)__");
+
+        bool first = true;
+
+        for (MemoryArenaStatistics const& arena : QueryStatistics())
+        {
+            fmt::format_to(out,
+                R"__({}{{ "name": "{}", "current": {}, "peak": {}, "segments": {}, "released_segments": {}, "histogram": {{ )__",
+                first ? " " : ", ",
+                arena.Name,
+                arena.Current,
+                arena.Peak,
+                arena.Segments,
+                arena.ReleasedSegments);
+
+            first = false;
+
+            // Only non-empty buckets are written, keyed by lower bound of the size range.
+            bool firstBucket = true;
+
+            for (size_t i = 0; i < MemoryHistogramBuckets; ++i)
+            {
+                if (arena.Histogram[i] != 0)
+                {
+                    fmt::format_to(out, R"__({}"{}": {})__", firstBucket ? "" : ", ", size_t{1} << i, arena.Histogram[i]);
+                    firstBucket = false;
+                }
+            }
+
+            fmt::format_to(out, R"__( }} }})__");
+        }
+
+        PageHeapStatistics heap{};
+        PageHeap::Get().QueryStatistics(heap);
+
+        fmt::format_to(out,
+            R"__( ], "page_heap": {{ "allocated": {}, "free": {}, "reserved": {}, "largest_free": {}, "free_frames": {}, "allocations": {}, "deallocations": {} }})__",
+            heap.Allocated,
+            heap.Free,
+            heap.Reserved,
+            heap.LargestFree,
+            heap.FreeFrames,
+            heap.Allocations,
+            heap.Deallocations);
+
+        if (ProcessMemoryUsage process{}; QueryProcessMemoryUsage(process))
+        {
+            fmt::format_to(out, R"__(, "process": {{ "resident": {}, "peak_resident": {} }})__", process.Resident, process.PeakResident);
+        }
+
+        fmt::format_to(out, " }}\n");
+
+        return fmt::to_string(buffer);
+    }
+}
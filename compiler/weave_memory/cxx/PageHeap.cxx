@@ -0,0 +1,514 @@
+#include "weave/memory/PageHeap.hxx"
+#include "weave/bugcheck/Assert.hxx"
+
+#include <algorithm>
+#include <bit>
+
+namespace weave::memory::impl
+{
+    // Descriptors are allocated in blocks, and recycled through lookaside list.
+    inline constexpr size_t PageFrameDescriptorBlockSize = 256;
+}
+
+namespace weave::memory
+{
+    PageHeap::PageHeap(size_t region_size)
+        : _region_size{bitwise::AlignUp(region_size, HugePageSize)}
+    {
+    }
+
+    PageHeap::~PageHeap()
+    {
+        while (this->_regions != nullptr)
+        {
+            this->ReleaseRegion(this->_regions);
+        }
+    }
+
+    void* PageHeap::Allocate(size_t size, size_t alignment)
+    {
+        size = bitwise::AlignUp(std::max<size_t>(size, 1), PageSize);
+        alignment = std::max(alignment, PageSize);
+
+        bool const huge = size >= HugePageSize;
+
+        if (huge)
+        {
+            alignment = std::max(alignment, HugePageSize);
+        }
+
+        std::byte* base{};
+
+        {
+            threading::CriticalSection::Lock lock{this->_lock};
+
+            PageFrameDescriptor* descriptor = this->FindFree(size, alignment);
+
+            if (descriptor == nullptr)
+            {
+                // Allocations larger than region get dedicated one.
+                size_t const required = bitwise::AlignUp(size + alignment - PageSize, HugePageSize);
+
+                if (this->CreateRegion(std::max(this->_region_size, required)) == nullptr)
+                {
+                    return nullptr;
+                }
+
+                descriptor = this->FindFree(size, alignment);
+                WEAVE_ASSERT(descriptor != nullptr);
+            }
+
+            this->RemoveFree(descriptor);
+
+            base = bitwise::AlignUp(descriptor->Base, alignment);
+            std::byte* const limit = base + size;
+
+            //
+            // Split free frame into
+            //
+            // +----------+-------------+----------+
+            // | before   | descriptor  | after    |
+            // +----------+-------------+----------+
+            //
+
+            if (descriptor->Base != base)
+            {
+                PageFrameDescriptor* const before = this->AllocateDescriptor();
+                before->Base = descriptor->Base;
+                before->Limit = base;
+                before->Owner = descriptor->Owner;
+
+                descriptor->Base = base;
+
+                this->MapFrame(before);
+                this->InsertFree(before);
+            }
+
+            if (descriptor->Limit != limit)
+            {
+                PageFrameDescriptor* const after = this->AllocateDescriptor();
+                after->Base = limit;
+                after->Limit = descriptor->Limit;
+                after->Owner = descriptor->Owner;
+
+                descriptor->Limit = limit;
+
+                this->MapFrame(after);
+                this->InsertFree(after);
+            }
+
+            descriptor->Used = true;
+            this->MapFrame(descriptor);
+
+            this->_statistics.Allocated += size;
+            this->_statistics.Free -= size;
+            ++this->_statistics.Allocations;
+
+            if (huge)
+            {
+                ++this->_statistics.HugePageAllocations;
+            }
+        }
+
+        if (not PageCommit(base, size))
+        {
+            this->Deallocate(base);
+            return nullptr;
+        }
+
+        ASAN_UNPOISON_MEMORY_REGION(base, size);
+
+        return base;
+    }
+
+    void PageHeap::Deallocate(void* pointer)
+    {
+        std::byte* const address = static_cast<std::byte*>(pointer);
+
+        threading::CriticalSection::Lock lock{this->_lock};
+
+        Region* const region = this->FindRegion(address);
+        WEAVE_ASSERT(region != nullptr, "Pointer not allocated by page heap");
+
+        PageFrameDescriptor* const descriptor = region->PageMap[static_cast<size_t>(address - region->Base) / PageSize];
+        WEAVE_ASSERT((descriptor != nullptr) and (descriptor->Base == address) and descriptor->Used, "Invalid pointer");
+
+        size_t const size = static_cast<size_t>(descriptor->Limit - descriptor->Base);
+
+        if (size >= DiscardThreshold)
+        {
+            PageDiscard(descriptor->Base, size);
+        }
+
+        ASAN_POISON_MEMORY_REGION(descriptor->Base, size);
+
+        descriptor->Used = false;
+
+        this->_statistics.Allocated -= size;
+        this->_statistics.Free += size;
+        ++this->_statistics.Deallocations;
+
+        //
+        // Coalesce with adjacent free frames. Both of them are mapped at the page next to this frame.
+        //
+
+        if (descriptor->Base != region->Base)
+        {
+            PageFrameDescriptor* const previous = region->PageMap[(static_cast<size_t>(descriptor->Base - region->Base) / PageSize) - 1];
+
+            if (not previous->Used)
+            {
+                this->RemoveFree(previous);
+                descriptor->Base = previous->Base;
+                this->ReleaseDescriptor(previous);
+            }
+        }
+
+        if (descriptor->Limit != region->Limit)
+        {
+            PageFrameDescriptor* const next = region->PageMap[static_cast<size_t>(descriptor->Limit - region->Base) / PageSize];
+
+            if (not next->Used)
+            {
+                this->RemoveFree(next);
+                descriptor->Limit = next->Limit;
+                this->ReleaseDescriptor(next);
+            }
+        }
+
+        this->MapFrame(descriptor);
+        this->InsertFree(descriptor);
+
+        bool const empty = (descriptor->Base == region->Base) and (descriptor->Limit == region->Limit);
+
+        // Keep one region around, so allocation patterns around empty heap do not map and unmap memory repeatedly.
+        if (empty and ((this->_statistics.Regions > 1) or (static_cast<size_t>(region->Limit - region->Base) > this->_region_size)))
+        {
+            this->ReleaseRegion(region);
+        }
+    }
+
+    size_t PageHeap::GetSize(void const* pointer) const
+    {
+        std::byte const* const address = static_cast<std::byte const*>(pointer);
+
+        threading::CriticalSection::Lock lock{this->_lock};
+
+        Region const* const region = this->FindRegion(address);
+        WEAVE_ASSERT(region != nullptr, "Pointer not allocated by page heap");
+
+        PageFrameDescriptor const* const descriptor = region->PageMap[static_cast<size_t>(address - region->Base) / PageSize];
+        WEAVE_ASSERT((descriptor != nullptr) and (descriptor->Base == address) and descriptor->Used, "Invalid pointer");
+
+        return static_cast<size_t>(descriptor->Limit - descriptor->Base);
+    }
+
+    void PageHeap::QueryStatistics(PageHeapStatistics& statistics) const
+    {
+        threading::CriticalSection::Lock lock{this->_lock};
+
+        statistics = this->_statistics;
+        statistics.LargestFree = 0;
+        statistics.FreeFrames = 0;
+
+        for (PageFrameDescriptorList const& bin : this->_bins)
+        {
+            for (PageFrameDescriptor const* descriptor = bin.Head; descriptor != nullptr; descriptor = descriptor->FLink)
+            {
+                statistics.LargestFree = std::max(statistics.LargestFree, static_cast<size_t>(descriptor->Limit - descriptor->Base));
+                ++statistics.FreeFrames;
+            }
+        }
+    }
+
+    void PageHeap::Validate() const
+    {
+        threading::CriticalSection::Lock lock{this->_lock};
+
+        size_t allocated{};
+        size_t free{};
+        size_t frames{};
+
+        for (Region const* region = this->_regions; region != nullptr; region = region->Next)
+        {
+            WEAVE_ASSERT(bitwise::IsAligned(region->Base, HugePageSize));
+
+            bool previousFree = false;
+
+            for (std::byte* address = region->Base; address != region->Limit;)
+            {
+                size_t const first = static_cast<size_t>(address - region->Base) / PageSize;
+
+                PageFrameDescriptor const* const descriptor = region->PageMap[first];
+                WEAVE_ASSERT(descriptor != nullptr);
+                WEAVE_ASSERT(descriptor->Owner == region);
+                WEAVE_ASSERT(descriptor->Base == address);
+                WEAVE_ASSERT(descriptor->Base < descriptor->Limit);
+                WEAVE_ASSERT(descriptor->Limit <= region->Limit);
+
+                size_t const last = (static_cast<size_t>(descriptor->Limit - region->Base) / PageSize) - 1;
+                WEAVE_ASSERT(region->PageMap[last] == descriptor);
+
+                size_t const size = static_cast<size_t>(descriptor->Limit - descriptor->Base);
+
+                if (descriptor->Used)
+                {
+                    allocated += size;
+                    previousFree = false;
+                }
+                else
+                {
+                    // Adjacent free frames are always coalesced.
+                    WEAVE_ASSERT(not previousFree);
+
+                    free += size;
+                    ++frames;
+                    previousFree = true;
+                }
+
+                address = descriptor->Limit;
+            }
+        }
+
+        size_t binned{};
+
+        for (size_t i = 0; i < BinCount; ++i)
+        {
+            for (PageFrameDescriptor const* descriptor = this->_bins[i].Head; descriptor != nullptr; descriptor = descriptor->FLink)
+            {
+                WEAVE_ASSERT(not descriptor->Used);
+                WEAVE_ASSERT(GetBinIndex(static_cast<size_t>(descriptor->Limit - descriptor->Base)) == i);
+                WEAVE_ASSERT((descriptor->FLink == nullptr) or (descriptor->FLink->BLink == descriptor));
+                ++binned;
+            }
+        }
+
+        WEAVE_ASSERT(binned == frames);
+        WEAVE_ASSERT(allocated == this->_statistics.Allocated);
+        WEAVE_ASSERT(free == this->_statistics.Free);
+    }
+
+    PageHeap& PageHeap::Get()
+    {
+        // Never destroyed, so allocators with static or thread storage duration can release memory at exit.
+        static PageHeap* const instance = new PageHeap{};
+        return *instance;
+    }
+
+    size_t PageHeap::GetBinIndex(size_t size)
+    {
+        size_t const pages = size / PageSize;
+        WEAVE_ASSERT(pages != 0);
+
+        return std::min<size_t>(static_cast<size_t>(std::bit_width(pages)) - 1, BinCount - 1);
+    }
+
+    PageHeap::PageFrameDescriptor* PageHeap::AllocateDescriptor()
+    {
+        if (this->_lookaside.Head == nullptr)
+        {
+            std::unique_ptr<PageFrameDescriptor[]>& block = this->_descriptors.emplace_back(
+                std::make_unique<PageFrameDescriptor[]>(impl::PageFrameDescriptorBlockSize));
+
+            for (size_t i = 0; i < impl::PageFrameDescriptorBlockSize; ++i)
+            {
+                this->ReleaseDescriptor(&block[i]);
+            }
+        }
+
+        PageFrameDescriptor* const result = this->_lookaside.Head;
+        this->_lookaside.Head = result->FLink;
+
+        *result = PageFrameDescriptor{};
+        return result;
+    }
+
+    void PageHeap::ReleaseDescriptor(PageFrameDescriptor* descriptor)
+    {
+        descriptor->FLink = this->_lookaside.Head;
+        descriptor->BLink = nullptr;
+        this->_lookaside.Head = descriptor;
+    }
+
+    void PageHeap::InsertFree(PageFrameDescriptor* descriptor)
+    {
+        PageFrameDescriptorList& bin = this->_bins[GetBinIndex(static_cast<size_t>(descriptor->Limit - descriptor->Base))];
+
+        descriptor->BLink = nullptr;
+        descriptor->FLink = bin.Head;
+
+        if (bin.Head != nullptr)
+        {
+            bin.Head->BLink = descriptor;
+        }
+
+        bin.Head = descriptor;
+    }
+
+    void PageHeap::RemoveFree(PageFrameDescriptor* descriptor)
+    {
+        if (descriptor->BLink != nullptr)
+        {
+            descriptor->BLink->FLink = descriptor->FLink;
+        }
+        else
+        {
+            this->_bins[GetBinIndex(static_cast<size_t>(descriptor->Limit - descriptor->Base))].Head = descriptor->FLink;
+        }
+
+        if (descriptor->FLink != nullptr)
+        {
+            descriptor->FLink->BLink = descriptor->BLink;
+        }
+
+        descriptor->FLink = nullptr;
+        descriptor->BLink = nullptr;
+    }
+
+    void PageHeap::MapFrame(PageFrameDescriptor* descriptor)
+    {
+        Region const* const region = descriptor->Owner;
+
+        size_t const first = static_cast<size_t>(descriptor->Base - region->Base) / PageSize;
+        size_t const last = (static_cast<size_t>(descriptor->Limit - region->Base) / PageSize) - 1;
+
+        region->PageMap[first] = descriptor;
+        region->PageMap[last] = descriptor;
+    }
+
+    PageHeap::Region* PageHeap::CreateRegion(size_t size)
+    {
+        WEAVE_ASSERT(bitwise::IsAligned(size, HugePageSize));
+
+        // Reserve more address space, so region can be aligned to huge page boundary.
+        size_t const reservationSize = size + HugePageSize;
+        std::byte* const reservation = static_cast<std::byte*>(PageReserve(reservationSize));
+
+        if (reservation == nullptr)
+        {
+            return nullptr;
+        }
+
+        Region* const region = new Region{};
+        region->Reservation = reservation;
+        region->ReservationSize = reservationSize;
+        region->Base = bitwise::AlignUp(reservation, HugePageSize);
+        region->Limit = region->Base + size;
+        region->PageMap = std::make_unique<PageFrameDescriptor*[]>(size / PageSize);
+
+        PageAdviseHugePages(region->Base, size);
+
+        ASAN_POISON_MEMORY_REGION(region->Base, size);
+
+        region->Next = this->_regions;
+        this->_regions = region;
+
+        PageFrameDescriptor* const descriptor = this->AllocateDescriptor();
+        descriptor->Base = region->Base;
+        descriptor->Limit = region->Limit;
+        descriptor->Owner = region;
+
+        this->MapFrame(descriptor);
+        this->InsertFree(descriptor);
+
+        this->_statistics.Reserved += reservationSize;
+        this->_statistics.Free += size;
+        ++this->_statistics.Regions;
+
+        return region;
+    }
+
+    void PageHeap::ReleaseRegion(Region* region)
+    {
+        Region** link = &this->_regions;
+
+        while (*link != region)
+        {
+            link = &(*link)->Next;
+        }
+
+        *link = region->Next;
+
+        size_t const size = static_cast<size_t>(region->Limit - region->Base);
+
+        // Region is released either empty, or when heap is destroyed.
+        for (std::byte* address = region->Base; address != region->Limit;)
+        {
+            PageFrameDescriptor* const descriptor = region->PageMap[static_cast<size_t>(address - region->Base) / PageSize];
+            address = descriptor->Limit;
+
+            if (descriptor->Used)
+            {
+                this->_statistics.Allocated -= static_cast<size_t>(descriptor->Limit - descriptor->Base);
+                this->_statistics.Free += static_cast<size_t>(descriptor->Limit - descriptor->Base);
+            }
+            else
+            {
+                this->RemoveFree(descriptor);
+            }
+
+            this->ReleaseDescriptor(descriptor);
+        }
+
+        ASAN_UNPOISON_MEMORY_REGION(region->Base, size);
+
+        PageRelease(region->Reservation, region->ReservationSize);
+
+        this->_statistics.Reserved -= region->ReservationSize;
+        this->_statistics.Free -= size;
+        --this->_statistics.Regions;
+
+        delete region;
+    }
+
+    PageHeap::Region* PageHeap::FindRegion(std::byte const* address) const
+    {
+        for (Region* region = this->_regions; region != nullptr; region = region->Next)
+        {
+            if ((region->Base <= address) and (address < region->Limit))
+            {
+                return region;
+            }
+        }
+
+        return nullptr;
+    }
+
+    PageHeap::PageFrameDescriptor* PageHeap::FindFree(size_t size, size_t alignment) const
+    {
+        // Best fit within the first bin with suitable frame.
+        for (size_t i = GetBinIndex(size); i < BinCount; ++i)
+        {
+            PageFrameDescriptor* best{};
+            size_t bestSize{};
+
+            for (PageFrameDescriptor* descriptor = this->_bins[i].Head; descriptor != nullptr; descriptor = descriptor->FLink)
+            {
+                std::byte* const base = bitwise::AlignUp(descriptor->Base, alignment);
+
+                if ((base + size) <= descriptor->Limit)
+                {
+                    size_t const frameSize = static_cast<size_t>(descriptor->Limit - descriptor->Base);
+
+                    if ((best == nullptr) or (frameSize < bestSize))
+                    {
+                        best = descriptor;
+                        bestSize = frameSize;
+                    }
+
+                    if (frameSize == size)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (best != nullptr)
+            {
+                return best;
+            }
+        }
+
+        return nullptr;
+    }
+}
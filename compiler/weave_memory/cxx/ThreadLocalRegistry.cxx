@@ -0,0 +1,84 @@
+#include "weave/memory/ThreadLocalRegistry.hxx"
+#include "weave/bugcheck/Assert.hxx"
+
+#include <array>
+
+namespace weave::memory::impl
+{
+    // Number of registries a thread keeps entries cached for.
+    inline constexpr size_t ThreadLocalCacheSize = 4;
+
+    // Identifiers are never reused, so stale cache entries of destroyed registries never match.
+    inline constinit std::atomic<uint64_t> g_NextThreadLocalRegistryId{1};
+
+    struct CachedEntry final
+    {
+        uint64_t Registry{};
+        ThreadLocalRegistry::Entry* Entry{};
+    };
+
+    struct ThreadLocalCache final
+    {
+        std::array<CachedEntry, ThreadLocalCacheSize> Entries{};
+        size_t Next{};
+
+        void Insert(uint64_t registry, ThreadLocalRegistry::Entry* entry)
+        {
+            this->Entries[this->Next++ % this->Entries.size()] = CachedEntry{
+                .Registry = registry,
+                .Entry = entry,
+            };
+        }
+    };
+
+    inline thread_local ThreadLocalCache t_ThreadLocalCache{};
+}
+
+namespace weave::memory
+{
+    ThreadLocalRegistry::ThreadLocalRegistry()
+        : _id{impl::g_NextThreadLocalRegistryId.fetch_add(1, std::memory_order_relaxed)}
+    {
+    }
+
+    ThreadLocalRegistry::Entry* ThreadLocalRegistry::Find() const
+    {
+        impl::ThreadLocalCache& cache = impl::t_ThreadLocalCache;
+
+        for (impl::CachedEntry const& cached : cache.Entries)
+        {
+            if (cached.Registry == this->_id)
+            {
+                return cached.Entry;
+            }
+        }
+
+        // Entry evicted from the cache is still in the list.
+        std::thread::id const thread = std::this_thread::get_id();
+
+        for (Entry* entry = this->GetFirst(); entry != nullptr; entry = entry->Next)
+        {
+            if (entry->Thread == thread)
+            {
+                cache.Insert(this->_id, entry);
+                return entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void ThreadLocalRegistry::Register(Entry* entry)
+    {
+        WEAVE_ASSERT(entry != nullptr);
+
+        entry->Thread = std::this_thread::get_id();
+        entry->Next = this->_entries.load(std::memory_order_relaxed);
+
+        while (not this->_entries.compare_exchange_weak(entry->Next, entry, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+
+        impl::t_ThreadLocalCache.Insert(this->_id, entry);
+    }
+}
@@ -0,0 +1,55 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/memory/MemoryAccounting.hxx"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <string>
+
+namespace weave::memory
+{
+    bool QueryProcessMemoryUsage(ProcessMemoryUsage& usage)
+    {
+#if defined(__linux__)
+        std::ifstream status{"/proc/self/status"};
+
+        if (not status)
+        {
+            return false;
+        }
+
+        // Values are reported in kilobytes, e.g. `VmHWM:     1234 kB`.
+        auto parse = [](std::string_view line, size_t& result)
+        {
+            std::string_view value = line.substr(line.find(':') + 1);
+            value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+
+            size_t kilobytes{};
+
+            if (std::from_chars(value.data(), value.data() + value.size(), kilobytes).ec == std::errc{})
+            {
+                result = kilobytes << 10u;
+            }
+        };
+
+        std::string line{};
+
+        while (std::getline(status, line))
+        {
+            if (line.starts_with("VmRSS:"))
+            {
+                parse(line, usage.Resident);
+            }
+            else if (line.starts_with("VmHWM:"))
+            {
+                parse(line, usage.PeakResident);
+            }
+        }
+
+        return true;
+#else
+        (void)usage;
+        return false;
+#endif
+    }
+}
@@ -17,7 +17,32 @@ namespace weave::memory
 
         size_t const aligned_size = bitwise::AlignUp(size, alignment);
 
-        void* result = mmap(nullptr, aligned_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        // Map with extra space, so unaligned head and tail can be trimmed.
+        size_t const mapped_size = aligned_size + alignment - PageSize;
+
+        std::byte* const mapped = static_cast<std::byte*>(mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+        if (mapped == MAP_FAILED)
+        {
+            return PageAllocationResult{
+                .Pointer = nullptr,
+                .Size = 0,
+                .Alignment = alignment,
+            };
+        }
+
+        std::byte* const result = bitwise::AlignUp(mapped, alignment);
+        std::byte* const limit = result + aligned_size;
+
+        if (result != mapped)
+        {
+            munmap(mapped, static_cast<size_t>(result - mapped));
+        }
+
+        if (limit != (mapped + mapped_size))
+        {
+            munmap(limit, static_cast<size_t>((mapped + mapped_size) - limit));
+        }
 
         WEAVE_ASSERT(bitwise::IsAligned(result, alignment));
 
@@ -28,8 +53,58 @@ namespace weave::memory
         };
     }
 
-    void PageDeallocate(void* pointer)
+    void PageDeallocate(void* pointer, size_t size)
+    {
+        // Size is rounded the same way as in `PageAllocate`.
+        size_t const alignment = (size < PageGranularity)
+            ? PageSize
+            : PageGranularity;
+
+        munmap(pointer, bitwise::AlignUp(size, alignment));
+    }
+
+    void* PageReserve(size_t size)
+    {
+        WEAVE_ASSERT(bitwise::IsAligned(size, PageGranularity));
+
+        void* const result = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+        if (result == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        return result;
+    }
+
+    void PageRelease(void* pointer, size_t size)
+    {
+        munmap(pointer, size);
+    }
+
+    bool PageCommit(void* pointer, size_t size)
+    {
+        WEAVE_ASSERT(bitwise::IsAligned(pointer, PageSize));
+        WEAVE_ASSERT(bitwise::IsAligned(size, PageSize));
+
+        return mprotect(pointer, size, PROT_READ | PROT_WRITE) == 0;
+    }
+
+    void PageDiscard(void* pointer, size_t size)
+    {
+        WEAVE_ASSERT(bitwise::IsAligned(pointer, PageSize));
+        WEAVE_ASSERT(bitwise::IsAligned(size, PageSize));
+
+        madvise(pointer, size, MADV_DONTNEED);
+    }
+
+    void PageAdviseHugePages(void* pointer, size_t size)
     {
-        munmap(pointer, 0);
+#if defined(MADV_HUGEPAGE)
+        madvise(pointer, size, MADV_HUGEPAGE);
+#else
+        (void)pointer;
+        (void)size;
+#endif
     }
 }
@@ -0,0 +1,26 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/memory/MemoryAccounting.hxx"
+
+#include "weave/platform/windows/PlatformHeaders.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+#include <psapi.h>
+WEAVE_EXTERNAL_HEADERS_END
+
+namespace weave::memory
+{
+    bool QueryProcessMemoryUsage(ProcessMemoryUsage& usage)
+    {
+        PROCESS_MEMORY_COUNTERS counters{};
+        counters.cb = sizeof(counters);
+
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            usage.Resident = counters.WorkingSetSize;
+            usage.PeakResident = counters.PeakWorkingSetSize;
+            return true;
+        }
+
+        return false;
+    }
+}
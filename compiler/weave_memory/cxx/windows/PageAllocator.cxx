@@ -26,8 +26,45 @@ namespace weave::memory
         };
     }
 
-    void PageDeallocate(void* pointer)
+    void PageDeallocate(void* pointer, size_t size)
     {
+        (void)size;
         VirtualFree(pointer, 0, MEM_RELEASE);
     }
+
+    void* PageReserve(size_t size)
+    {
+        WEAVE_ASSERT(bitwise::IsAligned(size, PageGranularity));
+
+        return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+    }
+
+    void PageRelease(void* pointer, size_t size)
+    {
+        (void)size;
+        VirtualFree(pointer, 0, MEM_RELEASE);
+    }
+
+    bool PageCommit(void* pointer, size_t size)
+    {
+        WEAVE_ASSERT(bitwise::IsAligned(pointer, PageSize));
+        WEAVE_ASSERT(bitwise::IsAligned(size, PageSize));
+
+        return VirtualAlloc(pointer, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+    }
+
+    void PageDiscard(void* pointer, size_t size)
+    {
+        WEAVE_ASSERT(bitwise::IsAligned(pointer, PageSize));
+        WEAVE_ASSERT(bitwise::IsAligned(size, PageSize));
+
+        VirtualAlloc(pointer, size, MEM_RESET, PAGE_READWRITE);
+    }
+
+    void PageAdviseHugePages(void* pointer, size_t size)
+    {
+        // Large pages require explicit privilege and must be allocated up front.
+        (void)pointer;
+        (void)size;
+    }
 }
@@ -0,0 +1,316 @@
+#pragma once
+#include "weave/platform/Compiler.hxx"
+#include "weave/memory/Layout.hxx"
+#include "weave/memory/MemoryAccounting.hxx"
+#include "weave/memory/ThreadLocalRegistry.hxx"
+#include "weave/threading/CriticalSection.hxx"
+#include "weave/Bitwise.hxx"
+
+#include <atomic>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace weave::memory
+{
+    class ArenaPool;
+    class ThreadArena;
+
+    struct ArenaPoolStatistics final
+    {
+        // Memory of segments allocated from the page heap.
+        size_t Reserved{};
+
+        // Number of segments allocated from the page heap.
+        size_t Segments{};
+
+        // Number of segments available for reuse.
+        size_t FreeSegments{};
+
+        // Number of sealed arenas not released yet.
+        size_t SealedArenas{};
+
+        // Number of times thread arenas took segments from the pool.
+        size_t Refills{};
+    };
+
+    namespace impl
+    {
+        struct ArenaSegment final
+        {
+            ArenaSegment* Next{};
+            size_t Size{};
+        };
+
+        struct ArenaSegmentList final
+        {
+            ArenaSegment* Head{};
+            ArenaSegment* Tail{};
+            size_t Count{};
+            size_t Size{};
+        };
+
+        // Segments of sealed arena, linked into the owning pool.
+        struct SealedArenaRecord final
+        {
+            SealedArenaRecord* Previous{};
+            SealedArenaRecord* Next{};
+            ArenaSegmentList Segments{};
+        };
+    }
+
+    /// \brief Immutable segment chain handed off from thread arena.
+    ///
+    /// \details Handle may be moved between threads; memory stays at the same address. Memory is owned by the pool
+    ///          and released either with `ArenaPool::Release` or when the pool is destroyed, so dropping the handle
+    ///          never frees memory still referenced by consumers.
+    class SealedArena final
+    {
+        friend class ArenaPool;
+        friend class ThreadArena;
+
+    private:
+        ArenaPool* _pool{};
+        impl::SealedArenaRecord* _record{};
+
+    private:
+        SealedArena(ArenaPool* pool, impl::SealedArenaRecord* record)
+            : _pool{pool}
+            , _record{record}
+        {
+        }
+
+    public:
+        SealedArena() = default;
+
+        SealedArena(SealedArena const&) = delete;
+        SealedArena& operator=(SealedArena const&) = delete;
+
+        SealedArena(SealedArena&& other) noexcept
+            : _pool{std::exchange(other._pool, {})}
+            , _record{std::exchange(other._record, {})}
+        {
+        }
+
+        SealedArena& operator=(SealedArena&& other) noexcept
+        {
+            if (this != std::addressof(other))
+            {
+                this->_pool = std::exchange(other._pool, {});
+                this->_record = std::exchange(other._record, {});
+            }
+
+            return *this;
+        }
+
+    public:
+        [[nodiscard]] bool IsEmpty() const
+        {
+            return this->_record == nullptr;
+        }
+
+        /// \brief Gets memory of all segments in the arena.
+        [[nodiscard]] size_t GetSize() const
+        {
+            return (this->_record != nullptr) ? this->_record->Segments.Size : 0;
+        }
+
+        [[nodiscard]] size_t GetSegmentCount() const
+        {
+            return (this->_record != nullptr) ? this->_record->Segments.Count : 0;
+        }
+
+        /// \brief Checks if pointer was allocated from this arena.
+        [[nodiscard]] bool Contains(void const* pointer) const;
+
+        /// \brief Moves segments of other arena of the same pool into this one.
+        void Append(SealedArena&& other);
+    };
+
+    /// \brief Bump allocator used by single thread, taking segments from shared pool.
+    ///
+    /// \details Thread arenas are owned by the pool and obtained with `ArenaPool::GetThreadArena`. Allocated memory
+    ///          is handed off to other threads by sealing the arena; the thread arena then continues with new
+    ///          segments.
+    class ThreadArena final : private ThreadLocalRegistry::Entry
+    {
+        friend class ArenaPool;
+
+    private:
+        ArenaPool* _pool{};
+        impl::ArenaSegmentList _segments{};
+        std::byte* _last{};
+        std::byte* _end{};
+
+        // Spare segments taken from the pool, not used yet.
+        impl::ArenaSegmentList _cache{};
+
+    private:
+        explicit ThreadArena(ArenaPool* pool)
+            : _pool{pool}
+        {
+        }
+
+    public:
+        ThreadArena(ThreadArena const&) = delete;
+        ThreadArena(ThreadArena&&) = delete;
+        ThreadArena& operator=(ThreadArena const&) = delete;
+        ThreadArena& operator=(ThreadArena&&) = delete;
+
+    private:
+        Allocation AllocateImpl(Layout const& layout);
+
+    public:
+        Allocation Allocate(Layout const& layout)
+        {
+            std::byte* const result = bitwise::AlignUp(this->_last, layout.Alignment);
+
+            // Arena without current segment has both pointers null.
+            if ((result > this->_end) or (layout.Size > static_cast<size_t>(this->_end - result)))
+            {
+                return this->AllocateImpl(layout);
+            }
+
+            this->_last = result + layout.Size;
+
+            ASAN_UNPOISON_MEMORY_REGION(result, layout.Size);
+
+            return Allocation{
+                .Address = result,
+                .Size = layout.Size,
+            };
+        }
+
+        template <typename T, typename... ArgsT>
+        [[nodiscard]] T* Emplace(ArgsT&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>);
+
+            Allocation const allocation = this->Allocate(Layout{
+                .Size = sizeof(T),
+                .Alignment = alignof(T),
+            });
+
+            return new (allocation.Address) T(std::forward<ArgsT>(args)...);
+        }
+
+        template <typename T>
+        [[nodiscard]] std::span<T> EmplaceArray(std::span<T const> source)
+        {
+            static_assert(std::is_trivially_destructible_v<T>);
+
+            if (not source.empty())
+            {
+                Allocation const allocation = this->Allocate(Layout{
+                    .Size = sizeof(T) * source.size(),
+                    .Alignment = alignof(T),
+                });
+
+                T* const result = reinterpret_cast<T*>(allocation.Address);
+
+                std::uninitialized_copy_n(
+                    source.data(),
+                    source.size(),
+                    result);
+
+                return std::span<T>{
+                    result,
+                    source.size(),
+                };
+            }
+
+            return {};
+        }
+
+        /// \brief Hands off all memory allocated so far.
+        ///
+        /// \note Remaining space of the current segment is not reused.
+        [[nodiscard]] SealedArena Seal();
+    };
+
+    /// \brief Source of segments for thread arenas.
+    ///
+    /// \details Each thread allocates from its own thread arena, so allocation takes no lock. Thread arenas take
+    ///          several segments from the pool at once and keep spare ones cached. Segments of released sealed arenas
+    ///          are reused. Allocations too large for a segment get a dedicated segment from the page heap.
+    ///
+    ///          Destroying the pool releases all its memory by walking segment lists, without visiting objects
+    ///          allocated in them. Handles of sealed arenas must not be used after the pool is destroyed.
+    class ArenaPool final
+    {
+        friend class SealedArena;
+        friend class ThreadArena;
+
+    public:
+        static constexpr size_t DefaultSegmentSize = size_t{256} << 10u;
+
+        // Number of segments thread arena takes from the pool at once.
+        static constexpr size_t RefillCount = 4;
+
+    private:
+        size_t _segment_size{};
+        ThreadLocalRegistry _arenas{};
+
+        // Protects free segments and list of sealed arenas.
+        mutable threading::CriticalSection _lock{};
+        impl::ArenaSegmentList _free{};
+        impl::SealedArenaRecord* _sealed{};
+        size_t _sealed_count{};
+
+        std::atomic<size_t> _reserved{};
+        std::atomic<size_t> _segments{};
+        std::atomic<size_t> _refills{};
+
+        // Arena receiving memory accounting of segments.
+        std::atomic<MemoryArena*> _arena{};
+
+    public:
+        explicit ArenaPool(size_t segment_size = DefaultSegmentSize);
+        ~ArenaPool();
+
+        ArenaPool(ArenaPool const&) = delete;
+        ArenaPool(ArenaPool&&) = delete;
+        ArenaPool& operator=(ArenaPool const&) = delete;
+        ArenaPool& operator=(ArenaPool&&) = delete;
+
+    private:
+        [[nodiscard]] impl::ArenaSegment* AllocateSegment(size_t size);
+
+        void DeallocateSegment(impl::ArenaSegment* segment);
+
+        // Takes segments from the free list, allocating missing ones.
+        [[nodiscard]] impl::ArenaSegmentList Refill(size_t count);
+
+        // Returns segments to the free list, or to the page heap for dedicated segments.
+        void Recycle(impl::ArenaSegmentList segments);
+
+        [[nodiscard]] SealedArena Seal(impl::ArenaSegmentList segments);
+
+        // Removes sealed arena from the list. Must be called with the lock held.
+        void UnlinkSealed(impl::SealedArenaRecord* record);
+
+        void Merge(impl::SealedArenaRecord* target, impl::SealedArenaRecord* source);
+
+    public:
+        /// \brief Gets arena of the calling thread, creating it on first use.
+        [[nodiscard]] ThreadArena& GetThreadArena();
+
+        /// \brief Releases memory of sealed arena for reuse.
+        ///
+        /// \note Pointers to memory allocated from the arena are invalid after this call.
+        void Release(SealedArena&& arena);
+
+        /// \brief Returns free segments to the page heap.
+        void Trim();
+
+        [[nodiscard]] size_t GetSegmentSize() const
+        {
+            return this->_segment_size;
+        }
+
+        void QueryStatistics(ArenaPoolStatistics& statistics) const;
+
+        /// \brief Reports memory of segments to the arena.
+        void SetArena(MemoryArena* arena);
+    };
+}
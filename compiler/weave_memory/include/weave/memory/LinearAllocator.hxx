@@ -1,6 +1,7 @@
 #pragma once
 #include "weave/platform/Compiler.hxx"
 #include "weave/memory/Layout.hxx"
+#include "weave/memory/MemoryAccounting.hxx"
 #include "weave/Bitwise.hxx"
 
 #include <span>
@@ -8,16 +9,31 @@
 
 namespace weave::memory
 {
+    /// \brief Bump allocator of objects released all at once.
+    ///
+    /// \details By default memory is allocated from the heap in linked segments. When constructed with reservation
+    ///          size, allocator reserves that much address space up front and commits it in `segment_size` steps as
+    ///          allocations grow, so allocations stay contiguous and no heap calls are made. When reservation is
+    ///          exhausted, allocator falls back to heap segments.
     class LinearAllocator
     {
         static constexpr size_t DefaultSegmentSize{64u << 10u};
 
+        // Segments of at least this size are allocated from the page heap.
+        static constexpr size_t PagedSegmentThreshold{16u << 10u};
+
+        // Rewinding reserved range by at least this much returns physical memory of the pages to the system.
+        static constexpr size_t RewindDiscardThreshold{256u << 10u};
+
     protected:
         struct Segment
         {
             Segment* BackLink{};
             Segment* ForwardLink{};
             std::byte* Last{};
+
+            // Size of heap segment; zero for segment of reserved range.
+            size_t Size{};
         };
 
         struct SegmentList
@@ -26,15 +42,33 @@ namespace weave::memory
             Segment* Tail{};
         };
 
+    public:
+        /// \brief Position in the allocator, which can be rewound to.
+        struct Marker final
+        {
+            Segment* Current{};
+            Segment* Previous{};
+            std::byte* Last{};
+        };
+
     protected:
         SegmentList _list{};
         std::byte* _end;
         size_t _segment_size;
         size_t _allocated_segments_size{};
 
+        // Reserved range of address space, starting with its segment header.
+        std::byte* _reservation{};
+        std::byte* _committed{};
+        size_t _reservation_size{};
+
+        // Arena receiving memory accounting of segments.
+        MemoryArena* _arena{};
+
     public:
         LinearAllocator();
         explicit LinearAllocator(size_t segment_size);
+        LinearAllocator(size_t segment_size, size_t reservation_size);
         ~LinearAllocator();
 
         LinearAllocator(LinearAllocator const&) = delete;
@@ -46,6 +80,29 @@ namespace weave::memory
     protected:
         Segment* AllocateSegment(size_t size);
 
+        void ReleaseSegment(Segment* segment);
+
+        // Commits more of the reserved range, so at least `last` is addressable.
+        [[nodiscard]] bool TryCommit(std::byte* last);
+
+        // Invokes callback with every segment and start of memory in it allocated after the marker.
+        template <typename CallbackT = void(Segment*, std::byte*)>
+        void EnumerateAfter(Marker const& marker, CallbackT&& callback) const
+        {
+            // Separate segments are inserted before the current one, so they may appear before the marked segment.
+            for (Segment* segment = marker.Current->BackLink; segment != marker.Previous; segment = segment->BackLink)
+            {
+                callback(segment, reinterpret_cast<std::byte*>(segment + 1));
+            }
+
+            callback(marker.Current, marker.Last);
+
+            for (Segment* segment = marker.Current->ForwardLink; segment != nullptr; segment = segment->ForwardLink)
+            {
+                callback(segment, reinterpret_cast<std::byte*>(segment + 1));
+            }
+        }
+
         Allocation AllocateImpl(Layout const& layout);
 
         [[nodiscard]] constexpr bool NeedsSeparateSegment(size_t size) const
@@ -173,5 +230,37 @@ namespace weave::memory
 
     public:
         void QueryMemoryUsage(size_t& allocated, size_t& reserved) const;
+
+        /// \brief Reports memory of segments to the arena.
+        void SetArena(MemoryArena* arena);
+
+        /// \brief Gets marker of the current position.
+        [[nodiscard]] Marker Mark() const
+        {
+            return Marker{
+                .Current = this->_list.Tail,
+                .Previous = this->_list.Tail->BackLink,
+                .Last = this->_list.Tail->Last,
+            };
+        }
+
+        /// \brief Releases all allocations made after the marker was taken.
+        ///
+        /// \details When a large part of reserved range is rewound, its whole pages are discarded like in `Reset`.
+        ///
+        /// \note Markers taken after this marker are invalidated.
+        void Rewind(Marker const& marker);
+
+        /// \brief Releases all allocations.
+        ///
+        /// \details All heap segments are freed. Without reserved range, a new segment is allocated to continue with.
+        ///          Pages of reserved range are discarded, returning physical memory to the system while keeping them
+        ///          committed.
+        void Reset();
+
+        [[nodiscard]] bool IsReserved() const
+        {
+            return this->_reservation != nullptr;
+        }
     };
 }
@@ -0,0 +1,110 @@
+#pragma once
+#include "weave/platform/Compiler.hxx"
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace weave::memory
+{
+    // Segments of size in range [2^i, 2^(i+1)) are counted in bucket i.
+    inline constexpr size_t MemoryHistogramBuckets = 48;
+
+    struct MemoryArenaStatistics final
+    {
+        std::string_view Name{};
+
+        // Memory currently held by the arena.
+        size_t Current{};
+
+        // High-water mark of memory held by the arena.
+        size_t Peak{};
+
+        // Number of segments taken from backing store, not of objects allocated in them.
+        size_t Segments{};
+
+        // Number of segments returned to backing store.
+        size_t ReleasedSegments{};
+
+        std::array<size_t, MemoryHistogramBuckets> Histogram{};
+    };
+
+    /// \brief Named record of memory held by allocators of one kind.
+    ///
+    /// \details Arenas are shared by allocators across threads, so all counters are updated atomically.
+    ///
+    ///          Allocators report memory at segment granularity: each call to `Allocated` records one block taken from
+    ///          backing store, such as a segment of `LinearAllocator`, not individual allocations made in it.
+    class MemoryArena final
+    {
+        friend class MemoryAccounting;
+
+    private:
+        std::string _name{};
+        std::atomic<size_t> _current{};
+        std::atomic<size_t> _peak{};
+        std::atomic<size_t> _segments{};
+        std::atomic<size_t> _released_segments{};
+        std::array<std::atomic<size_t>, MemoryHistogramBuckets> _histogram{};
+
+    public:
+        explicit MemoryArena(std::string_view name)
+            : _name{name}
+        {
+        }
+
+        MemoryArena(MemoryArena const&) = delete;
+        MemoryArena(MemoryArena&&) = delete;
+        MemoryArena& operator=(MemoryArena const&) = delete;
+        MemoryArena& operator=(MemoryArena&&) = delete;
+
+    public:
+        /// \brief Records segment taken from backing store.
+        void Allocated(size_t size);
+
+        /// \brief Records segment returned to backing store.
+        void Deallocated(size_t size);
+
+        [[nodiscard]] std::string_view GetName() const
+        {
+            return this->_name;
+        }
+
+        void QueryStatistics(MemoryArenaStatistics& statistics) const;
+    };
+
+    struct ProcessMemoryUsage final
+    {
+        // Resident set size.
+        size_t Resident{};
+
+        // Peak resident set size.
+        size_t PeakResident{};
+    };
+
+    /// \brief Queries memory usage of the current process.
+    ///
+    /// \note Returns `false` when not supported by the system.
+    bool QueryProcessMemoryUsage(ProcessMemoryUsage& usage);
+
+    /// \brief Process-wide registry of memory arenas.
+    class MemoryAccounting final
+    {
+    public:
+        /// \brief Gets arena of given name, creating it on first use.
+        ///
+        /// \note Arenas are never destroyed.
+        [[nodiscard]] static MemoryArena& GetArena(std::string_view name);
+
+        /// \brief Gets statistics of all arenas, sorted by name.
+        [[nodiscard]] static std::vector<MemoryArenaStatistics> QueryStatistics();
+
+        /// \brief Formats human readable report of arenas, page heap and process memory usage.
+        [[nodiscard]] static std::string FormatReport();
+
+        /// \brief Formats report as JSON document.
+        [[nodiscard]] static std::string FormatReportJson();
+    };
+}
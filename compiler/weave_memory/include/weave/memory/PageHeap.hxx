@@ -0,0 +1,149 @@
+#pragma once
+#include "weave/memory/PageAllocator.hxx"
+#include "weave/threading/CriticalSection.hxx"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace weave::memory
+{
+    struct PageHeapStatistics final
+    {
+        // Address space reserved for regions.
+        size_t Reserved{};
+
+        // Memory in allocated page frames.
+        size_t Allocated{};
+
+        // Memory in free page frames.
+        size_t Free{};
+
+        // Size of largest free page frame.
+        size_t LargestFree{};
+
+        // Number of free page frames.
+        size_t FreeFrames{};
+
+        size_t Regions{};
+        size_t Allocations{};
+        size_t Deallocations{};
+
+        // Number of allocations aligned to huge page boundary.
+        size_t HugePageAllocations{};
+
+        /// \brief Gets ratio of free memory not usable for the largest possible allocation.
+        [[nodiscard]] constexpr double GetFragmentation() const
+        {
+            if (this->Free == 0)
+            {
+                return 0.0;
+            }
+
+            return 1.0 - (static_cast<double>(this->LargestFree) / static_cast<double>(this->Free));
+        }
+    };
+
+    /// \brief Page granular heap allocating from large regions of reserved address space.
+    ///
+    /// \details Free page frames are kept in bins segregated by size class and coalesced with free neighbours when
+    ///          released. Regions are aligned to huge page size and allocations of at least `HugePageSize` are
+    ///          aligned to it, so transparent huge pages can back them.
+    class PageHeap final
+    {
+    public:
+        static constexpr size_t HugePageSize = size_t{2} << 20u;
+        static constexpr size_t DefaultRegionSize = size_t{64} << 20u;
+
+        // Freed frames at least this large return their physical memory to the system.
+        static constexpr size_t DiscardThreshold = size_t{256} << 10u;
+
+    private:
+        static constexpr size_t BinCount = 48;
+
+        struct Region;
+
+        struct PageFrameDescriptor final
+        {
+            // Links in list of free frames, or of lookaside descriptors.
+            PageFrameDescriptor* FLink{};
+            PageFrameDescriptor* BLink{};
+            std::byte* Base{};
+            std::byte* Limit{};
+            Region* Owner{};
+            bool Used{};
+        };
+
+        struct PageFrameDescriptorList final
+        {
+            PageFrameDescriptor* Head{};
+        };
+
+        struct Region final
+        {
+            Region* Next{};
+            std::byte* Reservation{};
+            size_t ReservationSize{};
+            std::byte* Base{};
+            std::byte* Limit{};
+
+            // Descriptors of frames starting or ending at given page.
+            std::unique_ptr<PageFrameDescriptor*[]> PageMap{};
+        };
+
+    private:
+        mutable threading::CriticalSection _lock{};
+        size_t _region_size{};
+        Region* _regions{};
+        std::array<PageFrameDescriptorList, BinCount> _bins{};
+        PageFrameDescriptorList _lookaside{};
+        std::vector<std::unique_ptr<PageFrameDescriptor[]>> _descriptors{};
+        PageHeapStatistics _statistics{};
+
+    public:
+        explicit PageHeap(size_t region_size = DefaultRegionSize);
+        ~PageHeap();
+
+        PageHeap(PageHeap const&) = delete;
+        PageHeap(PageHeap&&) = delete;
+        PageHeap& operator=(PageHeap const&) = delete;
+        PageHeap& operator=(PageHeap&&) = delete;
+
+    public:
+        /// \brief Allocates committed pages.
+        ///
+        /// \note Size is rounded up to `PageSize`. Returns `nullptr` when address space is exhausted.
+        [[nodiscard]] void* Allocate(size_t size, size_t alignment = PageSize);
+
+        /// \brief Releases pages allocated by `Allocate`.
+        void Deallocate(void* pointer);
+
+        /// \brief Gets size of allocation starting at pointer.
+        [[nodiscard]] size_t GetSize(void const* pointer) const;
+
+        void QueryStatistics(PageHeapStatistics& statistics) const;
+
+        /// \brief Verifies consistency of internal structures.
+        void Validate() const;
+
+        /// \brief Gets process-wide page heap.
+        [[nodiscard]] static PageHeap& Get();
+
+    private:
+        [[nodiscard]] static size_t GetBinIndex(size_t size);
+
+        [[nodiscard]] PageFrameDescriptor* AllocateDescriptor();
+        void ReleaseDescriptor(PageFrameDescriptor* descriptor);
+
+        void InsertFree(PageFrameDescriptor* descriptor);
+        void RemoveFree(PageFrameDescriptor* descriptor);
+
+        void MapFrame(PageFrameDescriptor* descriptor);
+
+        [[nodiscard]] Region* CreateRegion(size_t size);
+        void ReleaseRegion(Region* region);
+        [[nodiscard]] Region* FindRegion(std::byte const* address) const;
+
+        [[nodiscard]] PageFrameDescriptor* FindFree(size_t size, size_t alignment) const;
+    };
+}
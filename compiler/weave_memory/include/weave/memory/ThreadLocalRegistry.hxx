@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace weave::memory
+{
+    /// \brief Lock-free list of objects created once per thread and owned by a shared object.
+    ///
+    /// \details Lookup checks a small cache of the calling thread first and falls back to scanning the list by thread
+    ///          id, so an object evicted from the cache is found again instead of being created twice. Entries are
+    ///          never removed; the owner destroys them by walking the list once no other thread uses it.
+    ///
+    ///          Thread ids may be reused by the system, so an entry of an exited thread may be picked up by a new
+    ///          thread with the same id. Owners must not keep state that depends on the thread being still alive.
+    class ThreadLocalRegistry final
+    {
+    public:
+        struct Entry
+        {
+            Entry* Next{};
+            std::thread::id Thread{};
+        };
+
+    private:
+        uint64_t _id{};
+        std::atomic<Entry*> _entries{};
+
+    public:
+        ThreadLocalRegistry();
+
+        ThreadLocalRegistry(ThreadLocalRegistry const&) = delete;
+        ThreadLocalRegistry(ThreadLocalRegistry&&) = delete;
+        ThreadLocalRegistry& operator=(ThreadLocalRegistry const&) = delete;
+        ThreadLocalRegistry& operator=(ThreadLocalRegistry&&) = delete;
+
+    public:
+        /// \brief Finds entry registered by the calling thread.
+        [[nodiscard]] Entry* Find() const;
+
+        /// \brief Registers entry of the calling thread.
+        ///
+        /// \note Must be called only when `Find` returned no entry.
+        void Register(Entry* entry);
+
+        /// \brief Gets first registered entry.
+        [[nodiscard]] Entry* GetFirst() const
+        {
+            return this->_entries.load(std::memory_order_acquire);
+        }
+    };
+}
@@ -19,7 +19,24 @@ namespace weave::memory
         {
         }
 
+        TypedLinearAllocator(size_t capacity, size_t reservation_size)
+            : LinearAllocator{sizeof(T) * capacity, reservation_size}
+        {
+        }
+
         ~TypedLinearAllocator()
+        {
+            this->DestroyAll();
+        }
+
+        TypedLinearAllocator(TypedLinearAllocator const&) = delete;
+        TypedLinearAllocator(TypedLinearAllocator&&) = default;
+
+        TypedLinearAllocator& operator=(TypedLinearAllocator const&) = delete;
+        TypedLinearAllocator& operator=(TypedLinearAllocator&&) = default;
+
+    private:
+        void DestroyAll()
         {
             Segment* segment = this->_list.Head;
 
@@ -37,11 +54,27 @@ namespace weave::memory
             }
         }
 
-        TypedLinearAllocator(TypedLinearAllocator const&) = delete;
-        TypedLinearAllocator(TypedLinearAllocator&&) = default;
+    public:
+        /// \brief Destroys objects allocated after the marker was taken and releases their memory.
+        void Rewind(Marker const& marker)
+        {
+            this->EnumerateAfter(marker, [](Segment* segment, std::byte* memory)
+                {
+                    T* const first = reinterpret_cast<T*>(bitwise::AlignUp(memory, alignof(T)));
+                    T* const last = reinterpret_cast<T*>(segment->Last);
 
-        TypedLinearAllocator& operator=(TypedLinearAllocator const&) = delete;
-        TypedLinearAllocator& operator=(TypedLinearAllocator&&) = default;
+                    std::destroy(first, last);
+                });
+
+            LinearAllocator::Rewind(marker);
+        }
+
+        /// \brief Destroys all objects and releases their memory.
+        void Reset()
+        {
+            this->DestroyAll();
+            LinearAllocator::Reset();
+        }
 
     public:
         template <typename CallbackT = bool(T*)>
@@ -0,0 +1,344 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/memory/ArenaPool.hxx"
+#include "weave/memory/LinearAllocator.hxx"
+#include "weave/threading/Runnable.hxx"
+#include "weave/threading/Thread.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    struct Node final
+    {
+        Node* Next{};
+        size_t Value{};
+        size_t Owner{};
+    };
+
+    Node* BuildList(weave::memory::ThreadArena& arena, size_t owner, size_t count)
+    {
+        Node* head = nullptr;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            head = arena.Emplace<Node>(head, i, owner);
+        }
+
+        return head;
+    }
+
+    size_t VerifyList(Node const* head, size_t owner, size_t count)
+    {
+        size_t visited = 0;
+
+        for (Node const* node = head; node != nullptr; node = node->Next)
+        {
+            REQUIRE(node->Owner == owner);
+            REQUIRE(node->Value == (count - visited - 1));
+            ++visited;
+        }
+
+        return visited;
+    }
+}
+
+TEST_CASE("ArenaPool - seal and release")
+{
+    using namespace weave::memory;
+
+    ArenaPool pool{64u << 10u};
+
+    ThreadArena& arena = pool.GetThreadArena();
+    REQUIRE(std::addressof(arena) == std::addressof(pool.GetThreadArena()));
+
+    Node* const head = BuildList(arena, 1, 10000);
+
+    SealedArena sealed = arena.Seal();
+    REQUIRE_FALSE(sealed.IsEmpty());
+    REQUIRE(sealed.GetSegmentCount() > 1);
+    REQUIRE(sealed.Contains(head));
+    REQUIRE(VerifyList(head, 1, 10000) == 10000);
+
+    // Sealing without allocations yields empty arena.
+    REQUIRE(arena.Seal().IsEmpty());
+
+    ArenaPoolStatistics statistics{};
+    pool.QueryStatistics(statistics);
+    REQUIRE(statistics.SealedArenas == 1);
+    REQUIRE(statistics.Reserved == (statistics.Segments * pool.GetSegmentSize()));
+
+    size_t const segments = statistics.Segments;
+
+    pool.Release(std::move(sealed));
+    REQUIRE(sealed.IsEmpty());
+
+    pool.QueryStatistics(statistics);
+    REQUIRE(statistics.SealedArenas == 0);
+    REQUIRE(statistics.FreeSegments > 0);
+
+    // Released segments are reused before new ones are allocated.
+    Node* const reused = BuildList(arena, 2, 10000);
+    SealedArena second = arena.Seal();
+    REQUIRE(VerifyList(reused, 2, 10000) == 10000);
+
+    pool.QueryStatistics(statistics);
+    REQUIRE(statistics.Segments == segments);
+
+    pool.Release(std::move(second));
+    pool.Trim();
+
+    pool.QueryStatistics(statistics);
+    REQUIRE(statistics.FreeSegments == 0);
+    REQUIRE(statistics.Segments <= ArenaPool::RefillCount);
+}
+
+TEST_CASE("ArenaPool - large allocations")
+{
+    using namespace weave::memory;
+
+    ArenaPool pool{64u << 10u};
+    ThreadArena& arena = pool.GetThreadArena();
+
+    std::vector<std::byte> const source(1u << 20u, std::byte{0xCC});
+
+    std::span<std::byte> const small = arena.EmplaceArray<std::byte>(std::span{source}.first(100));
+    std::span<std::byte> const large = arena.EmplaceArray<std::byte>(std::span{source});
+    REQUIRE(large.size() == source.size());
+
+    SealedArena sealed = arena.Seal();
+    REQUIRE(sealed.Contains(small.data()));
+    REQUIRE(sealed.Contains(large.data()));
+    REQUIRE(sealed.Contains(&large.back()));
+    REQUIRE(std::memcmp(large.data(), source.data(), source.size()) == 0);
+
+    ArenaPoolStatistics statistics{};
+    pool.QueryStatistics(statistics);
+    size_t const reserved = statistics.Reserved;
+
+    // Dedicated segments go back to the page heap.
+    pool.Release(std::move(sealed));
+
+    pool.QueryStatistics(statistics);
+    REQUIRE(statistics.Reserved < reserved);
+    REQUIRE(statistics.Reserved == (statistics.Segments * pool.GetSegmentSize()));
+}
+
+TEST_CASE("ArenaPool - append")
+{
+    using namespace weave::memory;
+
+    ArenaPool pool{64u << 10u};
+    ThreadArena& arena = pool.GetThreadArena();
+
+    Node* const first = BuildList(arena, 1, 5000);
+    SealedArena merged = arena.Seal();
+
+    Node* const second = BuildList(arena, 2, 5000);
+    SealedArena other = arena.Seal();
+
+    size_t const count = merged.GetSegmentCount() + other.GetSegmentCount();
+
+    merged.Append(std::move(other));
+    REQUIRE(other.IsEmpty());
+    REQUIRE(merged.GetSegmentCount() == count);
+    REQUIRE(merged.Contains(first));
+    REQUIRE(merged.Contains(second));
+
+    ArenaPoolStatistics statistics{};
+    pool.QueryStatistics(statistics);
+    REQUIRE(statistics.SealedArenas == 1);
+}
+
+TEST_CASE("ArenaPool - many pools on one thread")
+{
+    using namespace weave::memory;
+
+    // More pools than the per-thread cache holds.
+    constexpr size_t PoolCount = 8;
+
+    std::vector<std::unique_ptr<ArenaPool>> pools{};
+    std::vector<ThreadArena*> arenas{};
+    std::vector<Node*> heads{};
+
+    for (size_t i = 0; i < PoolCount; ++i)
+    {
+        ArenaPool& pool = *pools.emplace_back(std::make_unique<ArenaPool>(64u << 10u));
+        ThreadArena& arena = pool.GetThreadArena();
+        arenas.push_back(std::addressof(arena));
+        heads.push_back(BuildList(arena, i, 1000));
+    }
+
+    for (size_t i = 0; i < PoolCount; ++i)
+    {
+        ArenaPool& pool = *pools[i];
+
+        // Arena evicted from the cache is found again, so allocations made before are sealed.
+        ThreadArena& arena = pool.GetThreadArena();
+        REQUIRE(std::addressof(arena) == arenas[i]);
+
+        SealedArena sealed = arena.Seal();
+        REQUIRE(sealed.Contains(heads[i]));
+        REQUIRE(VerifyList(heads[i], i, 1000) == 1000);
+
+        pool.Release(std::move(sealed));
+
+        ArenaPoolStatistics statistics{};
+        pool.QueryStatistics(statistics);
+        REQUIRE(statistics.SealedArenas == 0);
+    }
+}
+
+namespace
+{
+    class Producer final : public weave::threading::Runnable
+    {
+    public:
+        weave::memory::ArenaPool& Pool;
+        size_t Owner{};
+        size_t Count{};
+        std::vector<Node*> Lists{};
+        std::vector<weave::memory::SealedArena> Sealed{};
+
+    public:
+        Producer(weave::memory::ArenaPool& pool, size_t owner, size_t count)
+            : Pool{pool}
+            , Owner{owner}
+            , Count{count}
+        {
+        }
+
+    protected:
+        void Execute() override
+        {
+            weave::memory::ThreadArena& arena = this->Pool.GetThreadArena();
+
+            for (size_t i = 0; i < 8; ++i)
+            {
+                this->Lists.push_back(BuildList(arena, this->Owner, this->Count));
+                this->Sealed.push_back(arena.Seal());
+            }
+        }
+    };
+}
+
+TEST_CASE("ArenaPool - handoff between threads")
+{
+    using namespace weave::memory;
+    using namespace weave::threading;
+
+    ArenaPool pool{64u << 10u};
+
+    std::vector<Producer> producers{};
+    producers.reserve(4);
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        producers.emplace_back(pool, i, 20000);
+    }
+
+    {
+        std::vector<Thread> workers{};
+        workers.reserve(producers.size());
+
+        for (Producer& producer : producers)
+        {
+            workers.emplace_back(ThreadStart{.Callback = &producer});
+        }
+
+        for (Thread& worker : workers)
+        {
+            worker.Join();
+        }
+    }
+
+    // Consumer takes ownership of all arenas without copying.
+    SealedArena merged{};
+
+    for (Producer& producer : producers)
+    {
+        for (size_t i = 0; i < producer.Lists.size(); ++i)
+        {
+            REQUIRE(producer.Sealed[i].Contains(producer.Lists[i]));
+            REQUIRE(VerifyList(producer.Lists[i], producer.Owner, producer.Count) == producer.Count);
+
+            merged.Append(std::move(producer.Sealed[i]));
+        }
+    }
+
+    for (Producer const& producer : producers)
+    {
+        for (Node const* list : producer.Lists)
+        {
+            REQUIRE(merged.Contains(list));
+        }
+    }
+
+    ArenaPoolStatistics statistics{};
+    pool.QueryStatistics(statistics);
+    REQUIRE(statistics.SealedArenas == 1);
+    REQUIRE(statistics.Refills >= producers.size());
+
+    // Remaining memory is released with the pool.
+}
+
+TEST_CASE("ArenaPool - memory accounting")
+{
+    using namespace weave::memory;
+
+    MemoryArena accounting{"test.arena_pool"};
+
+    {
+        ArenaPool pool{64u << 10u};
+        pool.SetArena(&accounting);
+
+        (void)BuildList(pool.GetThreadArena(), 0, 10000);
+
+        ArenaPoolStatistics statistics{};
+        pool.QueryStatistics(statistics);
+
+        MemoryArenaStatistics arena{};
+        accounting.QueryStatistics(arena);
+        REQUIRE(arena.Current == statistics.Reserved);
+    }
+
+    MemoryArenaStatistics arena{};
+    accounting.QueryStatistics(arena);
+    REQUIRE(arena.Current == 0);
+    REQUIRE(arena.Peak > 0);
+}
+
+TEST_CASE("ArenaPool - benchmark", "[.benchmark]")
+{
+    using namespace weave::memory;
+
+    ArenaPool pool{};
+
+    BENCHMARK("thread arena")
+    {
+        ThreadArena& arena = pool.GetThreadArena();
+        Node* const head = BuildList(arena, 0, 100000);
+        pool.Release(arena.Seal());
+        return head;
+    };
+
+    BENCHMARK("linear allocator")
+    {
+        LinearAllocator allocator{};
+        Node* head = nullptr;
+
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            head = allocator.Emplace<Node>(head, i, 0);
+        }
+
+        return head;
+    };
+}
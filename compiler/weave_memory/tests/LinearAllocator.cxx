@@ -0,0 +1,373 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/memory/PageAllocator.hxx"
+#include "weave/memory/TypedLinearAllocator.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    struct Counted final
+    {
+        size_t& Destroyed;
+        size_t Value{};
+
+        Counted(size_t& destroyed, size_t value)
+            : Destroyed{destroyed}
+            , Value{value}
+        {
+        }
+
+        ~Counted()
+        {
+            ++this->Destroyed;
+        }
+    };
+
+    void FillAndVerify(weave::memory::LinearAllocator& allocator, size_t count)
+    {
+        std::vector<std::pair<uint32_t*, uint32_t>> allocations{};
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::span<uint32_t> const values = allocator.EmplaceArray<uint32_t>(1 + (i % 31));
+            std::fill(values.begin(), values.end(), static_cast<uint32_t>(i));
+            allocations.emplace_back(values.data(), static_cast<uint32_t>(values.size()));
+        }
+
+        for (size_t i = 0; i < allocations.size(); ++i)
+        {
+            auto const [data, size] = allocations[i];
+
+            for (uint32_t j = 0; j < size; ++j)
+            {
+                REQUIRE(data[j] == static_cast<uint32_t>(i));
+            }
+        }
+    }
+}
+
+TEST_CASE("LinearAllocator - segmented")
+{
+    using namespace weave::memory;
+
+    LinearAllocator allocator{4u << 10u};
+    REQUIRE_FALSE(allocator.IsReserved());
+
+    FillAndVerify(allocator, 10000);
+
+    // Allocation larger than segment gets its own segment.
+    std::span<std::byte> const large = allocator.EmplaceArray<std::byte>(64u << 10u);
+    std::memset(large.data(), 0xCC, large.size());
+
+    allocator.Reset();
+
+    size_t allocated{};
+    size_t reserved{};
+    allocator.QueryMemoryUsage(allocated, reserved);
+    REQUIRE(reserved == (4u << 10u));
+
+    FillAndVerify(allocator, 1000);
+}
+
+TEST_CASE("LinearAllocator - reserved")
+{
+    using namespace weave::memory;
+
+    LinearAllocator allocator{16u << 10u, 64u << 20u};
+    REQUIRE(allocator.IsReserved());
+
+    SECTION("Allocations are contiguous")
+    {
+        std::byte* previous = allocator.EmplaceArray<std::byte>(100).data();
+
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            std::byte* const current = allocator.EmplaceArray<std::byte>(100).data();
+            REQUIRE(current == (previous + 100));
+            previous = current;
+        }
+
+        // Large allocations are placed in the reserved range too.
+        std::byte* const large = allocator.EmplaceArray<std::byte>(1u << 20u).data();
+        REQUIRE(large == (previous + 100));
+        std::memset(large, 0xCC, 1u << 20u);
+
+        size_t allocated{};
+        size_t reserved{};
+        allocator.QueryMemoryUsage(allocated, reserved);
+        REQUIRE(allocated >= ((10001u * 100u) + (1u << 20u)));
+        REQUIRE(reserved >= allocated);
+        REQUIRE(reserved < (allocated + (16u << 10u) + 16u));
+    }
+
+    SECTION("Reset keeps committed range")
+    {
+        FillAndVerify(allocator, 50000);
+
+        size_t allocatedBefore{};
+        size_t reservedBefore{};
+        allocator.QueryMemoryUsage(allocatedBefore, reservedBefore);
+
+        allocator.Reset();
+
+        size_t allocatedAfter{};
+        size_t reservedAfter{};
+        allocator.QueryMemoryUsage(allocatedAfter, reservedAfter);
+
+        REQUIRE(allocatedAfter < allocatedBefore);
+        REQUIRE(reservedAfter == reservedBefore);
+
+        FillAndVerify(allocator, 50000);
+    }
+}
+
+TEST_CASE("LinearAllocator - reservation exhausted")
+{
+    using namespace weave::memory;
+
+    LinearAllocator allocator{4u << 10u, PageGranularity};
+    REQUIRE(allocator.IsReserved());
+
+    // Continues with heap segments.
+    FillAndVerify(allocator, 20000);
+
+    std::span<std::byte> const large = allocator.EmplaceArray<std::byte>(1u << 20u);
+    std::memset(large.data(), 0xCC, large.size());
+
+    allocator.Reset();
+    FillAndVerify(allocator, 20000);
+}
+
+TEST_CASE("TypedLinearAllocator - reset destroys objects")
+{
+    using namespace weave::memory;
+
+    size_t destroyed = 0;
+
+    {
+        TypedLinearAllocator<Counted> allocator{16, 16u << 20u};
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            (void)allocator.Emplace(destroyed, i);
+        }
+
+        allocator.Reset();
+        REQUIRE(destroyed == 100);
+
+        Counted* const item = allocator.Emplace(destroyed, 42);
+        REQUIRE(item->Value == 42);
+    }
+
+    REQUIRE(destroyed == 101);
+}
+
+TEST_CASE("LinearAllocator - rewind")
+{
+    using namespace weave::memory;
+
+    for (bool const reserve : {false, true})
+    {
+        LinearAllocator allocator = reserve
+            ? LinearAllocator{4u << 10u, 16u << 20u}
+            : LinearAllocator{4u << 10u};
+
+        FillAndVerify(allocator, 100);
+
+        size_t allocatedBefore{};
+        size_t reservedBefore{};
+        allocator.QueryMemoryUsage(allocatedBefore, reservedBefore);
+
+        LinearAllocator::Marker const marker = allocator.Mark();
+        std::byte* const expected = allocator.EmplaceArray<std::byte>(1).data();
+        allocator.Rewind(marker);
+
+        // Spans many segments, including separate ones for large allocations.
+        for (size_t i = 0; i < 10; ++i)
+        {
+            FillAndVerify(allocator, 1000);
+
+            std::span<std::byte> const large = allocator.EmplaceArray<std::byte>(64u << 10u);
+            std::memset(large.data(), 0xCC, large.size());
+        }
+
+        allocator.Rewind(marker);
+
+        size_t allocatedAfter{};
+        size_t reservedAfter{};
+        allocator.QueryMemoryUsage(allocatedAfter, reservedAfter);
+
+        REQUIRE(allocatedAfter == allocatedBefore);
+
+        if (not reserve)
+        {
+            REQUIRE(reservedAfter == reservedBefore);
+        }
+
+        // Allocation continues exactly at the marked position.
+        REQUIRE(allocator.EmplaceArray<std::byte>(1).data() == expected);
+
+        FillAndVerify(allocator, 10000);
+    }
+}
+
+#if defined(__linux__)
+
+TEST_CASE("LinearAllocator - rewind discards pages of reserved range")
+{
+    using namespace weave::memory;
+
+    LinearAllocator allocator{16u << 10u, 64u << 20u};
+    REQUIRE(allocator.IsReserved());
+
+    constexpr size_t size = 4u << 20u;
+
+    LinearAllocator::Marker const marker = allocator.Mark();
+
+    std::span<std::byte> const first = allocator.EmplaceArray<std::byte>(size);
+    std::memset(first.data(), 0xCC, first.size());
+
+    allocator.Rewind(marker);
+
+    // Same range is returned again; discarded pages read back as zeros.
+    std::span<std::byte> const second = allocator.EmplaceArray<std::byte>(size);
+    REQUIRE(second.data() == first.data());
+
+    std::byte const* const firstPage = weave::bitwise::AlignUp(second.data(), PageSize) + PageSize;
+    std::byte const* const lastPage = second.data() + (size / 2);
+
+    REQUIRE(std::all_of(firstPage, lastPage, [](std::byte value)
+        {
+            return value == std::byte{};
+        }));
+}
+
+#endif
+
+TEST_CASE("TypedLinearAllocator - rewind destroys objects")
+{
+    using namespace weave::memory;
+
+    size_t destroyed = 0;
+
+    {
+        TypedLinearAllocator<Counted> allocator{16};
+
+        for (size_t i = 0; i < 10; ++i)
+        {
+            (void)allocator.Emplace(destroyed, i);
+        }
+
+        TypedLinearAllocator<Counted>::Marker const marker = allocator.Mark();
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            (void)allocator.Emplace(destroyed, 10 + i);
+        }
+
+        allocator.Rewind(marker);
+        REQUIRE(destroyed == 100);
+
+        size_t count = 0;
+        allocator.Enumerate([&](Counted* item)
+            {
+                REQUIRE(item->Value == count);
+                ++count;
+                return false;
+            });
+
+        REQUIRE(count == 10);
+    }
+
+    REQUIRE(destroyed == 110);
+}
+
+namespace
+{
+    // Mix of allocation sizes typical for syntax tree nodes, tokens and lists.
+    void AllocateSyntaxTree(weave::memory::LinearAllocator& allocator, size_t count)
+    {
+        constexpr size_t sizes[]{32, 40, 48, 16, 72, 24, 56, 112};
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t const size = sizes[i % std::size(sizes)];
+            weave::memory::Allocation const allocation = allocator.Allocate(weave::memory::Layout{size, alignof(void*)});
+            std::memset(allocation.Address, 0, size);
+        }
+    }
+
+    size_t QueryResidentSetSize()
+    {
+#if defined(__linux__)
+        std::ifstream statm{"/proc/self/statm"};
+        size_t total{};
+        size_t resident{};
+        statm >> total >> resident;
+        return resident * weave::memory::PageSize;
+#else
+        return 0;
+#endif
+    }
+}
+
+TEST_CASE("LinearAllocator - benchmark", "[.benchmark]")
+{
+    using namespace weave::memory;
+
+    constexpr size_t count = 1u << 20u;
+
+    BENCHMARK("segmented")
+    {
+        LinearAllocator allocator{128u << 10u};
+        AllocateSyntaxTree(allocator, count);
+        return allocator.IsReserved();
+    };
+
+    BENCHMARK("reserved")
+    {
+        LinearAllocator allocator{128u << 10u, 1u << 30u};
+        AllocateSyntaxTree(allocator, count);
+        return allocator.IsReserved();
+    };
+
+    BENCHMARK("reserved, reused")
+    {
+        static LinearAllocator allocator{128u << 10u, 1u << 30u};
+        allocator.Reset();
+        AllocateSyntaxTree(allocator, count);
+        return allocator.IsReserved();
+    };
+
+    for (bool const reserve : {false, true})
+    {
+        ptrdiff_t const before = static_cast<ptrdiff_t>(QueryResidentSetSize());
+
+        LinearAllocator allocator = reserve
+            ? LinearAllocator{128u << 10u, 1u << 30u}
+            : LinearAllocator{128u << 10u};
+
+        AllocateSyntaxTree(allocator, count);
+
+        ptrdiff_t const peak = static_cast<ptrdiff_t>(QueryResidentSetSize());
+
+        allocator.Reset();
+
+        ptrdiff_t const after = static_cast<ptrdiff_t>(QueryResidentSetSize());
+
+        fmt::println("{}: RSS growth {} KiB, after reset {} KiB",
+            reserve ? "reserved" : "segmented",
+            (peak - before) / 1024,
+            (after - before) / 1024);
+    }
+}
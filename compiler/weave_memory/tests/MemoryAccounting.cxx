@@ -0,0 +1,115 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/memory/MemoryAccounting.hxx"
+#include "weave/memory/LinearAllocator.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include <algorithm>
+
+TEST_CASE("MemoryAccounting - arena statistics")
+{
+    using namespace weave::memory;
+
+    MemoryArena& arena = MemoryAccounting::GetArena("tests.arena-statistics");
+    REQUIRE(&MemoryAccounting::GetArena("tests.arena-statistics") == &arena);
+    REQUIRE(arena.GetName() == "tests.arena-statistics");
+
+    arena.Allocated(100);
+    arena.Allocated(4096);
+    arena.Deallocated(100);
+    arena.Allocated(10);
+
+    MemoryArenaStatistics statistics{};
+    arena.QueryStatistics(statistics);
+
+    REQUIRE(statistics.Current == 4106);
+    REQUIRE(statistics.Peak == 4196);
+    REQUIRE(statistics.Segments == 3);
+    REQUIRE(statistics.ReleasedSegments == 1);
+    REQUIRE(statistics.Histogram[3] == 1);
+    REQUIRE(statistics.Histogram[6] == 1);
+    REQUIRE(statistics.Histogram[12] == 1);
+
+    std::vector<MemoryArenaStatistics> const all = MemoryAccounting::QueryStatistics();
+    REQUIRE(std::is_sorted(all.begin(), all.end(), [](MemoryArenaStatistics const& left, MemoryArenaStatistics const& right)
+        {
+            return left.Name < right.Name;
+        }));
+
+    REQUIRE(std::any_of(all.begin(), all.end(), [](MemoryArenaStatistics const& item)
+        {
+            return item.Name == "tests.arena-statistics";
+        }));
+}
+
+TEST_CASE("MemoryAccounting - linear allocator")
+{
+    using namespace weave::memory;
+
+    MemoryArena& arena = MemoryAccounting::GetArena("tests.linear-allocator");
+
+    for (bool const reserve : {false, true})
+    {
+        {
+            LinearAllocator allocator = reserve
+                ? LinearAllocator{16u << 10u, 16u << 20u}
+                : LinearAllocator{16u << 10u};
+
+            allocator.SetArena(&arena);
+
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                (void)allocator.EmplaceArray<std::byte>(1000);
+            }
+
+            size_t allocated{};
+            size_t reserved{};
+            allocator.QueryMemoryUsage(allocated, reserved);
+
+            MemoryArenaStatistics statistics{};
+            arena.QueryStatistics(statistics);
+            REQUIRE(statistics.Current == reserved);
+
+            allocator.Reset();
+
+            allocated = 0;
+            reserved = 0;
+            allocator.QueryMemoryUsage(allocated, reserved);
+
+            arena.QueryStatistics(statistics);
+            REQUIRE(statistics.Current == reserved);
+        }
+
+        MemoryArenaStatistics statistics{};
+        arena.QueryStatistics(statistics);
+        REQUIRE(statistics.Current == 0);
+        REQUIRE(statistics.Peak >= 1000000);
+    }
+}
+
+TEST_CASE("MemoryAccounting - reports")
+{
+    using namespace weave::memory;
+
+    MemoryAccounting::GetArena("tests.reports").Allocated(64);
+
+    std::string const report = MemoryAccounting::FormatReport();
+    REQUIRE(report.find("tests.reports") != std::string::npos);
+
+    std::string const json = MemoryAccounting::FormatReportJson();
+    REQUIRE(json.starts_with("{"));
+    REQUIRE(json.find(R"("name": "tests.reports", "current": 64, "peak": 64, "segments": 1, "released_segments": 0, "histogram": { "64": 1 })") != std::string::npos);
+    REQUIRE(json.find(R"("page_heap": {)") != std::string::npos);
+
+#if defined(__linux__)
+    ProcessMemoryUsage usage{};
+    REQUIRE(QueryProcessMemoryUsage(usage));
+    REQUIRE(usage.Resident != 0);
+    REQUIRE(usage.PeakResident >= usage.Resident);
+    REQUIRE(json.find(R"("process": {)") != std::string::npos);
+#endif
+}
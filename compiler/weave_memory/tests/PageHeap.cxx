@@ -0,0 +1,224 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/memory/PageHeap.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+TEST_CASE("PageHeap - allocations")
+{
+    using namespace weave::memory;
+
+    PageHeap heap{};
+
+    void* const small = heap.Allocate(1);
+    REQUIRE(small != nullptr);
+    REQUIRE(weave::bitwise::IsAligned(small, PageSize));
+    REQUIRE(heap.GetSize(small) == PageSize);
+    std::memset(small, 0xCC, PageSize);
+
+    void* const aligned = heap.Allocate(3 * PageSize, PageGranularity);
+    REQUIRE(weave::bitwise::IsAligned(aligned, PageGranularity));
+    REQUIRE(heap.GetSize(aligned) == (3 * PageSize));
+
+    // Huge allocations are aligned to huge page boundary.
+    void* const huge = heap.Allocate(PageHeap::HugePageSize + PageSize);
+    REQUIRE(weave::bitwise::IsAligned(huge, PageHeap::HugePageSize));
+    std::memset(huge, 0xCC, PageHeap::HugePageSize + PageSize);
+
+    heap.Validate();
+
+    PageHeapStatistics statistics{};
+    heap.QueryStatistics(statistics);
+    REQUIRE(statistics.Regions == 1);
+    REQUIRE(statistics.Allocations == 3);
+    REQUIRE(statistics.HugePageAllocations == 1);
+    REQUIRE(statistics.Allocated == (PageSize + (3 * PageSize) + PageHeap::HugePageSize + PageSize));
+
+    heap.Deallocate(small);
+    heap.Deallocate(aligned);
+    heap.Deallocate(huge);
+
+    heap.Validate();
+
+    // Everything is coalesced back into single frame.
+    heap.QueryStatistics(statistics);
+    REQUIRE(statistics.Allocated == 0);
+    REQUIRE(statistics.FreeFrames == 1);
+    REQUIRE(statistics.LargestFree == PageHeap::DefaultRegionSize);
+    REQUIRE(statistics.GetFragmentation() == 0.0);
+}
+
+TEST_CASE("PageHeap - coalescing")
+{
+    using namespace weave::memory;
+
+    PageHeap heap{8u << 20u};
+
+    std::mt19937 random{42};
+    std::uniform_int_distribution<size_t> pages{1, 64};
+
+    std::vector<void*> allocations{};
+
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        void* const pointer = heap.Allocate(pages(random) * PageSize);
+        REQUIRE(pointer != nullptr);
+        allocations.push_back(pointer);
+    }
+
+    heap.Validate();
+
+    PageHeapStatistics statistics{};
+    heap.QueryStatistics(statistics);
+    REQUIRE(statistics.Regions > 1);
+
+    // Free every other allocation - holes can't be coalesced.
+    for (size_t i = 0; i < allocations.size(); i += 2)
+    {
+        heap.Deallocate(allocations[i]);
+    }
+
+    heap.Validate();
+
+    heap.QueryStatistics(statistics);
+    REQUIRE(statistics.GetFragmentation() > 0.5);
+
+    for (size_t i = 1; i < allocations.size(); i += 2)
+    {
+        heap.Deallocate(allocations[i]);
+    }
+
+    heap.Validate();
+
+    // Empty regions are released, but one.
+    heap.QueryStatistics(statistics);
+    REQUIRE(statistics.Regions == 1);
+    REQUIRE(statistics.Allocated == 0);
+    REQUIRE(statistics.FreeFrames == 1);
+    REQUIRE(statistics.Allocations == statistics.Deallocations);
+}
+
+TEST_CASE("PageHeap - dedicated regions")
+{
+    using namespace weave::memory;
+
+    PageHeap heap{4u << 20u};
+
+    void* const small = heap.Allocate(PageSize);
+
+    size_t const size = 16u << 20u;
+    std::byte* const large = static_cast<std::byte*>(heap.Allocate(size));
+    REQUIRE(large != nullptr);
+    REQUIRE(heap.GetSize(large) == size);
+
+    large[0] = std::byte{1};
+    large[size - 1] = std::byte{2};
+
+    PageHeapStatistics statistics{};
+    heap.QueryStatistics(statistics);
+    REQUIRE(statistics.Regions == 2);
+
+    heap.Deallocate(large);
+
+    heap.QueryStatistics(statistics);
+    REQUIRE(statistics.Regions == 1);
+
+    heap.Deallocate(small);
+    heap.Validate();
+}
+
+TEST_CASE("PageHeap - benchmark", "[.benchmark]")
+{
+    using namespace weave::memory;
+
+    std::mt19937 random{42};
+    std::uniform_int_distribution<size_t> pages{1, 32};
+
+    std::vector<size_t> sizes(1024);
+    std::generate(sizes.begin(), sizes.end(), [&]
+        {
+            return pages(random) * PageSize;
+        });
+
+    std::vector<void*> pointers(sizes.size());
+
+    BENCHMARK("page heap")
+    {
+        PageHeap& heap = PageHeap::Get();
+
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            pointers[i] = heap.Allocate(sizes[i]);
+        }
+
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            heap.Deallocate(pointers[(i * 7) % pointers.size()]);
+        }
+
+        return pointers.front();
+    };
+
+    BENCHMARK("page allocator")
+    {
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            pointers[i] = PageAllocate(sizes[i]).Pointer;
+        }
+
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            size_t const index = (i * 7) % pointers.size();
+            PageDeallocate(pointers[index], sizes[index]);
+        }
+
+        return pointers.front();
+    };
+
+    BENCHMARK("operator new")
+    {
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            pointers[i] = ::operator new(sizes[i]);
+        }
+
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            ::operator delete(pointers[(i * 7) % pointers.size()]);
+        }
+
+        return pointers.front();
+    };
+
+    PageHeap heap{};
+
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        pointers[i] = heap.Allocate(sizes[i]);
+    }
+
+    for (size_t i = 0; i < sizes.size(); i += 3)
+    {
+        heap.Deallocate(pointers[i]);
+    }
+
+    PageHeapStatistics statistics{};
+    heap.QueryStatistics(statistics);
+
+    fmt::println("allocated: {} KiB, free: {} KiB in {} frames, largest free: {} KiB, fragmentation: {:.3f}",
+        statistics.Allocated >> 10u,
+        statistics.Free >> 10u,
+        statistics.FreeFrames,
+        statistics.LargestFree >> 10u,
+        statistics.GetFragmentation());
+}
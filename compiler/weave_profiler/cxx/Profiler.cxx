@@ -1,7 +1,16 @@
 #include "weave/profiler/Profiler.hxx"
+#include "weave/threading/Thread.hxx"
+#include "weave/memory/PageHeap.hxx"
+
+#include <bit>
 
 namespace weave::profiler::impl
 {
+    uintptr_t GetCurrentThreadId()
+    {
+        return std::bit_cast<uintptr_t>(threading::GetThisThreadId().Native);
+    }
+
     void Serialize(fmt::memory_buffer& buffer, InstantEvent const& e)
     {
         fmt::format_to(
@@ -24,6 +33,29 @@ namespace weave::profiler::impl
             e.Duration.ToMicroseconds(),
             e.ThreadId);
     }
+
+    void Serialize(fmt::memory_buffer& buffer, CounterEvent const& e)
+    {
+        fmt::format_to(
+            std::back_inserter(buffer),
+            R"__({{ "cat": "{}", "name": "{}", "ph": "C", "ts": {}, "pid": 1, "tid": {}, "args": {{ )__",
+            e.Category,
+            e.Name,
+            e.Timestamp.SinceEpoch().ToMicroseconds(),
+            e.ThreadId);
+
+        for (size_t i = 0; i < e.Count; ++i)
+        {
+            fmt::format_to(
+                std::back_inserter(buffer),
+                R"__({}"{}": {})__",
+                (i != 0) ? ", " : "",
+                e.Values[i].Name,
+                e.Values[i].Value);
+        }
+
+        fmt::format_to(std::back_inserter(buffer), R"__( }} }},)__");
+    }
 }
 
 namespace weave::profiler
@@ -32,11 +64,15 @@ namespace weave::profiler
 
     CompleteEvent* Profiler::Start(const char* category, const char* name)
     {
+        time::Instant const timestamp = time::Instant::Now();
+
+        threading::CriticalSection::Lock lock{this->_lock};
+
         return this->_complete_events.Emplace(
             category,
             name,
-            time::Instant::Now(),
-            2137);
+            timestamp,
+            impl::GetCurrentThreadId());
     }
 
     void Profiler::Stop(CompleteEvent* e)
@@ -46,15 +82,71 @@ namespace weave::profiler
 
     void Profiler::Event(const char* category, const char* name)
     {
+        time::Instant const timestamp = time::Instant::Now();
+
+        threading::CriticalSection::Lock lock{this->_lock};
+
         (void)this->_events.Emplace(
             category,
             name,
-            time::Instant::Now(),
-            2137);
+            timestamp,
+            impl::GetCurrentThreadId());
+    }
+
+    void Profiler::Counter(const char* category, const char* name, std::initializer_list<CounterValue> values)
+    {
+        time::Instant const timestamp = time::Instant::Now();
+
+        threading::CriticalSection::Lock lock{this->_lock};
+
+        CounterEvent* const e = this->_counter_events.Emplace(
+            category,
+            name,
+            timestamp,
+            impl::GetCurrentThreadId());
+
+        for (CounterValue const& value : values)
+        {
+            if (e->Count == e->Values.size())
+            {
+                break;
+            }
+
+            e->Values[e->Count++] = value;
+        }
+    }
+
+    void Profiler::RecordPageHeap()
+    {
+        memory::PageHeapStatistics statistics{};
+        memory::PageHeap::Get().QueryStatistics(statistics);
+
+        this->Counter("memory", "PageHeap",
+            {
+                {"allocated", static_cast<int64_t>(statistics.Allocated)},
+                {"free", static_cast<int64_t>(statistics.Free)},
+                {"reserved", static_cast<int64_t>(statistics.Reserved)},
+            });
+
+        this->Counter("memory", "PageHeapFragmentation",
+            {
+                {"free-frames", static_cast<int64_t>(statistics.FreeFrames)},
+                {"largest-free", static_cast<int64_t>(statistics.LargestFree)},
+                {"fragmentation-permille", static_cast<int64_t>(statistics.GetFragmentation() * 1000.0)},
+            });
+
+        this->Counter("memory", "PageHeapOperations",
+            {
+                {"allocations", static_cast<int64_t>(statistics.Allocations)},
+                {"deallocations", static_cast<int64_t>(statistics.Deallocations)},
+                {"huge-page-allocations", static_cast<int64_t>(statistics.HugePageAllocations)},
+            });
     }
 
     void Profiler::Serialize(filesystem::FileWriter& writer)
     {
+        threading::CriticalSection::Lock lock{this->_lock};
+
         (void)filesystem::Write(writer, R"__({ "traceEvents": [)__");
 
         fmt::memory_buffer buffer{};
@@ -75,6 +167,14 @@ namespace weave::profiler
                 return false;
             });
 
+        this->_counter_events.Enumerate([&](CounterEvent const* e)
+            {
+                buffer.clear();
+                impl::Serialize(buffer, *e);
+                (void)writer.Write(buffer.data(), buffer.size());
+                return false;
+            });
+
         (void)filesystem::Write(writer, R"__(] })__");
     }
 }
@@ -2,6 +2,10 @@
 #include "weave/time/Instant.hxx"
 #include "weave/memory/TypedLinearAllocator.hxx"
 #include "weave/filesystem/FileWriter.hxx"
+#include "weave/threading/CriticalSection.hxx"
+
+#include <array>
+#include <initializer_list>
 
 #include <fmt/format.h>
 
@@ -46,11 +50,33 @@ namespace weave::profiler
         }
     };
 
+    struct CounterValue final
+    {
+        const char* Name{};
+        int64_t Value{};
+    };
+
+    struct CounterEvent final : public Event
+    {
+        static constexpr size_t Capacity = 8;
+
+        std::array<CounterValue, Capacity> Values{};
+        size_t Count{};
+
+        CounterEvent(const char* category, const char* name, time::Instant const& timestamp, uintptr_t thread_id)
+            : Event{category, name, timestamp, thread_id}
+        {
+        }
+    };
+
     class Profiler
     {
     private:
+        // Events may be recorded concurrently by compiler worker threads.
+        threading::CriticalSection _lock{};
         memory::TypedLinearAllocator<InstantEvent> _events{};
         memory::TypedLinearAllocator<CompleteEvent> _complete_events{};
+        memory::TypedLinearAllocator<CounterEvent> _counter_events{};
 
     public:
         Profiler();
@@ -60,6 +86,14 @@ namespace weave::profiler
         void Stop(CompleteEvent* e);
         void Event(const char* category, const char* name);
 
+        /// \brief Records values of named counters, displayed as a graph in trace viewer.
+        ///
+        /// \note At most `CounterEvent::Capacity` values are recorded.
+        void Counter(const char* category, const char* name, std::initializer_list<CounterValue> values);
+
+        /// \brief Records statistics of process-wide page heap.
+        void RecordPageHeap();
+
     public:
         void Serialize(filesystem::FileWriter& writer);
     };
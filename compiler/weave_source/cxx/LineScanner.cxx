@@ -0,0 +1,261 @@
+#include "weave/source/LineScanner.hxx"
+#include "weave/bugcheck/Assert.hxx"
+#include "weave/platform/Compiler.hxx"
+
+#include <bit>
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#if defined(_M_AMD64) || defined(__x86_64__)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#define WEAVE_LINE_SCANNER_X64 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define WEAVE_LINE_SCANNER_NEON 1
+#endif
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WEAVE_LINE_SCANNER_TARGET_AVX2 __attribute__((__target__("avx2")))
+#else
+#define WEAVE_LINE_SCANNER_TARGET_AVX2
+#endif
+
+namespace weave::source::impl
+{
+    void ScanLineBreaksScalar(char const* first, char const* last, char const* origin, std::vector<uint32_t>& lines)
+    {
+        char const* it = first;
+
+        while (it < last)
+        {
+            if (*it == '\r')
+            {
+                ++it;
+
+                if ((it < last) and (*it == '\n'))
+                {
+                    ++it;
+
+                    // Matched '\r\n'
+                    lines.emplace_back(static_cast<uint32_t>(it - origin));
+                }
+            }
+            else if (*it == '\n')
+            {
+                ++it;
+
+                // Matched '\n'
+                lines.emplace_back(static_cast<uint32_t>(it - origin));
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Vector scanners look for '\n' only. Both '\r\n' and '\n' end with it, and isolated '\r' never starts a line, so
+    // this is equivalent to the scalar state machine. Blocks never split line breaks in a way which matters.
+
+    template <typename MaskT>
+    inline void EmitLineBreaks(MaskT mask, uint32_t offset, std::vector<uint32_t>& lines)
+    {
+        while (mask != 0)
+        {
+            lines.emplace_back(offset + static_cast<uint32_t>(std::countr_zero(mask)) + 1);
+            mask &= mask - 1;
+        }
+    }
+
+#if defined(WEAVE_LINE_SCANNER_X64)
+
+    void ScanLineBreaksSse2(char const* first, char const* last, std::vector<uint32_t>& lines)
+    {
+        constexpr size_t BlockSize = sizeof(__m128i);
+
+        __m128i const newline = _mm_set1_epi8('\n');
+
+        char const* it = first;
+
+        for (; (last - it) >= static_cast<ptrdiff_t>(BlockSize); it += BlockSize)
+        {
+            __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(it));
+            uint32_t const mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)));
+            EmitLineBreaks(mask, static_cast<uint32_t>(it - first), lines);
+        }
+
+        ScanLineBreaksScalar(it, last, first, lines);
+    }
+
+    WEAVE_LINE_SCANNER_TARGET_AVX2
+    void ScanLineBreaksAvx2(char const* first, char const* last, std::vector<uint32_t>& lines)
+    {
+        constexpr size_t BlockSize = sizeof(__m256i);
+
+        __m256i const newline = _mm256_set1_epi8('\n');
+
+        char const* it = first;
+
+        for (; (last - it) >= static_cast<ptrdiff_t>(BlockSize); it += BlockSize)
+        {
+            __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(it));
+            uint32_t const mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline)));
+            EmitLineBreaks(mask, static_cast<uint32_t>(it - first), lines);
+        }
+
+        ScanLineBreaksScalar(it, last, first, lines);
+    }
+
+    bool IsAvx2Supported()
+    {
+#if defined(_MSC_VER)
+        int registers[4]{};
+        __cpuid(registers, 0);
+
+        if (registers[0] < 7)
+        {
+            return false;
+        }
+
+        __cpuid(registers, 1);
+
+        // OS has to save YMM registers on context switch.
+        bool const osxsave = (registers[2] & (1 << 27)) != 0;
+
+        if (not osxsave or ((_xgetbv(0) & 0x6) != 0x6))
+        {
+            return false;
+        }
+
+        __cpuidex(registers, 7, 0);
+        return (registers[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+#endif
+
+#if defined(WEAVE_LINE_SCANNER_NEON)
+
+    void ScanLineBreaksNeon(char const* first, char const* last, std::vector<uint32_t>& lines)
+    {
+        constexpr size_t BlockSize = sizeof(uint8x16_t);
+
+        uint8x16_t const newline = vdupq_n_u8('\n');
+
+        char const* it = first;
+
+        for (; (last - it) >= static_cast<ptrdiff_t>(BlockSize); it += BlockSize)
+        {
+            uint8x16_t const block = vld1q_u8(reinterpret_cast<uint8_t const*>(it));
+            uint8x16_t const matched = vceqq_u8(block, newline);
+
+            // Narrow each byte of comparison result to 4 bits, so whole block fits in 64-bit mask.
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matched), 4)), 0);
+
+            uint32_t const offset = static_cast<uint32_t>(it - first);
+
+            while (mask != 0)
+            {
+                uint32_t const index = static_cast<uint32_t>(std::countr_zero(mask)) >> 2;
+                lines.emplace_back(offset + index + 1);
+                mask &= ~(uint64_t{0xF} << (index * 4));
+            }
+        }
+
+        ScanLineBreaksScalar(it, last, first, lines);
+    }
+
+#endif
+}
+
+namespace weave::source
+{
+    bool IsSupported(LineScannerKind kind)
+    {
+        switch (kind)
+        {
+        case LineScannerKind::Scalar:
+            return true;
+
+#if defined(WEAVE_LINE_SCANNER_X64)
+        case LineScannerKind::Sse2:
+            return true;
+
+        case LineScannerKind::Avx2:
+        {
+            static bool const supported = impl::IsAvx2Supported();
+            return supported;
+        }
+#endif
+
+#if defined(WEAVE_LINE_SCANNER_NEON)
+        case LineScannerKind::Neon:
+            return true;
+#endif
+
+        default:
+            return false;
+        }
+    }
+
+    LineScannerKind GetBestLineScanner()
+    {
+        static LineScannerKind const best = []
+        {
+            for (LineScannerKind const kind : {LineScannerKind::Avx2, LineScannerKind::Neon, LineScannerKind::Sse2})
+            {
+                if (IsSupported(kind))
+                {
+                    return kind;
+                }
+            }
+
+            return LineScannerKind::Scalar;
+        }();
+
+        return best;
+    }
+
+    void ScanLineBreaks(std::string_view content, std::vector<uint32_t>& lines)
+    {
+        ScanLineBreaks(content, lines, GetBestLineScanner());
+    }
+
+    void ScanLineBreaks(std::string_view content, std::vector<uint32_t>& lines, LineScannerKind kind)
+    {
+        WEAVE_ASSERT(IsSupported(kind));
+
+        char const* const first = content.data();
+        char const* const last = first + content.size();
+
+        switch (kind)
+        {
+#if defined(WEAVE_LINE_SCANNER_X64)
+        case LineScannerKind::Sse2:
+            impl::ScanLineBreaksSse2(first, last, lines);
+            break;
+
+        case LineScannerKind::Avx2:
+            impl::ScanLineBreaksAvx2(first, last, lines);
+            break;
+#endif
+
+#if defined(WEAVE_LINE_SCANNER_NEON)
+        case LineScannerKind::Neon:
+            impl::ScanLineBreaksNeon(first, last, lines);
+            break;
+#endif
+
+        default:
+            impl::ScanLineBreaksScalar(first, last, first, lines);
+            break;
+        }
+    }
+}
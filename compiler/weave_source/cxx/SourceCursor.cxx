@@ -3,10 +3,8 @@
 
 namespace weave::source
 {
-    void SourceCursor::Advance()
+    void SourceCursor::DecodeNext()
     {
-        this->_current = this->_next;
-
         if (unicode::Decode(this->_value, this->_next, this->_last) != unicode::ConversionResult::Success)
         {
             this->_value = Invalid;
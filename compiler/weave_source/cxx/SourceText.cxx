@@ -1,5 +1,5 @@
 #include "weave/source/SourceText.hxx"
-#include "weave/Unicode.hxx"
+#include "weave/source/LineScanner.hxx"
 #include "weave/bugcheck/Assert.hxx"
 
 namespace weave::source
@@ -7,52 +7,14 @@ namespace weave::source
     SourceText::SourceText(std::string&& content)
         : _content{std::move(content)}
     {
-        WEAVE_ASSERT(unicode::Validate(this->_content));
-
         // Even empty source has one line starting at '0'
         this->_lines.emplace_back(0);
 
-        if (size_t const length = this->_content.size(); length != 0)
-        {
-            const char* first = this->_content.data();
-            const char* last = first + length;
-
-            // Split lines by '\r\n' or '\n' only.
-            // Mac line ending (isolated CR) is treated as whitespace character.
-            // Unicode line endings are not supported.
-            // This matches lexer behavior.
-
-            const char* it = first;
-
-            while (it < last)
-            {
-                if (*it == '\r')
-                {
-                    ++it;
-
-                    if ((it < last) and (*it == '\n'))
-                    {
-                        ++it;
-
-                        // Matched '\r\n'
-                        this->_lines.emplace_back(static_cast<uint32_t>(it - first));
-                    }
-                }
-                else if (*it == '\n')
-                {
-                    ++it;
-
-                    // Matched '\n'
-                    this->_lines.emplace_back(static_cast<uint32_t>(it - first));
-                }
-                else
-                {
-                    ++it;
-                }
-            }
-
-            WEAVE_ASSERT(it == last);
-        }
+        // Split lines by '\r\n' or '\n' only.
+        // Mac line ending (isolated CR) is treated as whitespace character.
+        // Unicode line endings are not supported.
+        // This matches lexer behavior.
+        ScanLineBreaks(this->_content, this->_lines);
     }
 
     std::optional<SourceSpan> SourceText::GetLine(uint32_t index) const
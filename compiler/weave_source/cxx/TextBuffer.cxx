@@ -0,0 +1,474 @@
+#include "weave/source/TextBuffer.hxx"
+#include "weave/source/LineScanner.hxx"
+#include "weave/bugcheck/Assert.hxx"
+#include "weave/bugcheck/BugCheck.hxx"
+
+#include <algorithm>
+
+namespace weave::source
+{
+    TextBuffer::TextBuffer(std::string&& content)
+    {
+        WEAVE_ASSERT(content.size() < UINT32_MAX);
+
+        this->_original.Content = std::move(content);
+
+        // Lines are split in the same way as in source text.
+        ScanLineBreaks(this->_original.Content, this->_original.Lines);
+
+        if (not this->_original.Content.empty())
+        {
+            this->_root = this->CreatePiece(false, 0, static_cast<uint32_t>(this->_original.Content.size()));
+        }
+    }
+
+    uint32_t TextBuffer::CountLines(bool added, uint32_t start, uint32_t length) const
+    {
+        std::vector<uint32_t> const& lines = added ? this->_added.Lines : this->_original.Lines;
+
+        // Line starts are stored after line break, so line breaks of this range start in range (start, start + length].
+        auto const first = std::upper_bound(lines.begin(), lines.end(), start);
+        auto const last = std::upper_bound(first, lines.end(), start + length);
+        return static_cast<uint32_t>(last - first);
+    }
+
+    uint32_t TextBuffer::CreatePiece(bool added, uint32_t start, uint32_t length)
+    {
+        // Use xorshift to generate priorities; balance of the tree depends only on their distribution.
+        this->_seed ^= this->_seed << 13u;
+        this->_seed ^= this->_seed >> 17u;
+        this->_seed ^= this->_seed << 5u;
+
+        uint32_t const lines = this->CountLines(added, start, length);
+
+        Piece const piece{
+            .Left = Null,
+            .Right = Null,
+            .Priority = this->_seed,
+            .Added = added,
+            .Start = start,
+            .Length = length,
+            .Lines = lines,
+            .TotalLength = length,
+            .TotalLines = lines,
+        };
+
+        if (not this->_released.empty())
+        {
+            uint32_t const index = this->_released.back();
+            this->_released.pop_back();
+            this->_pieces[index] = piece;
+            return index;
+        }
+
+        this->_pieces.push_back(piece);
+        return static_cast<uint32_t>(this->_pieces.size() - 1);
+    }
+
+    void TextBuffer::ReleasePieces(uint32_t node)
+    {
+        if (node != Null)
+        {
+            this->ReleasePieces(this->_pieces[node].Left);
+            this->ReleasePieces(this->_pieces[node].Right);
+            this->_released.push_back(node);
+        }
+    }
+
+    void TextBuffer::Update(uint32_t node)
+    {
+        Piece& piece = this->_pieces[node];
+        piece.TotalLength = piece.Length;
+        piece.TotalLines = piece.Lines;
+
+        if (piece.Left != Null)
+        {
+            piece.TotalLength += this->_pieces[piece.Left].TotalLength;
+            piece.TotalLines += this->_pieces[piece.Left].TotalLines;
+        }
+
+        if (piece.Right != Null)
+        {
+            piece.TotalLength += this->_pieces[piece.Right].TotalLength;
+            piece.TotalLines += this->_pieces[piece.Right].TotalLines;
+        }
+    }
+
+    uint32_t TextBuffer::Merge(uint32_t left, uint32_t right)
+    {
+        if (left == Null)
+        {
+            return right;
+        }
+
+        if (right == Null)
+        {
+            return left;
+        }
+
+        if (this->_pieces[left].Priority > this->_pieces[right].Priority)
+        {
+            uint32_t const merged = this->Merge(this->_pieces[left].Right, right);
+            this->_pieces[left].Right = merged;
+            this->Update(left);
+            return left;
+        }
+
+        uint32_t const merged = this->Merge(left, this->_pieces[right].Left);
+        this->_pieces[right].Left = merged;
+        this->Update(right);
+        return right;
+    }
+
+    void TextBuffer::Split(uint32_t node, uint32_t offset, uint32_t& left, uint32_t& right)
+    {
+        // Note: pieces may be reallocated when a piece is split, so references to them are not kept across calls.
+
+        if (node == Null)
+        {
+            left = Null;
+            right = Null;
+            return;
+        }
+
+        uint32_t const child = this->_pieces[node].Left;
+        uint32_t const leftLength = (child != Null) ? this->_pieces[child].TotalLength : 0;
+        uint32_t const length = this->_pieces[node].Length;
+
+        if (offset <= leftLength)
+        {
+            uint32_t inner{};
+            this->Split(child, offset, left, inner);
+            this->_pieces[node].Left = inner;
+            this->Update(node);
+            right = node;
+        }
+        else if (offset >= (leftLength + length))
+        {
+            uint32_t inner{};
+            this->Split(this->_pieces[node].Right, offset - leftLength - length, inner, right);
+            this->_pieces[node].Right = inner;
+            this->Update(node);
+            left = node;
+        }
+        else
+        {
+            // Split point is inside of this piece.
+            uint32_t const local = offset - leftLength;
+
+            uint32_t const tail = this->CreatePiece(this->_pieces[node].Added, this->_pieces[node].Start + local, length - local);
+
+            Piece& piece = this->_pieces[node];
+            piece.Length = local;
+            piece.Lines = this->CountLines(piece.Added, piece.Start, local);
+
+            uint32_t const rest = piece.Right;
+            piece.Right = Null;
+            this->Update(node);
+
+            left = node;
+            right = this->Merge(tail, rest);
+        }
+    }
+
+    char TextBuffer::GetCharacter(uint32_t offset) const
+    {
+        uint32_t node = this->_root;
+
+        while (node != Null)
+        {
+            Piece const& piece = this->_pieces[node];
+            uint32_t const leftLength = (piece.Left != Null) ? this->_pieces[piece.Left].TotalLength : 0;
+
+            if (offset < leftLength)
+            {
+                node = piece.Left;
+            }
+            else if (offset < (leftLength + piece.Length))
+            {
+                return this->GetBuffer(piece).Content[piece.Start + offset - leftLength];
+            }
+            else
+            {
+                offset -= leftLength + piece.Length;
+                node = piece.Right;
+            }
+        }
+
+        WEAVE_BUGCHECK("Offset out of range");
+    }
+
+    void TextBuffer::AppendText(uint32_t node, uint32_t offset, uint32_t start, uint32_t end, std::string& result) const
+    {
+        if (node == Null)
+        {
+            return;
+        }
+
+        Piece const& piece = this->_pieces[node];
+        uint32_t const pieceStart = offset + ((piece.Left != Null) ? this->_pieces[piece.Left].TotalLength : 0);
+        uint32_t const pieceEnd = pieceStart + piece.Length;
+
+        if (start < pieceStart)
+        {
+            this->AppendText(piece.Left, offset, start, end, result);
+        }
+
+        uint32_t const first = std::max(start, pieceStart);
+        uint32_t const last = std::min(end, pieceEnd);
+
+        if (first < last)
+        {
+            result.append(this->GetBuffer(piece).Content, piece.Start + (first - pieceStart), last - first);
+        }
+
+        if (end > pieceEnd)
+        {
+            this->AppendText(piece.Right, pieceEnd, start, end, result);
+        }
+    }
+
+    void TextBuffer::ApplyEdit(SourceSpan const& span, std::string_view text)
+    {
+        uint32_t const start = span.Start.Offset;
+        uint32_t const end = span.End.Offset;
+
+        WEAVE_ASSERT(start <= end);
+        WEAVE_ASSERT(end <= this->GetLength());
+        WEAVE_ASSERT((this->_added.Content.size() + text.size()) < UINT32_MAX);
+
+        uint32_t left{};
+        uint32_t removed{};
+        uint32_t right{};
+        this->Split(this->_root, start, left, removed);
+        this->Split(removed, end - start, removed, right);
+        this->ReleasePieces(removed);
+
+        if (not text.empty())
+        {
+            uint32_t const offset = static_cast<uint32_t>(this->_added.Content.size());
+            this->_added.Content.append(text);
+
+            size_t const first = this->_added.Lines.size();
+            ScanLineBreaks(text, this->_added.Lines);
+
+            for (size_t i = first; i < this->_added.Lines.size(); ++i)
+            {
+                this->_added.Lines[i] += offset;
+            }
+
+            // Find last piece before the edit. When it ends where inserted text starts, as it does for consecutive
+            // typing, the piece is extended instead of creating new one.
+            std::vector<uint32_t> path{};
+
+            for (uint32_t node = left; node != Null; node = this->_pieces[node].Right)
+            {
+                path.push_back(node);
+            }
+
+            if ((not path.empty()) and this->_pieces[path.back()].Added and ((this->_pieces[path.back()].Start + this->_pieces[path.back()].Length) == offset))
+            {
+                Piece& piece = this->_pieces[path.back()];
+                piece.Length += static_cast<uint32_t>(text.size());
+                piece.Lines += static_cast<uint32_t>(this->_added.Lines.size() - first);
+
+                for (auto it = path.rbegin(); it != path.rend(); ++it)
+                {
+                    this->Update(*it);
+                }
+            }
+            else
+            {
+                left = this->Merge(left, this->CreatePiece(true, offset, static_cast<uint32_t>(text.size())));
+            }
+        }
+
+        this->_root = this->Merge(left, right);
+    }
+
+    uint32_t TextBuffer::GetLength() const
+    {
+        return (this->_root != Null) ? this->_pieces[this->_root].TotalLength : 0;
+    }
+
+    uint32_t TextBuffer::GetLineCount() const
+    {
+        // Even empty text has one line.
+        return ((this->_root != Null) ? this->_pieces[this->_root].TotalLines : 0) + 1;
+    }
+
+    uint32_t TextBuffer::GetLineStart(uint32_t index) const
+    {
+        WEAVE_ASSERT(index < this->GetLineCount());
+
+        uint32_t offset = 0;
+        uint32_t node = this->_root;
+
+        // Line with given index starts after line break with the same 1-based index.
+        while ((index != 0) and (node != Null))
+        {
+            Piece const& piece = this->_pieces[node];
+            uint32_t const leftLength = (piece.Left != Null) ? this->_pieces[piece.Left].TotalLength : 0;
+            uint32_t const leftLines = (piece.Left != Null) ? this->_pieces[piece.Left].TotalLines : 0;
+
+            if (index <= leftLines)
+            {
+                node = piece.Left;
+            }
+            else if (index <= (leftLines + piece.Lines))
+            {
+                std::vector<uint32_t> const& lines = this->GetBuffer(piece).Lines;
+                auto const first = std::upper_bound(lines.begin(), lines.end(), piece.Start);
+                uint32_t const start = *(first + (index - leftLines - 1));
+                return offset + leftLength + (start - piece.Start);
+            }
+            else
+            {
+                index -= leftLines + piece.Lines;
+                offset += leftLength + piece.Length;
+                node = piece.Right;
+            }
+        }
+
+        return offset;
+    }
+
+    std::optional<SourceSpan> TextBuffer::GetLine(uint32_t index) const
+    {
+        if (index < this->GetLineCount())
+        {
+            uint32_t const start = this->GetLineStart(index);
+
+            if (index == (this->GetLineCount() - 1u))
+            {
+                return SourceSpan{
+                    {start},
+                    {this->GetLength()},
+                };
+            }
+
+            return SourceSpan{
+                {start},
+                {this->GetLineStart(index + 1u)},
+            };
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<SourceSpan> TextBuffer::GetLineContent(uint32_t index) const
+    {
+        if (std::optional<SourceSpan> span = this->GetLine(index); span.has_value())
+        {
+            if (index != (this->GetLineCount() - 1u))
+            {
+                // Every line except the last one ends with '\n', optionally preceded by '\r'.
+                uint32_t end = span->End.Offset - 1u;
+
+                if ((end > span->Start.Offset) and (this->GetCharacter(end - 1u) == '\r'))
+                {
+                    --end;
+                }
+
+                span->End.Offset = end;
+            }
+
+            return span;
+        }
+
+        return std::nullopt;
+    }
+
+    std::string TextBuffer::GetLineText(uint32_t index) const
+    {
+        if (std::optional<SourceSpan> const& span = this->GetLine(index); span.has_value())
+        {
+            return this->GetText(*span);
+        }
+
+        return std::string{};
+    }
+
+    std::string TextBuffer::GetLineContentText(uint32_t index) const
+    {
+        if (std::optional<SourceSpan> const& span = this->GetLineContent(index); span.has_value())
+        {
+            return this->GetText(*span);
+        }
+
+        return std::string{};
+    }
+
+    LinePosition TextBuffer::GetLinePosition(SourcePosition const& position) const
+    {
+        uint32_t const index = this->GetLineIndex(position.Offset);
+        uint32_t const start = this->GetLineStart(index);
+
+        return LinePosition{
+            .Line = index,
+            .Column = position.Offset - start,
+        };
+    }
+
+    LineSpan TextBuffer::GetLineSpan(SourceSpan const& span) const
+    {
+        return LineSpan{
+            this->GetLinePosition(span.Start),
+            this->GetLinePosition(span.End),
+        };
+    }
+
+    std::string TextBuffer::GetText(SourceSpan const& span) const
+    {
+        uint32_t const start = span.Start.Offset;
+        uint32_t const end = span.End.Offset;
+
+        WEAVE_ASSERT(start <= end);
+
+        std::string result{};
+
+        if (start < end)
+        {
+            result.reserve(end - start);
+            this->AppendText(this->_root, 0, start, end, result);
+        }
+
+        return result;
+    }
+
+    uint32_t TextBuffer::GetLineIndex(uint32_t position) const
+    {
+        // Count line starts up to the position, matching lookup in source text.
+        uint32_t result = 0;
+        uint32_t node = this->_root;
+
+        while (node != Null)
+        {
+            Piece const& piece = this->_pieces[node];
+            uint32_t const leftLength = (piece.Left != Null) ? this->_pieces[piece.Left].TotalLength : 0;
+            uint32_t const leftLines = (piece.Left != Null) ? this->_pieces[piece.Left].TotalLines : 0;
+
+            if (position < leftLength)
+            {
+                node = piece.Left;
+            }
+            else if (position <= (leftLength + piece.Length))
+            {
+                return result + leftLines + this->CountLines(piece.Added, piece.Start, position - leftLength);
+            }
+            else
+            {
+                result += leftLines + piece.Lines;
+                position -= leftLength + piece.Length;
+                node = piece.Right;
+            }
+        }
+
+        return result;
+    }
+
+    std::string TextBuffer::GetContent() const
+    {
+        return this->GetText(SourceSpan{{0}, {this->GetLength()}});
+    }
+}
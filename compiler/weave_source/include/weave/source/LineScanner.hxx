@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace weave::source
+{
+    enum class LineScannerKind
+    {
+        Scalar,
+        Sse2,
+        Avx2,
+        Neon,
+    };
+
+    /// \brief Checks whether the current processor supports given scanner.
+    [[nodiscard]] bool IsSupported(LineScannerKind kind);
+
+    /// \brief Gets the fastest scanner supported by the current processor.
+    [[nodiscard]] LineScannerKind GetBestLineScanner();
+
+    /// \brief Appends offsets of line starts following each line break in content.
+    ///
+    /// \details Lines are split by '\r\n' or '\n' only. Isolated '\r' is treated as whitespace character, which means
+    ///          that each line starts right after a '\n' character. This matches lexer behavior.
+    void ScanLineBreaks(std::string_view content, std::vector<uint32_t>& lines);
+
+    /// \brief Appends offsets of line starts using specific scanner.
+    ///
+    /// \note Scanner must be supported by the current processor.
+    void ScanLineBreaks(std::string_view content, std::vector<uint32_t>& lines, LineScannerKind kind);
+}
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <utility>
 #include <algorithm>
+#include <string_view>
 
 namespace weave::source
 {
@@ -68,6 +69,13 @@ namespace weave::source
         }
     };
 
+    /// \brief Replacement of text in the span with new text.
+    struct TextChange final
+    {
+        SourceSpan Span;
+        std::string_view NewText;
+    };
+
     [[nodiscard]] constexpr bool Disjoint(SourceSpan const& self, SourceSpan const& other)
     {
         uint32_t const min_end = std::min(self.End.Offset, other.End.Offset);
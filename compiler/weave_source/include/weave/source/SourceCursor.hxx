@@ -20,6 +20,9 @@ namespace weave::source
     private:
         static constexpr char32_t Invalid = std::numeric_limits<char32_t>::max();
 
+    private:
+        void DecodeNext();
+
     public:
         explicit SourceCursor(std::string_view v)
             : _current{v.data()}
@@ -117,7 +120,45 @@ namespace weave::source
             return cursor;
         }
 
-        void Advance();
+        void Advance()
+        {
+            this->_current = this->_next;
+
+            // Fast path for ASCII characters; multibyte sequences are decoded out of line.
+            if ((this->_next != this->_last) and (static_cast<unsigned char>(*this->_next) < 0x80u))
+            {
+                this->_value = static_cast<char32_t>(*this->_next++);
+            }
+            else
+            {
+                this->DecodeNext();
+            }
+        }
+
+        /// \brief Skips run of ASCII characters matching predicate, without decoding them.
+        ///
+        /// \param predicate The byte predicate. It is called for ASCII characters only.
+        ///
+        /// \return The skipped characters.
+        template <typename PredicateT>
+        std::string_view ConsumeAscii(PredicateT&& predicate)
+        {
+            const char* const start = this->_current;
+            const char* it = start;
+
+            while ((it != this->_last) and (static_cast<unsigned char>(*it) < 0x80u) and predicate(*it))
+            {
+                ++it;
+            }
+
+            if (it != start)
+            {
+                this->_next = it;
+                this->Advance();
+            }
+
+            return std::string_view{start, it};
+        }
 
         [[nodiscard]] bool StartsWith(std::u32string_view n)
         {
@@ -0,0 +1,123 @@
+#pragma once
+#include "weave/source/Source.hxx"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace weave::source
+{
+    /// \brief Mutable source text for editing.
+    ///
+    /// \details Text is stored as a piece table: original content and append-only buffer of inserted text, referenced
+    ///          by pieces kept in a balanced tree ordered by position. Each tree node caches length and number of line
+    ///          breaks of its subtree, so both edits and line lookups cost O(log n) in number of pieces, plus size of
+    ///          the inserted text.
+    ///
+    ///          Lines are split the same way as in `SourceText`.
+    class TextBuffer final
+    {
+    private:
+        static constexpr uint32_t Null = UINT32_MAX;
+
+        struct Piece final
+        {
+            uint32_t Left;
+            uint32_t Right;
+            uint32_t Priority;
+
+            // Range of text in one of the buffers.
+            bool Added;
+            uint32_t Start;
+            uint32_t Length;
+
+            // Number of line breaks in the piece.
+            uint32_t Lines;
+
+            // Cached totals of the subtree.
+            uint32_t TotalLength;
+            uint32_t TotalLines;
+        };
+
+        struct Buffer final
+        {
+            std::string Content{};
+
+            // Offsets of line starts following each line break in content.
+            std::vector<uint32_t> Lines{};
+        };
+
+    private:
+        Buffer _original{};
+        Buffer _added{};
+
+        std::vector<Piece> _pieces{};
+        std::vector<uint32_t> _released{};
+        uint32_t _root{Null};
+        uint32_t _seed{0x9e3779b9u};
+
+    public:
+        explicit TextBuffer(std::string&& content);
+
+    private:
+        [[nodiscard]] Buffer const& GetBuffer(Piece const& piece) const
+        {
+            return piece.Added ? this->_added : this->_original;
+        }
+
+        [[nodiscard]] uint32_t CountLines(bool added, uint32_t start, uint32_t length) const;
+
+        [[nodiscard]] uint32_t CreatePiece(bool added, uint32_t start, uint32_t length);
+
+        void ReleasePieces(uint32_t node);
+
+        void Update(uint32_t node);
+
+        [[nodiscard]] uint32_t Merge(uint32_t left, uint32_t right);
+
+        void Split(uint32_t node, uint32_t offset, uint32_t& left, uint32_t& right);
+
+        [[nodiscard]] char GetCharacter(uint32_t offset) const;
+
+        void AppendText(uint32_t node, uint32_t offset, uint32_t start, uint32_t end, std::string& result) const;
+
+    public:
+        /// \brief Replaces text in the span with new text.
+        void ApplyEdit(SourceSpan const& span, std::string_view text);
+
+        [[nodiscard]] uint32_t GetLength() const;
+
+        [[nodiscard]] uint32_t GetLineCount() const;
+
+        /// \brief Gets number of pieces referencing text buffers.
+        [[nodiscard]] size_t GetPieceCount() const
+        {
+            return this->_pieces.size() - this->_released.size();
+        }
+
+        [[nodiscard]] uint32_t GetLineStart(uint32_t index) const;
+
+        [[nodiscard]] std::optional<SourceSpan> GetLine(uint32_t index) const;
+
+        [[nodiscard]] std::optional<SourceSpan> GetLineContent(uint32_t index) const;
+
+        [[nodiscard]] std::string GetLineText(uint32_t index) const;
+
+        [[nodiscard]] std::string GetLineContentText(uint32_t index) const;
+
+        [[nodiscard]] LinePosition GetLinePosition(SourcePosition const& position) const;
+
+        [[nodiscard]] LineSpan GetLineSpan(SourceSpan const& span) const;
+
+        /// \brief Gets text of the span.
+        ///
+        /// \note Text may be stored in many pieces, so it is copied instead of returning view.
+        [[nodiscard]] std::string GetText(SourceSpan const& span) const;
+
+        [[nodiscard]] uint32_t GetLineIndex(uint32_t position) const;
+
+        /// \brief Gets whole content of the buffer.
+        [[nodiscard]] std::string GetContent() const;
+    };
+}
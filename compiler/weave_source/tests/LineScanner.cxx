@@ -0,0 +1,158 @@
+#include "weave/platform/Compiler.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "weave/source/LineScanner.hxx"
+
+#include <random>
+
+namespace
+{
+    constexpr weave::source::LineScannerKind AllLineScanners[]{
+        weave::source::LineScannerKind::Scalar,
+        weave::source::LineScannerKind::Sse2,
+        weave::source::LineScannerKind::Avx2,
+        weave::source::LineScannerKind::Neon,
+    };
+
+    constexpr std::string_view GetName(weave::source::LineScannerKind kind)
+    {
+        switch (kind)
+        {
+        case weave::source::LineScannerKind::Scalar:
+            return "scalar";
+        case weave::source::LineScannerKind::Sse2:
+            return "sse2";
+        case weave::source::LineScannerKind::Avx2:
+            return "avx2";
+        case weave::source::LineScannerKind::Neon:
+            return "neon";
+        }
+
+        return "unknown";
+    }
+
+    std::string GenerateText(std::mt19937& random, size_t length)
+    {
+        // Line breaks are overrepresented to hit block boundaries often.
+        constexpr std::string_view alphabet = "\r\n\r\nab \t\xC5\xBC";
+
+        std::uniform_int_distribution<size_t> distribution{0, alphabet.size() - 1};
+
+        std::string result{};
+        result.reserve(length);
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            result.push_back(alphabet[distribution(random)]);
+        }
+
+        return result;
+    }
+
+    std::vector<uint32_t> Scan(std::string_view content, weave::source::LineScannerKind kind)
+    {
+        std::vector<uint32_t> result{};
+        weave::source::ScanLineBreaks(content, result, kind);
+        return result;
+    }
+}
+
+TEST_CASE("Line Scanner - fixed inputs")
+{
+    using namespace weave::source;
+
+    for (LineScannerKind const kind : AllLineScanners)
+    {
+        if (not IsSupported(kind))
+        {
+            continue;
+        }
+
+        CAPTURE(GetName(kind));
+
+        CHECK(Scan("", kind).empty());
+        CHECK(Scan("\r", kind).empty());
+        CHECK(Scan("\n", kind) == std::vector<uint32_t>{1});
+        CHECK(Scan("\r\n", kind) == std::vector<uint32_t>{2});
+        CHECK(Scan("\n\r", kind) == std::vector<uint32_t>{1});
+        CHECK(Scan("a\rb\r\nc\nd", kind) == std::vector<uint32_t>{5, 7});
+
+        // Line break split across vector block boundary.
+        std::string text(31, 'x');
+        text += "\r\n";
+        text += std::string(14, 'y');
+        text += "\r\n";
+        CHECK(Scan(text, kind) == std::vector<uint32_t>{33, 49});
+    }
+}
+
+TEST_CASE("Line Scanner - matches scalar implementation")
+{
+    using namespace weave::source;
+
+    std::mt19937 random{2137};
+
+    for (size_t length = 0; length < 300; ++length)
+    {
+        std::string const buffer = GenerateText(random, length + 64);
+
+        // Check all alignments of the input.
+        for (size_t offset = 0; offset < 64; offset += 7)
+        {
+            std::string_view const text = std::string_view{buffer}.substr(offset, length);
+            std::vector<uint32_t> const expected = Scan(text, LineScannerKind::Scalar);
+
+            for (LineScannerKind const kind : AllLineScanners)
+            {
+                if (IsSupported(kind))
+                {
+                    CAPTURE(GetName(kind), length, offset);
+                    REQUIRE(Scan(text, kind) == expected);
+                }
+            }
+        }
+    }
+
+    REQUIRE(IsSupported(GetBestLineScanner()));
+}
+
+TEST_CASE("Line Scanner - throughput", "[.benchmark]")
+{
+    using namespace weave::source;
+
+    std::mt19937 random{2137};
+
+    // Realistic source: lines of about 40 characters.
+    std::string text{};
+
+    while (text.size() < (16u << 20u))
+    {
+        std::string line = GenerateText(random, 40);
+        std::erase_if(line, [](char c)
+            {
+                return (c == '\r') or (c == '\n');
+            });
+        text += line;
+        text += "\r\n";
+    }
+
+    for (LineScannerKind const kind : AllLineScanners)
+    {
+        if (not IsSupported(kind))
+        {
+            continue;
+        }
+
+        BENCHMARK(std::string{"16 MiB, "} + std::string{GetName(kind)})
+        {
+            std::vector<uint32_t> lines{};
+            ScanLineBreaks(text, lines, kind);
+            return lines.size();
+        };
+    }
+}
@@ -0,0 +1,214 @@
+#include "weave/platform/Compiler.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "weave/source/SourceText.hxx"
+#include "weave/source/TextBuffer.hxx"
+
+#include <array>
+#include <random>
+
+namespace
+{
+    // Fragments inserted by random edits, with all kinds of line breaks.
+    constexpr std::array<std::string_view, 10> Fragments{
+        "",
+        "a",
+        "\n",
+        "\r",
+        "\r\n",
+        "text\n",
+        "\n\n\n",
+        "line\r\nline\r\n",
+        "var x = 42;",
+        "\r\r\n\n\r",
+    };
+
+    void RequireSameText(weave::source::TextBuffer const& buffer, weave::source::SourceText const& text, std::mt19937& random)
+    {
+        using namespace weave::source;
+
+        REQUIRE(buffer.GetContent() == text.GetContentView());
+        REQUIRE(buffer.GetLength() == text.GetContentView().size());
+        REQUIRE(buffer.GetLineCount() == text.GetLines().size());
+
+        for (uint32_t i = 0; i <= buffer.GetLineCount(); ++i)
+        {
+            REQUIRE(buffer.GetLine(i) == text.GetLine(i));
+            REQUIRE(buffer.GetLineContent(i) == text.GetLineContent(i));
+            REQUIRE(buffer.GetLineContentText(i) == text.GetLineContentText(i));
+        }
+
+        for (uint32_t offset = 0; offset <= buffer.GetLength(); ++offset)
+        {
+            REQUIRE(buffer.GetLinePosition({offset}) == text.GetLinePosition({offset}));
+        }
+
+        for (size_t i = 0; i < 16; ++i)
+        {
+            uint32_t const start = std::uniform_int_distribution<uint32_t>{0, buffer.GetLength()}(random);
+            uint32_t const end = std::uniform_int_distribution<uint32_t>{start, buffer.GetLength()}(random);
+            SourceSpan const span{{start}, {end}};
+
+            REQUIRE(buffer.GetText(span) == text.GetText(span));
+            REQUIRE(buffer.GetLineSpan(span) == text.GetLineSpan(span));
+        }
+    }
+
+    std::string GenerateSource(size_t size)
+    {
+        std::string result{};
+        result.reserve(size + 64);
+
+        for (size_t i = 0; result.size() < size; ++i)
+        {
+            result += "    var value" + std::to_string(i) + " = [a, b, c] as int32;\n";
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE("Text Buffer")
+{
+    using namespace weave::source;
+
+    SECTION("Empty text")
+    {
+        TextBuffer const buffer{""};
+        REQUIRE(buffer.GetLength() == 0);
+        REQUIRE(buffer.GetLineCount() == 1);
+        REQUIRE(buffer.GetLine(0) == SourceSpan{{0}, {0}});
+        REQUIRE_FALSE(buffer.GetLine(1).has_value());
+        REQUIRE(buffer.GetLinePosition({0}) == LinePosition{0, 0});
+        REQUIRE(buffer.GetContent().empty());
+    }
+
+    SECTION("Edits")
+    {
+        TextBuffer buffer{"first\nsecond\r\nthird"};
+        REQUIRE(buffer.GetLineCount() == 3);
+        REQUIRE(buffer.GetLineContentText(1) == "second");
+
+        // Insert line inside of the second line.
+        buffer.ApplyEdit({{9}, {9}}, "-inserted\n");
+        REQUIRE(buffer.GetContent() == "first\nsec-inserted\nond\r\nthird");
+        REQUIRE(buffer.GetLineCount() == 4);
+        REQUIRE(buffer.GetLineContentText(1) == "sec-inserted");
+        REQUIRE(buffer.GetLineContentText(2) == "ond");
+        REQUIRE(buffer.GetLinePosition({22}) == LinePosition{2, 3});
+        REQUIRE(buffer.GetLineSpan({{0}, {27}}) == LineSpan{{0, 0}, {3, 3}});
+
+        // Remove line breaks spanning over many pieces.
+        buffer.ApplyEdit({{3}, {22}}, "");
+        REQUIRE(buffer.GetContent() == "fir\r\nthird");
+        REQUIRE(buffer.GetLineCount() == 2);
+        REQUIRE(buffer.GetLineContentText(0) == "fir");
+        REQUIRE(buffer.GetText({{2}, {7}}) == "r\r\nth");
+
+        // Replace everything.
+        buffer.ApplyEdit({{0}, {buffer.GetLength()}}, "replaced");
+        REQUIRE(buffer.GetContent() == "replaced");
+        REQUIRE(buffer.GetLineCount() == 1);
+    }
+
+    SECTION("Consecutive typing extends single piece")
+    {
+        TextBuffer buffer{"function f() { }\n"};
+
+        uint32_t offset = 15;
+
+        for (char const c : std::string_view{"return 42;\n"})
+        {
+            buffer.ApplyEdit({{offset}, {offset}}, std::string_view{&c, 1});
+            ++offset;
+        }
+
+        REQUIRE(buffer.GetContent() == "function f() { return 42;\n}\n");
+        REQUIRE(buffer.GetPieceCount() == 3);
+        REQUIRE(buffer.GetLineCount() == 3);
+    }
+}
+
+TEST_CASE("Text Buffer - random edits match source text")
+{
+    using namespace weave::source;
+
+    std::mt19937 random{0x7e47};
+
+    for (size_t sequence = 0; sequence < 8; ++sequence)
+    {
+        std::string content = GenerateSource(256);
+        TextBuffer buffer{std::string{content}};
+
+        for (size_t step = 0; step < 200; ++step)
+        {
+            uint32_t const start = std::uniform_int_distribution<uint32_t>{0, static_cast<uint32_t>(content.size())}(random);
+            uint32_t const length = std::min<uint32_t>(std::uniform_int_distribution<uint32_t>{0, 16}(random), static_cast<uint32_t>(content.size()) - start);
+            std::string_view const fragment = Fragments[std::uniform_int_distribution<size_t>{0, Fragments.size() - 1}(random)];
+
+            content.replace(start, length, fragment);
+            buffer.ApplyEdit({{start}, {start + length}}, fragment);
+
+            if ((step % 10) == 0)
+            {
+                RequireSameText(buffer, SourceText{std::string{content}}, random);
+            }
+        }
+
+        RequireSameText(buffer, SourceText{std::string{content}}, random);
+    }
+}
+
+TEST_CASE("Text Buffer - edits", "[.benchmark]")
+{
+    using namespace weave::source;
+
+    std::string const content = GenerateSource(10u << 20u);
+    uint32_t const size = static_cast<uint32_t>(content.size());
+
+    // Offsets are generated ahead, so both benchmarks do the same edits.
+    std::mt19937 random{2137};
+    std::vector<uint32_t> offsets{};
+
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        offsets.push_back(std::uniform_int_distribution<uint32_t>{0, size - 16}(random));
+    }
+
+    BENCHMARK("10 MiB, 5000 edits, text buffer")
+    {
+        TextBuffer buffer{std::string{content}};
+
+        uint32_t line = 0;
+
+        for (uint32_t const offset : offsets)
+        {
+            buffer.ApplyEdit({{offset}, {offset + 8}}, "edit\nof text");
+            line += buffer.GetLinePosition({offset}).Line;
+        }
+
+        return line;
+    };
+
+    BENCHMARK("10 MiB, 50 edits, source text")
+    {
+        std::string text{content};
+
+        uint32_t line = 0;
+
+        // Each edit rebuilds whole line index.
+        for (size_t i = 0; i < 50; ++i)
+        {
+            text.replace(offsets[i], 8, "edit\nof text");
+            SourceText const source{std::string{text}};
+            line += source.GetLinePosition({offsets[i]}).Line;
+        }
+
+        return line;
+    };
+}
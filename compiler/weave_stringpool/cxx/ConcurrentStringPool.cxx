@@ -0,0 +1,196 @@
+#include "weave/stringpool/ConcurrentStringPool.hxx"
+#include "weave/hash/WyHash.hxx"
+
+#include <cstring>
+
+namespace weave::stringpool
+{
+    ConcurrentStringPool::ConcurrentStringPool()
+        : _shards{std::make_unique<Shard[]>(ShardCount)}
+    {
+        for (size_t i = 0; i < ShardCount; ++i)
+        {
+            Shard& shard = this->_shards[i];
+
+            auto table = std::make_unique<Table>();
+            table->Mask = InitialTableCapacity - 1;
+            table->Slots = std::make_unique<std::atomic<Entry*>[]>(InitialTableCapacity);
+
+            shard.Current.store(table.get(), std::memory_order_relaxed);
+            shard.Tables.push_back(std::move(table));
+        }
+    }
+
+    ConcurrentStringPool::~ConcurrentStringPool()
+    {
+        memory::ThreadLocalRegistry::Entry* entry = this->_arenas.GetFirst();
+
+        while (entry != nullptr)
+        {
+            memory::ThreadLocalRegistry::Entry* const next = entry->Next;
+            delete static_cast<Arena*>(entry);
+            entry = next;
+        }
+    }
+
+    ConcurrentStringPool::Entry* ConcurrentStringPool::TryFind(Table const& table, uint64_t hash, std::string_view value)
+    {
+        for (size_t index = hash & table.Mask;; index = (index + 1) & table.Mask)
+        {
+            // Pairs with release store in `Insert` - entry is fully constructed when visible.
+            Entry* const entry = table.Slots[index].load(std::memory_order_acquire);
+
+            if (entry == nullptr)
+            {
+                return nullptr;
+            }
+
+            if ((entry->Hash == hash) and (entry->Value == value))
+            {
+                return entry;
+            }
+        }
+    }
+
+    void ConcurrentStringPool::Insert(Table& table, Entry* entry)
+    {
+        size_t index = entry->Hash & table.Mask;
+
+        while (table.Slots[index].load(std::memory_order_relaxed) != nullptr)
+        {
+            index = (index + 1) & table.Mask;
+        }
+
+        table.Slots[index].store(entry, std::memory_order_release);
+    }
+
+    void ConcurrentStringPool::Grow(Shard& shard)
+    {
+        Table const& current = *shard.Current.load(std::memory_order_relaxed);
+        size_t const capacity = (current.Mask + 1) * 2;
+
+        auto table = std::make_unique<Table>();
+        table->Mask = capacity - 1;
+        table->Slots = std::make_unique<std::atomic<Entry*>[]>(capacity);
+
+        for (size_t i = 0; i <= current.Mask; ++i)
+        {
+            if (Entry* const entry = current.Slots[i].load(std::memory_order_relaxed); entry != nullptr)
+            {
+                Insert(*table, entry);
+            }
+        }
+
+        // Readers still using old table either find the string there, or fall back to the locked path.
+        shard.Current.store(table.get(), std::memory_order_release);
+        shard.Tables.push_back(std::move(table));
+    }
+
+    ConcurrentStringPool::Arena& ConcurrentStringPool::GetThreadArena()
+    {
+        if (memory::ThreadLocalRegistry::Entry* const entry = this->_arenas.Find(); entry != nullptr)
+        {
+            return *static_cast<Arena*>(entry);
+        }
+
+        static memory::MemoryArena& storage = memory::MemoryAccounting::GetArena("stringpool.concurrent");
+
+        Arena* const arena = new Arena{};
+        arena->Storage.SetArena(&storage);
+        this->_arenas.Register(arena);
+        return *arena;
+    }
+
+    std::string_view ConcurrentStringPool::Get(std::string_view value)
+    {
+        uint64_t const hash = hash::WyHash64::FromString(value);
+
+        Shard& shard = this->_shards[hash >> (64 - ShardCountBits)];
+
+        if (Entry const* const entry = TryFind(*shard.Current.load(std::memory_order_acquire), hash, value); entry != nullptr)
+        {
+            return entry->Value;
+        }
+
+        threading::CriticalSection::Lock lock{shard.Lock};
+
+        // String might have been inserted by other thread since the lookup.
+        Table* table = shard.Current.load(std::memory_order_relaxed);
+
+        if (Entry const* const entry = TryFind(*table, hash, value); entry != nullptr)
+        {
+            return entry->Value;
+        }
+
+        size_t const count = shard.Count.load(std::memory_order_relaxed) + 1;
+
+        // Keep load factor below 1/2, so probe sequences stay short.
+        if ((count * 2) > (table->Mask + 1))
+        {
+            this->Grow(shard);
+            table = shard.Current.load(std::memory_order_relaxed);
+        }
+
+        Arena& arena = this->GetThreadArena();
+
+        char* const buffer = reinterpret_cast<char*>(arena.Storage.Allocate(memory::Layout{value.length() + 1, alignof(char)}).Address);
+        std::memcpy(buffer, value.data(), value.length());
+        buffer[value.length()] = '\0';
+
+        Entry* const entry = arena.Storage.Emplace<Entry>(std::string_view{buffer, value.length()}, hash);
+
+        Insert(*table, entry);
+        shard.Count.store(count, std::memory_order_relaxed);
+
+        return entry->Value;
+    }
+
+    size_t ConcurrentStringPool::GetCount() const
+    {
+        size_t result = 0;
+
+        for (size_t i = 0; i < ShardCount; ++i)
+        {
+            result += this->_shards[i].Count.load(std::memory_order_relaxed);
+        }
+
+        return result;
+    }
+
+    void ConcurrentStringPool::QueryMemoryUsage(size_t& allocated, size_t& reserved) const
+    {
+        for (size_t i = 0; i < ShardCount; ++i)
+        {
+            for (std::unique_ptr<Table> const& table : this->_shards[i].Tables)
+            {
+                size_t const size = (table->Mask + 1) * sizeof(std::atomic<Entry*>);
+                allocated += size;
+                reserved += size;
+            }
+        }
+
+        for (memory::ThreadLocalRegistry::Entry const* entry = this->_arenas.GetFirst(); entry != nullptr; entry = entry->Next)
+        {
+            static_cast<Arena const*>(entry)->Storage.QueryMemoryUsage(allocated, reserved);
+        }
+    }
+
+    void ConcurrentStringPool::Enumerate(void* context, bool (*callback)(void*, std::string_view)) const
+    {
+        for (size_t i = 0; i < ShardCount; ++i)
+        {
+            Table const& table = *this->_shards[i].Current.load(std::memory_order_acquire);
+
+            for (size_t j = 0; j <= table.Mask; ++j)
+            {
+                if (Entry const* const entry = table.Slots[j].load(std::memory_order_acquire); entry != nullptr)
+                {
+                    if (callback(context, entry->Value))
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -1,10 +1,22 @@
 #include "weave/stringpool/StringPool.hxx"
-#include "weave/hash/Fnv1a.hxx"
+#include "weave/hash/WyHash.hxx"
+#include "weave/bugcheck/Assert.hxx"
 
 #include <fmt/format.h>
 
+#include <limits>
+
 namespace weave::stringpool
 {
+    StringPool::StringPool()
+    {
+        static memory::MemoryArena& storage = memory::MemoryAccounting::GetArena("stringpool.storage");
+        static memory::MemoryArena& entries = memory::MemoryAccounting::GetArena("stringpool.entries");
+
+        this->_storage.SetArena(&storage);
+        this->_entries.SetArena(&entries);
+    }
+
     std::string_view StringPool::Intern(std::string_view value)
     {
         char* buffer = reinterpret_cast<char*>(this->_storage.Allocate(memory::Layout{value.length() + 1, alignof(char)}).Address);
@@ -59,14 +71,14 @@ namespace weave::stringpool
         this->_mapping = std::move(mapping);
     }
 
-    std::string_view StringPool::Get(std::string_view value)
+    StringPool::Entry const& StringPool::GetEntry(std::string_view value)
     {
         if (this->_count >= (this->_mapping.size() * RehashFactor))
         {
             this->Rehash();
         }
 
-        uint64_t const hash = hash::Fnv1a64::FromString(value);
+        uint64_t const hash = hash::WyHash64::FromString(value);
 
         size_t chain_length{};
 
@@ -74,15 +86,35 @@ namespace weave::stringpool
 
         if (*entry == nullptr)
         {
+            WEAVE_ASSERT(this->_symbols.size() < std::numeric_limits<uint32_t>::max());
+
             // Entry doesn't exist, create a new one.
             *entry = this->_entries.Emplace(
                 nullptr,
                 this->Intern(value),
-                hash);
+                hash,
+                static_cast<SymbolId>(this->_symbols.size() + 1));
             ++this->_count;
+
+            this->_symbols.push_back(*entry);
+        }
+
+        return **entry;
+    }
+
+    std::string_view StringPool::Get(std::string_view value)
+    {
+        return this->GetEntry(value).Value;
+    }
+
+    SymbolId StringPool::GetSymbol(std::string_view value)
+    {
+        if (value.empty())
+        {
+            return SymbolId::None;
         }
 
-        return (*entry)->Value;
+        return this->GetEntry(value).Id;
     }
 
     void StringPool::Dump() const
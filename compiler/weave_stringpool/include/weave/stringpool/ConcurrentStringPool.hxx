@@ -0,0 +1,104 @@
+#pragma once
+#include "weave/memory/LinearAllocator.hxx"
+#include "weave/memory/ThreadLocalRegistry.hxx"
+#include "weave/threading/CriticalSection.hxx"
+
+#include <atomic>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace weave::stringpool
+{
+    /// \brief String pool shared by multiple threads.
+    ///
+    /// \details Strings are distributed between independent shards by hash. Each shard is an open addressing table
+    ///          of atomic entry pointers, so lookup of already interned string takes no lock. Inserting a new string
+    ///          locks only the owning shard. Shards grow independently; old tables are retired, not freed, so readers
+    ///          never observe released memory.
+    ///
+    ///          String bytes are allocated from per-thread arenas owned by the pool, so allocation never contends
+    ///          with other threads.
+    ///
+    ///          Interned strings are valid until the pool is destroyed and may be compared by address.
+    class ConcurrentStringPool final
+    {
+    private:
+        static constexpr size_t CacheLineSize = 64;
+        static constexpr size_t ShardCountBits = 6;
+        static constexpr size_t ShardCount = size_t{1} << ShardCountBits;
+        static constexpr size_t InitialTableCapacity = 256;
+
+        struct Entry final
+        {
+            std::string_view Value{};
+            uint64_t Hash{};
+        };
+
+        struct Table final
+        {
+            size_t Mask{};
+            std::unique_ptr<std::atomic<Entry*>[]> Slots{};
+        };
+
+        struct alignas(CacheLineSize) Shard final
+        {
+            std::atomic<Table*> Current{};
+            std::atomic<size_t> Count{};
+            threading::CriticalSection Lock{};
+
+            // Current table and all tables retired by growing the shard.
+            std::vector<std::unique_ptr<Table>> Tables{};
+        };
+
+        // Storage used by single thread.
+        struct Arena final : memory::ThreadLocalRegistry::Entry
+        {
+            memory::LinearAllocator Storage{};
+        };
+
+    private:
+        std::unique_ptr<Shard[]> _shards{};
+        memory::ThreadLocalRegistry _arenas{};
+
+    public:
+        ConcurrentStringPool();
+        ~ConcurrentStringPool();
+
+        ConcurrentStringPool(ConcurrentStringPool const&) = delete;
+        ConcurrentStringPool(ConcurrentStringPool&&) = delete;
+        ConcurrentStringPool& operator=(ConcurrentStringPool const&) = delete;
+        ConcurrentStringPool& operator=(ConcurrentStringPool&&) = delete;
+
+    private:
+        [[nodiscard]] static Entry* TryFind(Table const& table, uint64_t hash, std::string_view value);
+
+        static void Insert(Table& table, Entry* entry);
+
+        void Grow(Shard& shard);
+
+        [[nodiscard]] Arena& GetThreadArena();
+
+    public:
+        /// \brief Interns string. May be called from any thread.
+        [[nodiscard]] std::string_view Get(std::string_view value);
+
+        /// \brief Gets number of interned strings.
+        [[nodiscard]] size_t GetCount() const;
+
+        /// \note Must not be called while other threads intern strings.
+        void QueryMemoryUsage(size_t& allocated, size_t& reserved) const;
+
+        /// \note Must not be called while other threads intern strings.
+        void Enumerate(void* context, bool (*callback)(void*, std::string_view)) const;
+
+        template <typename CallbackT = bool(std::string_view)>
+        void Enumerate(CallbackT&& callback)
+        {
+            this->Enumerate(&callback, [](void* context, std::string_view value)
+                {
+                    return (*static_cast<CallbackT*>(context))(value);
+                });
+        }
+    };
+}
@@ -1,11 +1,21 @@
 #pragma once
 #include "weave/memory/TypedLinearAllocator.hxx"
+#include "weave/hash/WyHash.hxx"
 
 #include <string_view>
 #include <vector>
 
 namespace weave::stringpool
 {
+    /// \brief Compact handle of interned string.
+    ///
+    /// \details Symbols are numbered consecutively by pool, starting from 1. Symbols from the same pool are equal
+    ///          only if their strings are equal. `None` represents empty string.
+    enum class SymbolId : uint32_t
+    {
+        None = 0,
+    };
+
     class StringPool
     {
     private:
@@ -14,6 +24,7 @@ namespace weave::stringpool
             Entry* Next{};
             std::string_view Value{};
             uint64_t Hash{};
+            SymbolId Id{};
         };
 
     private:
@@ -23,6 +34,9 @@ namespace weave::stringpool
         std::vector<Entry*> _mapping{4096};
         size_t _count{};
 
+        // Entries indexed by symbol id, minus one.
+        std::vector<Entry const*> _symbols{};
+
         static constexpr size_t RehashFactor = 4u;
 
     private:
@@ -34,9 +48,39 @@ namespace weave::stringpool
     private:
         void Rehash();
 
+        [[nodiscard]] Entry const& GetEntry(std::string_view value);
+
+    public:
+        StringPool();
+
     public:
         [[nodiscard]] std::string_view Get(std::string_view value);
 
+        /// \brief Interns string and returns its symbol.
+        [[nodiscard]] SymbolId GetSymbol(std::string_view value);
+
+        /// \brief Gets string of the symbol in constant time.
+        [[nodiscard]] std::string_view GetText(SymbolId symbol) const
+        {
+            if (symbol == SymbolId::None)
+            {
+                return {};
+            }
+
+            return this->_symbols[static_cast<size_t>(symbol) - 1]->Value;
+        }
+
+        /// \brief Gets hash of the symbol's string computed when it was interned.
+        [[nodiscard]] uint64_t GetHash(SymbolId symbol) const
+        {
+            if (symbol == SymbolId::None)
+            {
+                return hash::WyHash64::FromString({});
+            }
+
+            return this->_symbols[static_cast<size_t>(symbol) - 1]->Hash;
+        }
+
         void Dump() const;
 
         void QueryMemoryUsage(size_t& allocated, size_t& reserved) const
@@ -47,6 +91,12 @@ namespace weave::stringpool
                 reserved += size;
             }
 
+            if (size_t const size = this->_symbols.capacity() * sizeof(Entry const*); size != 0)
+            {
+                allocated += this->_symbols.size() * sizeof(Entry const*);
+                reserved += size;
+            }
+
             this->_storage.QueryMemoryUsage(allocated, reserved);
             this->_entries.QueryMemoryUsage(allocated, reserved);
         }
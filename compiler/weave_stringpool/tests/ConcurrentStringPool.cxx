@@ -0,0 +1,215 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/stringpool/ConcurrentStringPool.hxx"
+#include "weave/threading/Runnable.hxx"
+#include "weave/threading/Thread.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+TEST_CASE("ConcurrentStringPool - single thread")
+{
+    using namespace weave::stringpool;
+
+    ConcurrentStringPool pool{};
+
+    REQUIRE(pool.GetCount() == 0);
+
+    std::string const first{"identifier"};
+    std::string const second{"identifier"};
+
+    std::string_view const a = pool.Get(first);
+    std::string_view const b = pool.Get(second);
+
+    REQUIRE(a == "identifier");
+    REQUIRE(a.data() == b.data());
+    REQUIRE(a.data() != first.data());
+    REQUIRE(a.data()[a.size()] == '\0');
+
+    std::string_view const empty = pool.Get("");
+    REQUIRE(empty.empty());
+    REQUIRE(pool.Get("").data() == empty.data());
+
+    REQUIRE(pool.Get("other").data() != a.data());
+    REQUIRE(pool.GetCount() == 3);
+
+    SECTION("Growing preserves interned strings")
+    {
+        std::vector<std::string_view> interned{};
+
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            interned.push_back(pool.Get(fmt::format("name_{}", i)));
+        }
+
+        REQUIRE(pool.GetCount() == 100003);
+
+        for (size_t i = 0; i < interned.size(); ++i)
+        {
+            std::string const value = fmt::format("name_{}", i);
+            REQUIRE(interned[i] == value);
+            REQUIRE(pool.Get(value).data() == interned[i].data());
+        }
+
+        REQUIRE(pool.Get(first).data() == a.data());
+
+        size_t enumerated = 0;
+        pool.Enumerate([&](std::string_view)
+            {
+                ++enumerated;
+                return false;
+            });
+
+        REQUIRE(enumerated == pool.GetCount());
+
+        size_t allocated{};
+        size_t reserved{};
+        pool.QueryMemoryUsage(allocated, reserved);
+        REQUIRE(allocated != 0);
+        REQUIRE(reserved >= allocated);
+    }
+}
+
+namespace
+{
+    class Interner final : public weave::threading::Runnable
+    {
+    public:
+        weave::stringpool::ConcurrentStringPool& Pool;
+        std::vector<std::string> const& Values;
+        size_t Offset{};
+        std::vector<std::string_view> Results{};
+
+    public:
+        Interner(weave::stringpool::ConcurrentStringPool& pool, std::vector<std::string> const& values, size_t offset)
+            : Pool{pool}
+            , Values{values}
+            , Offset{offset}
+        {
+        }
+
+    protected:
+        void Execute() override
+        {
+            this->Results.resize(this->Values.size());
+
+            // Each thread starts at different offset, so threads race on both new and existing strings.
+            for (size_t i = 0; i < this->Values.size(); ++i)
+            {
+                size_t const index = (i + this->Offset) % this->Values.size();
+                this->Results[index] = this->Pool.Get(this->Values[index]);
+            }
+        }
+    };
+
+    std::vector<std::string> MakeIdentifiers(size_t count)
+    {
+        std::vector<std::string> result{};
+        result.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            result.push_back(fmt::format("identifier_{}", i));
+        }
+
+        return result;
+    }
+
+    void InternInParallel(
+        weave::stringpool::ConcurrentStringPool& pool,
+        std::vector<std::string> const& values,
+        std::vector<Interner>& interners,
+        size_t threads)
+    {
+        using namespace weave::threading;
+
+        interners.clear();
+        interners.reserve(threads);
+
+        for (size_t i = 0; i < threads; ++i)
+        {
+            interners.emplace_back(pool, values, (i * values.size()) / threads);
+        }
+
+        std::vector<Thread> workers{};
+        workers.reserve(threads);
+
+        for (Interner& interner : interners)
+        {
+            workers.emplace_back(ThreadStart{.Callback = &interner});
+        }
+
+        for (Thread& worker : workers)
+        {
+            worker.Join();
+        }
+    }
+}
+
+TEST_CASE("ConcurrentStringPool - every string is interned once")
+{
+    using namespace weave::stringpool;
+
+    std::vector<std::string> const values = MakeIdentifiers(50000);
+
+    ConcurrentStringPool pool{};
+    std::vector<Interner> interners{};
+
+    InternInParallel(pool, values, interners, 4);
+
+    REQUIRE(pool.GetCount() == values.size());
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        std::string_view const expected = pool.Get(values[i]);
+        REQUIRE(expected == values[i]);
+
+        for (Interner const& interner : interners)
+        {
+            REQUIRE(interner.Results[i].data() == expected.data());
+        }
+    }
+
+    REQUIRE(pool.GetCount() == values.size());
+}
+
+TEST_CASE("ConcurrentStringPool - benchmark", "[.benchmark]")
+{
+    using namespace weave::stringpool;
+    using namespace weave::threading;
+
+    std::vector<std::string> const values = MakeIdentifiers(1 << 16);
+    std::vector<Interner> interners{};
+
+    size_t const processors = std::max<size_t>(GetLogicalProcessorCount(), 1);
+
+    for (size_t threads = 1; threads <= processors; threads *= 2)
+    {
+        BENCHMARK_ADVANCED(fmt::format("insert, {} threads", threads))(Catch::Benchmark::Chronometer meter)
+        {
+            meter.measure([&]
+                {
+                    ConcurrentStringPool pool{};
+                    InternInParallel(pool, values, interners, threads);
+                    return pool.GetCount();
+                });
+        };
+
+        ConcurrentStringPool pool{};
+        InternInParallel(pool, values, interners, 1);
+
+        BENCHMARK(fmt::format("lookup, {} threads", threads))
+        {
+            InternInParallel(pool, values, interners, threads);
+            return pool.GetCount();
+        };
+    }
+}
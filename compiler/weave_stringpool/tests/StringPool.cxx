@@ -0,0 +1,58 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/stringpool/StringPool.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include <fmt/format.h>
+
+#include <string>
+#include <vector>
+
+TEST_CASE("StringPool - symbols")
+{
+    using namespace weave::stringpool;
+
+    StringPool pool{};
+
+    REQUIRE(pool.GetSymbol("") == SymbolId::None);
+    REQUIRE(pool.GetText(SymbolId::None).empty());
+    REQUIRE(pool.GetCount() == 0);
+
+    SymbolId const first = pool.GetSymbol("first");
+    SymbolId const second = pool.GetSymbol("second");
+
+    REQUIRE(first != SymbolId::None);
+    REQUIRE(second != SymbolId::None);
+    REQUIRE(first != second);
+    REQUIRE(pool.GetSymbol(std::string{"first"}) == first);
+
+    REQUIRE(pool.GetText(first) == "first");
+    REQUIRE(pool.GetText(second) == "second");
+    REQUIRE(pool.GetText(first).data() == pool.Get("first").data());
+    REQUIRE(pool.GetHash(first) == weave::hash::WyHash64::FromString("first"));
+    REQUIRE(pool.GetHash(SymbolId::None) == weave::hash::WyHash64::FromString(""));
+
+    SECTION("Symbols survive rehashing")
+    {
+        std::vector<SymbolId> symbols{};
+
+        for (size_t i = 0; i < 50000; ++i)
+        {
+            symbols.push_back(pool.GetSymbol(fmt::format("symbol_{}", i)));
+        }
+
+        for (size_t i = 0; i < symbols.size(); ++i)
+        {
+            std::string const value = fmt::format("symbol_{}", i);
+            REQUIRE(pool.GetText(symbols[i]) == value);
+            REQUIRE(pool.GetSymbol(value) == symbols[i]);
+        }
+
+        REQUIRE(pool.GetText(first) == "first");
+        REQUIRE(pool.GetCount() == (symbols.size() + 2));
+    }
+}
@@ -4,12 +4,12 @@ namespace weave::syntax
 {
     bool CharTraits::IsIdentifierStart(char32_t c)
     {
-        if (not IsIdentifierContinuation(c))
+        if (c < 0x80u)
         {
-            return false;
+            return HasAsciiClass(static_cast<char>(c), impl::AsciiIdentifierStart);
         }
 
-        if ((c < 0x80) and (IsDecimalDigit(c) or (c == U'$')))
+        if (not IsIdentifierContinuation(c))
         {
             return false;
         }
@@ -31,7 +31,7 @@ namespace weave::syntax
     {
         if (c < 0x80u)
         {
-            return IsIdentifierContinuationAscii(c);
+            return HasAsciiClass(static_cast<char>(c), impl::AsciiIdentifierContinuation);
         }
 
         // N1518: Recommendations for extended identifier characters for C and C++
@@ -85,6 +85,11 @@ namespace weave::syntax
 
     bool CharTraits::IsWhitespace(char32_t c)
     {
+        if (c < 0x80u)
+        {
+            return HasAsciiClass(static_cast<char>(c), impl::AsciiWhitespace);
+        }
+
         switch (c)
         {
             // New line characters are lexed separately
@@ -0,0 +1,97 @@
+#include "weave/syntax/FlatSyntaxTree.hxx"
+#include "weave/syntax/SyntaxToken.hxx"
+#include "weave/syntax/SyntaxTreeIterator.hxx"
+
+namespace weave::syntax
+{
+    FlatSyntaxTree::FlatSyntaxTree(SyntaxNode* root)
+    {
+        // Index of the innermost node which subtree is being built.
+        uint32_t current = InvalidIndex;
+
+        SyntaxTreeIterator it{root, SyntaxTreeOrder::PreAndPostOrder};
+
+        while (it.Next())
+        {
+            SyntaxNode* const node = it.GetNode();
+
+            if (not it.IsLeaving())
+            {
+                WEAVE_ASSERT(this->_nodes.size() < InvalidIndex);
+                uint32_t const index = static_cast<uint32_t>(this->_nodes.size());
+
+                source::SourceSpan source{};
+
+                if (IsToken(node->Kind))
+                {
+                    source = static_cast<SyntaxToken*>(node)->Source;
+                }
+
+                this->_nodes.push_back(FlatSyntaxNode{
+                    .Kind = node->Kind,
+                    .Slot = it.GetSlot(),
+                    .Parent = current,
+                    .ChildCount = 0,
+                    .SubtreeSize = 1,
+                    .Source = source,
+                });
+
+                if (current != InvalidIndex)
+                {
+                    ++this->_nodes[current].ChildCount;
+                }
+
+                current = index;
+            }
+            else
+            {
+                FlatSyntaxNode& flat = this->_nodes[current];
+                flat.SubtreeSize = static_cast<uint32_t>(this->_nodes.size()) - current;
+
+                if (flat.ChildCount != 0)
+                {
+                    // Find the last child by skipping subtrees of its siblings.
+                    uint32_t last = current + 1;
+
+                    for (uint32_t i = 1; i < flat.ChildCount; ++i)
+                    {
+                        last += this->_nodes[last].SubtreeSize;
+                    }
+
+                    flat.Source = source::SourceSpan{
+                        .Start = this->_nodes[current + 1].Source.Start,
+                        .End = this->_nodes[last].Source.End,
+                    };
+                }
+
+                current = flat.Parent;
+            }
+        }
+
+        WEAVE_ASSERT(current == InvalidIndex);
+
+        this->_nodes.shrink_to_fit();
+    }
+
+    uint32_t FlatSyntaxTree::GetChildInSlot(uint32_t index, uint16_t slot) const
+    {
+        uint32_t const end = this->GetSubtreeEnd(index);
+
+        for (uint32_t child = index + 1; child < end; child = this->GetNextSibling(child))
+        {
+            uint16_t const current = this->_nodes[child].Slot;
+
+            if (current == slot)
+            {
+                return child;
+            }
+
+            if (current > slot)
+            {
+                break;
+            }
+        }
+
+        return InvalidIndex;
+    }
+}
@@ -0,0 +1,435 @@
+#include "weave/syntax/GreenTree.hxx"
+#include "weave/syntax/SyntaxFactory.hxx"
+#include "weave/syntax/Visitor.hxx"
+#include "weave/source/SourceText.hxx"
+#include "weave/hash/Combine.hxx"
+#include "weave/hash/WyHash.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace weave::syntax::impl
+{
+    // Converts syntax tree into green tree. Children of a node are collected on the stack in order they are
+    // dispatched by the walker, then replaced with the green node created for them.
+    class GreenTreeBuilder final : public SyntaxWalker
+    {
+    private:
+        GreenNodeFactory& _green;
+        SyntaxFactory const& _factory;
+        std::string_view _text{};
+        std::vector<GreenNode const*> _stack{};
+
+    public:
+        GreenTreeBuilder(GreenNodeFactory& green, SyntaxFactory const& factory, source::SourceText const& text)
+            : _green{green}
+            , _factory{factory}
+            , _text{text.GetContentView()}
+        {
+        }
+
+    public:
+        void Dispatch(SyntaxNode* node) override
+        {
+            if (node == nullptr)
+            {
+                this->_stack.push_back(nullptr);
+            }
+            else if (IsToken(node->Kind))
+            {
+                this->_stack.push_back(this->CreateToken(static_cast<SyntaxToken const*>(node)));
+            }
+            else
+            {
+                size_t const first = this->_stack.size();
+
+                SyntaxWalker::Dispatch(node);
+
+                GreenNode const* const result = this->_green.CreateNode(
+                    node->Kind,
+                    std::span{this->_stack}.subspan(first));
+
+                this->_stack.resize(first);
+                this->_stack.push_back(result);
+            }
+        }
+
+        [[nodiscard]] GreenNode const* Build(SyntaxNode* root)
+        {
+            this->Dispatch(root);
+
+            WEAVE_ASSERT(this->_stack.size() == 1);
+            return this->_stack.back();
+        }
+
+    private:
+        [[nodiscard]] GreenNode const* CreateToken(SyntaxToken const* token)
+        {
+            if (token->IsMissing())
+            {
+                // Missing tokens borrow source span of the next token; they never occupy any text.
+                return this->_green.CreateMissingToken(token->Kind);
+            }
+
+            uint32_t leading = 0;
+            uint32_t trailing = 0;
+
+            for (SyntaxTriviaEntry const& entry : this->_factory.GetLeadingTriviaEntries(token))
+            {
+                leading += entry.Length;
+            }
+
+            for (SyntaxTriviaEntry const& entry : this->_factory.GetTrailingTriviaEntries(token))
+            {
+                trailing += entry.Length;
+            }
+
+            uint32_t const start = token->Source.Start.Offset - leading;
+            uint32_t const end = token->Source.End.Offset + trailing;
+
+            WEAVE_ASSERT(token->Source.Start.Offset >= leading);
+            WEAVE_ASSERT(end <= this->_text.size());
+
+            return this->_green.CreateToken(token->Kind, this->_text.substr(start, end - start), leading, trailing);
+        }
+    };
+
+    [[nodiscard]] constexpr uint64_t HashToken(SyntaxKind kind, bool missing, std::string_view text, uint32_t leading, uint32_t trailing)
+    {
+        uint64_t result = hash::WyHash64::FromString(text, static_cast<uint64_t>(kind));
+        hash::Combine(result, (uint64_t{leading} << 32u) | trailing);
+        hash::Combine(result, missing ? 1u : 0u);
+        return result;
+    }
+
+    [[nodiscard]] constexpr uint64_t HashNode(SyntaxKind kind, std::span<GreenNode const* const> slots)
+    {
+        // Hash of children is used instead of their address, so hash does not depend on allocation order.
+        uint64_t result = static_cast<uint64_t>(kind);
+        hash::Combine(result, slots.size());
+
+        for (GreenNode const* slot : slots)
+        {
+            hash::Combine(result, (slot != nullptr) ? slot->GetHash() : 0);
+        }
+
+        return result;
+    }
+}
+
+namespace weave::syntax
+{
+    uint32_t GreenNode::GetLeadingTriviaWidth() const
+    {
+        GreenNode const* node = this;
+
+        while (not node->IsToken())
+        {
+            std::span<GreenNode const* const> const slots = node->GetSlots();
+
+            auto const it = std::find_if(slots.begin(), slots.end(), [](GreenNode const* slot)
+                {
+                    return (slot != nullptr) and (slot->GetWidth() != 0);
+                });
+
+            if (it == slots.end())
+            {
+                return 0;
+            }
+
+            node = *it;
+        }
+
+        return static_cast<GreenToken const*>(node)->GetLeadingWidth();
+    }
+
+    uint32_t GreenNode::GetTrailingTriviaWidth() const
+    {
+        GreenNode const* node = this;
+
+        while (not node->IsToken())
+        {
+            std::span<GreenNode const* const> const slots = node->GetSlots();
+
+            auto const it = std::find_if(slots.rbegin(), slots.rend(), [](GreenNode const* slot)
+                {
+                    return (slot != nullptr) and (slot->GetWidth() != 0);
+                });
+
+            if (it == slots.rend())
+            {
+                return 0;
+            }
+
+            node = *it;
+        }
+
+        return static_cast<GreenToken const*>(node)->GetTrailingWidth();
+    }
+
+    void GreenNode::AppendText(std::string& result) const
+    {
+        if (this->IsToken())
+        {
+            result.append(static_cast<GreenToken const*>(this)->GetFullText());
+        }
+        else
+        {
+            for (GreenNode const* slot : this->GetSlots())
+            {
+                if (slot != nullptr)
+                {
+                    slot->AppendText(result);
+                }
+            }
+        }
+    }
+
+    GreenNodeFactory::GreenNodeFactory()
+    {
+        static memory::MemoryArena& green = memory::MemoryAccounting::GetArena("syntax.green");
+        this->_allocator.SetArena(&green);
+    }
+
+    void* GreenNodeFactory::AllocateToken()
+    {
+        memory::Allocation const allocation = this->_allocator.Allocate(memory::Layout{
+            .Size = sizeof(GreenToken),
+            .Alignment = alignof(GreenToken),
+        });
+
+        return allocation.Address;
+    }
+
+    GreenToken const* GreenNodeFactory::CreateToken(SyntaxKind kind, std::string_view text, uint32_t leading, uint32_t trailing)
+    {
+        WEAVE_ASSERT(text.size() <= std::numeric_limits<uint32_t>::max());
+        WEAVE_ASSERT((leading + trailing) <= text.size());
+
+        uint64_t const hash = impl::HashToken(kind, false, text, leading, trailing);
+
+        auto [first, last] = this->_nodes.equal_range(hash);
+
+        for (; first != last; ++first)
+        {
+            if (first->second->IsToken())
+            {
+                GreenToken const* const token = static_cast<GreenToken const*>(first->second);
+
+                if ((token->GetKind() == kind) and
+                    (not token->IsMissing()) and
+                    (token->GetLeadingWidth() == leading) and
+                    (token->GetTrailingWidth() == trailing) and
+                    (token->GetFullText() == text))
+                {
+                    ++this->_reused;
+                    return token;
+                }
+            }
+        }
+
+        std::span<char> const copy = this->_allocator.EmplaceArray<char>(std::span{text});
+
+        GreenToken const* const result = new (this->AllocateToken()) GreenToken{kind, false, std::string_view{copy.data(), copy.size()}, leading, trailing, hash};
+
+        this->_nodes.emplace(hash, result);
+        ++this->_tokens;
+        return result;
+    }
+
+    GreenToken const* GreenNodeFactory::CreateMissingToken(SyntaxKind kind)
+    {
+        uint64_t const hash = impl::HashToken(kind, true, {}, 0, 0);
+
+        auto [first, last] = this->_nodes.equal_range(hash);
+
+        for (; first != last; ++first)
+        {
+            if (first->second->IsToken() and (first->second->GetKind() == kind) and static_cast<GreenToken const*>(first->second)->IsMissing())
+            {
+                ++this->_reused;
+                return static_cast<GreenToken const*>(first->second);
+            }
+        }
+
+        GreenToken const* const result = new (this->AllocateToken()) GreenToken{kind, true, {}, 0, 0, hash};
+
+        this->_nodes.emplace(hash, result);
+        ++this->_tokens;
+        return result;
+    }
+
+    GreenNode const* GreenNodeFactory::CreateNode(SyntaxKind kind, std::span<GreenNode const* const> slots)
+    {
+        WEAVE_ASSERT(slots.size() <= std::numeric_limits<uint32_t>::max());
+
+        uint64_t const hash = impl::HashNode(kind, slots);
+
+        auto [first, last] = this->_nodes.equal_range(hash);
+
+        for (; first != last; ++first)
+        {
+            GreenNode const* const node = first->second;
+
+            // Children are interned, so comparing their addresses compares whole subtrees.
+            if ((not node->IsToken()) and (node->GetKind() == kind) and std::ranges::equal(node->GetSlots(), slots))
+            {
+                ++this->_reused;
+                return node;
+            }
+        }
+
+        uint64_t width = 0;
+
+        for (GreenNode const* slot : slots)
+        {
+            if (slot != nullptr)
+            {
+                width += slot->GetWidth();
+            }
+        }
+
+        WEAVE_ASSERT(width <= std::numeric_limits<uint32_t>::max());
+
+        memory::Allocation const allocation = this->_allocator.Allocate(memory::Layout{
+            .Size = sizeof(GreenNode) + (slots.size() * sizeof(GreenNode const*)),
+            .Alignment = alignof(GreenNode),
+        });
+
+        GreenNode* const result = new (allocation.Address) GreenNode{
+            kind,
+            false,
+            static_cast<uint32_t>(slots.size()),
+            static_cast<uint32_t>(width),
+            hash};
+
+        std::ranges::copy(slots, reinterpret_cast<GreenNode const**>(result + 1));
+
+        this->_nodes.emplace(hash, result);
+        return result;
+    }
+
+    GreenNode const* GreenNodeFactory::CreateFromSyntax(SyntaxNode* root, SyntaxFactory const& factory, source::SourceText const& text)
+    {
+        impl::GreenTreeBuilder builder{*this, factory, text};
+        return builder.Build(root);
+    }
+
+    GreenNode const* GreenNodeFactory::Replace(RedNode const* node, GreenNode const* replacement)
+    {
+        std::vector<GreenNode const*> slots{};
+
+        for (RedNode const* parent = node->GetParent(); parent != nullptr; node = parent, parent = parent->GetParent())
+        {
+            std::span<GreenNode const* const> const original = parent->GetGreen()->GetSlots();
+
+            slots.assign(original.begin(), original.end());
+            slots[node->GetIndex()] = replacement;
+
+            replacement = this->CreateNode(parent->GetKind(), slots);
+        }
+
+        return replacement;
+    }
+
+    void GreenNodeFactory::QueryStatistics(GreenNodeFactoryStatistics& statistics) const
+    {
+        size_t reserved{};
+
+        statistics.Nodes = this->_nodes.size() - this->_tokens;
+        statistics.Tokens = this->_tokens;
+        statistics.Reused = this->_reused;
+        this->_allocator.QueryMemoryUsage(statistics.Allocated, reserved);
+    }
+
+    source::SourceSpan RedNode::GetSpan() const
+    {
+        source::SourceSpan const result = this->GetFullSpan();
+
+        if (this->_green->GetWidth() == 0)
+        {
+            return result;
+        }
+
+        return source::SourceSpan{
+            .Start = {result.Start.Offset + this->_green->GetLeadingTriviaWidth()},
+            .End = {result.End.Offset - this->_green->GetTrailingTriviaWidth()},
+        };
+    }
+
+    RedNode const* RedNode::GetChild(size_t index) const
+    {
+        WEAVE_ASSERT(index < this->GetSlotCount());
+
+        if (this->_children == nullptr)
+        {
+            this->_tree->Materialize(*this);
+        }
+
+        return this->_children[index];
+    }
+
+    RedNode const* RedNode::FindToken(source::SourcePosition position) const
+    {
+        RedNode const* node = this;
+
+        if ((position.Offset < this->_offset) or ((position.Offset - this->_offset) >= this->_green->GetWidth()))
+        {
+            return nullptr;
+        }
+
+        while (not node->GetGreen()->IsToken())
+        {
+            RedNode const* next = nullptr;
+
+            for (size_t i = 0; i < node->GetSlotCount(); ++i)
+            {
+                RedNode const* const child = node->GetChild(i);
+
+                if ((child != nullptr) and (position.Offset < child->GetFullSpan().End.Offset))
+                {
+                    next = child;
+                    break;
+                }
+            }
+
+            WEAVE_ASSERT(next != nullptr);
+            node = next;
+        }
+
+        return node;
+    }
+
+    RedTree::RedTree(GreenNode const* root)
+    {
+        static memory::MemoryArena& red = memory::MemoryAccounting::GetArena("syntax.red");
+        this->_allocator.SetArena(&red);
+
+        this->_root = this->_allocator.Emplace<RedNode>(this, nullptr, root, 0, 0);
+    }
+
+    void RedTree::Materialize(RedNode const& node)
+    {
+        std::span<GreenNode const* const> const slots = node._green->GetSlots();
+        std::span<RedNode const*> const children = this->_allocator.EmplaceArray<RedNode const*>(slots.size());
+
+        uint32_t offset = node._offset;
+
+        for (size_t i = 0; i < slots.size(); ++i)
+        {
+            if (GreenNode const* const slot = slots[i]; slot != nullptr)
+            {
+                children[i] = this->_allocator.Emplace<RedNode>(this, &node, slot, offset, static_cast<uint32_t>(i));
+                offset += slot->GetWidth();
+            }
+            else
+            {
+                children[i] = nullptr;
+            }
+        }
+
+        node._children = children.data();
+    }
+}
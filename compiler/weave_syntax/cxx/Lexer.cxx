@@ -64,28 +64,38 @@ namespace weave::syntax
     }
 
     SyntaxToken* Lexer::Lex(SyntaxFactory& factory)
+    {
+        if (not this->Lex(this->_token))
+        {
+            this->_token.Kind = SyntaxKind::None;
+        }
+
+        return CreateToken(factory, this->_token);
+    }
+
+    SyntaxToken* Lexer::CreateToken(SyntaxFactory& factory, TokenInfo const& token)
     {
         // TODO: Determine how to parse token prefix and postfix for each literal type
         // Fix proposal:
         //  - have common prefix and postfix for all literals, which will be converted here to proper type (type-safe, scope limited to just lexer)
         //  - have all possible prefixes and postfixes as common type and use it everywhere (not type-safe)
 
-        if (this->Lex(this->_token))
+        if (token.Kind != SyntaxKind::None)
         {
-            if (this->_token.Kind == SyntaxKind::StringLiteralToken)
+            if (token.Kind == SyntaxKind::StringLiteralToken)
             {
                 return factory.CreateStringLiteralToken(
-                    this->_token.Source,
-                    this->_token.LeadingTrivia,
-                    this->_token.TrailingTrivia,
-                    this->_token.Prefix,
-                    this->_token.Value);
+                    token.Source,
+                    token.LeadingTrivia,
+                    token.TrailingTrivia,
+                    token.Prefix,
+                    token.Value);
             }
 
-            if (this->_token.Kind == SyntaxKind::CharacterLiteralToken)
+            if (token.Kind == SyntaxKind::CharacterLiteralToken)
             {
                 char32_t value{};
-                std::string_view const s = this->_token.Value;
+                std::string_view const s = token.Value;
 
                 const char* first = s.data();
                 const char* const last = first + s.size();
@@ -94,56 +104,56 @@ namespace weave::syntax
                 (void)unicode::Decode(value, first, last);
 
                 return factory.CreateCharacterLiteralToken(
-                    this->_token.Source,
-                    this->_token.LeadingTrivia,
-                    this->_token.TrailingTrivia,
-                    this->_token.Prefix,
+                    token.Source,
+                    token.LeadingTrivia,
+                    token.TrailingTrivia,
+                    token.Prefix,
                     value);
             }
 
-            if (this->_token.Kind == SyntaxKind::FloatLiteralToken)
+            if (token.Kind == SyntaxKind::FloatLiteralToken)
             {
                 return factory.CreateFloatLiteralToken(
-                    this->_token.Source,
-                    this->_token.LeadingTrivia,
-                    this->_token.TrailingTrivia,
-                    this->_token.Prefix,
-                    this->_token.Suffix,
-                    this->_token.Value);
+                    token.Source,
+                    token.LeadingTrivia,
+                    token.TrailingTrivia,
+                    token.Prefix,
+                    token.Value,
+                    token.Suffix);
             }
 
-            if (this->_token.Kind == SyntaxKind::IntegerLiteralToken)
+            if (token.Kind == SyntaxKind::IntegerLiteralToken)
             {
                 return factory.CreateIntegerLiteralToken(
-                    this->_token.Source,
-                    this->_token.LeadingTrivia,
-                    this->_token.TrailingTrivia,
-                    this->_token.Prefix,
-                    this->_token.Suffix,
-                    this->_token.Value);
+                    token.Source,
+                    token.LeadingTrivia,
+                    token.TrailingTrivia,
+                    token.Prefix,
+                    token.Value,
+                    token.Suffix);
             }
 
-            if (this->_token.Kind == SyntaxKind::IdentifierToken)
+            if (token.Kind == SyntaxKind::IdentifierToken)
             {
                 return factory.CreateIdentifierToken(
-                    this->_token.Source,
-                    this->_token.LeadingTrivia,
-                    this->_token.TrailingTrivia,
-                    this->_token.ContextualKeyword,
-                    this->_token.Value);
+                    token.Source,
+                    token.LeadingTrivia,
+                    token.TrailingTrivia,
+                    token.ContextualKeyword,
+                    token.Identifier);
             }
 
             return factory.CreateToken(
-                this->_token.Kind,
-                this->_token.Source,
-                this->_token.LeadingTrivia,
-                this->_token.TrailingTrivia);
+                token.Kind,
+                token.Source,
+                token.LeadingTrivia,
+                token.TrailingTrivia);
         }
 
         // Failed to lex token
         return factory.CreateToken(
             SyntaxKind::None,
-            this->_token.Source);
+            token.Source);
     }
 
     bool Lexer::TryReadToken(TokenInfo& token)
@@ -153,6 +163,7 @@ namespace weave::syntax
         token.Prefix = LiteralPrefixKind::Default;
         token.Value.clear();
         token.Suffix.clear();
+        token.Identifier = {};
 
         if (this->_cursor.IsEnd())
         {
@@ -196,7 +207,7 @@ namespace weave::syntax
 
         if (this->TryReadIdentifier(token))
         {
-            if (std::optional<SyntaxKind> const keyword = TryMapIdentifierToKeyword(token.Value); keyword.has_value())
+            if (std::optional<SyntaxKind> const keyword = TryMapIdentifierToKeyword(token.Identifier); keyword.has_value())
             {
                 if (IsContextualKeyword(*keyword))
                 {
@@ -211,7 +222,7 @@ namespace weave::syntax
             }
             else
             {
-                if ((token.Value.length() == 1) and (token.Value.front() == '_'))
+                if (token.Identifier == "_")
                 {
                     token.Kind = SyntaxKind::UnderscoreToken;
                 }
@@ -238,9 +249,15 @@ namespace weave::syntax
             this->_diagnostic->AddError(this->_cursor.GetSpan(), "invalid UTF-8 character");
         }
 
-        token.Kind = SyntaxKind::None;
+        if (this->_cursor.GetSpan().Start == this->_cursor.GetCurrentPosition())
+        {
+            // Character is consumed, so lexing continues after it.
+            this->_cursor.Advance();
+        }
+
+        token.Kind = SyntaxKind::ErrorToken;
         token.Source = this->_cursor.GetSpan();
-        return false;
+        return true;
     }
 
     void Lexer::TryReadTrivia(std::vector<SyntaxTrivia>& builder, bool leading)
@@ -1020,12 +1037,17 @@ namespace weave::syntax
     {
         if (CharTraits::IsIdentifierStart(this->_cursor.Peek()))
         {
+            source::SourcePosition const start = this->_cursor.GetCurrentPosition();
+
             do
             {
-                token.Value.append(this->_cursor.PeekAsStringView());
                 this->_cursor.Advance();
+
+                // Scan ASCII part without decoding; only non-ASCII characters go through the full check.
+                (void)this->_cursor.ConsumeAscii(CharTraits::IsIdentifierContinuationByte);
             } while (CharTraits::IsIdentifierContinuation(this->_cursor.Peek()));
 
+            token.Identifier = this->_source->GetText(this->_cursor.GetSpanToCurrent(start));
             return true;
         }
 
@@ -1056,7 +1078,30 @@ namespace weave::syntax
 
     bool Lexer::TryReadWhitespace()
     {
-        return this->_cursor.SkipIf(CharTraits::IsWhitespace);
+        bool matched = false;
+
+        while (true)
+        {
+            if (not this->_cursor.ConsumeAscii(CharTraits::IsWhitespaceByte).empty())
+            {
+                matched = true;
+            }
+
+            if (this->_cursor.Peek() < 0x80u)
+            {
+                break;
+            }
+
+            // Non-ASCII whitespace characters.
+            if (not this->_cursor.SkipIf(CharTraits::IsWhitespace))
+            {
+                break;
+            }
+
+            matched = true;
+        }
+
+        return matched;
     }
 
     SyntaxKind Lexer::TryReadSingleLineComment()
@@ -1066,6 +1111,8 @@ namespace weave::syntax
 
         while (true)
         {
+            (void)this->_cursor.ConsumeAscii(CharTraits::IsNotNewLineByte);
+
             char32_t const current = this->_cursor.Peek();
             if (CharTraits::IsNewLine(current) or not this->_cursor.IsValid() or this->_cursor.IsEnd())
             {
@@ -1202,6 +1249,26 @@ namespace weave::syntax
             return CharTraits::IsDecimalDigit;
         }();
 
+        auto const charsetByte = [base]
+        {
+            switch (base)
+            {
+            case 2:
+                return CharTraits::IsBinaryDigitByte;
+
+            case 8:
+                return CharTraits::IsOctalDigitByte;
+
+            case 16:
+                return CharTraits::IsHexadecimalDigitByte;
+
+            default:
+                break;
+            }
+
+            return CharTraits::IsDecimalDigitByte;
+        }();
+
         SingleInteger result{};
 
         if (this->_cursor.Peek() == U'_')
@@ -1211,6 +1278,15 @@ namespace weave::syntax
 
         while (true)
         {
+            // Append whole run of digits at once.
+            if (std::string_view const digits = this->_cursor.ConsumeAscii(charsetByte); not digits.empty())
+            {
+                builder.append(digits);
+                result.HasValue = true;
+                result.HasTrailingSeparator = false;
+                continue;
+            }
+
             char32_t const current = this->_cursor.Peek();
 
             if (current == U'_')
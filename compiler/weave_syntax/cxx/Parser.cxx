@@ -6,6 +6,7 @@
 #include "weave/syntax/SyntaxTree.hxx"
 #include "weave/syntax/SyntaxFacts.hxx"
 #include "weave/syntax/Lexer.hxx"
+#include "weave/syntax/GreenTree.hxx"
 
 // Implementation details:
 // - nesting level is used to determine when to stop token recovery operation
@@ -17,34 +18,17 @@ namespace weave::syntax
     Parser::Parser(
         source::DiagnosticSink* diagnostic,
         SyntaxFactory* factory,
-        source::SourceText const& source)
+        source::SourceText const& source,
+        TokenStreamMode mode)
         : _factory{factory}
+        , _tokens{*diagnostic, *factory, source, mode}
     {
-        Lexer lexer{*diagnostic, source, LexerTriviaMode::All};
-
-        while (SyntaxToken* token = lexer.Lex(*factory))
-        {
-            this->_tokens.push_back(token);
-
-            if ((token->Kind == SyntaxKind::EndOfFileToken) or (token->Kind == SyntaxKind::None))
-            {
-                break;
-            }
-        }
-
         this->_current = Peek(0);
     }
 
-    SyntaxToken* Parser::Peek(size_t offset) const
+    SyntaxToken* Parser::Peek(size_t offset)
     {
-        size_t const index = this->_index + offset;
-
-        if (index >= this->_tokens.size())
-        {
-            return this->_tokens.back();
-        }
-
-        return this->_tokens[index];
+        return this->_tokens.Get(this->_index + offset);
     }
 
     SyntaxToken* Parser::Current() const
@@ -58,15 +42,13 @@ namespace weave::syntax
         SyntaxToken* current = this->Current();
         ++this->_index;
 
-        if (this->_index >= this->_tokens.size())
-        {
-            this->_current = this->_tokens.back();
-        }
-        else
+        if (this->_resetPoints.empty())
         {
-            this->_current = this->_tokens[this->_index];
+            this->_tokens.Retain(this->_index);
         }
 
+        this->_current = this->_tokens.Get(this->_index);
+
         return current;
     }
 
@@ -204,9 +186,129 @@ namespace weave::syntax
         SourceFileSyntax* result = this->_factory->CreateNode<SourceFileSyntax>();
         result->Elements = SyntaxListView<CodeBlockItemSyntax>{this->_factory->CreateList(children)};
         this->MatchUntil(result->EndOfFileToken, result->BeforeEndOfFileToken, SyntaxKind::EndOfFileToken);
+
+        this->_tokens.Complete();
         return result;
     }
 
+    GreenNode const* Parser::Reparse(
+        GreenNodeFactory& factory,
+        GreenNode const* oldTree,
+        source::SourceText const& source,
+        source::TextChange const& change)
+    {
+        // Number of times the window is extended before whole source is parsed.
+        constexpr size_t MaxAttempts = 4;
+
+        WEAVE_ASSERT(oldTree->GetKind() == SyntaxKind::SourceFileSyntax);
+        WEAVE_ASSERT(oldTree->GetSlotCount() == 3);
+        WEAVE_ASSERT(change.Span.End.Offset <= oldTree->GetWidth());
+
+        std::span<GreenNode const* const> items{};
+
+        if (GreenNode const* const list = oldTree->GetSlot(0); list != nullptr)
+        {
+            items = list->GetSlots();
+        }
+
+        ptrdiff_t const count = static_cast<ptrdiff_t>(items.size());
+
+        // Item `i` spans old text in range [offsets[i], offsets[i + 1]).
+        std::vector<uint32_t> offsets{};
+        offsets.reserve(items.size() + 1);
+        offsets.push_back(0);
+
+        for (GreenNode const* item : items)
+        {
+            offsets.push_back(offsets.back() + item->GetWidth());
+        }
+
+        int64_t const delta = static_cast<int64_t>(change.NewText.size()) - static_cast<int64_t>(change.Span.End.Offset - change.Span.Start.Offset);
+
+        WEAVE_ASSERT((static_cast<int64_t>(oldTree->GetWidth()) + delta) == static_cast<int64_t>(source.GetContentView().size()));
+
+        // Items touching the change, including ones ending or starting exactly at its boundary.
+        ptrdiff_t const first = std::lower_bound(offsets.begin() + 1, offsets.end(), change.Span.Start.Offset) - (offsets.begin() + 1);
+        ptrdiff_t const last = (std::upper_bound(offsets.begin(), offsets.end() - 1, change.Span.End.Offset) - offsets.begin()) - 1;
+
+        // Neighbouring items are reparsed as well, to verify that boundaries of the window are stable.
+        ptrdiff_t left = first - 1;
+        ptrdiff_t right = last + 1;
+
+        for (size_t attempt = 0;; ++attempt)
+        {
+            if (attempt == MaxAttempts)
+            {
+                left = -1;
+                right = count;
+            }
+
+            left = std::max<ptrdiff_t>(left, -1);
+            right = std::min<ptrdiff_t>(right, count);
+
+            uint32_t const start = (left >= 0) ? offsets[static_cast<size_t>(left)] : 0;
+            uint32_t const end = (right < count)
+                ? static_cast<uint32_t>(offsets[static_cast<size_t>(right) + 1] + delta)
+                : static_cast<uint32_t>(source.GetContentView().size());
+
+            source::SourceText const window{std::string{source.GetContentView().substr(start, end - start)}};
+            source::DiagnosticSink diagnostic{"<reparse>"};
+            SyntaxFactory syntax{};
+            Parser parser{&diagnostic, &syntax, window};
+
+            GreenNode const* const reparsed = factory.CreateFromSyntax(parser.ParseSourceFile(), syntax, window);
+
+            if ((left < 0) and (right >= count))
+            {
+                return reparsed;
+            }
+
+            std::span<GreenNode const* const> created{};
+
+            if (GreenNode const* const list = reparsed->GetSlot(0); list != nullptr)
+            {
+                created = list->GetSlots();
+            }
+
+            size_t const required = ((left >= 0) ? 1 : 0) + ((right < count) ? 1 : 0);
+            bool stable = true;
+
+            // Green nodes are interned, so identical neighbours are the same nodes.
+            if ((left >= 0) and ((created.size() < required) or (created.front() != items[static_cast<size_t>(left)])))
+            {
+                --left;
+                stable = false;
+            }
+
+            if ((right < count) and ((created.size() < required) or (created.back() != items[static_cast<size_t>(right)]) or (reparsed->GetSlot(1) != nullptr) or (reparsed->GetSlot(2)->GetWidth() != 0)))
+            {
+                ++right;
+                stable = false;
+            }
+
+            if (stable)
+            {
+                std::vector<GreenNode const*> elements{};
+                elements.reserve(items.size() + created.size());
+                elements.insert(elements.end(), items.begin(), items.begin() + std::max<ptrdiff_t>(left, 0));
+                elements.insert(elements.end(), created.begin(), created.end());
+
+                if (right < count)
+                {
+                    elements.insert(elements.end(), items.begin() + right + 1, items.end());
+                }
+
+                GreenNode const* const slots[]{
+                    elements.empty() ? nullptr : factory.CreateNode(SyntaxKind::SyntaxList, elements),
+                    (right < count) ? oldTree->GetSlot(1) : reparsed->GetSlot(1),
+                    (right < count) ? oldTree->GetSlot(2) : reparsed->GetSlot(2),
+                };
+
+                return factory.CreateNode(SyntaxKind::SourceFileSyntax, slots);
+            }
+        }
+    }
+
     void Parser::ParseCodeBlockItemList(std::vector<CodeBlockItemSyntax*>& items, bool global)
     {
         items.clear();
@@ -290,8 +392,7 @@ namespace weave::syntax
 
         if ((label == nullptr) and (statement == nullptr))
         {
-            // No luck, reset parser to original state and stop.
-            // FIXME: This leaks memory allocated for attributes.
+            // No luck, reset parser to original state and stop. This releases attributes as well.
             this->Reset(started);
             return nullptr;
         }
@@ -2866,11 +2967,11 @@ namespace weave::syntax
     }
 }
 
-#include "weave/syntax/Visitor.hxx"
+#include "weave/syntax/StaticSyntaxWalker.hxx"
 
 namespace weave::syntax
 {
-    class SyntaxValidator : public SyntaxVisitor<void>
+    class SyntaxValidator final : public StaticSyntaxWalker<SyntaxValidator>
     {
     public:
         source::DiagnosticSink* _diagnostic;
@@ -2885,26 +2986,8 @@ namespace weave::syntax
     public:
     };
 
-    class SyntaxValidatorWalker : public SyntaxWalker
-    {
-    private:
-        SyntaxValidator validator;
-
-    public:
-        SyntaxValidatorWalker(source::DiagnosticSink* diagnostic)
-            : validator(diagnostic)
-        {
-        }
-
-    public:
-        void OnDefault(SyntaxNode* node) override
-        {
-            validator.Dispatch(node);
-        }
-    };
-
     void Validate(SourceFileSyntax* source, source::DiagnosticSink* diagnostic)
     {
-        SyntaxValidatorWalker{diagnostic}.Dispatch(source);
+        SyntaxValidator{diagnostic}.Dispatch(source);
     }
 }
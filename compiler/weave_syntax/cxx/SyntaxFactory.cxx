@@ -1,27 +1,212 @@
 #include "weave/syntax/SyntaxFactory.hxx"
 #include "weave/bugcheck/Assert.hxx"
 
+#include <limits>
+
 namespace weave::syntax
 {
-    SyntaxListView<SyntaxTrivia> SyntaxFactory::CreateTriviaList(std::span<const SyntaxTrivia> trivia)
+    SyntaxFactory::SyntaxFactory()
+    {
+        static memory::MemoryArena& tokens = memory::MemoryAccounting::GetArena("syntax.tokens");
+        static memory::MemoryArena& trivia = memory::MemoryAccounting::GetArena("syntax.trivia");
+        static memory::MemoryArena& literals = memory::MemoryAccounting::GetArena("syntax.literals");
+        static memory::MemoryArena& identifiers = memory::MemoryAccounting::GetArena("syntax.identifiers");
+        static memory::MemoryArena& nodes = memory::MemoryAccounting::GetArena("syntax.nodes");
+
+        this->TokenAllocator.SetArena(&tokens);
+        this->TriviaAllocator.SetArena(&trivia);
+        this->TriviaListAllocator.SetArena(&trivia);
+        this->CharacterLiteralAllocator.SetArena(&literals);
+        this->StringLiteralAllocator.SetArena(&literals);
+        this->FloatLiteralAllocator.SetArena(&literals);
+        this->IntegerLiteralAllocator.SetArena(&literals);
+        this->IdentifierAllocator.SetArena(&identifiers);
+        this->SyntaxNodeAllocator.SetArena(&nodes);
+        this->TriviaEntriesArena = &trivia;
+    }
+
+    SyntaxFactory::~SyntaxFactory()
+    {
+        this->TriviaEntriesArena->Deallocated(this->TriviaEntries.capacity() * sizeof(SyntaxTriviaEntry));
+    }
+
+    SyntaxList* SyntaxFactory::AllocateList(memory::LinearAllocator& allocator, size_t count)
+    {
+        WEAVE_ASSERT(count <= std::numeric_limits<uint32_t>::max());
+
+        memory::Allocation const allocation = allocator.Allocate(memory::Layout{
+            .Size = SyntaxList::GetAllocationSize(count),
+            .Alignment = alignof(SyntaxList),
+        });
+
+        return new (allocation.Address) SyntaxList{static_cast<uint32_t>(count)};
+    }
+
+    SyntaxTriviaRange SyntaxFactory::CreateTrivia(
+        source::SourceSpan const& source,
+        std::span<SyntaxTrivia const> leadingTrivia,
+        std::span<SyntaxTrivia const> trailingTrivia)
     {
-        if (not trivia.empty())
+        if (leadingTrivia.empty() and trailingTrivia.empty())
         {
-            // Allocate builder of trivia nodes
-            std::span<SyntaxTrivia> const nodes = this->TriviaAllocator.EmplaceArray(trivia);
+            return {};
+        }
 
-            std::span<SyntaxNode*> const builder = this->SyntaxNodeAllocator.EmplaceArray<SyntaxNode*>(nodes.size());
+        constexpr size_t MaxCount = std::numeric_limits<uint16_t>::max();
 
-            for (size_t i = 0; i < nodes.size(); ++i)
+        size_t const capacity = this->TriviaEntries.capacity();
+        size_t const index = this->TriviaEntries.size();
+
+        WEAVE_ASSERT(index <= std::numeric_limits<uint32_t>::max());
+
+        // Gaps between trivia are left by lexer modes skipping some trivia. Positions of leading trivia are computed
+        // backwards from the start of the token, so gaps after each of them are recorded.
+        for (size_t i = 0; i < leadingTrivia.size(); ++i)
+        {
+            SyntaxTrivia const& trivia = leadingTrivia[i];
+
+            this->TriviaEntries.push_back({trivia.Kind, trivia.Source.End.Offset - trivia.Source.Start.Offset});
+
+            uint32_t const next = ((i + 1) < leadingTrivia.size()) ? leadingTrivia[i + 1].Source.Start.Offset : source.Start.Offset;
+
+            if (uint32_t const gap = next - trivia.Source.End.Offset; gap != 0)
             {
-                builder[i] = static_cast<SyntaxNode*>(&nodes[i]);
+                this->TriviaEntries.push_back({SyntaxKind::None, gap});
             }
+        }
+
+        size_t leading = this->TriviaEntries.size() - index;
 
-            // Allocate builder of pointers to the nodes
-            return SyntaxListView<SyntaxTrivia>{this->CreateList(builder)};
+        if (leading > MaxCount)
+        {
+            // Fold entries furthest from the token into skipped text; positions of remaining ones stay valid.
+            size_t const folded = leading - MaxCount + 1;
+            uint32_t length = 0;
+
+            for (size_t i = 0; i < folded; ++i)
+            {
+                length += this->TriviaEntries[index + i].Length;
+            }
+
+            this->TriviaEntries[index] = {SyntaxKind::None, length};
+            this->TriviaEntries.erase(this->TriviaEntries.begin() + static_cast<ptrdiff_t>(index + 1), this->TriviaEntries.begin() + static_cast<ptrdiff_t>(index + folded));
+            leading = MaxCount;
         }
 
-        return SyntaxListView<SyntaxTrivia>{nullptr};
+        // Positions of trailing trivia are computed forward from the end of the token.
+        uint32_t position = source.End.Offset;
+
+        for (SyntaxTrivia const& trivia : trailingTrivia)
+        {
+            if ((this->TriviaEntries.size() - index - leading + 2) > MaxCount)
+            {
+                // Drop trivia furthest from the token.
+                break;
+            }
+
+            if (uint32_t const gap = trivia.Source.Start.Offset - position; gap != 0)
+            {
+                this->TriviaEntries.push_back({SyntaxKind::None, gap});
+            }
+
+            this->TriviaEntries.push_back({trivia.Kind, trivia.Source.End.Offset - trivia.Source.Start.Offset});
+            position = trivia.Source.End.Offset;
+        }
+
+        if (size_t const grown = this->TriviaEntries.capacity(); grown != capacity)
+        {
+            this->TriviaEntriesArena->Deallocated(capacity * sizeof(SyntaxTriviaEntry));
+            this->TriviaEntriesArena->Allocated(grown * sizeof(SyntaxTriviaEntry));
+        }
+
+        return SyntaxTriviaRange{
+            .Index = static_cast<uint32_t>(index),
+            .LeadingCount = static_cast<uint16_t>(leading),
+            .TrailingCount = static_cast<uint16_t>(this->TriviaEntries.size() - index - leading),
+        };
+    }
+
+    SyntaxListView<SyntaxTrivia> SyntaxFactory::CreateTriviaList(
+        source::SourcePosition start,
+        std::span<SyntaxTriviaEntry const> entries)
+    {
+        size_t count = 0;
+
+        for (SyntaxTriviaEntry const& entry : entries)
+        {
+            if (entry.Kind != SyntaxKind::None)
+            {
+                ++count;
+            }
+        }
+
+        if (count == 0)
+        {
+            return SyntaxListView<SyntaxTrivia>{nullptr};
+        }
+
+        SyntaxList* const result = AllocateList(this->TriviaListAllocator, count);
+        SyntaxNode** const elements = result->GetElements();
+
+        uint32_t position = start.Offset;
+        size_t index = 0;
+
+        for (SyntaxTriviaEntry const& entry : entries)
+        {
+            uint32_t const end = position + entry.Length;
+
+            if (entry.Kind != SyntaxKind::None)
+            {
+                elements[index++] = this->TriviaAllocator.Emplace(entry.Kind, source::SourceSpan{{position}, {end}});
+            }
+
+            position = end;
+        }
+
+        return SyntaxListView<SyntaxTrivia>{result};
+    }
+
+    SyntaxListView<SyntaxTrivia> SyntaxFactory::GetLeadingTrivia(SyntaxToken const* token)
+    {
+        if (token->LeadingTriviaCount == 0)
+        {
+            return SyntaxListView<SyntaxTrivia>{nullptr};
+        }
+
+        auto [it, inserted] = this->TriviaLists.try_emplace(token->TriviaIndex);
+
+        if (inserted)
+        {
+            std::span<SyntaxTriviaEntry const> const entries = this->GetLeadingTriviaEntries(token);
+
+            uint32_t length = 0;
+
+            for (SyntaxTriviaEntry const& entry : entries)
+            {
+                length += entry.Length;
+            }
+
+            it->second = this->CreateTriviaList(source::SourcePosition{token->Source.Start.Offset - length}, entries).GetNode();
+        }
+
+        return SyntaxListView<SyntaxTrivia>{it->second};
+    }
+
+    SyntaxListView<SyntaxTrivia> SyntaxFactory::GetTrailingTrivia(SyntaxToken const* token)
+    {
+        if (token->TrailingTriviaCount == 0)
+        {
+            return SyntaxListView<SyntaxTrivia>{nullptr};
+        }
+
+        auto [it, inserted] = this->TriviaLists.try_emplace(token->TriviaIndex + token->LeadingTriviaCount);
+
+        if (inserted)
+        {
+            it->second = this->CreateTriviaList(token->Source.End, this->GetTrailingTriviaEntries(token)).GetNode();
+        }
+
+        return SyntaxListView<SyntaxTrivia>{it->second};
     }
 
     SyntaxToken* SyntaxFactory::CreateToken(
@@ -37,8 +222,7 @@ namespace weave::syntax
         return this->TokenAllocator.Emplace(
             kind,
             source,
-            SyntaxListView<SyntaxTrivia>{},
-            SyntaxListView<SyntaxTrivia>{});
+            SyntaxTriviaRange{});
     }
 
     SyntaxToken* SyntaxFactory::CreateToken(
@@ -56,15 +240,13 @@ namespace weave::syntax
         return this->TokenAllocator.Emplace(
             kind,
             source,
-            this->CreateTriviaList(leadingTrivia),
-            this->CreateTriviaList(trailingTrivia));
+            this->CreateTrivia(source, leadingTrivia, trailingTrivia));
     }
 
     SyntaxToken* SyntaxFactory::CreateToken(
         SyntaxKind kind,
         source::SourceSpan const& source,
-        SyntaxListView<SyntaxTrivia> leadingTrivia,
-        SyntaxListView<SyntaxTrivia> trailingTrivia)
+        SyntaxTriviaRange trivia)
     {
         WEAVE_ASSERT(kind != SyntaxKind::IdentifierToken);
         WEAVE_ASSERT(kind != SyntaxKind::IntegerLiteralToken);
@@ -75,22 +257,19 @@ namespace weave::syntax
         return this->TokenAllocator.Emplace(
             kind,
             source,
-            leadingTrivia,
-            trailingTrivia);   
+            trivia);   
     }
 
     SyntaxToken* SyntaxFactory::CreateMissingToken(
         SyntaxKind kind,
         source::SourceSpan const& source,
-        SyntaxListView<SyntaxTrivia> leadingTrivia,
-        SyntaxListView<SyntaxTrivia> trailingTrivia)
+        SyntaxTriviaRange trivia)
     {
         if (kind == SyntaxKind::CharacterLiteralToken)
         {
             return this->CharacterLiteralAllocator.Emplace(
                 source,
-                leadingTrivia,
-                trailingTrivia,
+                trivia,
                 LiteralPrefixKind::Default,
                 char32_t{},
                 SyntaxTokenFlags::Missing);
@@ -100,11 +279,10 @@ namespace weave::syntax
         {
             return this->FloatLiteralAllocator.Emplace(
                 source,
-                leadingTrivia,
-                trailingTrivia,
+                trivia,
                 LiteralPrefixKind::Default,
-                std::string_view{},
-                std::string_view{},
+                stringpool::SymbolId::None,
+                stringpool::SymbolId::None,
                 SyntaxTokenFlags::Missing);
         }
 
@@ -112,11 +290,10 @@ namespace weave::syntax
         {
             return this->IntegerLiteralAllocator.Emplace(
                 source,
-                leadingTrivia,
-                trailingTrivia,
+                trivia,
                 LiteralPrefixKind::Default,
-                std::string_view{},
-                std::string_view{},
+                stringpool::SymbolId::None,
+                stringpool::SymbolId::None,
                 SyntaxTokenFlags::Missing);
         }
 
@@ -124,18 +301,16 @@ namespace weave::syntax
         {
             return this->IdentifierAllocator.Emplace(
                 source,
-                leadingTrivia,
-                trailingTrivia,
+                trivia,
                 SyntaxKind::None,
-                std::string_view{},
+                stringpool::SymbolId::None,
                 SyntaxTokenFlags::Missing);
         }
 
         return this->TokenAllocator.Emplace(
             kind,
             source,
-            leadingTrivia,
-            trailingTrivia,
+            trivia,
             SyntaxTokenFlags::Missing);
     }
 
@@ -145,10 +320,9 @@ namespace weave::syntax
     {
         return this->IdentifierAllocator.Emplace(
             source,
-            SyntaxListView<SyntaxTrivia>{},
-            SyntaxListView<SyntaxTrivia> {},
+            SyntaxTriviaRange{},
             kind,
-            std::string_view{},
+            stringpool::SymbolId::None,
             SyntaxTokenFlags::Missing);
     }
 
@@ -161,8 +335,7 @@ namespace weave::syntax
         return this->CreateMissingToken(
             kind,
             source,
-            this->CreateTriviaList(leadingTrivia),
-            this->CreateTriviaList(trailingTrivia));
+            this->CreateTrivia(source, leadingTrivia, trailingTrivia));
     }
 
     CharacterLiteralSyntaxToken* SyntaxFactory::CreateCharacterLiteralToken(
@@ -174,8 +347,7 @@ namespace weave::syntax
     {
         return this->CharacterLiteralAllocator.Emplace(
             source,
-            this->CreateTriviaList(leadingTrivia),
-            this->CreateTriviaList(trailingTrivia),
+            this->CreateTrivia(source, leadingTrivia, trailingTrivia),
             prefix,
             value);
     }
@@ -189,10 +361,9 @@ namespace weave::syntax
     {
         return this->StringLiteralAllocator.Emplace(
             source,
-            this->CreateTriviaList(leadingTrivia),
-            this->CreateTriviaList(trailingTrivia),
+            this->CreateTrivia(source, leadingTrivia, trailingTrivia),
             prefix,
-            this->Strings.Get(value));
+            this->GetSymbol(value));
     }
 
     FloatLiteralSyntaxToken* SyntaxFactory::CreateFloatLiteralToken(
@@ -205,11 +376,10 @@ namespace weave::syntax
     {
         return this->FloatLiteralAllocator.Emplace(
             source,
-            this->CreateTriviaList(leadingTrivia),
-            this->CreateTriviaList(trailingTrivia),
+            this->CreateTrivia(source, leadingTrivia, trailingTrivia),
             prefix,
-            this->Strings.Get(value),
-            this->Strings.Get(suffix));
+            this->GetSymbol(value),
+            this->GetSymbol(suffix));
     }
 
     IntegerLiteralSyntaxToken* SyntaxFactory::CreateIntegerLiteralToken(
@@ -222,11 +392,10 @@ namespace weave::syntax
     {
         return this->IntegerLiteralAllocator.Emplace(
             source,
-            this->CreateTriviaList(leadingTrivia),
-            this->CreateTriviaList(trailingTrivia),
+            this->CreateTrivia(source, leadingTrivia, trailingTrivia),
             prefix,
-            this->Strings.Get(value),
-            this->Strings.Get(suffix));
+            this->GetSymbol(value),
+            this->GetSymbol(suffix));
     }
 
     IdentifierSyntaxToken* SyntaxFactory::CreateIdentifierToken(
@@ -238,10 +407,30 @@ namespace weave::syntax
     {
         return this->IdentifierAllocator.Emplace(
             source,
-            this->CreateTriviaList(leadingTrivia),
-            this->CreateTriviaList(trailingTrivia),
+            this->CreateTrivia(source, leadingTrivia, trailingTrivia),
             contextualKeyword,
-            this->Strings.Get(value));
+            this->GetSymbol(value));
+    }
+
+    stringpool::SymbolId SyntaxFactory::GetSymbol(std::string_view value)
+    {
+        ++this->SymbolReferences;
+        return this->Strings.GetSymbol(value);
+    }
+
+    void SyntaxFactory::QueryTokensMemoryUsage(size_t& allocated, size_t& reserved) const
+    {
+        this->TokenAllocator.QueryMemoryUsage(allocated, reserved);
+        this->TriviaAllocator.QueryMemoryUsage(allocated, reserved);
+        this->TriviaListAllocator.QueryMemoryUsage(allocated, reserved);
+
+        allocated += this->TriviaEntries.size() * sizeof(SyntaxTriviaEntry);
+        reserved += this->TriviaEntries.capacity() * sizeof(SyntaxTriviaEntry);
+        this->CharacterLiteralAllocator.QueryMemoryUsage(allocated, reserved);
+        this->StringLiteralAllocator.QueryMemoryUsage(allocated, reserved);
+        this->FloatLiteralAllocator.QueryMemoryUsage(allocated, reserved);
+        this->IntegerLiteralAllocator.QueryMemoryUsage(allocated, reserved);
+        this->IdentifierAllocator.QueryMemoryUsage(allocated, reserved);
     }
 
     void SyntaxFactory::DebugDump()
@@ -269,7 +458,26 @@ namespace weave::syntax
         dump(this->IntegerLiteralAllocator, "IntegerLiteralAllocator");
         dump(this->IdentifierAllocator, "IdentifierAllocator");
         dump(this->SyntaxNodeAllocator, "SyntaxNodeAllocator");
+        dump(this->TriviaListAllocator, "TriviaListAllocator");
+
+        fmt::println("{:>30}: (allocated: {:>9}, reserved: {:>9})",
+            "TriviaEntries",
+            this->TriviaEntries.size() * sizeof(SyntaxTriviaEntry),
+            this->TriviaEntries.capacity() * sizeof(SyntaxTriviaEntry));
+
+        totalAllocated += this->TriviaEntries.size() * sizeof(SyntaxTriviaEntry);
+        totalReserved += this->TriviaEntries.capacity() * sizeof(SyntaxTriviaEntry);
 
         fmt::println("Total: (allocated: {}, reserved: {})", totalAllocated, totalReserved);
+
+        // Tokens referenced strings by view before symbols were introduced.
+        size_t const symbolsSize = this->SymbolReferences * sizeof(stringpool::SymbolId);
+        size_t const viewsSize = this->SymbolReferences * sizeof(std::string_view);
+
+        fmt::println("Symbols: (unique: {}, references: {}, size: {}, saved: {})",
+            this->Strings.GetCount(),
+            this->SymbolReferences,
+            symbolsSize,
+            viewsSize - symbolsSize);
     }
 }
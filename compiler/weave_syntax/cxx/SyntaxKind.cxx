@@ -1,5 +1,5 @@
 #include "weave/syntax/SyntaxKind.hxx"
-#include "weave/hash/Fnv1a.hxx"
+#include "weave/hash/WyHash.hxx"
 #include "weave/bugcheck/Assert.hxx"
 
 #include <utility>
@@ -154,66 +154,190 @@ namespace weave::syntax
 
         return false;
     }
+}
+
+namespace weave::syntax::impl
+{
+    // Keywords are recognized with a minimal perfect hash built at compile time using hash and displace method:
+    // keywords are first distributed to buckets, then for each bucket a seed is searched which maps all keywords of
+    // that bucket to unused slots of the table. Lookup computes hash of the identifier once, then probes exactly one
+    // slot.
 
-    struct KeywordMappingEntry
+    struct KeywordEntry final
     {
-        std::string_view Spelling;
-        SyntaxKind Kind;
-        uint64_t Hash;
+        std::string_view Spelling{};
+        SyntaxKind Kind{};
     };
 
-    constexpr auto c_KeywordLookup = []()  // NOLINT(fuchsia-statically-constructed-objects)
-    {
-        auto result = std::array{
-#define WEAVE_SYNTAX_CONTEXTUAL_KEYWORD(name, spelling) KeywordMappingEntry{spelling, SyntaxKind::name, hash::Fnv1a64::FromString(spelling)},
-#define WEAVE_SYNTAX_KEYWORD(name, spelling) KeywordMappingEntry{spelling, SyntaxKind::name, hash::Fnv1a64::FromString(spelling)},
+    inline constexpr auto c_Keywords = std::array{
+#define WEAVE_SYNTAX_CONTEXTUAL_KEYWORD(name, spelling) KeywordEntry{spelling, SyntaxKind::name},
+#define WEAVE_SYNTAX_KEYWORD(name, spelling) KeywordEntry{spelling, SyntaxKind::name},
 #include "weave/syntax/SyntaxKind.inl"
-        };
+    };
+
+    inline constexpr size_t KeywordSlotCount = c_Keywords.size();
+    inline constexpr size_t KeywordBucketCount = (KeywordSlotCount + 1) / 2;
+
+    // Lengths of keywords are tracked in 64-bit mask.
+    inline constexpr size_t KeywordMaxLength = 63;
+
+    constexpr uint64_t KeywordMix(uint64_t value)
+    {
+        value ^= value >> 33u;
+        value *= 0xFF51AFD7ED558CCDu;
+        value ^= value >> 33u;
+        return value;
+    }
+
+    constexpr size_t KeywordBucket(uint64_t hash)
+    {
+        return static_cast<size_t>(KeywordMix(hash) % KeywordBucketCount);
+    }
+
+    constexpr size_t KeywordSlot(uint64_t hash, uint16_t seed)
+    {
+        return static_cast<size_t>(KeywordMix(hash ^ (seed * 0x9E3779B97F4A7C15u)) % KeywordSlotCount);
+    }
+
+    struct KeywordTable final
+    {
+        std::array<KeywordEntry, KeywordSlotCount> Slots{};
+        std::array<uint16_t, KeywordBucketCount> Seeds{};
+
+        // Prefilter - bit set for each length and first character of any keyword.
+        uint64_t Lengths{};
+        std::array<uint64_t, 4> FirstCharacters{};
 
-        std::sort(result.begin(), result.end(), [](KeywordMappingEntry const& lhs, KeywordMappingEntry const& rhs)
+        bool Valid{};
+    };
+
+    consteval KeywordTable BuildKeywordTable()
+    {
+        KeywordTable result{};
+
+        std::array<uint64_t, KeywordSlotCount> hashes{};
+        std::array<size_t, KeywordBucketCount> sizes{};
+
+        for (size_t i = 0; i < KeywordSlotCount; ++i)
+        {
+            std::string_view const spelling = c_Keywords[i].Spelling;
+
+            if (spelling.empty() or (spelling.size() > KeywordMaxLength))
             {
-                if (lhs.Hash == rhs.Hash)
+                return result;
+            }
+
+            unsigned char const first = static_cast<unsigned char>(spelling.front());
+            result.Lengths |= uint64_t{1} << spelling.size();
+            result.FirstCharacters[first >> 6u] |= uint64_t{1} << (first & 63u);
+
+            hashes[i] = hash::WyHash64::FromString(spelling);
+            ++sizes[KeywordBucket(hashes[i])];
+        }
+
+        // Place largest buckets first, while most of the slots are still free.
+        std::array<size_t, KeywordBucketCount> order{};
+
+        for (size_t i = 0; i < KeywordBucketCount; ++i)
+        {
+            order[i] = i;
+        }
+
+        std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs)
+            {
+                return (sizes[lhs] != sizes[rhs]) ? (sizes[lhs] > sizes[rhs]) : (lhs < rhs);
+            });
+
+        std::array<bool, KeywordSlotCount> used{};
+
+        for (size_t const bucket : order)
+        {
+            if (sizes[bucket] == 0)
+            {
+                break;
+            }
+
+            bool placed = false;
+
+            for (uint16_t seed = 1; (seed != 0) and not placed; ++seed)
+            {
+                std::array<bool, KeywordSlotCount> taken = used;
+                placed = true;
+
+                for (size_t i = 0; i < KeywordSlotCount; ++i)
                 {
-                    if (lhs.Spelling.size() == rhs.Spelling.size())
+                    if (KeywordBucket(hashes[i]) == bucket)
                     {
-                        return lhs.Spelling < rhs.Spelling;
+                        size_t const slot = KeywordSlot(hashes[i], seed);
+
+                        if (taken[slot])
+                        {
+                            placed = false;
+                            break;
+                        }
+
+                        taken[slot] = true;
                     }
+                }
+
+                if (placed)
+                {
+                    used = taken;
+                    result.Seeds[bucket] = seed;
 
-                    return lhs.Spelling.size() < rhs.Spelling.size();
+                    for (size_t i = 0; i < KeywordSlotCount; ++i)
+                    {
+                        if (KeywordBucket(hashes[i]) == bucket)
+                        {
+                            result.Slots[KeywordSlot(hashes[i], seed)] = c_Keywords[i];
+                        }
+                    }
                 }
+            }
 
-                return lhs.Hash < rhs.Hash;
-            });
+            if (not placed)
+            {
+                return result;
+            }
+        }
 
+        result.Valid = true;
         return result;
-    }();
+    }
+
+    inline constexpr KeywordTable c_KeywordTable = BuildKeywordTable();
+
+    static_assert(c_KeywordTable.Valid, "Failed to build perfect hash for keywords");
+}
 
+namespace weave::syntax
+{
     std::optional<SyntaxKind> TryMapIdentifierToKeyword(std::string_view value)
     {
-        uint64_t const hash = hash::Fnv1a64::FromString(value);
+        impl::KeywordTable const& table = impl::c_KeywordTable;
 
-        auto const first = c_KeywordLookup.begin();
-        auto const last = c_KeywordLookup.end();
+        // Reject most identifiers without hashing them.
+        if ((value.size() > impl::KeywordMaxLength) or (((table.Lengths >> value.size()) & 1u) == 0))
+        {
+            return {};
+        }
 
-        auto it = std::lower_bound(
-            first,
-            last,
-            hash,
-            [&](KeywordMappingEntry const& e, uint64_t h)
-            {
-                return e.Hash < h;
-            });
+        unsigned char const first = static_cast<unsigned char>(value.front());
 
-        while ((it != last) and (it->Hash == hash))
+        if (((table.FirstCharacters[first >> 6u] >> (first & 63u)) & 1u) == 0)
         {
-            if (it->Spelling == value)
-            {
-                return it->Kind;
-            }
-            ++it;
+            return {};
+        }
+
+        uint64_t const hash = hash::WyHash64::FromString(value);
+
+        impl::KeywordEntry const& entry = table.Slots[impl::KeywordSlot(hash, table.Seeds[impl::KeywordBucket(hash)])];
+
+        if (entry.Spelling == value)
+        {
+            return entry.Kind;
         }
 
         return {};
     }
-
 }
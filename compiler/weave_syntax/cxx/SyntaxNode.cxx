@@ -3,4 +3,9 @@
 namespace weave::syntax
 {
     static_assert(std::is_trivially_destructible_v<SyntaxNode>);
+
+    // Elements follow the list directly, without padding.
+    static_assert(sizeof(SyntaxList) == 8);
+    static_assert(alignof(SyntaxList) == alignof(SyntaxNode*));
+    static_assert(std::is_trivially_destructible_v<SyntaxList>);
 }
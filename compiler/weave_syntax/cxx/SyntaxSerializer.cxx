@@ -0,0 +1,707 @@
+#include "weave/syntax/SyntaxSerializer.hxx"
+#include "weave/syntax/SyntaxChildren.hxx"
+#include "weave/syntax/SyntaxFactory.hxx"
+#include "weave/bitwise/CompressedInteger.hxx"
+#include "weave/Bitwise.hxx"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace weave::syntax
+{
+    namespace
+    {
+        // Format is changed whenever layout of records changes.
+        constexpr uint32_t FormatSignature = 0x54535657; // "WVST"
+        constexpr uint32_t FormatVersion = 1;
+
+        // Number of syntax kinds; serialized trees are rejected when kinds were added or removed.
+        constexpr uint32_t SyntaxKindCount = 0
+#define WEAVE_SYNTAX(name, spelling) +1
+#include "weave/syntax/SyntaxKind.inl"
+            ;
+
+        // Header is followed by the root node record.
+        struct SerializedHeader final
+        {
+            uint32_t Signature;
+            uint32_t Version;
+            uint32_t KindCount;
+            uint32_t SymbolCount;
+            uint32_t TriviaCount;
+            uint32_t NodeCount;
+        };
+
+        constexpr size_t SerializedHeaderSize = 6 * sizeof(uint32_t);
+
+        // Longest encoding of compressed integer.
+        constexpr size_t MaxCompressedIntegerSize = 8;
+
+        // Reader recurses for each level of nested nodes; deeper input is rejected before it exhausts the stack.
+        constexpr uint32_t MaxNestingDepth = 1024;
+    }
+
+    class SyntaxTreeWriter final
+    {
+    private:
+        std::vector<std::byte>& _output;
+        SyntaxFactory const& _factory;
+
+        // Serialized index of symbols, by symbol id; zero for symbols not written yet.
+        std::vector<uint32_t> _symbols{};
+
+        SerializedHeader _header{};
+
+        // End of previously written token.
+        uint32_t _position{};
+
+    public:
+        SyntaxTreeWriter(std::vector<std::byte>& output, SyntaxFactory const& factory)
+            : _output{output}
+            , _factory{factory}
+        {
+        }
+
+    public:
+        void Write(SourceFileSyntax* root)
+        {
+            size_t const start = this->_output.size();
+            this->_output.resize(start + SerializedHeaderSize);
+
+            this->Dispatch(root);
+
+            this->_header.Signature = FormatSignature;
+            this->_header.Version = FormatVersion;
+            this->_header.KindCount = SyntaxKindCount;
+
+            std::byte* const header = this->_output.data() + start;
+            bitwise::StoreUnalignedLittleEndian<uint32_t>(header + 0, this->_header.Signature);
+            bitwise::StoreUnalignedLittleEndian<uint32_t>(header + 4, this->_header.Version);
+            bitwise::StoreUnalignedLittleEndian<uint32_t>(header + 8, this->_header.KindCount);
+            bitwise::StoreUnalignedLittleEndian<uint32_t>(header + 12, this->_header.SymbolCount);
+            bitwise::StoreUnalignedLittleEndian<uint32_t>(header + 16, this->_header.TriviaCount);
+            bitwise::StoreUnalignedLittleEndian<uint32_t>(header + 20, this->_header.NodeCount);
+        }
+
+        void Dispatch(SyntaxNode* node)
+        {
+            if (node == nullptr)
+            {
+                // Empty slot.
+                this->WriteUnsigned(std::to_underlying(SyntaxKind::None));
+                return;
+            }
+
+            ++this->_header.NodeCount;
+            this->WriteUnsigned(std::to_underlying(node->Kind));
+
+            if (SyntaxList const* const list = node->TryCast<SyntaxList>(); list != nullptr)
+            {
+                this->WriteUnsigned(list->GetCount());
+            }
+
+            switch (node->Kind) // NOLINT(clang-diagnostic-switch-enum)
+            {
+#define WEAVE_SYNTAX_NODE(name, spelling) \
+    case SyntaxKind::name: \
+        DispatchChildren(static_cast<name*>(node), *this); \
+        break;
+#include "weave/syntax/SyntaxKind.inl"
+
+            default:
+                WEAVE_ASSERT(IsToken(node->Kind));
+                this->WriteToken(static_cast<SyntaxToken const*>(node));
+                break;
+            }
+        }
+
+    private:
+        void WriteUnsigned(uint64_t value)
+        {
+            if (value < 0x80u)
+            {
+                // Single byte encoding.
+                this->_output.push_back(static_cast<std::byte>(value));
+                return;
+            }
+
+            uint8_t buffer[MaxCompressedIntegerSize];
+            size_t const written = bitwise::EncodeUnsigned(value, std::begin(buffer), std::end(buffer));
+            WEAVE_ASSERT(written != 0);
+
+            std::byte const* const bytes = reinterpret_cast<std::byte const*>(buffer);
+            this->_output.insert(this->_output.end(), bytes, bytes + written);
+        }
+
+        void WriteSigned(int64_t value)
+        {
+            uint8_t buffer[MaxCompressedIntegerSize];
+            size_t const written = bitwise::EncodeSigned(value, std::begin(buffer), std::end(buffer));
+            WEAVE_ASSERT(written != 0);
+
+            std::byte const* const bytes = reinterpret_cast<std::byte const*>(buffer);
+            this->_output.insert(this->_output.end(), bytes, bytes + written);
+        }
+
+        void WriteSymbol(stringpool::SymbolId symbol)
+        {
+            if (symbol == stringpool::SymbolId::None)
+            {
+                this->WriteUnsigned(0);
+                return;
+            }
+
+            size_t const id = static_cast<size_t>(symbol);
+
+            if (id >= this->_symbols.size())
+            {
+                this->_symbols.resize(id + 1);
+            }
+
+            uint32_t& index = this->_symbols[id];
+
+            if (index != 0)
+            {
+                this->WriteUnsigned(index);
+                return;
+            }
+
+            // First reference to the symbol defines it with its text.
+            index = ++this->_header.SymbolCount;
+            this->WriteUnsigned(index);
+
+            std::string_view const text = this->_factory.GetText(symbol);
+            this->WriteUnsigned(text.size());
+
+            std::byte const* const bytes = reinterpret_cast<std::byte const*>(text.data());
+            this->_output.insert(this->_output.end(), bytes, bytes + text.size());
+        }
+
+        void WriteTrivia(std::span<SyntaxTriviaEntry const> entries)
+        {
+            for (SyntaxTriviaEntry const& entry : entries)
+            {
+                this->WriteUnsigned(std::to_underlying(entry.Kind));
+                this->WriteUnsigned(entry.Length);
+            }
+
+            this->_header.TriviaCount += static_cast<uint32_t>(entries.size());
+        }
+
+        void WriteToken(SyntaxToken const* token)
+        {
+            this->WriteUnsigned(std::to_underlying(static_cast<SyntaxTokenFlags>(token->Flags)));
+
+            // Missing tokens may start before the end of previous token.
+            this->WriteSigned(static_cast<int64_t>(token->Source.Start.Offset) - static_cast<int64_t>(this->_position));
+            this->WriteUnsigned(token->Source.End.Offset - token->Source.Start.Offset);
+            this->_position = token->Source.End.Offset;
+
+            this->WriteUnsigned(token->LeadingTriviaCount);
+            this->WriteUnsigned(token->TrailingTriviaCount);
+            this->WriteTrivia(this->_factory.GetLeadingTriviaEntries(token));
+            this->WriteTrivia(this->_factory.GetTrailingTriviaEntries(token));
+
+            switch (token->Kind) // NOLINT(clang-diagnostic-switch-enum)
+            {
+            case SyntaxKind::IdentifierToken:
+                {
+                    IdentifierSyntaxToken const* const identifier = static_cast<IdentifierSyntaxToken const*>(token);
+                    this->WriteUnsigned(std::to_underlying(identifier->ContextualKeyowrd));
+                    this->WriteSymbol(identifier->Identifier);
+                    break;
+                }
+
+            case SyntaxKind::IntegerLiteralToken:
+                {
+                    IntegerLiteralSyntaxToken const* const literal = static_cast<IntegerLiteralSyntaxToken const*>(token);
+                    this->WriteUnsigned(std::to_underlying(literal->Prefix));
+                    this->WriteSymbol(literal->Value);
+                    this->WriteSymbol(literal->Suffix);
+                    break;
+                }
+
+            case SyntaxKind::FloatLiteralToken:
+                {
+                    FloatLiteralSyntaxToken const* const literal = static_cast<FloatLiteralSyntaxToken const*>(token);
+                    this->WriteUnsigned(std::to_underlying(literal->Prefix));
+                    this->WriteSymbol(literal->Value);
+                    this->WriteSymbol(literal->Suffix);
+                    break;
+                }
+
+            case SyntaxKind::StringLiteralToken:
+                {
+                    StringLiteralSyntaxToken const* const literal = static_cast<StringLiteralSyntaxToken const*>(token);
+                    this->WriteUnsigned(std::to_underlying(literal->Prefix));
+                    this->WriteSymbol(literal->Value);
+                    break;
+                }
+
+            case SyntaxKind::CharacterLiteralToken:
+                {
+                    CharacterLiteralSyntaxToken const* const literal = static_cast<CharacterLiteralSyntaxToken const*>(token);
+                    this->WriteUnsigned(std::to_underlying(literal->Prefix));
+                    this->WriteUnsigned(literal->Value);
+                    break;
+                }
+
+            default:
+                break;
+            }
+        }
+    };
+
+    class SyntaxTreeReader final
+    {
+    private:
+        // Binds child slots of restored node to nodes read from the input.
+        struct SlotReader final
+        {
+            SyntaxTreeReader& Reader;
+
+            template <typename NodeT>
+            void Dispatch(NodeT*& slot)
+            {
+                slot = this->Reader.ReadChild<NodeT>();
+            }
+        };
+
+    private:
+        SyntaxFactory& _factory;
+        uint8_t const* _first;
+        uint8_t const* _last;
+
+        // Restored symbols, by serialized index minus one.
+        std::vector<stringpool::SymbolId> _symbols{};
+
+        // Remaining number of entities declared by the header.
+        uint32_t _symbolCount{};
+        uint32_t _triviaCount{};
+        uint32_t _nodeCount{};
+
+        // End of previously read token.
+        uint32_t _position{};
+
+        // Number of nodes being read.
+        uint32_t _depth{};
+
+        bool _failed{};
+
+    public:
+        SyntaxTreeReader(SyntaxFactory& factory, std::span<std::byte const> input)
+            : _factory{factory}
+            , _first{reinterpret_cast<uint8_t const*>(input.data())}
+            , _last{reinterpret_cast<uint8_t const*>(input.data() + input.size())}
+        {
+        }
+
+    public:
+        SourceFileSyntax* Read()
+        {
+            if (static_cast<size_t>(this->_last - this->_first) < SerializedHeaderSize)
+            {
+                return nullptr;
+            }
+
+            SerializedHeader const header{
+                .Signature = bitwise::LoadUnalignedLittleEndian<uint32_t>(this->_first + 0),
+                .Version = bitwise::LoadUnalignedLittleEndian<uint32_t>(this->_first + 4),
+                .KindCount = bitwise::LoadUnalignedLittleEndian<uint32_t>(this->_first + 8),
+                .SymbolCount = bitwise::LoadUnalignedLittleEndian<uint32_t>(this->_first + 12),
+                .TriviaCount = bitwise::LoadUnalignedLittleEndian<uint32_t>(this->_first + 16),
+                .NodeCount = bitwise::LoadUnalignedLittleEndian<uint32_t>(this->_first + 20),
+            };
+
+            this->_first += SerializedHeaderSize;
+
+            if ((header.Signature != FormatSignature) or (header.Version != FormatVersion) or (header.KindCount != SyntaxKindCount))
+            {
+                return nullptr;
+            }
+
+            // Each symbol, trivia entry and node takes at least one byte, so counts are bounded by size of the input
+            // before any storage is reserved for them.
+            size_t const remaining = static_cast<size_t>(this->_last - this->_first);
+
+            if ((header.SymbolCount > remaining) or (header.TriviaCount > remaining) or (header.NodeCount > remaining))
+            {
+                return nullptr;
+            }
+
+            this->_symbolCount = header.SymbolCount;
+            this->_triviaCount = header.TriviaCount;
+            this->_nodeCount = header.NodeCount;
+            this->_symbols.reserve(header.SymbolCount);
+            this->ReserveTrivia(header.TriviaCount);
+
+            SourceFileSyntax* const root = this->ReadChild<SourceFileSyntax>();
+
+            if (this->_failed or (this->_first != this->_last) or (this->_nodeCount != 0))
+            {
+                return nullptr;
+            }
+
+            return root;
+        }
+
+    private:
+        void Fail()
+        {
+            this->_failed = true;
+
+            // Stop reading remaining records.
+            this->_first = this->_last;
+        }
+
+        uint64_t ReadUnsigned()
+        {
+            // Most of values are kinds, counts and lengths encoded in a single byte.
+            if ((this->_first != this->_last) and ((*this->_first & 0x80u) == 0))
+            {
+                return *this->_first++;
+            }
+
+            uint64_t result{};
+            size_t const read = bitwise::DecodeUnsigned(result, this->_first, this->_last);
+
+            if (read == 0)
+            {
+                this->Fail();
+                return 0;
+            }
+
+            this->_first += read;
+            return result;
+        }
+
+        int64_t ReadSigned()
+        {
+            int64_t result{};
+            size_t const read = bitwise::DecodeSigned(result, this->_first, this->_last);
+
+            if (read == 0)
+            {
+                this->Fail();
+                return 0;
+            }
+
+            this->_first += read;
+            return result;
+        }
+
+        SyntaxKind ReadKind()
+        {
+            uint64_t const value = this->ReadUnsigned();
+
+            if (value >= SyntaxKindCount)
+            {
+                this->Fail();
+                return SyntaxKind::None;
+            }
+
+            return static_cast<SyntaxKind>(value);
+        }
+
+        LiteralPrefixKind ReadPrefix()
+        {
+            uint64_t const value = this->ReadUnsigned();
+
+            if (value > std::to_underlying(LiteralPrefixKind::Hexadecimal))
+            {
+                this->Fail();
+                return LiteralPrefixKind::Default;
+            }
+
+            return static_cast<LiteralPrefixKind>(value);
+        }
+
+        stringpool::SymbolId ReadSymbol()
+        {
+            uint64_t const index = this->ReadUnsigned();
+
+            if (index == 0)
+            {
+                return stringpool::SymbolId::None;
+            }
+
+            if (index <= this->_symbols.size())
+            {
+                return this->_symbols[index - 1];
+            }
+
+            if ((index != (this->_symbols.size() + 1)) or (this->_symbolCount == 0))
+            {
+                this->Fail();
+                return stringpool::SymbolId::None;
+            }
+
+            // First reference defines the symbol.
+            uint64_t const length = this->ReadUnsigned();
+
+            if (length > static_cast<size_t>(this->_last - this->_first))
+            {
+                this->Fail();
+                return stringpool::SymbolId::None;
+            }
+
+            std::string_view const text{reinterpret_cast<char const*>(this->_first), static_cast<size_t>(length)};
+            this->_first += length;
+
+            --this->_symbolCount;
+            stringpool::SymbolId const symbol = this->_factory.GetSymbol(text);
+            this->_symbols.push_back(symbol);
+            return symbol;
+        }
+
+        void ReserveTrivia(size_t count)
+        {
+            std::vector<SyntaxTriviaEntry>& entries = this->_factory.TriviaEntries;
+
+            size_t const capacity = entries.capacity();
+            entries.reserve(entries.size() + count);
+
+            if (size_t const grown = entries.capacity(); grown != capacity)
+            {
+                this->_factory.TriviaEntriesArena->Deallocated(capacity * sizeof(SyntaxTriviaEntry));
+                this->_factory.TriviaEntriesArena->Allocated(grown * sizeof(SyntaxTriviaEntry));
+            }
+        }
+
+        SyntaxTriviaRange ReadTrivia()
+        {
+            uint64_t const leading = this->ReadUnsigned();
+            uint64_t const trailing = this->ReadUnsigned();
+
+            if ((leading > std::numeric_limits<uint16_t>::max()) or (trailing > std::numeric_limits<uint16_t>::max()) or ((leading + trailing) > this->_triviaCount))
+            {
+                this->Fail();
+                return {};
+            }
+
+            if ((leading + trailing) == 0)
+            {
+                return {};
+            }
+
+            // Storage for all entries was reserved up front.
+            std::vector<SyntaxTriviaEntry>& entries = this->_factory.TriviaEntries;
+            size_t const index = entries.size();
+
+            for (uint64_t i = 0; i < (leading + trailing); ++i)
+            {
+                SyntaxKind const kind = this->ReadKind();
+                uint64_t const length = this->ReadUnsigned();
+
+                if (((kind != SyntaxKind::None) and (not IsTrivia(kind))) or (length > std::numeric_limits<uint32_t>::max()))
+                {
+                    this->Fail();
+                    return {};
+                }
+
+                entries.push_back({kind, static_cast<uint32_t>(length)});
+            }
+
+            this->_triviaCount -= static_cast<uint32_t>(leading + trailing);
+
+            return SyntaxTriviaRange{
+                .Index = static_cast<uint32_t>(index),
+                .LeadingCount = static_cast<uint16_t>(leading),
+                .TrailingCount = static_cast<uint16_t>(trailing),
+            };
+        }
+
+        SyntaxToken* ReadToken(SyntaxKind kind)
+        {
+            uint64_t const flags = this->ReadUnsigned();
+            int64_t const start = static_cast<int64_t>(this->_position) + this->ReadSigned();
+            uint64_t const length = this->ReadUnsigned();
+
+            if ((flags > std::numeric_limits<uint16_t>::max()) or (start < 0) or ((static_cast<uint64_t>(start) + length) > std::numeric_limits<uint32_t>::max()))
+            {
+                this->Fail();
+                return nullptr;
+            }
+
+            source::SourceSpan const source{
+                .Start = {static_cast<uint32_t>(start)},
+                .End = {static_cast<uint32_t>(start + static_cast<int64_t>(length))},
+            };
+
+            this->_position = source.End.Offset;
+
+            SyntaxTriviaRange const trivia = this->ReadTrivia();
+            bitwise::Flags<SyntaxTokenFlags> const tokenFlags{static_cast<SyntaxTokenFlags>(flags)};
+
+            switch (kind) // NOLINT(clang-diagnostic-switch-enum)
+            {
+            case SyntaxKind::IdentifierToken:
+                {
+                    SyntaxKind const contextualKeyword = this->ReadKind();
+                    stringpool::SymbolId const identifier = this->ReadSymbol();
+                    return this->_factory.IdentifierAllocator.Emplace(source, trivia, contextualKeyword, identifier, tokenFlags);
+                }
+
+            case SyntaxKind::IntegerLiteralToken:
+                {
+                    LiteralPrefixKind const prefix = this->ReadPrefix();
+                    stringpool::SymbolId const value = this->ReadSymbol();
+                    stringpool::SymbolId const suffix = this->ReadSymbol();
+                    return this->_factory.IntegerLiteralAllocator.Emplace(source, trivia, prefix, value, suffix, tokenFlags);
+                }
+
+            case SyntaxKind::FloatLiteralToken:
+                {
+                    LiteralPrefixKind const prefix = this->ReadPrefix();
+                    stringpool::SymbolId const value = this->ReadSymbol();
+                    stringpool::SymbolId const suffix = this->ReadSymbol();
+                    return this->_factory.FloatLiteralAllocator.Emplace(source, trivia, prefix, value, suffix, tokenFlags);
+                }
+
+            case SyntaxKind::StringLiteralToken:
+                {
+                    LiteralPrefixKind const prefix = this->ReadPrefix();
+                    stringpool::SymbolId const value = this->ReadSymbol();
+                    return this->_factory.StringLiteralAllocator.Emplace(source, trivia, prefix, value, tokenFlags);
+                }
+
+            case SyntaxKind::CharacterLiteralToken:
+                {
+                    LiteralPrefixKind const prefix = this->ReadPrefix();
+                    char32_t const value = static_cast<char32_t>(this->ReadUnsigned());
+                    return this->_factory.CharacterLiteralAllocator.Emplace(source, trivia, prefix, value, tokenFlags);
+                }
+
+            default:
+                return this->_factory.TokenAllocator.Emplace(kind, source, trivia, tokenFlags);
+            }
+        }
+
+        template <typename NodeT>
+        NodeT* ReadNode()
+        {
+            if (this->_depth == MaxNestingDepth)
+            {
+                this->Fail();
+                return nullptr;
+            }
+
+            ++this->_depth;
+            NodeT* const result = this->ReadSlots<NodeT>();
+            --this->_depth;
+            return result;
+        }
+
+        template <typename NodeT>
+        NodeT* ReadSlots()
+        {
+            if constexpr (std::is_same_v<NodeT, SyntaxList>)
+            {
+                uint64_t const count = this->ReadUnsigned();
+
+                // Each element takes at least one byte.
+                if ((count == 0) or (count > static_cast<size_t>(this->_last - this->_first)))
+                {
+                    this->Fail();
+                    return nullptr;
+                }
+
+                SyntaxList* const list = SyntaxFactory::AllocateList(this->_factory.SyntaxNodeAllocator, count);
+                std::fill_n(list->GetElements(), count, nullptr);
+
+                SlotReader reader{*this};
+                DispatchChildren(list, reader);
+                return list;
+            }
+            else
+            {
+                NodeT* const node = this->_factory.CreateNode<NodeT>();
+
+                SlotReader reader{*this};
+                DispatchChildren(node, reader);
+                return node;
+            }
+        }
+
+        SyntaxNode* ReadAnyNode()
+        {
+            SyntaxKind const kind = this->ReadKind();
+
+            if ((kind == SyntaxKind::None) or this->_failed)
+            {
+                // Empty slot.
+                return nullptr;
+            }
+
+            if (this->_nodeCount == 0)
+            {
+                this->Fail();
+                return nullptr;
+            }
+
+            --this->_nodeCount;
+
+            if (IsToken(kind))
+            {
+                return this->ReadToken(kind);
+            }
+
+            switch (kind) // NOLINT(clang-diagnostic-switch-enum)
+            {
+#define WEAVE_SYNTAX_NODE(name, spelling) \
+    case SyntaxKind::name: \
+        return this->ReadNode<name>();
+#include "weave/syntax/SyntaxKind.inl"
+
+            default:
+                break;
+            }
+
+            this->Fail();
+            return nullptr;
+        }
+
+        template <typename NodeT>
+        NodeT* ReadChild()
+        {
+            SyntaxNode* const node = this->ReadAnyNode();
+
+            if (node == nullptr)
+            {
+                return nullptr;
+            }
+
+            bool valid = true;
+
+            if constexpr (requires { NodeT::ClassOf(node); })
+            {
+                valid = NodeT::ClassOf(node);
+            }
+            else if constexpr (std::is_base_of_v<SyntaxToken, NodeT>)
+            {
+                valid = IsToken(node->Kind);
+            }
+
+            if (not valid)
+            {
+                this->Fail();
+                return nullptr;
+            }
+
+            return static_cast<NodeT*>(node);
+        }
+    };
+
+    void SerializeSyntaxTree(std::vector<std::byte>& output, SyntaxFactory const& factory, SourceFileSyntax* root)
+    {
+        SyntaxTreeWriter writer{output, factory};
+        writer.Write(root);
+    }
+
+    SourceFileSyntax* DeserializeSyntaxTree(SyntaxFactory& factory, std::span<std::byte const> input)
+    {
+        SyntaxTreeReader reader{factory, input};
+        return reader.Read();
+    }
+}
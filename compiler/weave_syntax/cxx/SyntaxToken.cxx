@@ -6,21 +6,23 @@ namespace weave::syntax
     static_assert(sizeof(SyntaxTrivia) == 12);
     static_assert(std::is_trivially_destructible_v<SyntaxTrivia>);
 
-    static_assert(sizeof(SyntaxToken) == 32);
+    static_assert(sizeof(SyntaxTriviaEntry) == 8);
+
+    static_assert(sizeof(SyntaxToken) == 20);
     static_assert(std::is_trivially_destructible_v<SyntaxToken>);
 
-    static_assert(sizeof(IntegerLiteralSyntaxToken) == 72);
+    static_assert(sizeof(IntegerLiteralSyntaxToken) == 32);
     static_assert(std::is_trivially_destructible_v<IntegerLiteralSyntaxToken>);
 
-    static_assert(sizeof(FloatLiteralSyntaxToken) == 72);
+    static_assert(sizeof(FloatLiteralSyntaxToken) == 32);
     static_assert(std::is_trivially_destructible_v<FloatLiteralSyntaxToken>);
 
-    static_assert(sizeof(StringLiteralSyntaxToken) == 56);
+    static_assert(sizeof(StringLiteralSyntaxToken) == 28);
     static_assert(std::is_trivially_destructible_v<StringLiteralSyntaxToken>);
 
-    static_assert(sizeof(CharacterLiteralSyntaxToken) == 40);
+    static_assert(sizeof(CharacterLiteralSyntaxToken) == 28);
     static_assert(std::is_trivially_destructible_v<CharacterLiteralSyntaxToken>);
 
-    static_assert(sizeof(IdentifierSyntaxToken) == 56);
+    static_assert(sizeof(IdentifierSyntaxToken) == 28);
     static_assert(std::is_trivially_destructible_v<IdentifierSyntaxToken>);
 }
@@ -0,0 +1,171 @@
+#include "weave/syntax/SyntaxTreeIterator.hxx"
+#include "weave/syntax/SyntaxChildren.hxx"
+#include "weave/syntax/SyntaxFactory.hxx"
+
+#include <algorithm>
+
+namespace weave::syntax
+{
+    struct SyntaxTreeIterator::ChildCollector final
+    {
+        SyntaxTreeIterator& Iterator;
+        uint32_t Depth;
+        uint16_t Slot;
+
+        void Dispatch(SyntaxNode* node)
+        {
+            uint16_t const slot = this->Slot++;
+
+            if (node != nullptr)
+            {
+                // Space for all children was reserved up front.
+                WEAVE_ASSERT(this->Iterator._count < this->Iterator._capacity);
+
+                this->Iterator._stack[this->Iterator._count++] = Entry{
+                    .Node = node,
+                    .Depth = this->Depth,
+                    .Slot = slot,
+                    .Leaving = false,
+                };
+            }
+        }
+    };
+
+    SyntaxTreeIterator::SyntaxTreeIterator(SyntaxNode* root, SyntaxTreeOrder order, SyntaxFactory* trivia)
+        : _trivia{trivia}
+        , _order{order}
+    {
+        static memory::MemoryArena& iterator = memory::MemoryAccounting::GetArena("syntax.iterator");
+        this->_allocator.SetArena(&iterator);
+
+        if (root != nullptr)
+        {
+            this->Push(root, 0, 0, false);
+        }
+    }
+
+    void SyntaxTreeIterator::Reserve(size_t count)
+    {
+        if ((this->_count + count) > this->_capacity)
+        {
+            // Stack grows geometrically; previous storage is released with the allocator.
+            size_t const capacity = std::max<size_t>({256, this->_capacity * 2, this->_count + count});
+            Entry* const stack = this->_allocator.EmplaceArray<Entry>(capacity).data();
+            std::copy_n(this->_stack, this->_count, stack);
+            this->_stack = stack;
+            this->_capacity = capacity;
+        }
+    }
+
+    void SyntaxTreeIterator::Push(SyntaxNode* node, uint32_t depth, uint16_t slot, bool leaving)
+    {
+        this->Reserve(1);
+
+        this->_stack[this->_count++] = Entry{
+            .Node = node,
+            .Depth = depth,
+            .Slot = slot,
+            .Leaving = leaving,
+        };
+    }
+
+    void SyntaxTreeIterator::PushChildren(SyntaxNode* node, uint32_t depth)
+    {
+        using ChildrenFunction = void (*)(SyntaxNode* node, ChildCollector& collector);
+
+        // Children of nodes, by syntax kind. Tokens and trivia have no children in the table.
+        static constexpr ChildrenFunction ChildrenTable[]{
+#define WEAVE_SYNTAX(name, spelling) nullptr,
+#define WEAVE_SYNTAX_NODE(name, spelling) \
+    [](SyntaxNode* node, ChildCollector& collector) \
+    { \
+        DispatchChildren(static_cast<name*>(node), collector); \
+    },
+#include "weave/syntax/SyntaxKind.inl"
+        };
+
+        // Syntax nodes other than lists have at most this many child slots.
+        constexpr size_t MaxChildren = 16;
+
+        if (SyntaxList* const list = node->TryCast<SyntaxList>(); list != nullptr)
+        {
+            // Elements are pushed in reverse order, so the first one is popped first.
+            size_t const count = list->GetCount();
+            SyntaxNode** const elements = list->GetElements();
+
+            this->Reserve(count);
+
+            for (size_t i = count; i != 0; --i)
+            {
+                if (elements[i - 1] != nullptr)
+                {
+                    this->_stack[this->_count++] = Entry{
+                        .Node = elements[i - 1],
+                        .Depth = depth,
+                        .Slot = 0,
+                        .Leaving = false,
+                    };
+                }
+            }
+
+            return;
+        }
+
+        this->Reserve(MaxChildren);
+
+        size_t const first = this->_count;
+
+        ChildCollector collector{*this, depth, 0};
+
+        if (ChildrenFunction const children = ChildrenTable[static_cast<size_t>(node->Kind)]; children != nullptr)
+        {
+            children(node, collector);
+        }
+        else if ((this->_trivia != nullptr) and IsToken(node->Kind))
+        {
+            SyntaxToken* const token = static_cast<SyntaxToken*>(node);
+            collector.Dispatch(this->_trivia->GetLeadingTrivia(token).GetNode());
+            collector.Dispatch(this->_trivia->GetTrailingTrivia(token).GetNode());
+        }
+
+        // Children are pushed in source order, but the first one must be popped first.
+        std::reverse(this->_stack + first, this->_stack + this->_count);
+    }
+
+    bool SyntaxTreeIterator::Next()
+    {
+        if (this->_expand)
+        {
+            this->_expand = false;
+            this->PushChildren(this->_current.Node, this->_current.Depth + 1);
+        }
+
+        while (this->_count != 0)
+        {
+            Entry const entry = this->_stack[--this->_count];
+
+            if (entry.Leaving)
+            {
+                this->_current = entry;
+                return true;
+            }
+
+            if (this->_order != SyntaxTreeOrder::PreOrder)
+            {
+                this->Push(entry.Node, entry.Depth, entry.Slot, true);
+            }
+
+            if (this->_order != SyntaxTreeOrder::PostOrder)
+            {
+                this->_current = entry;
+                this->_expand = true;
+                return true;
+            }
+
+            this->PushChildren(entry.Node, entry.Depth + 1);
+        }
+
+        this->_current = {};
+        return false;
+    }
+}
@@ -0,0 +1,280 @@
+#include "weave/syntax/TokenStream.hxx"
+#include "weave/syntax/SyntaxFactory.hxx"
+#include "weave/threading/ConditionVariable.hxx"
+#include "weave/threading/CriticalSection.hxx"
+#include "weave/threading/Runnable.hxx"
+#include "weave/threading/Thread.hxx"
+
+#include <algorithm>
+#include <array>
+
+namespace weave::syntax::impl
+{
+    inline constexpr size_t TokenStreamInitialCapacity = 1024;
+    inline constexpr size_t BackgroundLexerChunkSize = 512;
+
+    /// \brief Lexes source on separate thread.
+    ///
+    /// \details Lexer thread produces plain token infos, while syntax tokens are created by the parser thread - syntax
+    ///          factory is not thread safe. Two chunks are used, so lexer works on one while parser consumes the other.
+    class BackgroundLexer final : public threading::Runnable
+    {
+    private:
+        struct Chunk final
+        {
+            std::vector<TokenInfo> Tokens{};
+            size_t Count{};
+        };
+
+    private:
+        Lexer _lexer;
+
+        threading::CriticalSection _lock{};
+        threading::ConditionVariable _produced{};
+        threading::ConditionVariable _consumed{};
+
+        std::array<Chunk, 2> _chunks{};
+        size_t _filled{};
+        size_t _produceIndex{};
+        size_t _consumeIndex{};
+        bool _cancelled{};
+        bool _finished{};
+
+        threading::Thread _thread{};
+
+    public:
+        BackgroundLexer(
+            source::DiagnosticSink& diagnostic,
+            source::SourceText const& source)
+            : _lexer{diagnostic, source, LexerTriviaMode::All}
+        {
+            for (Chunk& chunk : this->_chunks)
+            {
+                chunk.Tokens.resize(BackgroundLexerChunkSize);
+            }
+
+            this->_thread = threading::Thread{threading::ThreadStart{
+                .Name = "weave-lexer",
+                .Callback = this,
+            }};
+        }
+
+        ~BackgroundLexer() override
+        {
+            {
+                threading::CriticalSection::Lock lock{this->_lock};
+                this->_cancelled = true;
+            }
+
+            this->_consumed.Notify();
+            this->_thread.Join();
+        }
+
+        BackgroundLexer(BackgroundLexer const&) = delete;
+        BackgroundLexer(BackgroundLexer&&) = delete;
+        BackgroundLexer& operator=(BackgroundLexer const&) = delete;
+        BackgroundLexer& operator=(BackgroundLexer&&) = delete;
+
+    public:
+        /// \brief Waits for next chunk of tokens and creates syntax tokens from it.
+        template <typename CallbackT>
+        void Consume(SyntaxFactory& factory, CallbackT&& callback)
+        {
+            {
+                threading::CriticalSection::Lock lock{this->_lock};
+
+                while (this->_filled == 0)
+                {
+                    this->_produced.Wait(this->_lock);
+                }
+            }
+
+            // Chunk is owned by consumer until it is released.
+            Chunk const& chunk = this->_chunks[this->_consumeIndex];
+
+            for (size_t i = 0; i < chunk.Count; ++i)
+            {
+                callback(Lexer::CreateToken(factory, chunk.Tokens[i]));
+            }
+
+            this->_consumeIndex = (this->_consumeIndex + 1) % this->_chunks.size();
+
+            {
+                threading::CriticalSection::Lock lock{this->_lock};
+                --this->_filled;
+            }
+
+            this->_consumed.Notify();
+        }
+
+    protected:
+        void Execute() override
+        {
+            while (not this->_finished)
+            {
+                {
+                    threading::CriticalSection::Lock lock{this->_lock};
+
+                    while ((this->_filled == this->_chunks.size()) and not this->_cancelled)
+                    {
+                        this->_consumed.Wait(this->_lock);
+                    }
+
+                    if (this->_cancelled)
+                    {
+                        return;
+                    }
+                }
+
+                Chunk& chunk = this->_chunks[this->_produceIndex];
+                chunk.Count = 0;
+
+                while ((chunk.Count < chunk.Tokens.size()) and not this->_finished)
+                {
+                    TokenInfo& token = chunk.Tokens[chunk.Count++];
+
+                    if (not this->_lexer.Lex(token))
+                    {
+                        token.Kind = SyntaxKind::None;
+                    }
+
+                    this->_finished = (token.Kind == SyntaxKind::EndOfFileToken) or (token.Kind == SyntaxKind::None);
+                }
+
+                this->_produceIndex = (this->_produceIndex + 1) % this->_chunks.size();
+
+                {
+                    threading::CriticalSection::Lock lock{this->_lock};
+                    ++this->_filled;
+                }
+
+                this->_produced.Notify();
+            }
+        }
+    };
+}
+
+namespace weave::syntax
+{
+    TokenStream::TokenStream(
+        source::DiagnosticSink& diagnostic,
+        SyntaxFactory& factory,
+        source::SourceText const& source,
+        TokenStreamMode mode)
+        : _diagnostic{&diagnostic}
+        , _factory{&factory}
+        , _mode{mode}
+        , _diagnosticStart{diagnostic.Items.size()}
+        , _buffer(impl::TokenStreamInitialCapacity)
+    {
+        switch (mode)
+        {
+        case TokenStreamMode::Eager:
+            this->_lexer = std::make_unique<Lexer>(diagnostic, source, LexerTriviaMode::All);
+
+            while (this->_last == nullptr)
+            {
+                this->Fill();
+            }
+
+            this->_completed = true;
+            break;
+
+        case TokenStreamMode::Streaming:
+            this->_lexer = std::make_unique<Lexer>(this->_lexerDiagnostic, source, LexerTriviaMode::All);
+            break;
+
+        case TokenStreamMode::Background:
+            this->_background = std::make_unique<impl::BackgroundLexer>(this->_lexerDiagnostic, source);
+            break;
+        }
+    }
+
+    TokenStream::~TokenStream()
+    {
+        // Parser may stop before reaching end of source; lexer diagnostics are reported anyway.
+        this->Complete();
+    }
+
+    void TokenStream::Complete()
+    {
+        if (this->_completed)
+        {
+            return;
+        }
+
+        this->_completed = true;
+
+        // Lex remaining tokens, so all lexer diagnostics are reported. Parser is done, so tokens may be discarded.
+        this->_retain = this->_first + this->_count;
+
+        while (this->_last == nullptr)
+        {
+            this->Fill();
+        }
+
+        // Lexer thread is done, release it.
+        this->_background.reset();
+
+        std::vector<source::DiagnosticSink::Entry>& items = this->_diagnostic->Items;
+
+        items.insert(
+            items.begin() + static_cast<ptrdiff_t>(std::min(this->_diagnosticStart, items.size())),
+            std::make_move_iterator(this->_lexerDiagnostic.Items.begin()),
+            std::make_move_iterator(this->_lexerDiagnostic.Items.end()));
+
+        this->_lexerDiagnostic.Items.clear();
+    }
+
+    void TokenStream::Fill()
+    {
+        WEAVE_ASSERT(this->_last == nullptr);
+
+        if (this->_background != nullptr)
+        {
+            this->_background->Consume(*this->_factory, [this](SyntaxToken* token)
+                {
+                    this->Append(token);
+                });
+        }
+        else
+        {
+            this->Append(this->_lexer->Lex(*this->_factory));
+        }
+    }
+
+    void TokenStream::Append(SyntaxToken* token)
+    {
+        if (this->_count == this->_buffer.size())
+        {
+            // Discard tokens no longer needed by the parser.
+            size_t const discarded = std::min(this->_retain - this->_first, this->_count);
+            this->_first += discarded;
+            this->_count -= discarded;
+
+            if (this->_count == this->_buffer.size())
+            {
+                // Parser still needs all buffered tokens.
+                std::vector<SyntaxToken*> buffer(this->_buffer.size() * 2);
+
+                for (size_t i = this->_first; i < (this->_first + this->_count); ++i)
+                {
+                    buffer[i & (buffer.size() - 1)] = this->_buffer[i & (this->_buffer.size() - 1)];
+                }
+
+                this->_buffer = std::move(buffer);
+            }
+        }
+
+        size_t const index = this->_first + this->_count;
+        this->_buffer[index & (this->_buffer.size() - 1)] = token;
+        ++this->_count;
+
+        this->_peakCount = std::max(this->_peakCount, this->_count);
+
+        if ((token->Kind == SyntaxKind::EndOfFileToken) or (token->Kind == SyntaxKind::None))
+        {
+            this->_last = token;
+        }
+    }
+}
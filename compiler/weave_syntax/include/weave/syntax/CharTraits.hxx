@@ -1,10 +1,125 @@
 #pragma once
+#include <array>
 #include <cstdint>
 
+namespace weave::syntax::impl
+{
+    inline constexpr uint8_t AsciiIdentifierStart = 1u << 0u;
+    inline constexpr uint8_t AsciiIdentifierContinuation = 1u << 1u;
+    inline constexpr uint8_t AsciiWhitespace = 1u << 2u;
+    inline constexpr uint8_t AsciiBinaryDigit = 1u << 3u;
+    inline constexpr uint8_t AsciiOctalDigit = 1u << 4u;
+    inline constexpr uint8_t AsciiDecimalDigit = 1u << 5u;
+    inline constexpr uint8_t AsciiHexadecimalDigit = 1u << 6u;
+    inline constexpr uint8_t AsciiNewLine = 1u << 7u;
+
+    consteval std::array<uint8_t, 256> BuildAsciiClasses()
+    {
+        std::array<uint8_t, 256> result{};
+
+        for (unsigned c = 0; c < 0x80u; ++c)
+        {
+            bool const lower = (U'a' <= c) and (c <= U'z');
+            bool const upper = (U'A' <= c) and (c <= U'Z');
+            bool const digit = (U'0' <= c) and (c <= U'9');
+
+            uint8_t value{};
+
+            if (lower or upper or (c == U'_'))
+            {
+                value |= AsciiIdentifierStart | AsciiIdentifierContinuation;
+            }
+
+            if (digit)
+            {
+                value |= AsciiIdentifierContinuation | AsciiDecimalDigit | AsciiHexadecimalDigit;
+            }
+
+            if ((U'0' <= c) and (c <= U'1'))
+            {
+                value |= AsciiBinaryDigit;
+            }
+
+            if ((U'0' <= c) and (c <= U'7'))
+            {
+                value |= AsciiOctalDigit;
+            }
+
+            if (((U'a' <= c) and (c <= U'f')) or ((U'A' <= c) and (c <= U'F')))
+            {
+                value |= AsciiHexadecimalDigit;
+            }
+
+            // Must match `CharTraits::IsWhitespace`.
+            if ((c == 0x09) or (c == 0x0B) or (c == 0x0C) or (c == 0x20))
+            {
+                value |= AsciiWhitespace;
+            }
+
+            if ((c == U'\n') or (c == U'\r'))
+            {
+                value |= AsciiNewLine;
+            }
+
+            result[c] = value;
+        }
+
+        // Bytes of multibyte sequences don't belong to any class.
+        return result;
+    }
+
+    inline constexpr std::array<uint8_t, 256> AsciiClasses = BuildAsciiClasses();
+}
+
 namespace weave::syntax
 {
     class CharTraits final
     {
+    private:
+        [[nodiscard]] static constexpr bool HasAsciiClass(char c, uint8_t mask)
+        {
+            return (impl::AsciiClasses[static_cast<unsigned char>(c)] & mask) != 0;
+        }
+
+    public:
+        // Byte predicates used to scan runs of ASCII characters without decoding them. Bytes of multibyte sequences
+        // never match.
+
+        [[nodiscard]] static constexpr bool IsIdentifierContinuationByte(char c)
+        {
+            return HasAsciiClass(c, impl::AsciiIdentifierContinuation);
+        }
+
+        [[nodiscard]] static constexpr bool IsWhitespaceByte(char c)
+        {
+            return HasAsciiClass(c, impl::AsciiWhitespace);
+        }
+
+        [[nodiscard]] static constexpr bool IsBinaryDigitByte(char c)
+        {
+            return HasAsciiClass(c, impl::AsciiBinaryDigit);
+        }
+
+        [[nodiscard]] static constexpr bool IsOctalDigitByte(char c)
+        {
+            return HasAsciiClass(c, impl::AsciiOctalDigit);
+        }
+
+        [[nodiscard]] static constexpr bool IsDecimalDigitByte(char c)
+        {
+            return HasAsciiClass(c, impl::AsciiDecimalDigit);
+        }
+
+        [[nodiscard]] static constexpr bool IsHexadecimalDigitByte(char c)
+        {
+            return HasAsciiClass(c, impl::AsciiHexadecimalDigit);
+        }
+
+        [[nodiscard]] static constexpr bool IsNotNewLineByte(char c)
+        {
+            return not HasAsciiClass(c, impl::AsciiNewLine);
+        }
+
     public:
         [[nodiscard]] static constexpr bool IsIdentifierStartAscii(char32_t c)
         {
@@ -0,0 +1,95 @@
+#pragma once
+#include "weave/bugcheck/Assert.hxx"
+#include "weave/source/Source.hxx"
+#include "weave/syntax/SyntaxKind.hxx"
+
+#include <span>
+#include <vector>
+
+namespace weave::syntax
+{
+    struct SyntaxNode;
+
+    /// \brief Node of syntax tree laid out in preorder.
+    ///
+    /// \details Children of a node directly follow it, each one followed by its own subtree. First child of node at
+    ///          index `i` is at index `i + 1`, next sibling of a node is at `i + SubtreeSize`, and whole subtree
+    ///          occupies range `[i, i + SubtreeSize)`.
+    struct FlatSyntaxNode final
+    {
+        SyntaxKind Kind;
+
+        // Index of slot in parent node, counting empty slots; 0 for list elements.
+        uint16_t Slot;
+
+        // Index of parent node; `FlatSyntaxTree::InvalidIndex` for root node.
+        uint32_t Parent;
+
+        // Number of direct children.
+        uint32_t ChildCount;
+
+        // Number of nodes in the subtree, including this node.
+        uint32_t SubtreeSize;
+
+        // Span of token, or span from the first to the last token of syntax node.
+        source::SourceSpan Source;
+    };
+
+    static_assert(sizeof(FlatSyntaxNode) == 24);
+
+    /// \brief Syntax tree flattened into contiguous array of nodes.
+    ///
+    /// \details Flattened tree is an immutable snapshot of syntax nodes and tokens, without trivia. It allows later
+    ///          phases to iterate over siblings and skip subtrees without chasing pointers across syntax arenas.
+    class FlatSyntaxTree final
+    {
+    public:
+        static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+    private:
+        std::vector<FlatSyntaxNode> _nodes{};
+
+    public:
+        FlatSyntaxTree() = default;
+
+        /// \brief Flattens the tree without recursion.
+        explicit FlatSyntaxTree(SyntaxNode* root);
+
+    public:
+        [[nodiscard]] std::span<FlatSyntaxNode const> GetNodes() const
+        {
+            return this->_nodes;
+        }
+
+        [[nodiscard]] FlatSyntaxNode const& GetNode(uint32_t index) const
+        {
+            WEAVE_ASSERT(index < this->_nodes.size());
+            return this->_nodes[index];
+        }
+
+        [[nodiscard]] uint32_t GetFirstChild(uint32_t index) const
+        {
+            return (this->GetNode(index).ChildCount != 0) ? (index + 1) : InvalidIndex;
+        }
+
+        /// \brief Gets index of next sibling, or end of parent's subtree when node is the last child.
+        [[nodiscard]] uint32_t GetNextSibling(uint32_t index) const
+        {
+            return index + this->GetNode(index).SubtreeSize;
+        }
+
+        /// \brief Gets index past the last node of the subtree.
+        [[nodiscard]] uint32_t GetSubtreeEnd(uint32_t index) const
+        {
+            return index + this->GetNode(index).SubtreeSize;
+        }
+
+        /// \brief Gets child node in given slot, or `InvalidIndex` when slot is empty.
+        [[nodiscard]] uint32_t GetChildInSlot(uint32_t index, uint16_t slot) const;
+
+        [[nodiscard]] size_t GetMemoryUsage() const
+        {
+            return this->_nodes.capacity() * sizeof(FlatSyntaxNode);
+        }
+    };
+}
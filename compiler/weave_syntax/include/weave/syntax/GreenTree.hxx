@@ -0,0 +1,323 @@
+#pragma once
+#include "weave/bugcheck/Assert.hxx"
+#include "weave/memory/LinearAllocator.hxx"
+#include "weave/source/Source.hxx"
+#include "weave/syntax/SyntaxKind.hxx"
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace weave::source
+{
+    class SourceText;
+}
+
+namespace weave::syntax
+{
+    class SyntaxFactory;
+    struct SyntaxNode;
+
+    /// \brief Immutable, position independent syntax node.
+    ///
+    /// \details Green nodes store widths instead of absolute offsets, so the same node may appear at different
+    ///          positions and in many trees at once. Nodes are interned by `GreenNodeFactory`; structurally
+    ///          identical nodes created by the same factory are the same object and may be compared by address.
+    ///
+    ///          Slots of a node are stored in memory directly after the node object. Empty slots are null.
+    class alignas(void*) GreenNode
+    {
+        friend class GreenNodeFactory;
+
+    protected:
+        SyntaxKind _kind{};
+        bool _token{};
+        bool _missing{};
+        uint32_t _slot_count{};
+        uint32_t _width{};
+        uint64_t _hash{};
+
+    protected:
+        constexpr GreenNode(SyntaxKind kind, bool token, uint32_t slot_count, uint32_t width, uint64_t hash)
+            : _kind{kind}
+            , _token{token}
+            , _slot_count{slot_count}
+            , _width{width}
+            , _hash{hash}
+        {
+        }
+
+    public:
+        GreenNode(GreenNode const&) = delete;
+        GreenNode(GreenNode&&) = delete;
+        GreenNode& operator=(GreenNode const&) = delete;
+        GreenNode& operator=(GreenNode&&) = delete;
+
+    public:
+        [[nodiscard]] constexpr SyntaxKind GetKind() const
+        {
+            return this->_kind;
+        }
+
+        [[nodiscard]] constexpr bool IsToken() const
+        {
+            return this->_token;
+        }
+
+        /// \brief Gets width of the node, including trivia of its tokens.
+        [[nodiscard]] constexpr uint32_t GetWidth() const
+        {
+            return this->_width;
+        }
+
+        [[nodiscard]] constexpr uint64_t GetHash() const
+        {
+            return this->_hash;
+        }
+
+        [[nodiscard]] constexpr size_t GetSlotCount() const
+        {
+            return this->_slot_count;
+        }
+
+        [[nodiscard]] std::span<GreenNode const* const> GetSlots() const
+        {
+            return {reinterpret_cast<GreenNode const* const*>(this + 1), this->_slot_count};
+        }
+
+        [[nodiscard]] GreenNode const* GetSlot(size_t index) const
+        {
+            WEAVE_ASSERT(index < this->_slot_count);
+            return this->GetSlots()[index];
+        }
+
+        /// \brief Gets width of leading trivia of the first token in the node.
+        [[nodiscard]] uint32_t GetLeadingTriviaWidth() const;
+
+        /// \brief Gets width of trailing trivia of the last token in the node.
+        [[nodiscard]] uint32_t GetTrailingTriviaWidth() const;
+
+        /// \brief Appends full text of the node, including trivia.
+        void AppendText(std::string& result) const;
+    };
+
+    /// \brief Green token, storing its text along with leading and trailing trivia.
+    class GreenToken final : public GreenNode
+    {
+        friend class GreenNodeFactory;
+
+    private:
+        uint32_t _leading_width{};
+        uint32_t _trailing_width{};
+        char const* _text{};
+
+    private:
+        constexpr GreenToken(SyntaxKind kind, bool missing, std::string_view text, uint32_t leading, uint32_t trailing, uint64_t hash)
+            : GreenNode{kind, true, 0, static_cast<uint32_t>(text.size()), hash}
+            , _leading_width{leading}
+            , _trailing_width{trailing}
+            , _text{text.data()}
+        {
+            this->_missing = missing;
+        }
+
+    public:
+        [[nodiscard]] constexpr bool IsMissing() const
+        {
+            return this->_missing;
+        }
+
+        [[nodiscard]] constexpr uint32_t GetLeadingWidth() const
+        {
+            return this->_leading_width;
+        }
+
+        [[nodiscard]] constexpr uint32_t GetTrailingWidth() const
+        {
+            return this->_trailing_width;
+        }
+
+        /// \brief Gets text of the token with its trivia.
+        [[nodiscard]] constexpr std::string_view GetFullText() const
+        {
+            return {this->_text, this->_width};
+        }
+
+        /// \brief Gets text of the token without trivia.
+        [[nodiscard]] constexpr std::string_view GetText() const
+        {
+            return this->GetFullText().substr(this->_leading_width, this->_width - this->_leading_width - this->_trailing_width);
+        }
+    };
+
+    class RedNode;
+
+    struct GreenNodeFactoryStatistics final
+    {
+        // Number of distinct nodes and tokens created.
+        size_t Nodes{};
+        size_t Tokens{};
+
+        // Number of requests satisfied by already existing node.
+        size_t Reused{};
+
+        // Memory used by nodes and token text.
+        size_t Allocated{};
+    };
+
+    /// \brief Creates and interns green nodes.
+    ///
+    /// \details Factory keeps all created nodes alive. Trees built from successive versions of the same source share
+    ///          all subtrees whose text did not change, so factory should live as long as the document it was created
+    ///          for.
+    class GreenNodeFactory final
+    {
+    private:
+        memory::LinearAllocator _allocator{64u << 10u};
+
+        // Interned nodes, by hash.
+        std::unordered_multimap<uint64_t, GreenNode const*> _nodes{};
+
+        size_t _tokens{};
+        size_t _reused{};
+
+    public:
+        GreenNodeFactory();
+
+        GreenNodeFactory(GreenNodeFactory const&) = delete;
+        GreenNodeFactory(GreenNodeFactory&&) = delete;
+        GreenNodeFactory& operator=(GreenNodeFactory const&) = delete;
+        GreenNodeFactory& operator=(GreenNodeFactory&&) = delete;
+
+    private:
+        [[nodiscard]] void* AllocateToken();
+
+    public:
+        /// \brief Gets token of given full text.
+        ///
+        /// \param text     Text of the token, including its leading and trailing trivia.
+        /// \param leading  Width of leading trivia.
+        /// \param trailing Width of trailing trivia.
+        [[nodiscard]] GreenToken const* CreateToken(SyntaxKind kind, std::string_view text, uint32_t leading, uint32_t trailing);
+
+        /// \brief Gets zero width token representing token missing in the source.
+        [[nodiscard]] GreenToken const* CreateMissingToken(SyntaxKind kind);
+
+        [[nodiscard]] GreenNode const* CreateNode(SyntaxKind kind, std::span<GreenNode const* const> slots);
+
+        /// \brief Creates green tree of the syntax tree parsed from the source text.
+        [[nodiscard]] GreenNode const* CreateFromSyntax(SyntaxNode* root, SyntaxFactory const& factory, source::SourceText const& text);
+
+        /// \brief Creates new root with the node replaced, reusing all nodes outside of path to the root.
+        [[nodiscard]] GreenNode const* Replace(RedNode const* node, GreenNode const* replacement);
+
+        void QueryStatistics(GreenNodeFactoryStatistics& statistics) const;
+    };
+
+    class RedTree;
+
+    /// \brief Positioned view of green node.
+    ///
+    /// \details Red nodes are created on demand, when children of a node are requested for the first time.
+    ///          They are owned by the red tree and are not thread safe.
+    class RedNode final
+    {
+        friend class RedTree;
+
+    private:
+        RedTree* _tree{};
+        RedNode const* _parent{};
+        GreenNode const* _green{};
+        uint32_t _offset{};
+        uint32_t _index{};
+        mutable RedNode const** _children{};
+
+    public:
+        RedNode(RedTree* tree, RedNode const* parent, GreenNode const* green, uint32_t offset, uint32_t index)
+            : _tree{tree}
+            , _parent{parent}
+            , _green{green}
+            , _offset{offset}
+            , _index{index}
+        {
+        }
+
+        RedNode(RedNode const&) = delete;
+        RedNode(RedNode&&) = delete;
+        RedNode& operator=(RedNode const&) = delete;
+        RedNode& operator=(RedNode&&) = delete;
+
+    public:
+        [[nodiscard]] constexpr GreenNode const* GetGreen() const
+        {
+            return this->_green;
+        }
+
+        [[nodiscard]] constexpr SyntaxKind GetKind() const
+        {
+            return this->_green->GetKind();
+        }
+
+        [[nodiscard]] constexpr RedNode const* GetParent() const
+        {
+            return this->_parent;
+        }
+
+        /// \brief Gets index of slot in parent node.
+        [[nodiscard]] constexpr uint32_t GetIndex() const
+        {
+            return this->_index;
+        }
+
+        /// \brief Gets span of the node, including trivia.
+        [[nodiscard]] constexpr source::SourceSpan GetFullSpan() const
+        {
+            return source::SourceSpan{
+                .Start = {this->_offset},
+                .End = {this->_offset + this->_green->GetWidth()},
+            };
+        }
+
+        /// \brief Gets span of the node, excluding leading trivia of first token and trailing trivia of last token.
+        [[nodiscard]] source::SourceSpan GetSpan() const;
+
+        [[nodiscard]] constexpr size_t GetSlotCount() const
+        {
+            return this->_green->GetSlotCount();
+        }
+
+        /// \brief Gets child node in given slot, or null for empty slot.
+        [[nodiscard]] RedNode const* GetChild(size_t index) const;
+
+        /// \brief Finds token which full span contains the position.
+        [[nodiscard]] RedNode const* FindToken(source::SourcePosition position) const;
+    };
+
+    /// \brief Owner of red nodes created for green tree.
+    class RedTree final
+    {
+        friend class RedNode;
+
+    private:
+        memory::LinearAllocator _allocator{16u << 10u};
+        RedNode* _root{};
+
+    public:
+        explicit RedTree(GreenNode const* root);
+
+        RedTree(RedTree const&) = delete;
+        RedTree(RedTree&&) = delete;
+        RedTree& operator=(RedTree const&) = delete;
+        RedTree& operator=(RedTree&&) = delete;
+
+    private:
+        void Materialize(RedNode const& node);
+
+    public:
+        [[nodiscard]] RedNode const* GetRoot() const
+        {
+            return this->_root;
+        }
+    };
+}
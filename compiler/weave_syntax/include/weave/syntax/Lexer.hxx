@@ -15,6 +15,9 @@ namespace weave::syntax
         LiteralPrefixKind Prefix;
         std::string Value{};
         std::string Suffix{};
+
+        /// \brief The identifier or keyword, as a slice of the source text.
+        std::string_view Identifier{};
         source::SourceSpan Source{};
         SyntaxKind Kind{};
         SyntaxKind ContextualKeyword{};
@@ -54,6 +57,11 @@ namespace weave::syntax
 
         [[nodiscard]] SyntaxToken* Lex(SyntaxFactory& factory);
 
+        /// \brief Creates syntax token from lexed token info.
+        ///
+        /// \note Token info with kind `SyntaxKind::None` represents token which failed to lex.
+        [[nodiscard]] static SyntaxToken* CreateToken(SyntaxFactory& factory, TokenInfo const& token);
+
     private:
         struct SingleInteger final
         {
@@ -5,6 +5,7 @@
 #include "weave/syntax/SyntaxToken.hxx"
 #include "weave/syntax/SyntaxFactory.hxx"
 #include "weave/syntax/SyntaxFacts.hxx"
+#include "weave/syntax/TokenStream.hxx"
 
 namespace weave::syntax
 {
@@ -87,62 +88,100 @@ namespace weave::syntax
 
 namespace weave::syntax
 {
+    class GreenNode;
+    class GreenNodeFactory;
+
     class Parser
     {
     private:
         SyntaxFactory* _factory{};
-        std::vector<SyntaxToken*> _tokens{};
+        TokenStream _tokens;
         size_t _index{};
         SyntaxToken* _current{};
 
+        // Indices of active reset points, in order of creation.
+        std::vector<size_t> _resetPoints{};
+
     public:
         explicit Parser(
             source::DiagnosticSink* diagnostic,
             SyntaxFactory* factory,
-            source::SourceText const& source);
+            source::SourceText const& source,
+            TokenStreamMode mode = TokenStreamMode::Streaming);
 
     public:
-        struct ResetPoint
+        /// \brief Represents parser position which can be restored later.
+        ///
+        /// \note Tokens after reset point are kept by the token stream as long as reset point is alive.
+        struct ResetPoint final
         {
             friend class Parser;
 
         private:
-            Parser const* _owner{};
+            Parser* _owner{};
             size_t _index{};
+            memory::LinearAllocator::Marker _marker{};
 
         private:
-            explicit constexpr ResetPoint(
-                Parser const* owner,
+            explicit ResetPoint(
+                Parser* owner,
                 size_t index)
                 : _owner{owner}
                 , _index{index}
+                , _marker{owner->_factory->Mark()}
             {
+                owner->_resetPoints.push_back(index);
             }
 
         public:
-            ResetPoint() = default;
-            ResetPoint(ResetPoint const&) = default;
-            ResetPoint(ResetPoint&&) = default;
-            ResetPoint& operator=(ResetPoint const&) = default;
-            ResetPoint& operator=(ResetPoint&&) = default;
+            ~ResetPoint()
+            {
+                this->_owner->ReleaseResetPoint(this->_index);
+            }
+
+            ResetPoint(ResetPoint const&) = delete;
+            ResetPoint(ResetPoint&&) = delete;
+            ResetPoint& operator=(ResetPoint const&) = delete;
+            ResetPoint& operator=(ResetPoint&&) = delete;
         };
 
-        [[nodiscard]] ResetPoint GetResetPoint() const
+        [[nodiscard]] ResetPoint GetResetPoint()
         {
             return ResetPoint{this, this->_index};
         }
 
+        /// \brief Restores parser position.
+        ///
+        /// \note Syntax nodes created after reset point was taken are released.
         void Reset(ResetPoint const& resetPoint)
         {
             WEAVE_ASSERT(resetPoint._owner == this, "Invalid reset point");
-            WEAVE_ASSERT(resetPoint._index < this->_tokens.size(), "Invalid reset point");
+
+            this->_factory->Rewind(resetPoint._marker);
 
             this->_index = resetPoint._index;
-            this->_current = this->_tokens[this->_index];
+            this->_current = this->_tokens.Get(this->_index);
+        }
+
+        [[nodiscard]] TokenStream const& GetTokenStream() const
+        {
+            return this->_tokens;
         }
 
     private:
-        [[nodiscard]] SyntaxToken* Peek(size_t offset) const;
+        void ReleaseResetPoint(size_t index)
+        {
+            WEAVE_ASSERT(not this->_resetPoints.empty() and (this->_resetPoints.back() == index), "Reset points must be released in reverse order");
+            this->_resetPoints.pop_back();
+
+            if (this->_resetPoints.empty())
+            {
+                this->_tokens.Retain(this->_index);
+            }
+        }
+
+    private:
+        [[nodiscard]] SyntaxToken* Peek(size_t offset);
         [[nodiscard]] SyntaxToken* Current() const;
         SyntaxToken* Next();
         [[nodiscard]] SyntaxToken* Match(SyntaxKind kind);
@@ -223,6 +262,25 @@ namespace weave::syntax
             }
         };
 
+    public:
+        /// \brief Parses source after the text change, reusing top level code block items of the old tree.
+        ///
+        /// \details Only items affected by the change are relexed and reparsed, together with one neighbouring item
+        ///          on each side. The window is accepted when reparsed neighbours are identical to the old ones;
+        ///          otherwise it is extended, falling back to parsing the whole source. Diagnostics are not reported.
+        ///
+        /// \param factory  Factory which created the old tree.
+        /// \param oldTree  Green tree of the source before the change.
+        /// \param source   Source text after the change.
+        /// \param change   Change applied to the old source.
+        ///
+        /// \returns Green tree of the new source, identical to the tree created by parsing it from scratch.
+        [[nodiscard]] static GreenNode const* Reparse(
+            GreenNodeFactory& factory,
+            GreenNode const* oldTree,
+            source::SourceText const& source,
+            source::TextChange const& change);
+
     private:
         // NOTE:
         //      This is public only for unit test purposes.
@@ -0,0 +1,114 @@
+#pragma once
+#include "weave/syntax/SyntaxChildren.hxx"
+#include "weave/syntax/SyntaxFactory.hxx"
+#include "weave/syntax/SyntaxNode.hxx"
+#include "weave/syntax/SyntaxToken.hxx"
+#include "weave/syntax/SyntaxTree.hxx"
+#include "weave/bugcheck/BugCheck.hxx"
+
+namespace weave::syntax
+{
+    /// \brief Syntax walker dispatched at compile time.
+    ///
+    /// \details Walks the tree in the same order as `SyntaxWalker`, but calls handlers of the derived class directly
+    ///          instead of through virtual functions, so the whole walk may be inlined. Derived class customizes the
+    ///          walk by hiding handlers of this class, for example:
+    ///
+    ///          \code
+    ///          class Counter final : public StaticSyntaxWalker<Counter>
+    ///          {
+    ///          public:
+    ///              void OnDefault(SyntaxNode* node);
+    ///          };
+    ///          \endcode
+    template <typename DerivedT>
+    class StaticSyntaxWalker
+    {
+    public:
+        size_t Depth = 0;
+
+        // Factory creating trivia of visited tokens; trivia is not visited when null.
+        SyntaxFactory* Trivia = nullptr;
+
+        StaticSyntaxWalker() = default;
+
+        explicit StaticSyntaxWalker(SyntaxFactory* trivia)
+            : Trivia{trivia}
+        {
+        }
+
+    private:
+        [[nodiscard]] DerivedT& Self()
+        {
+            return *static_cast<DerivedT*>(this);
+        }
+
+    public:
+        void Dispatch(SyntaxNode* node)
+        {
+            if (node != nullptr)
+            {
+                switch (node->Kind) // NOLINT(clang-diagnostic-switch-enum)
+                {
+#define WEAVE_SYNTAX_NODE(name, spelling) \
+    case SyntaxKind::name: \
+        this->Self().On##name(static_cast<name*>(node)); \
+        return;
+#include "weave/syntax/SyntaxKind.inl"
+
+                default:
+                    if (IsToken(node->Kind))
+                    {
+                        this->Self().OnToken(static_cast<SyntaxToken*>(node));
+                        return;
+                    }
+
+                    if (IsTrivia(node->Kind))
+                    {
+                        this->Self().OnTrivia(static_cast<SyntaxTrivia*>(node));
+                        return;
+                    }
+
+                    WEAVE_BUGCHECK("Invalid node kind");
+                }
+            }
+        }
+
+        void OnDefault([[maybe_unused]] SyntaxNode* node)
+        {
+        }
+
+        void OnToken(SyntaxToken* token)
+        {
+            this->Self().OnDefault(token);
+
+            ++this->Depth;
+
+            if (this->Trivia != nullptr)
+            {
+                this->Self().Dispatch(this->Trivia->GetLeadingTrivia(token).GetNode());
+                this->Self().Dispatch(this->Trivia->GetTrailingTrivia(token).GetNode());
+            }
+
+            --this->Depth;
+        }
+
+        void OnTrivia(SyntaxTrivia* trivia)
+        {
+            this->Self().OnDefault(trivia);
+        }
+
+#define WEAVE_SYNTAX_NODE(name, spelling) \
+    void On##name(name* node) \
+    { \
+        this->Self().OnDefault(node); \
+\
+        ++this->Depth; \
+\
+        DispatchChildren(node, this->Self()); \
+\
+        --this->Depth; \
+    }
+#include "weave/syntax/SyntaxKind.inl"
+    };
+}
@@ -0,0 +1,1129 @@
+#pragma once
+#include "weave/syntax/SyntaxTree.hxx"
+
+namespace weave::syntax
+{
+    // Dispatches children of syntax nodes, in source order.
+    //
+    // Visitor is called for every child slot, including empty ones, and is required to ignore null nodes. Both the
+    // virtual `SyntaxWalker` and `StaticSyntaxWalker` walk children through these functions.
+
+    template <typename VisitorT>
+    void DispatchChildren(SyntaxList* node, VisitorT& visitor)
+    {
+        size_t const count = node->GetCount();
+        SyntaxNode** elements = node->GetElements();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            visitor.Dispatch(elements[i]);
+        }
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(NamespaceDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->NamespaceKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->Members);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(StructDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->StructKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->GenericParameters);
+        visitor.Dispatch(node->Constraints.GetNode());
+        visitor.Dispatch(node->Members);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(UnionDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->UnionKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->GenericParameters);
+        visitor.Dispatch(node->Constraints.GetNode());
+        visitor.Dispatch(node->Members);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ConceptDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->ConceptKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->GenericParameters);
+        visitor.Dispatch(node->Constraints.GetNode());
+        visitor.Dispatch(node->Members);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ExtendDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->ExtendKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->GenericParameters);
+        visitor.Dispatch(node->AsKeyword);
+        visitor.Dispatch(node->ConceptType);
+        visitor.Dispatch(node->Constraints.GetNode());
+        visitor.Dispatch(node->Members);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(IncompleteDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(FunctionDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->FunctionKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->GenericParameters);
+        visitor.Dispatch(node->Parameters);
+        visitor.Dispatch(node->ReturnType);
+        visitor.Dispatch(node->Constraints.GetNode());
+        visitor.Dispatch(node->BeforeBody);
+        visitor.Dispatch(node->Body);
+        visitor.Dispatch(node->ExpressionBody);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(UsingDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->UsingKeyword);
+        visitor.Dispatch(node->Name);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TupleTypeSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Elements.GetNode());
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TupleTypeElementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->Type);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ParameterListSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Parameters.GetNode());
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ParameterSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->Identifier);
+        visitor.Dispatch(node->Type);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TypeClauseSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->ColonToken);
+        visitor.Dispatch(node->Specifiers.GetNode());
+        visitor.Dispatch(node->Type);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ConstantDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->ConstKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->Type);
+        visitor.Dispatch(node->Initializer);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ExpressionInitializerClauseSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->EqualsToken);
+        visitor.Dispatch(node->Expression);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TypeInitializerClauseSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->EqualsToken);
+        visitor.Dispatch(node->DefaultType);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(LiteralExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->LiteralToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(AssignmentExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Left);
+        visitor.Dispatch(node->OperatorToken);
+        visitor.Dispatch(node->Right);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(BinaryExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Left);
+        visitor.Dispatch(node->OperatorToken);
+        visitor.Dispatch(node->Right);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(UnaryExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->OperatorToken);
+        visitor.Dispatch(node->Operand);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(PostfixUnaryExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Operand);
+        visitor.Dispatch(node->OperatorToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(InvocationExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->ArgumentList);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(MemberAccessExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->OperatorToken);
+        visitor.Dispatch(node->Name);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ArgumentListSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Arguments.GetNode());
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(BracketedArgumentListSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeOpenBracketToken);
+        visitor.Dispatch(node->OpenBracketToken);
+        visitor.Dispatch(node->Arguments.GetNode());
+        visitor.Dispatch(node->BeforeCloseBracketToken);
+        visitor.Dispatch(node->CloseBracketToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ElementAccessExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->ArgumentList);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ArgumentSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(BlockStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->Members);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ExpressionStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->Expression);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ReturnStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->ReturnKeyword);
+        visitor.Dispatch(node->Expression);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ElseClauseSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->ElseKeyword);
+        visitor.Dispatch(node->Body);
+        visitor.Dispatch(node->Continuation);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(WhileStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->WhileKeyword);
+        visitor.Dispatch(node->ConditionAttributes.GetNode());
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Condition);
+        visitor.Dispatch(node->CloseParenToken);
+        visitor.Dispatch(node->Body);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(BreakStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->BreakKeyword);
+        visitor.Dispatch(node->Label);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ContinueStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->ContinueKeyword);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(GotoStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->GotoKeyword);
+        visitor.Dispatch(node->Label);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(VariableDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->BindingSpecifier);
+        visitor.Dispatch(node->Pattern);
+        visitor.Dispatch(node->Initializer);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ConditionalExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Condition);
+        visitor.Dispatch(node->QuestionToken);
+        visitor.Dispatch(node->WhenTrue);
+        visitor.Dispatch(node->ColonToken);
+        visitor.Dispatch(node->WhenFalse);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ArrowExpressionClauseSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->ArrowToken);
+        visitor.Dispatch(node->Expression);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ReturnTypeClauseSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->ArrowToken);
+
+        visitor.Dispatch(node->Specifiers.GetNode());
+
+        visitor.Dispatch(node->Name);
+
+        visitor.Dispatch(node->Type);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(DelegateDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->DelegateKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->GenericParameters);
+        visitor.Dispatch(node->Parameters);
+        visitor.Dispatch(node->ReturnType);
+        visitor.Dispatch(node->Constraints.GetNode());
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(UnexpectedNodesSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Nodes.GetNode());
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(BalancedTokenSequenceSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Tokens.GetNode());
+        visitor.Dispatch(node->BeforeCloseParen);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(AttributeListSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->OpenAttributeToken);
+        visitor.Dispatch(node->Target);
+        visitor.Dispatch(node->Attributes.GetNode());
+
+        visitor.Dispatch(node->BeforeCloseAttributeToken);
+        visitor.Dispatch(node->CloseAttributeToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(AttributeSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->Tokens);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(SourceFileSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Elements.GetNode());
+        visitor.Dispatch(node->BeforeEndOfFileToken);
+        visitor.Dispatch(node->EndOfFileToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(EmptyStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(CodeBlockItemSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Item);
+        visitor.Dispatch(node->Semicolon);
+        visitor.Dispatch(node->AfterSemicolon);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(CodeBlockSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeLeftBrace);
+        visitor.Dispatch(node->LeftBrace);
+        visitor.Dispatch(node->Elements.GetNode());
+        visitor.Dispatch(node->BeforeRightBrace);
+        visitor.Dispatch(node->RightBrace);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(SizeOfExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->SizeOfKeyword);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(AlignOfExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->AlignOfKeyword);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TypeOfExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->TypeOfKeyword);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(NameOfExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->NameOfKeyword);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(AddressOfExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->AddressOfKeyword);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(LabeledStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->Statement);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TupleExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Elements.GetNode());
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(LabeledExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TypeAliasDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->TypeKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->EqualsToken);
+        visitor.Dispatch(node->Type);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TypeGenericParameterSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->TypeKeyword);
+        visitor.Dispatch(node->Name);
+
+        // TODO Constraints
+
+        visitor.Dispatch(node->Initializer);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ConstGenericParameterSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->ConstKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->Type);
+        visitor.Dispatch(node->Initializer);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(GenericParametersSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeOpenToken);
+        visitor.Dispatch(node->OpenToken);
+        visitor.Dispatch(node->Parameters.GetNode());
+        visitor.Dispatch(node->BeforeCloseToken);
+        visitor.Dispatch(node->CloseToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(GenericArgumentSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(GenericArgumentsSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeOpenToken);
+        visitor.Dispatch(node->OpenToken);
+        visitor.Dispatch(node->Arguments.GetNode());
+        visitor.Dispatch(node->BeforeCloseToken);
+        visitor.Dispatch(node->CloseToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(EvalExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->EvalKeyword);
+        visitor.Dispatch(node->Body);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(YieldStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->YieldKeyword);
+        visitor.Dispatch(node->KindKeyword);
+        visitor.Dispatch(node->Expression);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(IfExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->IfKeyword);
+        visitor.Dispatch(node->ConditionAttributes.GetNode());
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Condition);
+        visitor.Dispatch(node->CloseParenToken);
+        visitor.Dispatch(node->Body);
+        visitor.Dispatch(node->ElseClause);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(MatchCaseClauseSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->CaseKeyword);
+        visitor.Dispatch(node->Pattern);
+        visitor.Dispatch(node->ColonToken);
+        visitor.Dispatch(node->Body);
+        visitor.Dispatch(node->TrailingSemicolon);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(MatchDefaultClauseSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->DefaultKeyword);
+        visitor.Dispatch(node->ColonToken);
+        visitor.Dispatch(node->Body);
+        visitor.Dispatch(node->TrailingSemicolon);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(MatchExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->MatchKeyword);
+        visitor.Dispatch(node->ConditionAttributes.GetNode());
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Condition);
+        visitor.Dispatch(node->CloseParenToken);
+
+        visitor.Dispatch(node->BeforeLeftBrace);
+        visitor.Dispatch(node->LeftBrace);
+        visitor.Dispatch(node->Elements.GetNode());
+        visitor.Dispatch(node->BeforeRightBrace);
+        visitor.Dispatch(node->RightBrace);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ArrayTypeSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->OpenBracketToken);
+        visitor.Dispatch(node->ElementType);
+        visitor.Dispatch(node->ColonToken);
+        visitor.Dispatch(node->LengthExpression);
+        visitor.Dispatch(node->CloseBracketToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(SliceTypeSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->OpenBracketToken);
+        visitor.Dispatch(node->ElementType);
+        visitor.Dispatch(node->CloseBracketToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TypePointerSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->AsteriskToken);
+        visitor.Dispatch(node->Qualifiers.GetNode());
+        visitor.Dispatch(node->Type);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(CheckedStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->CheckedKeyword);
+        visitor.Dispatch(node->Body);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(UncheckedStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->UncheckedKeyword);
+        visitor.Dispatch(node->Body);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(LoopStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->LoopKeyword);
+        visitor.Dispatch(node->Body);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(RepeatStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->RepeatKeyword);
+        visitor.Dispatch(node->Body);
+        visitor.Dispatch(node->WhileKeyword);
+        visitor.Dispatch(node->ConditionAttributes.GetNode());
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Condition);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(UnsafeStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->UnsafeKeyword);
+        visitor.Dispatch(node->Body);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(WildcardPatternSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->WildcardToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(LiteralPatternSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->LiteralToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(IdentifierPatternSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Identifier);
+        visitor.Dispatch(node->Pattern);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(SlicePatternSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->OpenBracketToken);
+        visitor.Dispatch(node->Items.GetNode());
+        visitor.Dispatch(node->CloseBracketToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(SlicePatternItemSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Pattern);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TuplePatternSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Items.GetNode());
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TuplePatternItemSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->Pattern);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TypePatternSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Pattern);
+        visitor.Dispatch(node->Type);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(EnumDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+
+        visitor.Dispatch(node->EnumKeyword);
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->GenericParameters);
+        visitor.Dispatch(node->BaseType);
+
+        visitor.Dispatch(node->BeforeOpenBrace);
+        visitor.Dispatch(node->OpenBraceToken);
+
+        visitor.Dispatch(node->Members.GetNode());
+
+        visitor.Dispatch(node->BeforeCloseBrace);
+        visitor.Dispatch(node->CloseBraceToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(EnumMemberDeclarationSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+        visitor.Dispatch(node->Identifier);
+        visitor.Dispatch(node->Tuple);
+        visitor.Dispatch(node->Discriminator);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(MoveExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->MoveKeyword);
+        visitor.Dispatch(node->Expression);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(RefExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->RefKeyword);
+        visitor.Dispatch(node->Expression);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(OutExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->OutKeyword);
+        visitor.Dispatch(node->Expression);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(WhereClauseSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->WhereKeyword);
+
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+
+        visitor.Dispatch(node->Type);
+
+        visitor.Dispatch(node->BeforeColon);
+        visitor.Dispatch(node->Colon);
+
+        visitor.Dispatch(node->Predicates.GetNode());
+
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(WherePredicateSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Type);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ContractClauseSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Introducer);
+
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+
+        visitor.Dispatch(node->Level);
+
+        visitor.Dispatch(node->Condition);
+
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(AssertExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->AssertKeyword);
+
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+
+        visitor.Dispatch(node->Level);
+
+        visitor.Dispatch(node->Condition);
+
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(NameColonSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->ColonToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(LetExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BindingSpecifier);
+        visitor.Dispatch(node->Pattern);
+        visitor.Dispatch(node->Initializer);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ExpressionReferenceSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->AmpersandToken);
+        visitor.Dispatch(node->QualifierToken);
+        visitor.Dispatch(node->Expression);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TypeReferenceSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->AmpersandToken);
+        visitor.Dispatch(node->Qualifiers.GetNode());
+        visitor.Dispatch(node->Type);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(StructExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->TypeName);
+        visitor.Dispatch(node->BeforeOpenBraceToken);
+        visitor.Dispatch(node->OpenBraceToken);
+        visitor.Dispatch(node->Elements.GetNode());
+        visitor.Dispatch(node->BeforeCloseBraceToken);
+        visitor.Dispatch(node->CloseBraceToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ArrayExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeOpenBracketToken);
+        visitor.Dispatch(node->OpenBracketToken);
+        visitor.Dispatch(node->Elements.GetNode());
+        visitor.Dispatch(node->BeforeCloseBracketToken);
+        visitor.Dispatch(node->CloseBracketToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(StructPatternSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->BeforeOpenBraceToken);
+        visitor.Dispatch(node->OpenBraceToken);
+        visitor.Dispatch(node->Fields.GetNode());
+        visitor.Dispatch(node->BeforeCloseBraceToken);
+        visitor.Dispatch(node->CloseBraceToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(FieldPatternSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Name);
+        visitor.Dispatch(node->ColonToken);
+        visitor.Dispatch(node->Pattern);
+        visitor.Dispatch(node->TrailingComma);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(PatternOrItemSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Pattern);
+        visitor.Dispatch(node->TrailingBarToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(PatternOrSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Items.GetNode());
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ForStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->ForKeyword);
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Initializer);
+        visitor.Dispatch(node->FirstSemicolonToken);
+        visitor.Dispatch(node->Condition);
+        visitor.Dispatch(node->SecondSemicolonToken);
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+        visitor.Dispatch(node->Body);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(ForeachStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->ForeachKeyword);
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Variable);
+        visitor.Dispatch(node->InKeyword);
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+        visitor.Dispatch(node->Body);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TypeInheritanceClause* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->ColonToken);
+        visitor.Dispatch(node->BaseType);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(LazyStatementSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Attributes.GetNode());
+        visitor.Dispatch(node->Modifiers.GetNode());
+        visitor.Dispatch(node->LazyKeyword);
+        visitor.Dispatch(node->Body);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(AttributeTargetSpecifierSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Identifier);
+        visitor.Dispatch(node->ColonToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(OldExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->OldKeyword);
+        visitor.Dispatch(node->BeforeOpenParenToken);
+        visitor.Dispatch(node->OpenParenToken);
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->BeforeCloseParenToken);
+        visitor.Dispatch(node->CloseParenToken);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(UnreachableExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->UnreachableKeyword);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(IdentifierSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Identifier);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(IndexSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Index);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(PathSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Segments.GetNode());
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(PathSegmentSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Identifier);
+        visitor.Dispatch(node->Arguments);
+        visitor.Dispatch(node->TrailingSeparator);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(PathExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Path);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(TypePathSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Path);
+    }
+
+    template <typename VisitorT>
+    void DispatchChildren(WithExpressionSyntax* node, VisitorT& visitor)
+    {
+        visitor.Dispatch(node->Expression);
+        visitor.Dispatch(node->WithKeyword);
+        visitor.Dispatch(node->BeforeOpenBraceToken);
+        visitor.Dispatch(node->OpenBraceToken);
+        visitor.Dispatch(node->Elements.GetNode());
+        visitor.Dispatch(node->BeforeCloseBraceToken);
+        visitor.Dispatch(node->CloseBraceToken);
+    }
+}
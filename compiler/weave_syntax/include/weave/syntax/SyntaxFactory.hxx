@@ -3,12 +3,19 @@
 #include "weave/stringpool/StringPool.hxx"
 #include "weave/syntax/SyntaxToken.hxx"
 
+#include <unordered_map>
+#include <vector>
+
 namespace weave::syntax
 {
     class SyntaxFactory final
     {
+        // Deserialized tokens and trivia are restored directly into allocators of the factory.
+        friend class SyntaxTreeReader;
+
     private:
         memory::TypedLinearAllocator<SyntaxToken> TokenAllocator{16u << 10u};
+        // Trivia nodes are created lazily, when requested for a token.
         memory::TypedLinearAllocator<SyntaxTrivia> TriviaAllocator{};
         memory::TypedLinearAllocator<CharacterLiteralSyntaxToken> CharacterLiteralAllocator{};
         memory::TypedLinearAllocator<StringLiteralSyntaxToken> StringLiteralAllocator{};
@@ -17,8 +24,30 @@ namespace weave::syntax
         memory::TypedLinearAllocator<IdentifierSyntaxToken> IdentifierAllocator{};
 
         memory::LinearAllocator SyntaxNodeAllocator{128u << 10u};
+
+        // Trivia lists are created for tokens and must survive rewinding of syntax nodes.
+        memory::LinearAllocator TriviaListAllocator{};
+
+        // Packed trivia of all tokens.
+        std::vector<SyntaxTriviaEntry> TriviaEntries{};
+        memory::MemoryArena* TriviaEntriesArena{};
+
+        // Trivia lists created so far, by index of first entry.
+        std::unordered_map<uint32_t, SyntaxList*> TriviaLists{};
         stringpool::StringPool Strings{};
 
+        // Number of symbols stored in tokens.
+        size_t SymbolReferences{};
+
+    public:
+        SyntaxFactory();
+        ~SyntaxFactory();
+
+        SyntaxFactory(SyntaxFactory const&) = delete;
+        SyntaxFactory(SyntaxFactory&&) = delete;
+        SyntaxFactory& operator=(SyntaxFactory const&) = delete;
+        SyntaxFactory& operator=(SyntaxFactory&&) = delete;
+
     public:
         template <typename NodeT, typename... ArgsT>
             requires(std::is_base_of_v<SyntaxNode, NodeT>)
@@ -35,18 +64,66 @@ namespace weave::syntax
                 return nullptr;
             }
 
-            std::span<SyntaxNode*> const elements = this->SyntaxNodeAllocator.EmplaceArray<SyntaxNode*>(builder.size());
+            SyntaxList* const result = AllocateList(this->SyntaxNodeAllocator, builder.size());
+            SyntaxNode** const elements = result->GetElements();
+
             for (size_t i = 0; i < builder.size(); ++i)
             {
                 elements[i] = static_cast<SyntaxNode*>(builder[i]);
             }
 
-            return this->CreateNode<SyntaxList>(elements);
+            return result;
         }
 
+    private:
+        // Allocates list with uninitialized elements stored after it.
+        [[nodiscard]] static SyntaxList* AllocateList(memory::LinearAllocator& allocator, size_t count);
+
+    public:
+        /// \brief Gets marker of syntax nodes created so far.
+        [[nodiscard]] memory::LinearAllocator::Marker Mark() const
+        {
+            return this->SyntaxNodeAllocator.Mark();
+        }
+
+        /// \brief Releases syntax nodes and lists created after the marker was taken.
+        ///
+        /// \note Tokens and trivia are not released, as lexer creates them independently of parser position.
+        void Rewind(memory::LinearAllocator::Marker const& marker)
+        {
+            this->SyntaxNodeAllocator.Rewind(marker);
+        }
+
+    private:
+        [[nodiscard]] SyntaxTriviaRange CreateTrivia(
+            source::SourceSpan const& source,
+            std::span<SyntaxTrivia const> leadingTrivia,
+            std::span<SyntaxTrivia const> trailingTrivia);
+
+        [[nodiscard]] SyntaxListView<SyntaxTrivia> CreateTriviaList(
+            source::SourcePosition start,
+            std::span<SyntaxTriviaEntry const> entries);
+
     public:
-        SyntaxListView<SyntaxTrivia> CreateTriviaList(std::span<SyntaxTrivia const> trivia);
+        /// \brief Gets leading trivia of the token, creating trivia nodes on first request.
+        [[nodiscard]] SyntaxListView<SyntaxTrivia> GetLeadingTrivia(SyntaxToken const* token);
+
+        /// \brief Gets trailing trivia of the token, creating trivia nodes on first request.
+        [[nodiscard]] SyntaxListView<SyntaxTrivia> GetTrailingTrivia(SyntaxToken const* token);
+
+        /// \brief Gets packed leading trivia of the token, without creating trivia nodes.
+        [[nodiscard]] std::span<SyntaxTriviaEntry const> GetLeadingTriviaEntries(SyntaxToken const* token) const
+        {
+            return std::span{this->TriviaEntries}.subspan(token->TriviaIndex, token->LeadingTriviaCount);
+        }
+
+        /// \brief Gets packed trailing trivia of the token, without creating trivia nodes.
+        [[nodiscard]] std::span<SyntaxTriviaEntry const> GetTrailingTriviaEntries(SyntaxToken const* token) const
+        {
+            return std::span{this->TriviaEntries}.subspan(token->TriviaIndex + token->LeadingTriviaCount, token->TrailingTriviaCount);
+        }
 
+    public:
         SyntaxToken* CreateToken(
             SyntaxKind kind,
             source::SourceSpan const& source);
@@ -60,14 +137,12 @@ namespace weave::syntax
         SyntaxToken* CreateToken(
             SyntaxKind kind,
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia);
+            SyntaxTriviaRange trivia);
 
         SyntaxToken* CreateMissingToken(
             SyntaxKind kind,
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia);
+            SyntaxTriviaRange trivia);
 
         SyntaxToken* CreateMissingContextualKeyword(
             SyntaxKind kind,
@@ -80,8 +155,7 @@ namespace weave::syntax
             return this->CreateMissingToken(
                 kind,
                 source,
-                SyntaxListView<SyntaxTrivia>{},
-                SyntaxListView<SyntaxTrivia>{});
+                SyntaxTriviaRange{});
         }
 
         SyntaxToken* CreateMissingToken(
@@ -128,6 +202,22 @@ namespace weave::syntax
             std::string_view value);
 
     public:
+        [[nodiscard]] stringpool::SymbolId GetSymbol(std::string_view value);
+
+        [[nodiscard]] std::string_view GetText(stringpool::SymbolId symbol) const
+        {
+            return this->Strings.GetText(symbol);
+        }
+
+    public:
+        void QuerySyntaxNodesMemoryUsage(size_t& allocated, size_t& reserved) const
+        {
+            this->SyntaxNodeAllocator.QueryMemoryUsage(allocated, reserved);
+        }
+
+        /// \brief Gets memory used by tokens and their trivia.
+        void QueryTokensMemoryUsage(size_t& allocated, size_t& reserved) const;
+
         void DebugDump();
     };
 }
@@ -48,9 +48,12 @@ namespace weave::syntax
         }
     };
 
-    class SyntaxList : public SyntaxNode
+    /// \brief List of syntax nodes.
+    ///
+    /// \details Elements are stored in memory directly after the list object, so each list is a single allocation.
+    ///          Lists are created by `SyntaxFactory`.
+    class alignas(SyntaxNode*) SyntaxList : public SyntaxNode
     {
-        // Optimization idea: we can store elements in memory after the SyntaxList object
     public:
         static constexpr bool ClassOf(SyntaxKind kind)
         {
@@ -63,29 +66,41 @@ namespace weave::syntax
         }
 
     private:
-        std::span<SyntaxNode*> _elements{};
+        uint32_t _count{};
 
     public:
-        explicit constexpr SyntaxList(std::span<SyntaxNode*> elements)
+        explicit constexpr SyntaxList(uint32_t count)
             : SyntaxNode{SyntaxKind::SyntaxList}
-            , _elements{elements}
+            , _count{count}
         {
         }
 
+        SyntaxList(SyntaxList const&) = delete;
+        SyntaxList(SyntaxList&&) = delete;
+        SyntaxList& operator=(SyntaxList const&) = delete;
+        SyntaxList& operator=(SyntaxList&&) = delete;
+
     public:
-        [[nodiscard]] constexpr SyntaxNode** GetElements() const
+        /// \brief Gets size of memory required for list of given number of elements.
+        [[nodiscard]] static constexpr size_t GetAllocationSize(size_t count)
+        {
+            return sizeof(SyntaxList) + (count * sizeof(SyntaxNode*));
+        }
+
+        [[nodiscard]] SyntaxNode** GetElements() const
         {
-            return this->_elements.data();
+            return reinterpret_cast<SyntaxNode**>(const_cast<SyntaxList*>(this) + 1);
         }
 
         [[nodiscard]] constexpr size_t GetCount() const
         {
-            return this->_elements.size();
+            return this->_count;
         }
 
-        [[nodiscard]] constexpr SyntaxNode* Get(size_t index) const
+        [[nodiscard]] SyntaxNode* Get(size_t index) const
         {
-            return this->_elements[index];
+            WEAVE_ASSERT(index < this->_count);
+            return this->GetElements()[index];
         }
     };
 }
@@ -120,6 +135,12 @@ namespace weave::syntax
             return this->_node;
         }
 
+        /// \brief Gets reference to the list node, allowing visitors of child slots to replace it.
+        [[nodiscard]] constexpr SyntaxList*& GetNode()
+        {
+            return this->_node;
+        }
+
         [[nodiscard]] constexpr size_t GetCount() const
         {
             if (this->_node == nullptr)
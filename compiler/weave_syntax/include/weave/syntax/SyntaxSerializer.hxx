@@ -0,0 +1,29 @@
+#pragma once
+#include "weave/syntax/SyntaxTree.hxx"
+
+#include <span>
+#include <vector>
+
+namespace weave::syntax
+{
+    class SyntaxFactory;
+
+    /// \brief Serializes syntax tree into compact binary format.
+    ///
+    /// \details Nodes are stored in pre-order, each one followed by all of its child slots. Tokens are stored with
+    ///          flags, packed trivia and values of literals. Integers are stored as compressed integers, and start of
+    ///          each token is stored relative to the end of previous one. Strings of symbols are stored once, at the
+    ///          first reference. Trivia nodes are not stored, as factory creates them on request.
+    void SerializeSyntaxTree(std::vector<std::byte>& output, SyntaxFactory const& factory, SourceFileSyntax* root);
+
+    /// \brief Deserializes syntax tree into the factory.
+    ///
+    /// \details Nodes, tokens and trivia are restored in a single pass over the input and allocated from arenas of the
+    ///          factory. Input is expected to be written by the same version of compiler; header of the input is
+    ///          validated, but structure of malformed input is checked only to stay within its bounds.
+    ///          Nesting depth of nodes is limited, so deeply nested input is rejected instead of exhausting the stack.
+    ///
+    /// \return Root of the tree, or `nullptr` when the input is malformed. Nodes restored before the error are left
+    ///         in the factory.
+    [[nodiscard]] SourceFileSyntax* DeserializeSyntaxTree(SyntaxFactory& factory, std::span<std::byte const> input);
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "weave/syntax/SyntaxNode.hxx"
 #include "weave/bitwise/Flag.hxx"
+#include "weave/stringpool/StringPool.hxx"
 
 #include <span>
 
@@ -19,7 +20,26 @@ namespace weave::syntax
         }
     };
 
-    enum class SyntaxTokenFlags : uint32_t
+    /// \brief Trivia packed in side-table of syntax factory.
+    ///
+    /// \details Entries of token trivia are contiguous. Leading trivia ends at start of the token and trailing trivia
+    ///          starts at its end, so position of each entry follows from lengths of its neighbours.
+    struct SyntaxTriviaEntry final
+    {
+        // Kind of trivia, or `None` for text skipped by the lexer, which has no trivia node.
+        SyntaxKind Kind;
+        uint32_t Length;
+    };
+
+    /// \brief Range of token trivia entries in side-table of syntax factory.
+    struct SyntaxTriviaRange final
+    {
+        uint32_t Index{};
+        uint16_t LeadingCount{};
+        uint16_t TrailingCount{};
+    };
+
+    enum class SyntaxTokenFlags : uint16_t
     {
         None = 0u,
         Missing = 1u << 0u,
@@ -29,37 +49,51 @@ namespace weave::syntax
 
     struct SyntaxToken : SyntaxNode
     {
+        // Fields are ordered to fill padding after the kind.
+        uint16_t LeadingTriviaCount{};
+
         source::SourceSpan Source;
 
         bitwise::Flags<SyntaxTokenFlags> Flags{};
 
-        SyntaxListView<SyntaxTrivia> LeadingTrivia{};
-        SyntaxListView<SyntaxTrivia> TrailingTrivia{};
+        uint16_t TrailingTriviaCount{};
+
+        // Index of first trivia entry in side-table of the factory.
+        uint32_t TriviaIndex{};
 
         constexpr SyntaxToken(
             SyntaxKind kind,
             source::SourceSpan source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia)
+            SyntaxTriviaRange trivia)
             : SyntaxNode{kind}
+            , LeadingTriviaCount{trivia.LeadingCount}
             , Source{source}
-            , LeadingTrivia{leadingTrivia}
-            , TrailingTrivia{trailingTrivia}
+            , TrailingTriviaCount{trivia.TrailingCount}
+            , TriviaIndex{trivia.Index}
         {
         }
 
         constexpr SyntaxToken(
             SyntaxKind kind,
             source::SourceSpan source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             bitwise::Flags<SyntaxTokenFlags> flags)
             : SyntaxNode{kind}
+            , LeadingTriviaCount{trivia.LeadingCount}
             , Source{source}
             , Flags{flags}
-            , LeadingTrivia{leadingTrivia}
-            , TrailingTrivia{trailingTrivia}
+            , TrailingTriviaCount{trivia.TrailingCount}
+            , TriviaIndex{trivia.Index}
+        {
+        }
+
+        [[nodiscard]] constexpr SyntaxTriviaRange GetTriviaRange() const
         {
+            return SyntaxTriviaRange{
+                .Index = this->TriviaIndex,
+                .LeadingCount = this->LeadingTriviaCount,
+                .TrailingCount = this->TrailingTriviaCount,
+            };
         }
 
         [[nodiscard]] constexpr bool IsMissing() const
@@ -94,17 +128,16 @@ namespace weave::syntax
         }
 
         LiteralPrefixKind Prefix;
-        std::string_view Value;
-        std::string_view Suffix;
+        stringpool::SymbolId Value;
+        stringpool::SymbolId Suffix;
 
         constexpr IntegerLiteralSyntaxToken(
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             LiteralPrefixKind prefix,
-            std::string_view value,
-            std::string_view suffix)
-            : SyntaxToken{SyntaxKind::IntegerLiteralToken, source, leadingTrivia, trailingTrivia}
+            stringpool::SymbolId value,
+            stringpool::SymbolId suffix)
+            : SyntaxToken{SyntaxKind::IntegerLiteralToken, source, trivia}
             , Prefix{prefix}
             , Value{value}
             , Suffix{suffix}
@@ -113,13 +146,12 @@ namespace weave::syntax
 
         constexpr IntegerLiteralSyntaxToken(
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             LiteralPrefixKind prefix,
-            std::string_view value,
-            std::string_view suffix,
+            stringpool::SymbolId value,
+            stringpool::SymbolId suffix,
             bitwise::Flags<SyntaxTokenFlags> flags)
-            : SyntaxToken{SyntaxKind::IntegerLiteralToken, source, leadingTrivia, trailingTrivia, flags}
+            : SyntaxToken{SyntaxKind::IntegerLiteralToken, source, trivia, flags}
             , Prefix{prefix}
             , Value{value}
             , Suffix{suffix}
@@ -140,17 +172,16 @@ namespace weave::syntax
         }
 
         LiteralPrefixKind Prefix;
-        std::string_view Value;
-        std::string_view Suffix;
+        stringpool::SymbolId Value;
+        stringpool::SymbolId Suffix;
 
         constexpr FloatLiteralSyntaxToken(
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             LiteralPrefixKind prefix,
-            std::string_view value,
-            std::string_view suffix)
-            : SyntaxToken{SyntaxKind::FloatLiteralToken, source, leadingTrivia, trailingTrivia}
+            stringpool::SymbolId value,
+            stringpool::SymbolId suffix)
+            : SyntaxToken{SyntaxKind::FloatLiteralToken, source, trivia}
             , Prefix{prefix}
             , Value{value}
             , Suffix{suffix}
@@ -159,13 +190,12 @@ namespace weave::syntax
 
         constexpr FloatLiteralSyntaxToken(
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             LiteralPrefixKind prefix,
-            std::string_view value,
-            std::string_view suffix,
+            stringpool::SymbolId value,
+            stringpool::SymbolId suffix,
             bitwise::Flags<SyntaxTokenFlags> flags)
-            : SyntaxToken{SyntaxKind::FloatLiteralToken, source, leadingTrivia, trailingTrivia, flags}
+            : SyntaxToken{SyntaxKind::FloatLiteralToken, source, trivia, flags}
             , Prefix{prefix}
             , Value{value}
             , Suffix{suffix}
@@ -186,15 +216,14 @@ namespace weave::syntax
         }
 
         LiteralPrefixKind Prefix;
-        std::string_view Value;
+        stringpool::SymbolId Value;
 
         constexpr StringLiteralSyntaxToken(
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             LiteralPrefixKind prefix,
-            std::string_view value)
-            : SyntaxToken{SyntaxKind::StringLiteralToken, source, leadingTrivia, trailingTrivia}
+            stringpool::SymbolId value)
+            : SyntaxToken{SyntaxKind::StringLiteralToken, source, trivia}
             , Prefix{prefix}
             , Value{value}
         {
@@ -202,12 +231,11 @@ namespace weave::syntax
 
         constexpr StringLiteralSyntaxToken(
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             LiteralPrefixKind prefix,
-            std::string_view value,
+            stringpool::SymbolId value,
             bitwise::Flags<SyntaxTokenFlags> flags)
-            : SyntaxToken{SyntaxKind::StringLiteralToken, source, leadingTrivia, trailingTrivia, flags}
+            : SyntaxToken{SyntaxKind::StringLiteralToken, source, trivia, flags}
             , Prefix{prefix}
             , Value{value}
         {
@@ -231,11 +259,10 @@ namespace weave::syntax
 
         constexpr CharacterLiteralSyntaxToken(
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             LiteralPrefixKind prefix,
             char32_t value)
-            : SyntaxToken{SyntaxKind::CharacterLiteralToken, source, leadingTrivia, trailingTrivia}
+            : SyntaxToken{SyntaxKind::CharacterLiteralToken, source, trivia}
             , Prefix{prefix}
             , Value{value}
         {
@@ -243,12 +270,11 @@ namespace weave::syntax
 
         constexpr CharacterLiteralSyntaxToken(
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             LiteralPrefixKind prefix,
             char32_t value,
             bitwise::Flags<SyntaxTokenFlags> flags)
-            : SyntaxToken{SyntaxKind::CharacterLiteralToken, source, leadingTrivia, trailingTrivia, flags}
+            : SyntaxToken{SyntaxKind::CharacterLiteralToken, source, trivia, flags}
             , Prefix{prefix}
             , Value{value}
         {
@@ -268,15 +294,14 @@ namespace weave::syntax
         }
 
         SyntaxKind ContextualKeyowrd{};
-        std::string_view Identifier;
+        stringpool::SymbolId Identifier;
 
         constexpr IdentifierSyntaxToken(
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             SyntaxKind contextualKeyword,
-            std::string_view identifier)
-            : SyntaxToken{SyntaxKind::IdentifierToken, source, leadingTrivia, trailingTrivia}
+            stringpool::SymbolId identifier)
+            : SyntaxToken{SyntaxKind::IdentifierToken, source, trivia}
             , ContextualKeyowrd{contextualKeyword}
             , Identifier{identifier}
         {
@@ -284,12 +309,11 @@ namespace weave::syntax
 
         constexpr IdentifierSyntaxToken(
             source::SourceSpan const& source,
-            SyntaxListView<SyntaxTrivia> leadingTrivia,
-            SyntaxListView<SyntaxTrivia> trailingTrivia,
+            SyntaxTriviaRange trivia,
             SyntaxKind contextualKeyword,
-            std::string_view identifier,
+            stringpool::SymbolId identifier,
             bitwise::Flags<SyntaxTokenFlags> flags)
-            : SyntaxToken{SyntaxKind::IdentifierToken, source, leadingTrivia, trailingTrivia, flags}
+            : SyntaxToken{SyntaxKind::IdentifierToken, source, trivia, flags}
             , ContextualKeyowrd{contextualKeyword}
             , Identifier{identifier}
         {
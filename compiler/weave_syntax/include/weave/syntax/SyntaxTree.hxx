@@ -371,6 +371,12 @@ namespace weave::syntax
     {
         WEAVE_DEFINE_SYNTAX_NODE(AttributeTargetSpecifierSyntax);
 
+    public:
+        explicit constexpr AttributeTargetSpecifierSyntax()
+            : SyntaxNode{SyntaxKind::AttributeTargetSpecifierSyntax}
+        {
+        }
+
     public:
         SyntaxToken* Identifier{};
         SyntaxToken* ColonToken{};
@@ -0,0 +1,125 @@
+#pragma once
+#include "weave/bugcheck/Assert.hxx"
+#include "weave/memory/LinearAllocator.hxx"
+#include "weave/syntax/SyntaxNode.hxx"
+
+namespace weave::syntax
+{
+    class SyntaxFactory;
+
+    enum class SyntaxTreeOrder : uint8_t
+    {
+        // Node is visited before its children.
+        PreOrder,
+
+        // Node is visited after its children.
+        PostOrder,
+
+        // Node is visited both before and after its children.
+        PreAndPostOrder,
+    };
+
+    /// \brief Iterates over syntax tree without recursion.
+    ///
+    /// \details Nodes waiting for visit are kept on explicit stack allocated from an arena, so depth of the tree is
+    ///          limited only by available memory. Children of nodes are enumerated by table of functions indexed by
+    ///          syntax kind, in the same order as `SyntaxWalker` visits them.
+    ///
+    ///          \code
+    ///          SyntaxTreeIterator it{root};
+    ///
+    ///          while (it.Next())
+    ///          {
+    ///              Process(it.GetNode(), it.GetDepth());
+    ///          }
+    ///          \endcode
+    class SyntaxTreeIterator final
+    {
+    private:
+        struct Entry final
+        {
+            SyntaxNode* Node;
+            uint32_t Depth;
+            uint16_t Slot;
+            bool Leaving;
+        };
+
+        struct ChildCollector;
+
+    private:
+        memory::LinearAllocator _allocator{16u << 10u};
+        Entry* _stack{};
+        size_t _count{};
+        size_t _capacity{};
+
+        // Factory creating trivia of visited tokens; trivia is not visited when null.
+        SyntaxFactory* _trivia{};
+
+        SyntaxTreeOrder _order{};
+        Entry _current{};
+
+        // Children of the current node are pushed on next step, unless skipped.
+        bool _expand{};
+
+    public:
+        explicit SyntaxTreeIterator(SyntaxNode* root, SyntaxTreeOrder order = SyntaxTreeOrder::PreOrder, SyntaxFactory* trivia = nullptr);
+
+        SyntaxTreeIterator(SyntaxTreeIterator const&) = delete;
+        SyntaxTreeIterator(SyntaxTreeIterator&&) = delete;
+        SyntaxTreeIterator& operator=(SyntaxTreeIterator const&) = delete;
+        SyntaxTreeIterator& operator=(SyntaxTreeIterator&&) = delete;
+
+    private:
+        void Reserve(size_t count);
+
+        void Push(SyntaxNode* node, uint32_t depth, uint16_t slot, bool leaving);
+
+        void PushChildren(SyntaxNode* node, uint32_t depth);
+
+    public:
+        /// \brief Moves to the next node.
+        ///
+        /// \return false when there are no more nodes to visit.
+        [[nodiscard]] bool Next();
+
+        /// \brief Skips children of the current node.
+        ///
+        /// \note Valid only when entering a node in pre-order traversal. Node is still visited again when leaving it.
+        void SkipChildren()
+        {
+            WEAVE_ASSERT(not this->_current.Leaving);
+            this->_expand = false;
+        }
+
+        [[nodiscard]] SyntaxNode* GetNode() const
+        {
+            return this->_current.Node;
+        }
+
+        /// \brief Gets depth of the current node; root node has depth 0.
+        [[nodiscard]] uint32_t GetDepth() const
+        {
+            return this->_current.Depth;
+        }
+
+        /// \brief Gets index of slot in parent node holding the current node, counting empty slots.
+        ///
+        /// \note Slot of list elements is 0. Leading and trailing trivia lists of tokens are in slots 0 and 1.
+        [[nodiscard]] uint16_t GetSlot() const
+        {
+            return this->_current.Slot;
+        }
+
+        /// \brief Checks whether the current node is visited after its children.
+        [[nodiscard]] bool IsLeaving() const
+        {
+            return this->_current.Leaving;
+        }
+
+        /// \brief Gets maximum number of entries stored on the stack so far.
+        [[nodiscard]] size_t GetCapacity() const
+        {
+            return this->_capacity;
+        }
+    };
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "weave/syntax/Lexer.hxx"
+
+#include <memory>
+#include <vector>
+
+namespace weave::syntax::impl
+{
+    class BackgroundLexer;
+}
+
+namespace weave::syntax
+{
+    enum class TokenStreamMode
+    {
+        /// \brief Whole source is lexed up front.
+        Eager,
+
+        /// \brief Tokens are lexed on demand, as parser requests them.
+        Streaming,
+
+        /// \brief Tokens are lexed on separate thread, one chunk ahead of parser.
+        Background,
+    };
+
+    /// \brief Provides tokens to the parser.
+    ///
+    /// \details Tokens are addressed by absolute index. Only tokens starting from the index passed to `Retain` are kept
+    ///          in the ring buffer; tokens before it may be discarded. Requesting token past the end of the source
+    ///          returns the last token.
+    class TokenStream final
+    {
+    private:
+        source::DiagnosticSink* _diagnostic{};
+        SyntaxFactory* _factory{};
+        TokenStreamMode _mode{};
+
+        // Diagnostics reported by lexer, in streaming modes.
+        source::DiagnosticSink _lexerDiagnostic{};
+
+        // Index of the first diagnostic reported after this stream was created.
+        size_t _diagnosticStart{};
+
+        std::unique_ptr<Lexer> _lexer{};
+        std::unique_ptr<impl::BackgroundLexer> _background{};
+
+        std::vector<SyntaxToken*> _buffer{};
+        size_t _first{};
+        size_t _count{};
+        size_t _retain{};
+        size_t _peakCount{};
+
+        SyntaxToken* _last{};
+        bool _completed{};
+
+    public:
+        TokenStream(
+            source::DiagnosticSink& diagnostic,
+            SyntaxFactory& factory,
+            source::SourceText const& source,
+            TokenStreamMode mode);
+
+        ~TokenStream();
+
+        TokenStream(TokenStream const&) = delete;
+        TokenStream(TokenStream&&) = delete;
+        TokenStream& operator=(TokenStream const&) = delete;
+        TokenStream& operator=(TokenStream&&) = delete;
+
+    public:
+        [[nodiscard]] SyntaxToken* Get(size_t index)
+        {
+            WEAVE_ASSERT(index >= this->_first, "Token was already discarded");
+
+            while ((index - this->_first) >= this->_count)
+            {
+                if (this->_last != nullptr)
+                {
+                    return this->_last;
+                }
+
+                this->Fill();
+            }
+
+            return this->_buffer[index & (this->_buffer.size() - 1)];
+        }
+
+        /// \brief Allows to discard all tokens before specified index.
+        void Retain(size_t index)
+        {
+            WEAVE_ASSERT(index >= this->_retain);
+            this->_retain = index;
+        }
+
+        /// \brief Lexes remaining tokens and moves lexer diagnostics into the diagnostic sink.
+        ///
+        /// \note Lexer diagnostics are placed before diagnostics reported during parsing, exactly as in eager mode.
+        ///       Called on destruction if the stream was not completed yet.
+        void Complete();
+
+        [[nodiscard]] TokenStreamMode GetMode() const
+        {
+            return this->_mode;
+        }
+
+        /// \brief Gets maximum number of tokens held in the buffer at once.
+        [[nodiscard]] size_t GetPeakCount() const
+        {
+            return this->_peakCount;
+        }
+
+    private:
+        void Fill();
+
+        void Append(SyntaxToken* token);
+    };
+}
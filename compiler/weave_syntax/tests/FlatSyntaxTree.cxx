@@ -0,0 +1,231 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/syntax/FlatSyntaxTree.hxx"
+#include "weave/syntax/Parser.hxx"
+#include "weave/syntax/StaticSyntaxWalker.hxx"
+#include "weave/syntax/SyntaxTreeIterator.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "Helpers.hxx"
+
+#include <fmt/format.h>
+
+namespace
+{
+    class FunctionCounter final : public weave::syntax::StaticSyntaxWalker<FunctionCounter>
+    {
+    public:
+        size_t Nodes{};
+        size_t Functions{};
+
+    public:
+        void OnDefault(weave::syntax::SyntaxNode* node)
+        {
+            ++this->Nodes;
+
+            if (node->Is(weave::syntax::SyntaxKind::FunctionDeclarationSyntax))
+            {
+                ++this->Functions;
+            }
+        }
+    };
+
+    // Pattern of generated functions; {0} is replaced with index of the function.
+    constexpr std::string_view FunctionPattern =
+        "// function {0}\n"
+        "public function f{0}(a: int32, b: float32, c: int32) -> int32 {{\n"
+        "    var x = [a, {0}, c, (b as int32)];\n"
+        "    if x > 0 {{ return f(x, a, b, c); }} else {{ return -x; }}\n"
+        "}}\n";
+}
+
+TEST_CASE("FlatSyntaxTree - layout matches syntax tree")
+{
+    using namespace weave::syntax;
+
+    helpers::ParsedTree const tree{helpers::GenerateSource(8, FunctionPattern)};
+    FlatSyntaxTree const flat{tree.Root};
+
+    std::span<FlatSyntaxNode const> const nodes = flat.GetNodes();
+
+    // Nodes are stored in the order of pre-order traversal.
+    SyntaxTreeIterator it{tree.Root};
+    std::vector<uint32_t> depths{};
+
+    for (FlatSyntaxNode const& node : nodes)
+    {
+        REQUIRE(it.Next());
+        REQUIRE(node.Kind == it.GetNode()->Kind);
+        REQUIRE(node.Slot == it.GetSlot());
+
+        uint32_t const depth = (node.Parent == FlatSyntaxTree::InvalidIndex) ? 0 : (depths[node.Parent] + 1);
+        REQUIRE(depth == it.GetDepth());
+        depths.push_back(depth);
+
+        if (IsToken(node.Kind))
+        {
+            REQUIRE(node.Source == static_cast<SyntaxToken*>(it.GetNode())->Source);
+            REQUIRE(node.ChildCount == 0);
+        }
+    }
+
+    REQUIRE_FALSE(it.Next());
+
+    REQUIRE(nodes[0].Kind == SyntaxKind::SourceFileSyntax);
+    REQUIRE(nodes[0].SubtreeSize == nodes.size());
+
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        // Children are found by skipping subtrees of siblings and end exactly at the end of the parent subtree.
+        uint32_t count = 0;
+        uint32_t child = flat.GetFirstChild(i);
+
+        if (child != FlatSyntaxTree::InvalidIndex)
+        {
+            for (; child < flat.GetSubtreeEnd(i); child = flat.GetNextSibling(child))
+            {
+                REQUIRE(nodes[child].Parent == i);
+                ++count;
+            }
+
+            REQUIRE(child == flat.GetSubtreeEnd(i));
+        }
+
+        REQUIRE(count == nodes[i].ChildCount);
+    }
+
+    // Spans of nodes cover all of their tokens.
+    size_t functions = 0;
+
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        if (nodes[i].Kind == SyntaxKind::FunctionDeclarationSyntax)
+        {
+            REQUIRE(tree.Text.GetText(nodes[i].Source).starts_with(fmt::format("public function f{}(", functions)));
+            REQUIRE(tree.Text.GetText(nodes[i].Source).ends_with("}"));
+
+            uint32_t const keyword = flat.GetChildInSlot(i, 2);
+            REQUIRE(keyword != FlatSyntaxTree::InvalidIndex);
+            REQUIRE(nodes[keyword].Kind == SyntaxKind::FunctionKeyword);
+
+            // Function has no generic parameters.
+            REQUIRE(flat.GetChildInSlot(i, 4) == FlatSyntaxTree::InvalidIndex);
+
+            ++functions;
+        }
+    }
+
+    REQUIRE(functions == 8);
+
+    // Top level declarations are reached by skipping subtrees: source file, list of items, item, declaration.
+    uint32_t const items = flat.GetFirstChild(0);
+    REQUIRE(nodes[items].Kind == SyntaxKind::SyntaxList);
+    REQUIRE(nodes[items].ChildCount == 8);
+
+    for (uint32_t item = flat.GetFirstChild(items); item < flat.GetSubtreeEnd(items); item = flat.GetNextSibling(item))
+    {
+        REQUIRE(nodes[item].Kind == SyntaxKind::CodeBlockItemSyntax);
+        REQUIRE(nodes[item + 1].Kind == SyntaxKind::FunctionDeclarationSyntax);
+    }
+}
+
+TEST_CASE("FlatSyntaxTree - deeply nested tree")
+{
+    using namespace weave;
+
+    constexpr uint32_t Depth = 100'000;
+
+    syntax::SyntaxFactory factory{};
+
+    syntax::LiteralExpressionSyntax* const literal = factory.CreateNode<syntax::LiteralExpressionSyntax>();
+    literal->LiteralToken = factory.CreateToken(syntax::SyntaxKind::TrueKeyword, source::SourceSpan{{Depth}, {Depth + 4}});
+
+    syntax::ExpressionSyntax* root = literal;
+
+    for (uint32_t i = 0; i < Depth; ++i)
+    {
+        syntax::UnaryExpressionSyntax* const unary = factory.CreateNode<syntax::UnaryExpressionSyntax>();
+        unary->OperatorToken = factory.CreateToken(syntax::SyntaxKind::MinusToken, source::SourceSpan{{Depth - i - 1}, {Depth - i}});
+        unary->Operand = root;
+        root = unary;
+    }
+
+    syntax::FlatSyntaxTree const flat{root};
+    REQUIRE(flat.GetNodes().size() == ((Depth * 2) + 2));
+    REQUIRE(flat.GetNode(0).SubtreeSize == flat.GetNodes().size());
+    REQUIRE(flat.GetNode(0).Source == source::SourceSpan{{0}, {Depth + 4}});
+
+    // Operand of the root is after its operator token.
+    REQUIRE(flat.GetNode(2).Kind == syntax::SyntaxKind::UnaryExpressionSyntax);
+    REQUIRE(flat.GetNode(2).SubtreeSize == (flat.GetNodes().size() - 2));
+}
+
+TEST_CASE("FlatSyntaxTree - walk", "[.benchmark]")
+{
+    using namespace weave::syntax;
+
+    helpers::ParsedTree const tree{helpers::GenerateSource(20000, FunctionPattern)};
+
+    BENCHMARK("flatten")
+    {
+        return FlatSyntaxTree{tree.Root};
+    };
+
+    FlatSyntaxTree const flat{tree.Root};
+
+    BENCHMARK("pointer tree, static walker")
+    {
+        FunctionCounter counter{};
+        counter.Dispatch(tree.Root);
+        return counter.Functions;
+    };
+
+    BENCHMARK("flat tree, linear scan")
+    {
+        size_t functions = 0;
+
+        for (FlatSyntaxNode const& node : flat.GetNodes())
+        {
+            if (node.Kind == SyntaxKind::FunctionDeclarationSyntax)
+            {
+                ++functions;
+            }
+        }
+
+        return functions;
+    };
+
+    BENCHMARK("flat tree, top level declarations")
+    {
+        // Source file, list of items, item, declaration.
+        size_t functions = 0;
+
+        uint32_t const items = flat.GetFirstChild(0);
+
+        for (uint32_t item = flat.GetFirstChild(items); item < flat.GetSubtreeEnd(items); item = flat.GetNextSibling(item))
+        {
+            if (flat.GetNode(item + 1).Kind == SyntaxKind::FunctionDeclarationSyntax)
+            {
+                ++functions;
+            }
+        }
+
+        return functions;
+    };
+
+    size_t nodes{};
+    size_t tokens{};
+    size_t reserved{};
+    tree.Factory.QuerySyntaxNodesMemoryUsage(nodes, reserved);
+    tree.Factory.QueryTokensMemoryUsage(tokens, reserved);
+
+    fmt::println("flat nodes: {}, flat memory: {} bytes, syntax nodes memory: {} bytes, tokens memory: {} bytes",
+        flat.GetNodes().size(),
+        flat.GetMemoryUsage(),
+        nodes,
+        tokens);
+}
@@ -0,0 +1,252 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/syntax/GreenTree.hxx"
+#include "weave/syntax/Parser.hxx"
+#include "weave/syntax/Visitor.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "Helpers.hxx"
+
+#include <fmt/format.h>
+
+namespace
+{
+    class TokenCollector final : public weave::syntax::SyntaxWalker
+    {
+    public:
+        std::vector<weave::syntax::SyntaxToken*> Tokens{};
+
+    public:
+        void OnToken(weave::syntax::SyntaxToken* token) override
+        {
+            if (not token->IsMissing())
+            {
+                this->Tokens.push_back(token);
+            }
+        }
+    };
+
+    void CollectTokens(weave::syntax::RedNode const* node, std::vector<weave::syntax::RedNode const*>& tokens)
+    {
+        if (node->GetGreen()->IsToken())
+        {
+            if (not static_cast<weave::syntax::GreenToken const*>(node->GetGreen())->IsMissing())
+            {
+                tokens.push_back(node);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < node->GetSlotCount(); ++i)
+            {
+                if (weave::syntax::RedNode const* const child = node->GetChild(i); child != nullptr)
+                {
+                    CollectTokens(child, tokens);
+                }
+            }
+        }
+    }
+
+    // Pattern of generated functions; {0} is replaced with index of the function, {1} with value of the changed literal.
+    constexpr std::string_view FunctionPattern =
+        "// function {0}\n"
+        "public function f{0}(a: int32, b: float32) -> int32 {{\n"
+        "    var x = [a, {1}, (b as int32)];\n"
+        "    if x > 0 {{ return f(x, a, b); }} else {{ return -x; }}\n"
+        "}}\n";
+}
+
+TEST_CASE("GreenTree - identical nodes are interned")
+{
+    using namespace weave::syntax;
+
+    GreenNodeFactory factory{};
+
+    GreenToken const* const first = factory.CreateToken(SyntaxKind::IdentifierToken, " name ", 1, 1);
+    GreenToken const* const second = factory.CreateToken(SyntaxKind::IdentifierToken, " name ", 1, 1);
+    GreenToken const* const other = factory.CreateToken(SyntaxKind::IdentifierToken, "name  ", 0, 2);
+
+    REQUIRE(first == second);
+    REQUIRE(first != other);
+    REQUIRE(first->GetText() == "name");
+    REQUIRE(other->GetText() == "name");
+
+    GreenToken const* const missing = factory.CreateMissingToken(SyntaxKind::IdentifierToken);
+    REQUIRE(missing->IsMissing());
+    REQUIRE(missing->GetWidth() == 0);
+    REQUIRE(missing == factory.CreateMissingToken(SyntaxKind::IdentifierToken));
+
+    GreenNode const* const slots[]{first, nullptr, other};
+
+    GreenNode const* const node = factory.CreateNode(SyntaxKind::IdentifierSyntax, slots);
+    REQUIRE(node == factory.CreateNode(SyntaxKind::IdentifierSyntax, slots));
+    REQUIRE(node != factory.CreateNode(SyntaxKind::IndexSyntax, slots));
+    REQUIRE(node->GetWidth() == 12);
+    REQUIRE(node->GetSlotCount() == 3);
+    REQUIRE(node->GetSlot(1) == nullptr);
+    REQUIRE(node->GetLeadingTriviaWidth() == 1);
+    REQUIRE(node->GetTrailingTriviaWidth() == 2);
+
+    GreenNodeFactoryStatistics statistics{};
+    factory.QueryStatistics(statistics);
+    REQUIRE(statistics.Tokens == 3);
+    REQUIRE(statistics.Nodes == 2);
+    REQUIRE(statistics.Reused == 3);
+}
+
+TEST_CASE("GreenTree - red nodes match source positions")
+{
+    using namespace weave::syntax;
+
+    helpers::ParsedTree const tree{helpers::GenerateSource(10, FunctionPattern)};
+    REQUIRE(tree.Root != nullptr);
+
+    GreenNodeFactory factory{};
+    GreenNode const* const root = factory.CreateFromSyntax(tree.Root, tree.Factory, tree.Text);
+
+    std::string text{};
+    root->AppendText(text);
+    REQUIRE(text == tree.Text.GetContentView());
+    REQUIRE(root->GetWidth() == tree.Text.GetContentView().size());
+
+    // Identical statements of different functions share green nodes.
+    GreenNodeFactoryStatistics statistics{};
+    factory.QueryStatistics(statistics);
+    REQUIRE(statistics.Reused != 0);
+
+    TokenCollector collector{};
+    collector.Dispatch(tree.Root);
+
+    RedTree const red{root};
+    std::vector<RedNode const*> tokens{};
+    CollectTokens(red.GetRoot(), tokens);
+
+    REQUIRE(tokens.size() == collector.Tokens.size());
+
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        REQUIRE(tokens[i]->GetKind() == collector.Tokens[i]->Kind);
+        REQUIRE(tokens[i]->GetSpan() == collector.Tokens[i]->Source);
+
+        if (tokens[i]->GetFullSpan().Start != tokens[i]->GetFullSpan().End)
+        {
+            REQUIRE(red.GetRoot()->FindToken(collector.Tokens[i]->Source.Start) == tokens[i]);
+        }
+    }
+
+    REQUIRE(tokens.back()->GetKind() == SyntaxKind::EndOfFileToken);
+
+    REQUIRE(red.GetRoot()->FindToken({static_cast<uint32_t>(text.size())}) == nullptr);
+}
+
+TEST_CASE("GreenTree - edited source reuses unchanged subtrees")
+{
+    using namespace weave::syntax;
+
+    GreenNodeFactory factory{};
+
+    helpers::ParsedTree const before{helpers::GenerateSource(8, FunctionPattern)};
+    helpers::ParsedTree const after{helpers::GenerateSource(8, FunctionPattern, 3)};
+
+    GreenNode const* const original = factory.CreateFromSyntax(before.Root, before.Factory, before.Text);
+
+    GreenNodeFactoryStatistics statistics{};
+    factory.QueryStatistics(statistics);
+    size_t const created = statistics.Nodes + statistics.Tokens;
+
+    GreenNode const* const edited = factory.CreateFromSyntax(after.Root, after.Factory, after.Text);
+    REQUIRE(original != edited);
+
+    GreenNode const* const items = original->GetSlot(0);
+    GreenNode const* const editedItems = edited->GetSlot(0);
+    REQUIRE(items->GetSlotCount() == 8);
+    REQUIRE(editedItems->GetSlotCount() == 8);
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        REQUIRE((items->GetSlot(i) == editedItems->GetSlot(i)) == (i != 3));
+    }
+
+    // Only nodes on path from changed token to the root are created.
+    factory.QueryStatistics(statistics);
+    REQUIRE((statistics.Nodes + statistics.Tokens - created) < 16);
+}
+
+TEST_CASE("GreenTree - replacing node rebuilds path to the root")
+{
+    using namespace weave::syntax;
+
+    helpers::ParsedTree const tree{helpers::GenerateSource(4, FunctionPattern)};
+
+    GreenNodeFactory factory{};
+    GreenNode const* const root = factory.CreateFromSyntax(tree.Root, tree.Factory, tree.Text);
+
+    RedTree const red{root};
+
+    std::string_view const source = tree.Text.GetContentView();
+    uint32_t const offset = static_cast<uint32_t>(source.find("f2"));
+
+    RedNode const* const name = red.GetRoot()->FindToken({offset});
+    REQUIRE(name != nullptr);
+    REQUIRE(name->GetKind() == SyntaxKind::IdentifierToken);
+
+    GreenToken const* const token = static_cast<GreenToken const*>(name->GetGreen());
+    REQUIRE(token->GetFullText() == "f2");
+
+    GreenNode const* const replacement = factory.CreateToken(SyntaxKind::IdentifierToken, "renamed", 0, 0);
+    GreenNode const* const updated = factory.Replace(name, replacement);
+
+    std::string expected{source};
+    expected.replace(name->GetFullSpan().Start.Offset, token->GetWidth(), "renamed");
+
+    std::string text{};
+    updated->AppendText(text);
+    REQUIRE(text == expected);
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        REQUIRE((root->GetSlot(0)->GetSlot(i) == updated->GetSlot(0)->GetSlot(i)) == (i != 2));
+    }
+
+    REQUIRE(root->GetSlot(1) == updated->GetSlot(1));
+}
+
+TEST_CASE("GreenTree - build", "[.benchmark]")
+{
+    using namespace weave::syntax;
+
+    helpers::ParsedTree const before{helpers::GenerateSource(20000, FunctionPattern)};
+    helpers::ParsedTree const after{helpers::GenerateSource(20000, FunctionPattern, 10000)};
+
+    BENCHMARK("build")
+    {
+        GreenNodeFactory factory{};
+        return factory.CreateFromSyntax(before.Root, before.Factory, before.Text);
+    };
+
+    GreenNodeFactory factory{};
+    (void)factory.CreateFromSyntax(before.Root, before.Factory, before.Text);
+
+    BENCHMARK("rebuild after edit")
+    {
+        return factory.CreateFromSyntax(after.Root, after.Factory, after.Text);
+    };
+
+    GreenNodeFactoryStatistics statistics{};
+    factory.QueryStatistics(statistics);
+
+    size_t allocated{};
+    size_t reserved{};
+    before.Factory.QuerySyntaxNodesMemoryUsage(allocated, reserved);
+
+    fmt::println("green nodes: {}, tokens: {}, reused: {}, green memory: {} bytes, syntax nodes memory: {} bytes",
+        statistics.Nodes,
+        statistics.Tokens,
+        statistics.Reused,
+        statistics.Allocated,
+        allocated);
+}
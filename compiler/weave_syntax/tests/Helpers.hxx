@@ -0,0 +1,48 @@
+#pragma once
+#include "weave/syntax/Parser.hxx"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace helpers
+{
+    // Pattern of generated functions; {0} is replaced with index of the function.
+    inline constexpr std::string_view DefaultFunctionPattern =
+        "public function f{0}(a: int32, b: float32) -> int32 {{\n"
+        "    var x = a * {0} + (b as int32);\n"
+        "    if x > 0 {{ return x; }} else {{ return -x; }}\n"
+        "}}\n";
+
+    // Generates source with given number of functions formatted from the pattern.
+    // Pattern may use {1} for literal which is 42 in the changed function and 0 in all others.
+    inline std::string GenerateSource(size_t functions, std::string_view pattern = DefaultFunctionPattern, size_t changed = SIZE_MAX)
+    {
+        std::string result{};
+
+        for (size_t i = 0; i < functions; ++i)
+        {
+            result += fmt::format(fmt::runtime(pattern), i, (i == changed) ? 42 : 0);
+        }
+
+        return result;
+    }
+
+    // Source parsed with syntax factory owned by the tree.
+    struct ParsedTree final
+    {
+        weave::source::SourceText Text;
+        weave::source::DiagnosticSink Diagnostic{"<source>"};
+        weave::syntax::SyntaxFactory Factory{};
+        weave::syntax::SourceFileSyntax* Root{};
+
+        explicit ParsedTree(std::string&& source)
+            : Text{std::move(source)}
+        {
+            weave::syntax::Parser parser{&this->Diagnostic, &this->Factory, this->Text};
+            this->Root = parser.ParseSourceFile();
+        }
+    };
+}
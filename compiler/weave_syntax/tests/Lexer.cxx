@@ -1,5 +1,6 @@
 #include "weave/platform/Compiler.hxx"
 #include "weave/syntax/Lexer.hxx"
+#include "weave/syntax/SyntaxFactory.hxx"
 
 WEAVE_EXTERNAL_HEADERS_BEGIN
 
@@ -7,6 +8,10 @@ WEAVE_EXTERNAL_HEADERS_BEGIN
 
 WEAVE_EXTERNAL_HEADERS_END
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
 void LexTokenStream(
     std::string_view source,
     std::vector<weave::syntax::SyntaxKind>& result,
@@ -39,3 +44,261 @@ TEST_CASE("Merged operators")
     REQUIRE(tokens[0] == weave::syntax::SyntaxKind::LessThanLessThanToken);
     REQUIRE(tokens[1] == weave::syntax::SyntaxKind::LessThanLessThanToken);
 }
+
+TEST_CASE("Lexer - identifiers are slices of source")
+{
+    using namespace weave;
+
+    source::SourceText const text{std::string{"abc123 za\u017C\u00F3\u0142\u0107_x \u017Cab _ r#if if\t\u0085  x0"}};
+    source::DiagnosticSink diagnostic{};
+    syntax::Lexer lexer{diagnostic, text, syntax::LexerTriviaMode::All};
+
+    std::vector<std::pair<syntax::SyntaxKind, std::string_view>> tokens{};
+
+    syntax::TokenInfo token{};
+    while (lexer.Lex(token) and (token.Kind != syntax::SyntaxKind::EndOfFileToken))
+    {
+        tokens.emplace_back(token.Kind, token.Identifier);
+
+        if (not token.Identifier.empty())
+        {
+            // Identifier points into the source text.
+            std::string_view const content = text.GetContentView();
+            CHECK(token.Identifier.data() >= content.data());
+            CHECK((token.Identifier.data() + token.Identifier.size()) <= (content.data() + content.size()));
+        }
+    }
+
+    CHECK(diagnostic.Items.empty());
+
+    REQUIRE(tokens.size() == 7);
+    CHECK(tokens[0] == std::pair{syntax::SyntaxKind::IdentifierToken, std::string_view{"abc123"}});
+    CHECK(tokens[1] == std::pair{syntax::SyntaxKind::IdentifierToken, std::string_view{"za\u017C\u00F3\u0142\u0107_x"}});
+    CHECK(tokens[2] == std::pair{syntax::SyntaxKind::IdentifierToken, std::string_view{"\u017Cab"}});
+    CHECK(tokens[3] == std::pair{syntax::SyntaxKind::UnderscoreToken, std::string_view{"_"}});
+    CHECK(tokens[4] == std::pair{syntax::SyntaxKind::IdentifierToken, std::string_view{"if"}});
+    CHECK(tokens[5] == std::pair{syntax::SyntaxKind::IfKeyword, std::string_view{"if"}});
+    CHECK(tokens[6] == std::pair{syntax::SyntaxKind::IdentifierToken, std::string_view{"x0"}});
+}
+
+TEST_CASE("Lexer - identifier tokens store symbols")
+{
+    using namespace weave;
+
+    source::SourceText const text{std::string{"alpha beta alpha 42u8 42"}};
+    source::DiagnosticSink diagnostic{};
+    syntax::SyntaxFactory factory{};
+    syntax::Lexer lexer{diagnostic, text, syntax::LexerTriviaMode::All};
+
+    std::vector<syntax::SyntaxToken*> tokens{};
+
+    for (syntax::SyntaxToken* token = lexer.Lex(factory); token->Kind != syntax::SyntaxKind::EndOfFileToken; token = lexer.Lex(factory))
+    {
+        tokens.push_back(token);
+    }
+
+    REQUIRE(tokens.size() == 5);
+
+    syntax::IdentifierSyntaxToken const* const first = tokens[0]->As<syntax::IdentifierSyntaxToken>();
+    syntax::IdentifierSyntaxToken const* const second = tokens[1]->As<syntax::IdentifierSyntaxToken>();
+    syntax::IdentifierSyntaxToken const* const third = tokens[2]->As<syntax::IdentifierSyntaxToken>();
+
+    CHECK(first->Identifier == third->Identifier);
+    CHECK(first->Identifier != second->Identifier);
+    CHECK(factory.GetText(first->Identifier) == "alpha");
+    CHECK(factory.GetText(second->Identifier) == "beta");
+
+    syntax::IntegerLiteralSyntaxToken const* const suffixed = tokens[3]->As<syntax::IntegerLiteralSyntaxToken>();
+    syntax::IntegerLiteralSyntaxToken const* const plain = tokens[4]->As<syntax::IntegerLiteralSyntaxToken>();
+
+    CHECK(suffixed->Value == plain->Value);
+    CHECK(factory.GetText(suffixed->Suffix) == "u8");
+    CHECK(plain->Suffix == stringpool::SymbolId::None);
+    CHECK(factory.GetText(plain->Suffix).empty());
+}
+
+namespace
+{
+    void VerifyTrivia(weave::syntax::SyntaxListView<weave::syntax::SyntaxTrivia> list, std::vector<weave::syntax::SyntaxTrivia> const& expected)
+    {
+        REQUIRE(list.GetCount() == expected.size());
+
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            weave::syntax::SyntaxTrivia const* const trivia = list.GetElement(i);
+            CHECK(trivia->Kind == expected[i].Kind);
+            CHECK(trivia->Source == expected[i].Source);
+        }
+    }
+}
+
+TEST_CASE("Lexer - trivia is created lazily from side-table")
+{
+    using namespace weave;
+
+    auto mode = GENERATE(syntax::LexerTriviaMode::All, syntax::LexerTriviaMode::Documentation);
+
+    source::SourceText const text{std::string{
+        "/// doc\n"
+        "// comment\n"
+        "\n"
+        "   /* block */ a /* trailing */ + b // end\n"
+        "/// doc\n"
+        "   c\n"}};
+
+    source::DiagnosticSink diagnostic{};
+    syntax::SyntaxFactory factory{};
+    syntax::Lexer reference{diagnostic, text, mode};
+    syntax::Lexer lexer{diagnostic, text, mode};
+
+    syntax::TokenInfo info{};
+    size_t trivia{};
+
+    while (reference.Lex(info))
+    {
+        syntax::SyntaxToken* const token = lexer.Lex(factory);
+        REQUIRE(token->Kind == info.Kind);
+        REQUIRE(token->Source == info.Source);
+
+        VerifyTrivia(factory.GetLeadingTrivia(token), info.LeadingTrivia);
+        VerifyTrivia(factory.GetTrailingTrivia(token), info.TrailingTrivia);
+
+        // Trivia nodes are created once.
+        CHECK(factory.GetLeadingTrivia(token).GetNode() == factory.GetLeadingTrivia(token).GetNode());
+
+        trivia += info.LeadingTrivia.size() + info.TrailingTrivia.size();
+
+        if (info.Kind == syntax::SyntaxKind::EndOfFileToken)
+        {
+            break;
+        }
+    }
+
+    CHECK(trivia != 0);
+}
+
+TEST_CASE("Lexer - throughput", "[.benchmark]")
+{
+    using namespace weave;
+
+    // Lex whole syntax test corpus.
+    std::vector<source::SourceText> sources{};
+    size_t bytes{};
+
+    for (std::filesystem::directory_entry const& entry : std::filesystem::recursive_directory_iterator{WEAVE_SYNTAX_TESTS_DATA})
+    {
+        if (entry.path().extension() == ".source")
+        {
+            std::ifstream file{entry.path(), std::ios::binary};
+            std::string content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+            bytes += content.size();
+            sources.emplace_back(std::move(content));
+        }
+    }
+
+    REQUIRE_FALSE(sources.empty());
+
+    auto const lexAll = [&]
+    {
+        size_t tokens{};
+
+        for (source::SourceText const& text : sources)
+        {
+            source::DiagnosticSink diagnostic{};
+            syntax::Lexer lexer{diagnostic, text, syntax::LexerTriviaMode::All};
+            syntax::TokenInfo token{};
+
+            while (lexer.Lex(token) and (token.Kind != syntax::SyntaxKind::EndOfFileToken))
+            {
+                ++tokens;
+            }
+        }
+
+        return tokens;
+    };
+
+    BENCHMARK(fmt::format("corpus, {} files, {} bytes", sources.size(), bytes))
+    {
+        return lexAll();
+    };
+
+    constexpr size_t iterations = 200;
+
+    auto const started = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        (void)lexAll();
+    }
+
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - started;
+
+    fmt::println("lexer throughput: {:.2f} MB/s", static_cast<double>(bytes * iterations) / elapsed.count() / 1e6);
+}
+
+TEST_CASE("Lexer - bytes per token", "[.benchmark]")
+{
+    using namespace weave;
+
+    size_t tokens{};
+    size_t allocated{};
+    size_t reserved{};
+
+    for (std::filesystem::directory_entry const& entry : std::filesystem::recursive_directory_iterator{WEAVE_SYNTAX_TESTS_DATA})
+    {
+        if (entry.path().extension() == ".source")
+        {
+            std::ifstream file{entry.path(), std::ios::binary};
+            source::SourceText const text{std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}}};
+            source::DiagnosticSink diagnostic{};
+            syntax::SyntaxFactory factory{};
+            syntax::Lexer lexer{diagnostic, text, syntax::LexerTriviaMode::All};
+
+            while (lexer.Lex(factory)->Kind != syntax::SyntaxKind::EndOfFileToken)
+            {
+                ++tokens;
+            }
+
+            factory.QueryTokensMemoryUsage(allocated, reserved);
+        }
+    }
+
+    REQUIRE(tokens != 0);
+
+    fmt::println("tokens: {}, allocated: {} bytes, {:.2f} bytes per token", tokens, allocated, static_cast<double>(allocated) / static_cast<double>(tokens));
+}
+
+TEST_CASE("Lexer - unrecognized characters produce error tokens")
+{
+    using namespace weave;
+
+    for (std::string_view const source : {"\"abc\nx", "x \"", "'a\n\"\n"})
+    {
+        source::SourceText const text{std::string{source}};
+        source::DiagnosticSink diagnostic{};
+        syntax::SyntaxFactory factory{};
+        syntax::Lexer lexer{diagnostic, text, syntax::LexerTriviaMode::All};
+
+        size_t errors = 0;
+        size_t count = 0;
+
+        for (; count < 16; ++count)
+        {
+            syntax::SyntaxToken const* const token = lexer.Lex(factory);
+
+            if (token->Kind == syntax::SyntaxKind::ErrorToken)
+            {
+                REQUIRE(token->Source.Start < token->Source.End);
+                ++errors;
+            }
+            else if (token->Kind == syntax::SyntaxKind::EndOfFileToken)
+            {
+                break;
+            }
+        }
+
+        REQUIRE(count < 16);
+        REQUIRE(errors != 0);
+        REQUIRE_FALSE(diagnostic.Items.empty());
+    }
+}
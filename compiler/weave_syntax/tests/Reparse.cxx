@@ -0,0 +1,223 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/syntax/GreenTree.hxx"
+#include "weave/syntax/Parser.hxx"
+#include "weave/syntax/SyntaxTree.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "Helpers.hxx"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <random>
+
+namespace
+{
+    // Pattern of generated declarations; {0} is replaced with index of the function, {1} with value of the changed literal.
+    constexpr std::string_view FunctionPattern =
+        "// function {0}\n"
+        "public function f{0}(a: int32, b: float32) -> int32 {{\n"
+        "    var x = [a, {1}, (b as int32)];\n"
+        "    if x > 0 {{ return f(x, a, b); }} else {{ return -x; }}\n"
+        "}}\n"
+        "struct S{0} {{ var x: int32; }}\n"
+        "using T{0} = S{0};\n";
+
+    weave::syntax::GreenNode const* Parse(weave::syntax::GreenNodeFactory& factory, weave::source::SourceText const& text)
+    {
+        weave::source::DiagnosticSink diagnostic{"<source>"};
+        weave::syntax::SyntaxFactory syntax{};
+        weave::syntax::Parser parser{&diagnostic, &syntax, text};
+
+        return factory.CreateFromSyntax(parser.ParseSourceFile(), syntax, text);
+    }
+
+    // Fragments inserted by random edits; they are chosen to break and restore declaration boundaries.
+    constexpr std::array<std::string_view, 24> Fragments{
+        "",
+        " ",
+        "\n",
+        "x",
+        "42",
+        ";",
+        "{",
+        "}",
+        "(",
+        ")",
+        "[",
+        "]",
+        ",",
+        "// comment\n",
+        "/* comment */",
+        "/*",
+        "*/",
+        "\"",
+        "\"text\"",
+        "function g() { }\n",
+        "struct Q { }",
+        "if x { } else ",
+        "using U = ",
+        "public ",
+    };
+}
+
+TEST_CASE("Parser - reparse reuses declarations not affected by the change")
+{
+    using namespace weave;
+
+    syntax::GreenNodeFactory factory{};
+
+    source::SourceText const before{helpers::GenerateSource(8, FunctionPattern)};
+    source::SourceText const after{helpers::GenerateSource(8, FunctionPattern, 5)};
+
+    syntax::GreenNode const* const original = Parse(factory, before);
+
+    size_t const offset = before.GetContentView().find("0, (b as int32)", before.GetContentView().find("function f5"));
+    REQUIRE(offset != std::string_view::npos);
+
+    source::TextChange const change{
+        .Span = {{static_cast<uint32_t>(offset)}, {static_cast<uint32_t>(offset + 1)}},
+        .NewText = "42",
+    };
+
+    syntax::GreenNode const* const reparsed = syntax::Parser::Reparse(factory, original, after, change);
+    REQUIRE(reparsed == Parse(factory, after));
+
+    std::span<syntax::GreenNode const* const> const items = original->GetSlot(0)->GetSlots();
+    std::span<syntax::GreenNode const* const> const changed = reparsed->GetSlot(0)->GetSlots();
+    REQUIRE(items.size() == changed.size());
+
+    size_t different = 0;
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        if (items[i] != changed[i])
+        {
+            ++different;
+        }
+    }
+
+    REQUIRE(different == 1);
+    REQUIRE(original->GetSlot(2) == reparsed->GetSlot(2));
+}
+
+TEST_CASE("Parser - reparse at boundaries of the source")
+{
+    using namespace weave;
+
+    std::string const text = helpers::GenerateSource(3, FunctionPattern);
+
+    struct Case final
+    {
+        uint32_t Start;
+        uint32_t End;
+        std::string_view Text;
+    };
+
+    uint32_t const size = static_cast<uint32_t>(text.size());
+
+    Case const cases[]{
+        {0, 0, "using A = B;\n"},
+        {0, 0, "}"},
+        {0, 2, ""},
+        {size, size, "using A = B;\n"},
+        {size, size, "/* unterminated"},
+        {size - 2, size, ""},
+        {0, size, "function f() { }\n"},
+        {0, size, ""},
+    };
+
+    for (Case const& c : cases)
+    {
+        syntax::GreenNodeFactory factory{};
+        source::SourceText const before{std::string{text}};
+        syntax::GreenNode const* const original = Parse(factory, before);
+
+        std::string edited = text;
+        edited.replace(c.Start, c.End - c.Start, c.Text);
+        source::SourceText const after{std::move(edited)};
+
+        source::TextChange const change{
+            .Span = {{c.Start}, {c.End}},
+            .NewText = c.Text,
+        };
+
+        REQUIRE(syntax::Parser::Reparse(factory, original, after, change) == Parse(factory, after));
+    }
+}
+
+TEST_CASE("Parser - reparse matches full parse for random edits")
+{
+    using namespace weave;
+
+    std::mt19937 random{0x5eed};
+
+    for (size_t sequence = 0; sequence < 8; ++sequence)
+    {
+        syntax::GreenNodeFactory factory{};
+
+        std::string text = helpers::GenerateSource(6, FunctionPattern);
+        syntax::GreenNode const* tree = Parse(factory, source::SourceText{std::string{text}});
+
+        for (size_t step = 0; step < 100; ++step)
+        {
+            uint32_t const start = std::uniform_int_distribution<uint32_t>{0, static_cast<uint32_t>(text.size())}(random);
+            uint32_t const length = std::min<uint32_t>(std::uniform_int_distribution<uint32_t>{0, 12}(random), static_cast<uint32_t>(text.size()) - start);
+            std::string_view const fragment = Fragments[std::uniform_int_distribution<size_t>{0, Fragments.size() - 1}(random)];
+
+            INFO(fmt::format("sequence: {}, step: {}, start: {}, length: {}, text: '{}'", sequence, step, start, length, fragment));
+
+            text.replace(start, length, fragment);
+            source::SourceText const after{std::string{text}};
+
+            source::TextChange const change{
+                .Span = {{start}, {start + length}},
+                .NewText = fragment,
+            };
+
+            syntax::GreenNode const* const reparsed = syntax::Parser::Reparse(factory, tree, after, change);
+
+            // Trees created by the same factory are identical only if they are the same node.
+            REQUIRE(reparsed == Parse(factory, after));
+
+            tree = reparsed;
+        }
+
+        std::string result{};
+        tree->AppendText(result);
+        REQUIRE(result == text);
+    }
+}
+
+TEST_CASE("Parser - reparse", "[.benchmark]")
+{
+    using namespace weave;
+
+    source::SourceText const before{helpers::GenerateSource(10000, FunctionPattern)};
+    source::SourceText const after{helpers::GenerateSource(10000, FunctionPattern, 5000)};
+
+    size_t const offset = before.GetContentView().find("0, (b as int32)", before.GetContentView().find("function f5000("));
+
+    source::TextChange const change{
+        .Span = {{static_cast<uint32_t>(offset)}, {static_cast<uint32_t>(offset + 1)}},
+        .NewText = "42",
+    };
+
+    syntax::GreenNodeFactory factory{};
+    syntax::GreenNode const* const original = Parse(factory, before);
+
+    BENCHMARK("full parse")
+    {
+        return Parse(factory, after);
+    };
+
+    BENCHMARK("incremental reparse")
+    {
+        return syntax::Parser::Reparse(factory, original, after, change);
+    };
+}
@@ -1,6 +1,10 @@
 #include "weave/platform/Compiler.hxx"
 #include "weave/syntax/SyntaxKind.hxx"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 WEAVE_EXTERNAL_HEADERS_BEGIN
 
 #include <catch_amalgamated.hpp>
@@ -112,3 +116,97 @@ TEST_CASE("SyntaxKind Tests - TryMapIdentifierToKeyword")
     CHECK(TryMapIdentifierToKeyword(spelling).value_or(SyntaxKind::None) == SyntaxKind::name);
 #include "weave/syntax/SyntaxKind.inl"
 }
+
+TEST_CASE("SyntaxKind Tests - TryMapIdentifierToKeyword - non keywords")
+{
+    using namespace weave::syntax;
+
+    std::vector<std::string_view> const keywords{
+#define WEAVE_SYNTAX_KEYWORD(name, spelling) spelling,
+#define WEAVE_SYNTAX_CONTEXTUAL_KEYWORD(name, spelling) spelling,
+#include "weave/syntax/SyntaxKind.inl"
+    };
+
+    for (std::string_view const keyword : keywords)
+    {
+        CAPTURE(keyword);
+
+        // Prefixes, extensions and case variants of keywords are ordinary identifiers.
+        for (size_t length = 0; length < keyword.size(); ++length)
+        {
+            std::string_view const prefix = keyword.substr(0, length);
+
+            if (std::ranges::find(keywords, prefix) == keywords.end())
+            {
+                CHECK_FALSE(TryMapIdentifierToKeyword(prefix).has_value());
+            }
+        }
+
+        for (char const c : std::string_view{"_0aZ"})
+        {
+            std::string extended{keyword};
+            extended.push_back(c);
+
+            if (std::ranges::find(keywords, extended) == keywords.end())
+            {
+                CHECK_FALSE(TryMapIdentifierToKeyword(extended).has_value());
+            }
+        }
+
+        std::string upper{keyword};
+        std::ranges::transform(upper, upper.begin(), [](char c)
+            {
+                return static_cast<char>(((c >= 'a') and (c <= 'z')) ? (c - 'a' + 'A') : c);
+            });
+
+        if (std::ranges::find(keywords, upper) == keywords.end())
+        {
+            CHECK_FALSE(TryMapIdentifierToKeyword(upper).has_value());
+        }
+    }
+
+    CHECK_FALSE(TryMapIdentifierToKeyword("").has_value());
+    CHECK_FALSE(TryMapIdentifierToKeyword("x").has_value());
+    CHECK_FALSE(TryMapIdentifierToKeyword("\xC5\xBC").has_value());
+    CHECK_FALSE(TryMapIdentifierToKeyword("a_very_long_identifier_which_is_longer_than_any_keyword_in_the_language").has_value());
+}
+
+TEST_CASE("SyntaxKind Tests - TryMapIdentifierToKeyword - benchmark", "[.benchmark]")
+{
+    using namespace weave::syntax;
+
+    std::vector<std::string_view> const keywords{
+#define WEAVE_SYNTAX_KEYWORD(name, spelling) spelling,
+#define WEAVE_SYNTAX_CONTEXTUAL_KEYWORD(name, spelling) spelling,
+#include "weave/syntax/SyntaxKind.inl"
+    };
+
+    std::vector<std::string_view> const identifiers{
+        "x", "i", "value1", "count", "result", "index", "foo_bar", "Vector3", "buffer", "length",
+        "node", "first", "last", "m_data", "callback", "T", "item", "source", "target", "a_long_identifier_name",
+        "IsValid", "GetName", "parser", "token", "kind", "self_", "ifx", "fn", "var_", "letter"};
+
+    BENCHMARK("keywords")
+    {
+        size_t matched{};
+
+        for (std::string_view const value : keywords)
+        {
+            matched += TryMapIdentifierToKeyword(value).has_value();
+        }
+
+        return matched;
+    };
+
+    BENCHMARK("identifiers")
+    {
+        size_t matched{};
+
+        for (std::string_view const value : identifiers)
+        {
+            matched += TryMapIdentifierToKeyword(value).has_value();
+        }
+
+        return matched;
+    };
+}
@@ -0,0 +1,321 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/bitwise/CompressedInteger.hxx"
+#include "weave/syntax/Parser.hxx"
+#include "weave/syntax/StaticSyntaxWalker.hxx"
+#include "weave/syntax/SyntaxSerializer.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "Helpers.hxx"
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    // Prints the same structure as `-x:print-syntax-tree`, extended with trivia, flags and values of tokens.
+    class SyntaxTreeDumper final : public weave::syntax::StaticSyntaxWalker<SyntaxTreeDumper>
+    {
+    private:
+        weave::source::SourceText const& _text;
+
+    public:
+        std::string Output{};
+
+    public:
+        SyntaxTreeDumper(weave::source::SourceText const& text, weave::syntax::SyntaxFactory& factory)
+            : StaticSyntaxWalker{&factory}
+            , _text{text}
+        {
+        }
+
+    public:
+        void OnDefault(weave::syntax::SyntaxNode* node)
+        {
+            fmt::format_to(std::back_inserter(this->Output), "{:{}}{}\n", "", this->Depth, weave::syntax::GetName(node->Kind));
+        }
+
+        void OnToken(weave::syntax::SyntaxToken* token)
+        {
+            using namespace weave::syntax;
+
+            auto const startPosition = this->_text.GetLinePosition(token->Source.Start);
+            auto const endPosition = this->_text.GetLinePosition(token->Source.End);
+
+            fmt::format_to(std::back_inserter(this->Output), "{:{}}{} <{}:{}> [{}:{}:{}:{}]{} '{}' flags: {}",
+                "", this->Depth,
+                GetName(token->Kind),
+                token->Source.Start.Offset,
+                token->Source.End.Offset,
+                startPosition.Line, startPosition.Column,
+                endPosition.Line, endPosition.Column,
+                token->IsMissing() ? " missing" : "",
+                (not token->IsMissing()) ? this->_text.GetText(token->Source) : "",
+                std::to_underlying(static_cast<SyntaxTokenFlags>(token->Flags)));
+
+            if (IdentifierSyntaxToken const* const identifier = token->TryCast<IdentifierSyntaxToken>())
+            {
+                fmt::format_to(std::back_inserter(this->Output), " identifier: '{}' contextual: {}",
+                    this->Trivia->GetText(identifier->Identifier),
+                    GetName(identifier->ContextualKeyowrd));
+            }
+            else if (IntegerLiteralSyntaxToken const* const integer = token->TryCast<IntegerLiteralSyntaxToken>())
+            {
+                fmt::format_to(std::back_inserter(this->Output), " integer: {} '{}' '{}'",
+                    std::to_underlying(integer->Prefix),
+                    this->Trivia->GetText(integer->Value),
+                    this->Trivia->GetText(integer->Suffix));
+            }
+            else if (FloatLiteralSyntaxToken const* const real = token->TryCast<FloatLiteralSyntaxToken>())
+            {
+                fmt::format_to(std::back_inserter(this->Output), " float: {} '{}' '{}'",
+                    std::to_underlying(real->Prefix),
+                    this->Trivia->GetText(real->Value),
+                    this->Trivia->GetText(real->Suffix));
+            }
+            else if (StringLiteralSyntaxToken const* const string = token->TryCast<StringLiteralSyntaxToken>())
+            {
+                fmt::format_to(std::back_inserter(this->Output), " string: {} '{}'",
+                    std::to_underlying(string->Prefix),
+                    this->Trivia->GetText(string->Value));
+            }
+            else if (CharacterLiteralSyntaxToken const* const character = token->TryCast<CharacterLiteralSyntaxToken>())
+            {
+                fmt::format_to(std::back_inserter(this->Output), " character: {} {}",
+                    std::to_underlying(character->Prefix),
+                    static_cast<uint32_t>(character->Value));
+            }
+
+            this->Output += '\n';
+
+            ++this->Depth;
+            this->Dispatch(this->Trivia->GetLeadingTrivia(token).GetNode());
+            this->Dispatch(this->Trivia->GetTrailingTrivia(token).GetNode());
+            --this->Depth;
+        }
+
+        void OnTrivia(weave::syntax::SyntaxTrivia* trivia)
+        {
+            fmt::format_to(std::back_inserter(this->Output), "{:{}}{} <{}:{}>\n",
+                "", this->Depth,
+                weave::syntax::GetName(trivia->Kind),
+                trivia->Source.Start.Offset,
+                trivia->Source.End.Offset);
+        }
+    };
+
+    std::string Dump(weave::source::SourceText const& text, weave::syntax::SyntaxFactory& factory, weave::syntax::SyntaxNode* root)
+    {
+        SyntaxTreeDumper dumper{text, factory};
+        dumper.Dispatch(root);
+        return std::move(dumper.Output);
+    }
+
+    // Pattern of generated functions; {0} is replaced with index of the function.
+    constexpr std::string_view FunctionPattern =
+        "/// Function {0}\n"
+        "public function f{0}(a: int32, b: float32, c: int32) -> int32 {{\n"
+        "    var x = [a, {0}, c, (b as int32), 0x{0}u32, 1.5e{0}f, u8\"text {0}\", 'c'];\n"
+        "    if x > 0 {{ return f(x, a, b, c); }} else {{ return -x; }}\n"
+        "}}\n";
+
+    void RequireRoundTrip(weave::source::SourceText const& text)
+    {
+        using namespace weave;
+
+        source::DiagnosticSink diagnostic{"<source>"};
+        syntax::SyntaxFactory factory{};
+        syntax::Parser parser{&diagnostic, &factory, text};
+        syntax::SourceFileSyntax* const root = parser.ParseSourceFile();
+
+        std::vector<std::byte> serialized{};
+        syntax::SerializeSyntaxTree(serialized, factory, root);
+
+        syntax::SyntaxFactory restoredFactory{};
+        syntax::SourceFileSyntax* const restored = syntax::DeserializeSyntaxTree(restoredFactory, serialized);
+        REQUIRE(restored != nullptr);
+
+        REQUIRE(Dump(text, restoredFactory, restored) == Dump(text, factory, root));
+
+        // Serialized form of restored tree is the same.
+        std::vector<std::byte> reserialized{};
+        syntax::SerializeSyntaxTree(reserialized, restoredFactory, restored);
+        REQUIRE(reserialized == serialized);
+    }
+}
+
+TEST_CASE("SyntaxSerializer - round trip")
+{
+    using namespace weave;
+
+    SECTION("Generated source")
+    {
+        RequireRoundTrip(source::SourceText{helpers::GenerateSource(16, FunctionPattern)});
+    }
+
+    SECTION("Source with errors")
+    {
+        RequireRoundTrip(source::SourceText{"struct S { var x: int32 = @; } function f( { return ; /* trailing */"});
+    }
+
+    SECTION("Empty source")
+    {
+        RequireRoundTrip(source::SourceText{""});
+    }
+
+    SECTION("Test corpus")
+    {
+        for (std::filesystem::directory_entry const& entry : std::filesystem::recursive_directory_iterator{WEAVE_SYNTAX_TESTS_DATA})
+        {
+            if (entry.path().extension() == ".source")
+            {
+                std::ifstream file{entry.path(), std::ios::binary};
+                INFO(entry.path().string());
+                RequireRoundTrip(source::SourceText{std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}}});
+            }
+        }
+    }
+}
+
+TEST_CASE("SyntaxSerializer - malformed input")
+{
+    using namespace weave;
+
+    source::SourceText const text{helpers::GenerateSource(2, FunctionPattern)};
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+    syntax::Parser parser{&diagnostic, &factory, text};
+    syntax::SourceFileSyntax* const root = parser.ParseSourceFile();
+
+    std::vector<std::byte> serialized{};
+    syntax::SerializeSyntaxTree(serialized, factory, root);
+
+    SECTION("Truncated input")
+    {
+        for (size_t size = 0; size < serialized.size(); ++size)
+        {
+            syntax::SyntaxFactory restored{};
+            REQUIRE(syntax::DeserializeSyntaxTree(restored, std::span{serialized}.first(size)) == nullptr);
+        }
+    }
+
+    SECTION("Trailing data")
+    {
+        serialized.push_back(std::byte{});
+
+        syntax::SyntaxFactory restored{};
+        REQUIRE(syntax::DeserializeSyntaxTree(restored, serialized) == nullptr);
+    }
+
+    SECTION("Invalid header")
+    {
+        // Format version.
+        serialized[4] = std::byte{0xFF};
+
+        syntax::SyntaxFactory restored{};
+        REQUIRE(syntax::DeserializeSyntaxTree(restored, serialized) == nullptr);
+    }
+
+    SECTION("Corrupted records")
+    {
+        // Flipping bits of records may produce a different valid tree, but never reads out of bounds.
+        for (size_t i = 24; i < serialized.size(); ++i)
+        {
+            std::vector<std::byte> corrupted = serialized;
+            corrupted[i] ^= std::byte{0x5A};
+
+            syntax::SyntaxFactory restored{};
+            (void)syntax::DeserializeSyntaxTree(restored, corrupted);
+        }
+    }
+}
+
+TEST_CASE("SyntaxSerializer - deeply nested input")
+{
+    using namespace weave;
+
+    // Header of valid tree provides format signature, version and number of kinds.
+    std::vector<std::byte> serialized{};
+    {
+        syntax::SyntaxFactory factory{};
+        syntax::SerializeSyntaxTree(serialized, factory, factory.CreateNode<syntax::SourceFileSyntax>());
+        serialized.resize(24);
+    }
+
+    auto append = [&](syntax::SyntaxKind kind)
+    {
+        uint8_t buffer[8];
+        size_t const written = bitwise::EncodeUnsigned(std::to_underlying(kind), std::begin(buffer), std::end(buffer));
+
+        for (size_t i = 0; i < written; ++i)
+        {
+            serialized.push_back(static_cast<std::byte>(buffer[i]));
+        }
+    };
+
+    // Chain of unary expressions with empty operator tokens, each one nested in the operand of the previous one.
+    constexpr uint32_t Depth = 1'000'000;
+
+    append(syntax::SyntaxKind::SourceFileSyntax);
+
+    for (uint32_t i = 0; i < Depth; ++i)
+    {
+        append(syntax::SyntaxKind::UnaryExpressionSyntax);
+        append(syntax::SyntaxKind::None);
+    }
+
+    // Node count in the header.
+    uint32_t const nodes = Depth + 1;
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        serialized[20 + i] = static_cast<std::byte>(nodes >> (i * 8));
+    }
+
+    syntax::SyntaxFactory restored{};
+    REQUIRE(syntax::DeserializeSyntaxTree(restored, serialized) == nullptr);
+}
+
+TEST_CASE("SyntaxSerializer - load", "[.benchmark]")
+{
+    using namespace weave;
+
+    source::SourceText const text{helpers::GenerateSource(20000, FunctionPattern)};
+
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+    syntax::Parser parser{&diagnostic, &factory, text};
+    syntax::SourceFileSyntax* const root = parser.ParseSourceFile();
+
+    std::vector<std::byte> serialized{};
+    syntax::SerializeSyntaxTree(serialized, factory, root);
+
+    BENCHMARK("re-lex and re-parse")
+    {
+        source::DiagnosticSink reparsedDiagnostic{"<source>"};
+        syntax::SyntaxFactory reparsedFactory{};
+        syntax::Parser reparser{&reparsedDiagnostic, &reparsedFactory, text};
+        return reparser.ParseSourceFile() != nullptr;
+    };
+
+    BENCHMARK("load cached tree")
+    {
+        syntax::SyntaxFactory restoredFactory{};
+        return syntax::DeserializeSyntaxTree(restoredFactory, serialized) != nullptr;
+    };
+
+    BENCHMARK("serialize tree")
+    {
+        std::vector<std::byte> output{};
+        syntax::SerializeSyntaxTree(output, factory, root);
+        return output.size();
+    };
+
+    fmt::println("source: {} bytes, serialized tree: {} bytes", text.GetContentView().size(), serialized.size());
+}
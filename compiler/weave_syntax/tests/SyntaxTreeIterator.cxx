@@ -0,0 +1,355 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/syntax/Parser.hxx"
+#include "weave/syntax/SyntaxTreeIterator.hxx"
+#include "weave/syntax/Visitor.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "Helpers.hxx"
+
+#include <fmt/format.h>
+
+namespace
+{
+    using VisitedNodes = std::vector<std::pair<weave::syntax::SyntaxNode*, size_t>>;
+
+    class NodeCollector final : public weave::syntax::SyntaxWalker
+    {
+    public:
+        VisitedNodes Nodes{};
+
+    public:
+        using SyntaxWalker::SyntaxWalker;
+
+        void OnDefault(weave::syntax::SyntaxNode* node) override
+        {
+            this->Nodes.emplace_back(node, this->Depth);
+        }
+    };
+
+    class NodeCounter final : public weave::syntax::SyntaxWalker
+    {
+    public:
+        size_t Nodes{};
+        size_t MaxDepth{};
+
+    public:
+        void OnDefault([[maybe_unused]] weave::syntax::SyntaxNode* node) override
+        {
+            ++this->Nodes;
+            this->MaxDepth = std::max(this->MaxDepth, this->Depth);
+        }
+    };
+
+    VisitedNodes Collect(weave::syntax::SyntaxNode* root, weave::syntax::SyntaxTreeOrder order, weave::syntax::SyntaxFactory* trivia = nullptr)
+    {
+        VisitedNodes result{};
+
+        weave::syntax::SyntaxTreeIterator it{root, order, trivia};
+
+        while (it.Next())
+        {
+            result.emplace_back(it.GetNode(), it.GetDepth());
+        }
+
+        return result;
+    }
+
+    // Pattern of generated functions; {0} is replaced with index of the function.
+    constexpr std::string_view FunctionPattern =
+        "// function {0}\n"
+        "public function f{0}(a: int32, b: float32, c: int32) -> int32 {{\n"
+        "    var x = [a, {0}, c, (b as int32)];\n"
+        "    if x > 0 {{ return f(x, a, b, c); }} else if x < 0 {{ return -x; }} else {{ }}\n"
+        "}}\n";
+
+    // Creates expression nested to given depth, without recursion.
+    weave::syntax::ExpressionSyntax* CreateNestedExpression(weave::syntax::SyntaxFactory& factory, size_t depth)
+    {
+        using namespace weave;
+
+        syntax::LiteralExpressionSyntax* const literal = factory.CreateNode<syntax::LiteralExpressionSyntax>();
+        literal->LiteralToken = factory.CreateToken(syntax::SyntaxKind::TrueKeyword, source::SourceSpan{});
+
+        syntax::ExpressionSyntax* result = literal;
+
+        for (size_t i = 0; i < depth; ++i)
+        {
+            syntax::UnaryExpressionSyntax* const unary = factory.CreateNode<syntax::UnaryExpressionSyntax>();
+            unary->OperatorToken = factory.CreateToken(syntax::SyntaxKind::MinusToken, source::SourceSpan{});
+            unary->Operand = result;
+            result = unary;
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE("SyntaxTreeIterator - pre-order matches SyntaxWalker")
+{
+    using namespace weave;
+
+    source::SourceText const text{helpers::GenerateSource(10, FunctionPattern) + "struct S { var x: int32 = @; } /* trailing */"};
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+    syntax::Parser parser{&diagnostic, &factory, text};
+
+    syntax::SourceFileSyntax* const root = parser.ParseSourceFile();
+    REQUIRE(root != nullptr);
+
+    NodeCollector expected{&factory};
+    expected.Dispatch(root);
+
+    REQUIRE(Collect(root, syntax::SyntaxTreeOrder::PreOrder, &factory) == expected.Nodes);
+
+    NodeCollector walked{&factory};
+    walked.Walk(root);
+
+    REQUIRE(walked.Depth == 0);
+    REQUIRE(walked.Nodes == expected.Nodes);
+}
+
+TEST_CASE("SyntaxTreeIterator - post-order visits node after its children")
+{
+    using namespace weave;
+
+    source::SourceText const text{helpers::GenerateSource(4, FunctionPattern)};
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+    syntax::Parser parser{&diagnostic, &factory, text};
+
+    syntax::SourceFileSyntax* const root = parser.ParseSourceFile();
+
+    VisitedNodes const preorder = Collect(root, syntax::SyntaxTreeOrder::PreOrder);
+    VisitedNodes const postorder = Collect(root, syntax::SyntaxTreeOrder::PostOrder);
+
+    REQUIRE(postorder.size() == preorder.size());
+    REQUIRE(postorder.back().first == root);
+    REQUIRE(postorder.back().second == 0);
+
+    // Build the same post-order from the pre-order, by emitting nodes when their subtree ends.
+    VisitedNodes expected{};
+    VisitedNodes pending{};
+
+    for (auto const& entry : preorder)
+    {
+        while ((not pending.empty()) and (pending.back().second >= entry.second))
+        {
+            expected.push_back(pending.back());
+            pending.pop_back();
+        }
+
+        pending.push_back(entry);
+    }
+
+    expected.insert(expected.end(), pending.rbegin(), pending.rend());
+
+    REQUIRE(postorder == expected);
+
+    // Combined order enters and leaves nodes in matching pairs.
+    syntax::SyntaxTreeIterator it{root, syntax::SyntaxTreeOrder::PreAndPostOrder};
+
+    VisitedNodes entered{};
+    VisitedNodes left{};
+    std::vector<syntax::SyntaxNode*> stack{};
+
+    while (it.Next())
+    {
+        if (it.IsLeaving())
+        {
+            REQUIRE(stack.back() == it.GetNode());
+            stack.pop_back();
+            left.emplace_back(it.GetNode(), it.GetDepth());
+        }
+        else
+        {
+            REQUIRE(stack.size() == it.GetDepth());
+            stack.push_back(it.GetNode());
+            entered.emplace_back(it.GetNode(), it.GetDepth());
+        }
+    }
+
+    REQUIRE(stack.empty());
+    REQUIRE(entered == preorder);
+    REQUIRE(left == postorder);
+}
+
+TEST_CASE("SyntaxTreeIterator - skipping children")
+{
+    using namespace weave;
+
+    source::SourceText const text{helpers::GenerateSource(4, FunctionPattern)};
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+    syntax::Parser parser{&diagnostic, &factory, text};
+
+    syntax::SourceFileSyntax* const root = parser.ParseSourceFile();
+
+    syntax::SyntaxTreeIterator it{root, syntax::SyntaxTreeOrder::PreAndPostOrder};
+
+    size_t functions = 0;
+    bool inside = false;
+
+    while (it.Next())
+    {
+        if (it.GetNode()->Is(syntax::SyntaxKind::FunctionDeclarationSyntax))
+        {
+            if (it.IsLeaving())
+            {
+                inside = false;
+            }
+            else
+            {
+                REQUIRE_FALSE(inside);
+                inside = true;
+                ++functions;
+                it.SkipChildren();
+            }
+        }
+        else
+        {
+            REQUIRE_FALSE(inside);
+        }
+    }
+
+    REQUIRE(functions == 4);
+}
+
+TEST_CASE("SyntaxTreeIterator - deeply nested tree")
+{
+    using namespace weave;
+
+    constexpr size_t Depth = 100'000;
+
+    syntax::SyntaxFactory factory{};
+    syntax::ExpressionSyntax* const root = CreateNestedExpression(factory, Depth);
+
+    // Each unary expression has token and operand; innermost literal has a token.
+    constexpr size_t Nodes = (Depth * 2) + 2;
+
+    SECTION("Pre-order")
+    {
+        syntax::SyntaxTreeIterator it{root};
+
+        size_t count = 0;
+        uint32_t depth = 0;
+
+        while (it.Next())
+        {
+            ++count;
+            depth = std::max(depth, it.GetDepth());
+        }
+
+        REQUIRE(count == Nodes);
+        REQUIRE(depth == (Depth + 1));
+
+        // Only operator token and operand are waiting on each level.
+        REQUIRE(it.GetCapacity() < 1024);
+    }
+
+    SECTION("Post-order")
+    {
+        syntax::SyntaxTreeIterator it{root, syntax::SyntaxTreeOrder::PostOrder};
+
+        REQUIRE(it.Next());
+        REQUIRE(it.GetNode()->Is(syntax::SyntaxKind::MinusToken));
+        REQUIRE(it.GetDepth() == 1);
+
+        size_t count = 1;
+        syntax::SyntaxNode* last = nullptr;
+
+        while (it.Next())
+        {
+            ++count;
+            last = it.GetNode();
+        }
+
+        REQUIRE(count == Nodes);
+        REQUIRE(last == root);
+    }
+
+    SECTION("Walker")
+    {
+        NodeCounter counter{};
+        counter.Walk(root);
+
+        REQUIRE(counter.Nodes == Nodes);
+        REQUIRE(counter.MaxDepth == (Depth + 1));
+        REQUIRE(counter.Depth == 0);
+    }
+}
+
+TEST_CASE("SyntaxTreeIterator - walk", "[.benchmark]")
+{
+    using namespace weave;
+
+    source::SourceText const text{helpers::GenerateSource(20000, FunctionPattern)};
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+    syntax::Parser parser{&diagnostic, &factory, text};
+
+    syntax::SourceFileSyntax* const root = parser.ParseSourceFile();
+    REQUIRE(root != nullptr);
+
+    BENCHMARK("recursive walker")
+    {
+        NodeCounter counter{};
+        counter.Dispatch(root);
+        return counter.Nodes;
+    };
+
+    BENCHMARK("iterative walker")
+    {
+        NodeCounter counter{};
+        counter.Walk(root);
+        return counter.Nodes;
+    };
+
+    BENCHMARK("iterator, pre-order")
+    {
+        syntax::SyntaxTreeIterator it{root};
+
+        size_t count = 0;
+
+        while (it.Next())
+        {
+            ++count;
+        }
+
+        return count;
+    };
+
+    BENCHMARK("iterator, pre and post-order")
+    {
+        syntax::SyntaxTreeIterator it{root, syntax::SyntaxTreeOrder::PreAndPostOrder};
+
+        size_t count = 0;
+
+        while (it.Next())
+        {
+            ++count;
+        }
+
+        return count;
+    };
+
+    syntax::ExpressionSyntax* const nested = CreateNestedExpression(factory, 1'000'000);
+
+    BENCHMARK("iterator, 1M deep")
+    {
+        syntax::SyntaxTreeIterator it{nested};
+
+        size_t count = 0;
+
+        while (it.Next())
+        {
+            ++count;
+        }
+
+        return count;
+    };
+}
@@ -0,0 +1,234 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/syntax/Parser.hxx"
+#include "weave/syntax/TokenStream.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "Helpers.hxx"
+
+namespace
+{
+    struct ParseResult final
+    {
+        std::vector<std::string> Diagnostics{};
+        std::vector<weave::syntax::SyntaxKind> Tokens{};
+    };
+
+    ParseResult Parse(std::string_view source, weave::syntax::TokenStreamMode mode)
+    {
+        using namespace weave;
+
+        source::SourceText text{std::string{source}};
+        source::DiagnosticSink diagnostic{"<source>"};
+        syntax::SyntaxFactory factory{};
+
+        syntax::Parser parser{&diagnostic, &factory, text, mode};
+        syntax::SourceFileSyntax* root = parser.ParseSourceFile();
+        REQUIRE(root != nullptr);
+
+        ParseResult result{};
+
+        for (source::DiagnosticSink::Entry const& entry : diagnostic.Items)
+        {
+            result.Diagnostics.push_back(fmt::format("{}:{}: {}", entry.Source.Start.Offset, entry.Source.End.Offset, entry.Message));
+        }
+
+        return result;
+    }
+
+    ParseResult Lex(std::string_view source, weave::syntax::TokenStreamMode mode)
+    {
+        using namespace weave;
+
+        source::SourceText text{std::string{source}};
+        source::DiagnosticSink diagnostic{"<source>"};
+        syntax::SyntaxFactory factory{};
+
+        syntax::TokenStream stream{diagnostic, factory, text, mode};
+
+        ParseResult result{};
+
+        for (size_t i = 0;; ++i)
+        {
+            syntax::SyntaxToken const* token = stream.Get(i);
+            result.Tokens.push_back(token->Kind);
+
+            if ((token->Kind == syntax::SyntaxKind::EndOfFileToken) or (token->Kind == syntax::SyntaxKind::None))
+            {
+                break;
+            }
+
+            stream.Retain(i);
+        }
+
+        stream.Complete();
+
+        for (source::DiagnosticSink::Entry const& entry : diagnostic.Items)
+        {
+            result.Diagnostics.push_back(entry.Message);
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE("TokenStream - all modes produce the same tokens")
+{
+    using namespace weave::syntax;
+
+    // Invalid numeric literal and character literal are reported by lexer.
+    std::string const source = helpers::GenerateSource(200) + "var a = 0b102; var b = 'xy';\n" + helpers::GenerateSource(200);
+
+    ParseResult const eager = Lex(source, TokenStreamMode::Eager);
+    REQUIRE(eager.Tokens.size() > 4096);
+    REQUIRE_FALSE(eager.Diagnostics.empty());
+
+    ParseResult const streaming = Lex(source, TokenStreamMode::Streaming);
+    CHECK(streaming.Tokens == eager.Tokens);
+    CHECK(streaming.Diagnostics == eager.Diagnostics);
+
+    ParseResult const background = Lex(source, TokenStreamMode::Background);
+    CHECK(background.Tokens == eager.Tokens);
+    CHECK(background.Diagnostics == eager.Diagnostics);
+}
+
+TEST_CASE("TokenStream - retained tokens are kept")
+{
+    using namespace weave;
+
+    std::string const source = helpers::GenerateSource(200);
+
+    source::SourceText text{std::string{source}};
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+
+    syntax::TokenStream stream{diagnostic, factory, text, syntax::TokenStreamMode::Streaming};
+
+    syntax::SyntaxToken* const first = stream.Get(0);
+    syntax::SyntaxToken* const middle = stream.Get(2000);
+
+    // Buffer had to grow, since nothing was released.
+    REQUIRE(stream.GetPeakCount() > 2000);
+    REQUIRE(stream.Get(0) == first);
+
+    stream.Retain(2000);
+    (void)stream.Get(6000);
+    REQUIRE(stream.Get(2000) == middle);
+}
+
+TEST_CASE("TokenStream - lexer diagnostics are reported when stream is destroyed")
+{
+    using namespace weave;
+
+    std::string const source = "var a = 0b102;\n" + helpers::GenerateSource(200) + "var b = 'xy';\n";
+
+    for (syntax::TokenStreamMode const mode : {syntax::TokenStreamMode::Streaming, syntax::TokenStreamMode::Background})
+    {
+        source::SourceText text{std::string{source}};
+        source::DiagnosticSink diagnostic{"<source>"};
+        syntax::SyntaxFactory factory{};
+
+        {
+            // Consumer stops after the first token, without completing the stream.
+            syntax::TokenStream stream{diagnostic, factory, text, mode};
+            (void)stream.Get(0);
+        }
+
+        CHECK(diagnostic.Items.size() == Lex(source, syntax::TokenStreamMode::Eager).Diagnostics.size());
+    }
+}
+
+TEST_CASE("Parser - diagnostics do not depend on token stream mode")
+{
+    using namespace weave::syntax;
+
+    std::string const source = helpers::GenerateSource(100) + "function f() { var x = 0b12 + ; 'ab'; }\nstruct S { var x = ; }\n" + helpers::GenerateSource(100);
+
+    ParseResult const eager = Parse(source, TokenStreamMode::Eager);
+    REQUIRE_FALSE(eager.Diagnostics.empty());
+
+    CHECK(Parse(source, TokenStreamMode::Streaming).Diagnostics == eager.Diagnostics);
+    CHECK(Parse(source, TokenStreamMode::Background).Diagnostics == eager.Diagnostics);
+}
+
+TEST_CASE("Parser - abandoned speculative parse releases nodes")
+{
+    using namespace weave;
+
+    auto parse = [](size_t count)
+    {
+        std::string source{"function f() {\n"};
+
+        // Attributes not followed by declaration nor statement are parsed speculatively and then abandoned.
+        for (size_t i = 0; i < count; ++i)
+        {
+            source += "    #[a(b, c, d)]\n";
+        }
+
+        source += "}\n";
+
+        source::SourceText text{std::move(source)};
+        source::DiagnosticSink diagnostic{"<source>"};
+        syntax::SyntaxFactory factory{};
+
+        syntax::Parser parser{&diagnostic, &factory, text};
+        REQUIRE(parser.ParseSourceFile() != nullptr);
+
+        size_t allocated{};
+        size_t reserved{};
+        factory.QuerySyntaxNodesMemoryUsage(allocated, reserved);
+        return allocated;
+    };
+
+    size_t const single = parse(1);
+    size_t const multiple = parse(1001);
+
+    // Only the list of unexpected tokens grows: 10 tokens per attribute.
+    REQUIRE((multiple - single) <= (1000 * 10 * sizeof(syntax::SyntaxNode*)));
+}
+
+TEST_CASE("Parser - token stream modes", "[.benchmark]")
+{
+    using namespace weave;
+
+    std::string const source = helpers::GenerateSource(20000);
+    source::SourceText const text{std::string{source}};
+
+    for (syntax::TokenStreamMode const mode : {syntax::TokenStreamMode::Eager, syntax::TokenStreamMode::Streaming, syntax::TokenStreamMode::Background})
+    {
+        std::string_view const name = (mode == syntax::TokenStreamMode::Eager) ? "eager" : (mode == syntax::TokenStreamMode::Streaming) ? "streaming" : "background";
+
+        BENCHMARK_ADVANCED(fmt::format("first node, {}", name))(Catch::Benchmark::Chronometer meter)
+        {
+            meter.measure([&]
+                {
+                    source::DiagnosticSink diagnostic{"<source>"};
+                    syntax::SyntaxFactory factory{};
+                    syntax::Parser parser{&diagnostic, &factory, text, mode};
+                    return parser.ParseCodeBlockItem();
+                });
+        };
+
+        BENCHMARK_ADVANCED(fmt::format("whole file, {}", name))(Catch::Benchmark::Chronometer meter)
+        {
+            meter.measure([&]
+                {
+                    source::DiagnosticSink diagnostic{"<source>"};
+                    syntax::SyntaxFactory factory{};
+                    syntax::Parser parser{&diagnostic, &factory, text, mode};
+                    return parser.ParseSourceFile();
+                });
+        };
+
+        source::DiagnosticSink diagnostic{"<source>"};
+        syntax::SyntaxFactory factory{};
+        syntax::Parser parser{&diagnostic, &factory, text, mode};
+        (void)parser.ParseSourceFile();
+
+        fmt::println("{}: peak buffered tokens: {}", name, parser.GetTokenStream().GetPeakCount());
+    }
+}
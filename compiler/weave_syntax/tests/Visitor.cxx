@@ -1,5 +1,8 @@
 #include "weave/platform/Compiler.hxx"
 #include "weave/syntax/SyntaxKind.hxx"
+#include "weave/syntax/Parser.hxx"
+#include "weave/syntax/StaticSyntaxWalker.hxx"
+#include "weave/syntax/Visitor.hxx"
 
 WEAVE_EXTERNAL_HEADERS_BEGIN
 
@@ -7,3 +10,194 @@ WEAVE_EXTERNAL_HEADERS_BEGIN
 
 WEAVE_EXTERNAL_HEADERS_END
 
+#include "Helpers.hxx"
+
+#include <fmt/format.h>
+
+namespace
+{
+    class NodeCounter final : public weave::syntax::SyntaxWalker
+    {
+    public:
+        size_t Nodes{};
+        size_t Lists{};
+        size_t Elements{};
+
+    public:
+        void OnDefault(weave::syntax::SyntaxNode* node) override
+        {
+            ++this->Nodes;
+
+            if (weave::syntax::SyntaxList const* const list = node->TryCast<weave::syntax::SyntaxList>(); list != nullptr)
+            {
+                ++this->Lists;
+                this->Elements += list->GetCount();
+            }
+        }
+    };
+
+    class StaticNodeCounter final : public weave::syntax::StaticSyntaxWalker<StaticNodeCounter>
+    {
+    public:
+        size_t Nodes{};
+        size_t Lists{};
+        size_t Elements{};
+
+    public:
+        void OnDefault(weave::syntax::SyntaxNode* node)
+        {
+            ++this->Nodes;
+
+            if (weave::syntax::SyntaxList const* const list = node->TryCast<weave::syntax::SyntaxList>(); list != nullptr)
+            {
+                ++this->Lists;
+                this->Elements += list->GetCount();
+            }
+        }
+    };
+
+    class KindCollector final : public weave::syntax::SyntaxWalker
+    {
+    public:
+        std::vector<std::pair<weave::syntax::SyntaxKind, size_t>> Kinds{};
+
+    public:
+        void OnDefault(weave::syntax::SyntaxNode* node) override
+        {
+            this->Kinds.emplace_back(node->Kind, this->Depth);
+        }
+    };
+
+    class StaticKindCollector final : public weave::syntax::StaticSyntaxWalker<StaticKindCollector>
+    {
+    public:
+        std::vector<std::pair<weave::syntax::SyntaxKind, size_t>> Kinds{};
+
+    public:
+        using StaticSyntaxWalker::StaticSyntaxWalker;
+
+        void OnDefault(weave::syntax::SyntaxNode* node)
+        {
+            this->Kinds.emplace_back(node->Kind, this->Depth);
+        }
+    };
+
+    // Pattern of generated functions; {0} is replaced with index of the function.
+    constexpr std::string_view FunctionPattern =
+        "public function f{0}(a: int32, b: float32, c: int32) -> int32 {{\n"
+        "    var x = [a, {0}, c, (b as int32)];\n"
+        "    if x > 0 {{ return f(x, a, b, c); }} else {{ return -x; }}\n"
+        "}}\n";
+}
+
+TEST_CASE("SyntaxFactory - list elements are stored after the list")
+{
+    using namespace weave;
+
+    syntax::SyntaxFactory factory{};
+
+    std::vector<syntax::SyntaxToken*> tokens{};
+
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        tokens.push_back(factory.CreateToken(syntax::SyntaxKind::CommaToken, source::SourceSpan{{i}, {i + 1}}));
+    }
+
+    REQUIRE(factory.CreateList(std::vector<syntax::SyntaxToken*>{}) == nullptr);
+
+    syntax::SyntaxList* const list = factory.CreateList(tokens);
+    REQUIRE(list != nullptr);
+    REQUIRE(list->GetCount() == tokens.size());
+    REQUIRE(reinterpret_cast<std::byte*>(list->GetElements()) == (reinterpret_cast<std::byte*>(list) + sizeof(syntax::SyntaxList)));
+
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        REQUIRE(list->Get(i) == tokens[i]);
+    }
+
+    syntax::SyntaxListView<syntax::SyntaxToken> const view{list};
+    REQUIRE(view.GetCount() == tokens.size());
+    REQUIRE(view.GetElement(4) == tokens[4]);
+}
+
+TEST_CASE("SyntaxWalker - visits list elements")
+{
+    using namespace weave;
+
+    source::SourceText const text{helpers::GenerateSource(10, FunctionPattern)};
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+    syntax::Parser parser{&diagnostic, &factory, text};
+
+    syntax::SourceFileSyntax* const root = parser.ParseSourceFile();
+    REQUIRE(root != nullptr);
+
+    NodeCounter counter{};
+    counter.Dispatch(root);
+
+    REQUIRE(counter.Lists != 0);
+    REQUIRE(counter.Elements >= counter.Lists);
+}
+
+TEST_CASE("StaticSyntaxWalker - visits nodes in the same order as SyntaxWalker")
+{
+    using namespace weave;
+
+    source::SourceText const text{helpers::GenerateSource(10, FunctionPattern) + "struct S { var x: int32 = @; } /* trailing */"};
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+    syntax::Parser parser{&diagnostic, &factory, text};
+
+    syntax::SourceFileSyntax* const root = parser.ParseSourceFile();
+    REQUIRE(root != nullptr);
+
+    KindCollector expected{};
+    expected.Trivia = &factory;
+    expected.Dispatch(root);
+
+    StaticKindCollector collected{&factory};
+    collected.Dispatch(root);
+
+    REQUIRE(collected.Depth == 0);
+    REQUIRE(collected.Kinds == expected.Kinds);
+}
+
+TEST_CASE("SyntaxWalker - walk", "[.benchmark]")
+{
+    using namespace weave;
+
+    source::SourceText const text{helpers::GenerateSource(20000, FunctionPattern)};
+    source::DiagnosticSink diagnostic{"<source>"};
+    syntax::SyntaxFactory factory{};
+    syntax::Parser parser{&diagnostic, &factory, text};
+
+    syntax::SourceFileSyntax* const root = parser.ParseSourceFile();
+    REQUIRE(root != nullptr);
+
+    BENCHMARK("walk")
+    {
+        NodeCounter counter{};
+        counter.Dispatch(root);
+        return counter.Nodes;
+    };
+
+    BENCHMARK("static walk")
+    {
+        StaticNodeCounter counter{};
+        counter.Dispatch(root);
+        return counter.Nodes;
+    };
+
+    NodeCounter counter{};
+    counter.Dispatch(root);
+
+    StaticNodeCounter staticCounter{};
+    staticCounter.Dispatch(root);
+    REQUIRE(staticCounter.Nodes == counter.Nodes);
+
+    size_t allocated{};
+    size_t reserved{};
+    factory.QuerySyntaxNodesMemoryUsage(allocated, reserved);
+
+    fmt::println("nodes: {}, lists: {}, elements: {}, syntax nodes memory: {} bytes", counter.Nodes, counter.Lists, counter.Elements, allocated);
+}
@@ -0,0 +1,325 @@
+#include "weave/threading/TaskScheduler.hxx"
+#include "weave/threading/WorkStealingQueue.hxx"
+#include "weave/threading/Yield.hxx"
+#include "weave/bugcheck/BugCheck.hxx"
+
+namespace weave::threading::impl
+{
+    inline constexpr size_t TaskPoolCapacity = 4096;
+    inline constexpr size_t TaskQueueCapacity = 4096;
+
+    // Number of spins and yields an idle worker performs before going to sleep.
+    inline constexpr size_t IdleSpinCount = 64;
+    inline constexpr size_t IdleYieldCount = 16;
+
+    struct TaskWorker final : Runnable
+    {
+        TaskScheduler* Scheduler{};
+        size_t Index{};
+        uint64_t Random{};
+        size_t NextTask{};
+        std::unique_ptr<Task[]> Tasks{std::make_unique<Task[]>(TaskPoolCapacity)};
+        WorkStealingQueue<Task*> Queue{TaskQueueCapacity};
+
+        TaskWorker(TaskScheduler* scheduler, size_t index)
+            : Scheduler{scheduler}
+            , Index{index}
+            , Random{(index + 1) * 0x9E3779B97F4A7C15u}
+        {
+        }
+
+        [[nodiscard]] size_t NextRandom()
+        {
+            // xorshift64
+            this->Random ^= this->Random << 13;
+            this->Random ^= this->Random >> 7;
+            this->Random ^= this->Random << 17;
+            return static_cast<size_t>(this->Random);
+        }
+
+    protected:
+        void Execute() override
+        {
+            this->Scheduler->WorkerMain(*this);
+        }
+    };
+
+    thread_local TaskWorker* t_CurrentWorker = nullptr;
+}
+
+namespace weave::threading
+{
+    TaskScheduler::TaskScheduler(size_t workers)
+    {
+        workers = std::max<size_t>(workers, 1);
+
+        WEAVE_ASSERT(impl::t_CurrentWorker == nullptr, "Thread already participates in other scheduler");
+
+        this->_workers.reserve(workers);
+
+        for (size_t i = 0; i < workers; ++i)
+        {
+            this->_workers.push_back(std::make_unique<impl::TaskWorker>(this, i));
+        }
+
+        impl::t_CurrentWorker = this->_workers.front().get();
+
+        this->_threads.reserve(workers - 1);
+
+        for (size_t i = 1; i < workers; ++i)
+        {
+            this->_threads.emplace_back(ThreadStart{
+                .Name = "weave-worker",
+                .Callback = this->_workers[i].get(),
+            });
+        }
+    }
+
+    TaskScheduler::~TaskScheduler()
+    {
+        WEAVE_ASSERT(impl::t_CurrentWorker == this->_workers.front().get());
+        WEAVE_ASSERT(not this->HasPendingTasks());
+
+        this->_running.store(false, std::memory_order_release);
+
+        for (size_t i = 0; i < this->_threads.size(); ++i)
+        {
+            this->_wakeup.Release();
+        }
+
+        for (Thread& thread : this->_threads)
+        {
+            thread.Join();
+        }
+
+        impl::t_CurrentWorker = nullptr;
+    }
+
+    TaskHandle TaskScheduler::CreateGroup(TaskHandle parent)
+    {
+        impl::TaskWorker& worker = this->GetCurrentWorker();
+
+        Task* const task = this->AllocateTask(worker);
+        task->InitializeBarrier(parent);
+        return task->GetHandle();
+    }
+
+    TaskHandle TaskScheduler::Dispatch(TaskHandle parent, Runnable* callback)
+    {
+        WEAVE_ASSERT(callback != nullptr);
+
+        impl::TaskWorker& worker = this->GetCurrentWorker();
+
+        Task* const task = this->AllocateTask(worker);
+        task->InitializeRunnable(callback, parent);
+        task->Dispatched();
+
+        // Handle is captured before submitting, as the task may complete and be reused right after.
+        TaskHandle const handle = task->GetHandle();
+        this->Submit(worker, task);
+        return handle;
+    }
+
+    void TaskScheduler::Wait(TaskHandle handle)
+    {
+        impl::TaskWorker& worker = this->GetCurrentWorker();
+
+        Task* const task = static_cast<Task*>(handle.Native);
+        WEAVE_ASSERT(task != nullptr);
+
+        // Acquiring the state publishes generation of the initialization which stored it. Stale handle of reused task
+        // does not match it, so the group of another owner is never closed here.
+        if ((task->State.load(std::memory_order_acquire) == TaskState::Initialized) and task->IsCurrent(handle))
+        {
+            // Close the group by releasing its own reference.
+            task->Dispatched();
+            task->Execute();
+        }
+
+        WaitForCompletion(
+            [&]
+            {
+                // Task reused since the handle was created has completed already.
+                return task->IsFinished() or not task->IsCurrent(handle);
+            },
+            [&]
+            {
+                return this->TryExecute(worker);
+            });
+    }
+
+    impl::TaskWorker& TaskScheduler::GetCurrentWorker() const
+    {
+        impl::TaskWorker* const worker = impl::t_CurrentWorker;
+
+        if ((worker == nullptr) or (worker->Scheduler != this))
+        {
+            WEAVE_BUGCHECK("Tasks may be used only from worker threads of the scheduler");
+        }
+
+        return *worker;
+    }
+
+    Task* TaskScheduler::AllocateTask(impl::TaskWorker& worker)
+    {
+        constexpr size_t mask = impl::TaskPoolCapacity - 1;
+
+        while (true)
+        {
+            // Busy tasks are skipped - groups stay allocated until they are waited on.
+            for (size_t i = 0; i < impl::TaskPoolCapacity; ++i)
+            {
+                Task& task = worker.Tasks[worker.NextTask++ & mask];
+
+                if (task.IsFinished())
+                {
+                    return &task;
+                }
+            }
+
+            // All tasks from the pool are in flight. Drain local queue to release as many of them as possible at once.
+            bool executed = false;
+
+            for (Task* task{}; worker.Queue.Pop(task);)
+            {
+                task->Execute();
+                executed = true;
+            }
+
+            if (not executed and not this->TryExecute(worker))
+            {
+                YieldThread();
+            }
+        }
+    }
+
+    void TaskScheduler::Submit(impl::TaskWorker& worker, Task* task)
+    {
+        if (worker.Queue.Push(task))
+        {
+            this->WakeWorker();
+        }
+        else
+        {
+            // Queue is full, execute task immediately.
+            task->Execute();
+        }
+    }
+
+    bool TaskScheduler::TryExecute(impl::TaskWorker& worker)
+    {
+        Task* task{};
+
+        if (worker.Queue.Pop(task) or this->TrySteal(worker, task))
+        {
+            task->Execute();
+            return true;
+        }
+
+        return false;
+    }
+
+    bool TaskScheduler::TrySteal(impl::TaskWorker& worker, Task*& result)
+    {
+        size_t const count = this->_workers.size();
+
+        if (count > 1)
+        {
+            size_t const start = worker.NextRandom();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                impl::TaskWorker& victim = *this->_workers[(start + i) % count];
+
+                if ((&victim != &worker) and victim.Queue.Steal(result))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool TaskScheduler::HasPendingTasks() const
+    {
+        for (std::unique_ptr<impl::TaskWorker> const& worker : this->_workers)
+        {
+            if (worker->Queue.GetCount() != 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void TaskScheduler::WakeWorker()
+    {
+        if (this->_threads.empty())
+        {
+            return;
+        }
+
+        // Pairs with fence in `WaitForTasks` - either we see sleeping worker, or it sees submitted task.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        size_t sleeping = this->_sleeping.load(std::memory_order_relaxed);
+
+        while (sleeping != 0)
+        {
+            if (this->_sleeping.compare_exchange_weak(sleeping, sleeping - 1, std::memory_order_relaxed))
+            {
+                this->_wakeup.Release();
+                break;
+            }
+        }
+    }
+
+    void TaskScheduler::WaitForTasks()
+    {
+        this->_sleeping.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (this->HasPendingTasks() or not this->_running.load(std::memory_order_acquire))
+        {
+            // Unregister, unless some other thread already claimed this worker and released the semaphore.
+            size_t sleeping = this->_sleeping.load(std::memory_order_relaxed);
+
+            while ((sleeping != 0) and not this->_sleeping.compare_exchange_weak(sleeping, sleeping - 1, std::memory_order_relaxed))
+            {
+            }
+
+            if (sleeping != 0)
+            {
+                return;
+            }
+        }
+
+        this->_wakeup.Wait();
+    }
+
+    void TaskScheduler::WorkerMain(impl::TaskWorker& worker)
+    {
+        impl::t_CurrentWorker = &worker;
+
+        while (this->_running.load(std::memory_order_acquire))
+        {
+            bool const executed = TryWaitForCompletion(
+                [&]
+                {
+                    return this->TryExecute(worker);
+                },
+                impl::IdleSpinCount,
+                impl::IdleYieldCount,
+                YieldTarget::AnyThreadOnAnyProcessor);
+
+            if (not executed)
+            {
+                this->WaitForTasks();
+            }
+        }
+
+        impl::t_CurrentWorker = nullptr;
+    }
+}
@@ -10,6 +10,7 @@ WEAVE_EXTERNAL_HEADERS_BEGIN
 #include <pthread.h>
 #include <semaphore.h>
 #include <time.h>
+#include <unistd.h>
 
 WEAVE_EXTERNAL_HEADERS_END
 
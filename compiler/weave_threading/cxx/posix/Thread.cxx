@@ -51,6 +51,18 @@ namespace weave::threading
     {
         return ThreadId{std::bit_cast<void*>(pthread_self())};
     }
+
+    size_t GetLogicalProcessorCount()
+    {
+        long const count = sysconf(_SC_NPROCESSORS_ONLN);
+
+        if (count < 1)
+        {
+            return 1;
+        }
+
+        return static_cast<size_t>(count);
+    }
 }
 
 namespace weave::threading
@@ -117,7 +129,8 @@ namespace weave::threading
         {
             std::string const name{*start.Name};
 
-            if (int const rc = pthread_setname_np(this->AsPlatform().Native, name.c_str()); rc != 0)
+            // Short-lived thread may exit before its name is set.
+            if (int const rc = pthread_setname_np(this->AsPlatform().Native, name.c_str()); (rc != 0) and (rc != ENOENT) and (rc != ESRCH))
             {
                 WEAVE_BUGCHECK("pthread_setname_np (rc: {}, `{}`)", rc, strerror(rc));
             }
@@ -7,7 +7,7 @@ namespace weave::threading
     static_assert(sizeof(impl::NativeCriticalSection) >= sizeof(impl::PlatformCriticalSection));
     static_assert(alignof(impl::NativeCriticalSection) >= alignof(impl::PlatformCriticalSection));
 
-    inline impl::PlatformCriticalSection& CriticalSection::AsPlatform()
+    impl::PlatformCriticalSection& CriticalSection::AsPlatform()
     {
         return *reinterpret_cast<impl::PlatformCriticalSection*>(&this->_native);
     }
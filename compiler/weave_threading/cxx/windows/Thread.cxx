@@ -55,6 +55,18 @@ namespace weave::threading
     {
         return ThreadId{std::bit_cast<void*>(static_cast<uintptr_t>(GetCurrentThreadId()))};
     }
+
+    size_t GetLogicalProcessorCount()
+    {
+        DWORD const count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+
+        if (count == 0)
+        {
+            return 1;
+        }
+
+        return static_cast<size_t>(count);
+    }
 }
 
 
@@ -3,6 +3,7 @@
 #include "weave/bugcheck/Assert.hxx"
 
 #include <atomic>
+#include <cstdint>
 
 namespace weave::threading
 {
@@ -10,13 +11,16 @@ namespace weave::threading
     {
         void* Native;
 
+        // Tasks are reused once completed; handle of earlier use of the task refers to a different generation.
+        uint64_t Generation;
+
         [[nodiscard]] constexpr auto operator<=>(TaskHandle const&) const = default;
     };
 }
 
-namespace weave::threading::impl
+namespace weave::threading
 {
-
+    class TaskScheduler;
 }
 
 namespace weave::threading
@@ -31,25 +35,35 @@ namespace weave::threading
 
     class Task
     {
+        friend class TaskScheduler;
+
         std::atomic_size_t Waiters{0};
 
         TaskHandle Parent{};
-        TaskState State{TaskState::Completed};
+
+        // Completion is published through the state - once it becomes `Completed` the task may be reused by another
+        // thread.
+        std::atomic<TaskState> State{TaskState::Completed};
         threading::Runnable* Callback{};
 
+        // Incremented each time the task is reused. Published by the release store of `Initialized` state.
+        std::atomic_uint64_t Generation{0};
+
         void InitializeBarrier(TaskHandle parent)
         {
             WEAVE_ASSERT(this->Waiters == 0);
             WEAVE_ASSERT(this->State == TaskState::Completed);
 
+            this->Generation.fetch_add(1, std::memory_order_relaxed);
+
             this->Waiters = 1;
             this->Callback = nullptr;
             this->Parent = parent;
-            this->State = TaskState::Initialized;
+            this->State.store(TaskState::Initialized, std::memory_order_release);
 
             if (Task* task = static_cast<Task*>(parent.Native))
             {
-                ++task->Waiters;
+                task->Waiters.fetch_add(1, std::memory_order_relaxed);
             }
         }
 
@@ -58,27 +72,47 @@ namespace weave::threading
             WEAVE_ASSERT(this->Waiters == 0);
             WEAVE_ASSERT(this->State == TaskState::Completed);
 
+            this->Generation.fetch_add(1, std::memory_order_relaxed);
+
             this->Waiters = 1;
             this->Callback = callback;
             this->Parent = parent;
-            this->State = TaskState::Initialized;
+            this->State.store(TaskState::Initialized, std::memory_order_release);
 
             if (Task* task = static_cast<Task*>(parent.Native))
             {
-                ++task->Waiters;
+                task->Waiters.fetch_add(1, std::memory_order_relaxed);
             }
         }
 
+        TaskHandle GetHandle()
+        {
+            return TaskHandle{
+                .Native = this,
+                .Generation = this->Generation.load(std::memory_order_relaxed),
+            };
+        }
+
+        // Checks if handle refers to the current use of the task.
+        bool IsCurrent(TaskHandle handle) const
+        {
+            return this->Generation.load(std::memory_order_relaxed) == handle.Generation;
+        }
+
         void Finish()
         {
-            if (--this->Waiters == 0)
+            if (this->Waiters.fetch_sub(1, std::memory_order_acq_rel) == 1)
             {
                 WEAVE_ASSERT(this->State == TaskState::Executing);
-                this->State = TaskState::Completed;
 
-                if (Task* task = static_cast<Task*>(this->Parent.Native))
+                // Capture parent before releasing this task.
+                Task* const parent = static_cast<Task*>(this->Parent.Native);
+
+                this->State.store(TaskState::Completed, std::memory_order_release);
+
+                if (parent != nullptr)
                 {
-                    task->Finish();
+                    parent->Finish();
                 }
             }
         }
@@ -86,13 +120,13 @@ namespace weave::threading
         void Dispatched()
         {
             WEAVE_ASSERT(this->State == TaskState::Initialized);
-            this->State = TaskState::Dispatched;
+            this->State.store(TaskState::Dispatched, std::memory_order_release);
         }
 
         void Execute()
         {
             WEAVE_ASSERT(this->State == TaskState::Dispatched);
-            this->State = TaskState::Executing;
+            this->State.store(TaskState::Executing, std::memory_order_relaxed);
 
             if (threading::Runnable* const callback = this->Callback)
             {
@@ -104,7 +138,7 @@ namespace weave::threading
 
         bool IsFinished() const
         {
-            return this->Waiters == 0;
+            return this->State.load(std::memory_order_acquire) == TaskState::Completed;
         }
     };
 }
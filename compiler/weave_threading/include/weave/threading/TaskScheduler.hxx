@@ -0,0 +1,86 @@
+#pragma once
+#include "weave/threading/Task.hxx"
+#include "weave/threading/Thread.hxx"
+#include "weave/threading/Semaphore.hxx"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace weave::threading::impl
+{
+    struct TaskWorker;
+}
+
+namespace weave::threading
+{
+    /// \brief Work-stealing scheduler for fine-grained tasks.
+    ///
+    /// \details Each worker owns a Chase-Lev deque of tasks. Tasks dispatched by a worker are pushed to its own deque
+    ///          and executed in LIFO order, while idle workers steal from the other end of other deques. Threads blocked
+    ///          in `Wait` keep executing pending tasks until the awaited task completes.
+    ///
+    ///          The thread constructing the scheduler becomes worker zero; the remaining workers are background threads.
+    ///          Tasks may be dispatched and awaited only from worker threads of this scheduler.
+    class TaskScheduler final
+    {
+        friend struct impl::TaskWorker;
+
+    private:
+        std::vector<std::unique_ptr<impl::TaskWorker>> _workers{};
+        std::vector<Thread> _threads{};
+        std::atomic_bool _running{true};
+        std::atomic_size_t _sleeping{0};
+        Semaphore _wakeup{0};
+
+    public:
+        /// \brief Creates scheduler with specified number of workers, including the calling thread.
+        explicit TaskScheduler(size_t workers);
+
+        ~TaskScheduler();
+
+        TaskScheduler(TaskScheduler const&) = delete;
+        TaskScheduler(TaskScheduler&&) = delete;
+        TaskScheduler& operator=(TaskScheduler const&) = delete;
+        TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+    public:
+        [[nodiscard]] size_t GetWorkerCount() const
+        {
+            return this->_workers.size();
+        }
+
+        /// \brief Creates task without callback, used to group other tasks.
+        ///
+        /// \note The group is closed when it is waited on; children must be dispatched before that.
+        [[nodiscard]] TaskHandle CreateGroup(TaskHandle parent);
+
+        /// \brief Dispatches callback for execution.
+        ///
+        /// \param parent   The parent task. It won't complete until this task completes.
+        /// \param callback The callback to execute. Must remain alive until the task completes.
+        TaskHandle Dispatch(TaskHandle parent, Runnable* callback);
+
+        /// \brief Waits for task and all its children to complete, executing other tasks in the meantime.
+        void Wait(TaskHandle handle);
+
+    private:
+        [[nodiscard]] impl::TaskWorker& GetCurrentWorker() const;
+
+        [[nodiscard]] Task* AllocateTask(impl::TaskWorker& worker);
+
+        void Submit(impl::TaskWorker& worker, Task* task);
+
+        [[nodiscard]] bool TryExecute(impl::TaskWorker& worker);
+
+        [[nodiscard]] bool TrySteal(impl::TaskWorker& worker, Task*& result);
+
+        [[nodiscard]] bool HasPendingTasks() const;
+
+        void WakeWorker();
+
+        void WaitForTasks();
+
+        void WorkerMain(impl::TaskWorker& worker);
+    };
+}
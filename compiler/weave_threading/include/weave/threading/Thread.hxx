@@ -55,6 +55,8 @@ namespace weave::threading
 
     ThreadId GetThisThreadId();
 
+    [[nodiscard]] size_t GetLogicalProcessorCount();
+
     class Thread final
     {
     private:
@@ -0,0 +1,127 @@
+#pragma once
+#include "weave/bugcheck/Assert.hxx"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace weave::threading
+{
+    /// \brief Bounded Chase-Lev work-stealing deque.
+    ///
+    /// \details The owning thread pushes and pops items at the bottom end, while any other thread may steal items from
+    ///          the top end. Memory ordering follows "Correct and Efficient Work-Stealing for Weak Memory Models"
+    ///          by Le, Pop, Cohen and Zappa Nardelli.
+    ///
+    /// \note The queue does not grow. When it is full, `Push` fails and the caller is expected to handle the item
+    ///       directly.
+    template <typename T>
+    class WorkStealingQueue final
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+    private:
+        static constexpr size_t CacheLineSize = 64;
+
+        alignas(CacheLineSize) std::atomic<int64_t> _top{0};
+        alignas(CacheLineSize) std::atomic<int64_t> _bottom{0};
+        alignas(CacheLineSize) std::unique_ptr<std::atomic<T>[]> _items{};
+        int64_t _mask{};
+
+    public:
+        explicit WorkStealingQueue(size_t capacity)
+        {
+            WEAVE_ASSERT(std::has_single_bit(capacity));
+
+            this->_items = std::make_unique<std::atomic<T>[]>(capacity);
+            this->_mask = static_cast<int64_t>(capacity - 1);
+        }
+
+        WorkStealingQueue(WorkStealingQueue const&) = delete;
+        WorkStealingQueue(WorkStealingQueue&&) = delete;
+        WorkStealingQueue& operator=(WorkStealingQueue const&) = delete;
+        WorkStealingQueue& operator=(WorkStealingQueue&&) = delete;
+
+    public:
+        /// \brief Pushes item at the bottom of the queue. Owner thread only.
+        [[nodiscard]] bool Push(T item)
+        {
+            int64_t const bottom = this->_bottom.load(std::memory_order_relaxed);
+            int64_t const top = this->_top.load(std::memory_order_acquire);
+
+            if ((bottom - top) > this->_mask)
+            {
+                return false;
+            }
+
+            this->_items[bottom & this->_mask].store(item, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            this->_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /// \brief Pops item from the bottom of the queue. Owner thread only.
+        [[nodiscard]] bool Pop(T& result)
+        {
+            int64_t const bottom = this->_bottom.load(std::memory_order_relaxed) - 1;
+            this->_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = this->_top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                // Queue was empty.
+                this->_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            result = this->_items[bottom & this->_mask].load(std::memory_order_relaxed);
+
+            if (top != bottom)
+            {
+                // More than one item left, no race with thieves possible.
+                return true;
+            }
+
+            // Last item - race against thieves.
+            bool const acquired = this->_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            this->_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return acquired;
+        }
+
+        /// \brief Steals item from the top of the queue. Any thread.
+        [[nodiscard]] bool Steal(T& result)
+        {
+            int64_t top = this->_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t const bottom = this->_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+            {
+                return false;
+            }
+
+            T const item = this->_items[top & this->_mask].load(std::memory_order_relaxed);
+
+            if (this->_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                result = item;
+                return true;
+            }
+
+            // Lost race against another thief or the owner.
+            return false;
+        }
+
+        /// \brief Returns approximate number of items in the queue.
+        [[nodiscard]] size_t GetCount() const
+        {
+            int64_t const bottom = this->_bottom.load(std::memory_order_relaxed);
+            int64_t const top = this->_top.load(std::memory_order_relaxed);
+            return (bottom > top) ? static_cast<size_t>(bottom - top) : 0;
+        }
+    };
+}
@@ -0,0 +1,208 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/threading/TaskScheduler.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include <atomic>
+#include <vector>
+
+namespace
+{
+    class SumTask final : public weave::threading::Runnable
+    {
+    public:
+        weave::threading::TaskScheduler& Scheduler;
+        uint64_t First;
+        uint64_t Last;
+        uint64_t Cutoff;
+        uint64_t Result{};
+
+    public:
+        SumTask(weave::threading::TaskScheduler& scheduler, uint64_t first, uint64_t last, uint64_t cutoff)
+            : Scheduler{scheduler}
+            , First{first}
+            , Last{last}
+            , Cutoff{cutoff}
+        {
+        }
+
+    protected:
+        void Execute() override
+        {
+            if ((this->Last - this->First) <= this->Cutoff)
+            {
+                for (uint64_t i = this->First; i < this->Last; ++i)
+                {
+                    this->Result += i;
+                }
+
+                return;
+            }
+
+            uint64_t const middle = this->First + ((this->Last - this->First) / 2);
+
+            SumTask left{this->Scheduler, this->First, middle, this->Cutoff};
+            SumTask right{this->Scheduler, middle, this->Last, this->Cutoff};
+
+            weave::threading::TaskHandle const group = this->Scheduler.CreateGroup({});
+            this->Scheduler.Dispatch(group, &left);
+            this->Scheduler.Dispatch(group, &right);
+            this->Scheduler.Wait(group);
+
+            this->Result = left.Result + right.Result;
+        }
+    };
+
+    class CountingTask final : public weave::threading::Runnable
+    {
+    public:
+        std::atomic_size_t* Counter{};
+
+    protected:
+        void Execute() override
+        {
+            this->Counter->fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    uint64_t ForkJoinSum(weave::threading::TaskScheduler& scheduler, uint64_t count, uint64_t cutoff)
+    {
+        SumTask root{scheduler, 0, count, cutoff};
+        weave::threading::TaskHandle const handle = scheduler.Dispatch({}, &root);
+        scheduler.Wait(handle);
+        return root.Result;
+    }
+}
+
+TEST_CASE("TaskScheduler - fork/join")
+{
+    using namespace weave::threading;
+
+    size_t const workers = GENERATE(1, 2, 4);
+
+    TaskScheduler scheduler{workers};
+    REQUIRE(scheduler.GetWorkerCount() == workers);
+
+    constexpr uint64_t count = 1'000'000;
+    REQUIRE(ForkJoinSum(scheduler, count, 64) == ((count * (count - 1)) / 2));
+}
+
+TEST_CASE("TaskScheduler - group waits for all children")
+{
+    using namespace weave::threading;
+
+    size_t const workers = GENERATE(1, 4);
+
+    TaskScheduler scheduler{workers};
+
+    // More tasks than fits in the task pool and queue at once.
+    constexpr size_t count = 10000;
+
+    std::atomic_size_t counter{0};
+    std::vector<CountingTask> tasks(count);
+
+    TaskHandle const group = scheduler.CreateGroup({});
+
+    for (CountingTask& task : tasks)
+    {
+        task.Counter = &counter;
+        scheduler.Dispatch(group, &task);
+    }
+
+    scheduler.Wait(group);
+    REQUIRE(counter.load() == count);
+}
+
+TEST_CASE("TaskScheduler - nested groups")
+{
+    using namespace weave::threading;
+
+    TaskScheduler scheduler{4};
+
+    std::atomic_size_t counter{0};
+    std::vector<CountingTask> tasks(64);
+
+    TaskHandle const outer = scheduler.CreateGroup({});
+    TaskHandle const inner = scheduler.CreateGroup(outer);
+
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+        tasks[i].Counter = &counter;
+        scheduler.Dispatch(((i % 2) == 0) ? outer : inner, &tasks[i]);
+    }
+
+    // Inner group is a child of outer one, so it has to be closed before waiting for outer group.
+    scheduler.Wait(inner);
+    scheduler.Wait(outer);
+    REQUIRE(counter.load() == tasks.size());
+}
+
+TEST_CASE("TaskScheduler - stale handle")
+{
+    using namespace weave::threading;
+
+    TaskScheduler scheduler{1};
+
+    std::atomic_size_t counter{0};
+    CountingTask task{};
+    task.Counter = &counter;
+
+    TaskHandle const stale = scheduler.Dispatch({}, &task);
+    scheduler.Wait(stale);
+
+    // Keep allocating until the completed task is reused for a new group.
+    TaskHandle group{};
+
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        group = scheduler.CreateGroup({});
+
+        if (group.Native == stale.Native)
+        {
+            break;
+        }
+
+        scheduler.Wait(group);
+    }
+
+    REQUIRE(group.Native == stale.Native);
+    REQUIRE(group.Generation != stale.Generation);
+
+    // Waiting on stale handle must not close the group of the new owner.
+    scheduler.Wait(stale);
+
+    scheduler.Dispatch(group, &task);
+    scheduler.Wait(group);
+    REQUIRE(counter.load() == 2);
+}
+
+TEST_CASE("TaskScheduler - fork/join overhead", "[.benchmark]")
+{
+    using namespace weave::threading;
+
+    std::vector<size_t> configurations{1, 2, 4};
+
+    if (size_t const processors = GetLogicalProcessorCount(); processors > 4)
+    {
+        configurations.push_back(processors);
+    }
+
+    for (size_t const workers : configurations)
+    {
+        TaskScheduler scheduler{workers};
+
+        BENCHMARK(fmt::format("fork/join, {} workers, cutoff 1", workers))
+        {
+            return ForkJoinSum(scheduler, 1 << 16, 1);
+        };
+
+        BENCHMARK(fmt::format("fork/join, {} workers, cutoff 256", workers))
+        {
+            return ForkJoinSum(scheduler, 1 << 22, 256);
+        };
+    }
+}
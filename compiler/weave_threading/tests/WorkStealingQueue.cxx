@@ -0,0 +1,157 @@
+#include "weave/platform/Compiler.hxx"
+#include "weave/threading/WorkStealingQueue.hxx"
+#include "weave/threading/Runnable.hxx"
+#include "weave/threading/Thread.hxx"
+#include "weave/threading/Yield.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include <atomic>
+#include <vector>
+
+TEST_CASE("WorkStealingQueue - owner")
+{
+    using namespace weave::threading;
+
+    WorkStealingQueue<int> queue{4};
+
+    int item{};
+    REQUIRE_FALSE(queue.Pop(item));
+
+    REQUIRE(queue.Push(1));
+    REQUIRE(queue.Push(2));
+    REQUIRE(queue.Push(3));
+    REQUIRE(queue.Push(4));
+    REQUIRE_FALSE(queue.Push(5));
+    REQUIRE(queue.GetCount() == 4);
+
+    REQUIRE(queue.Pop(item));
+    REQUIRE(item == 4);
+
+    REQUIRE(queue.Steal(item));
+    REQUIRE(item == 1);
+
+    REQUIRE(queue.Pop(item));
+    REQUIRE(item == 3);
+
+    REQUIRE(queue.Pop(item));
+    REQUIRE(item == 2);
+
+    REQUIRE_FALSE(queue.Pop(item));
+    REQUIRE_FALSE(queue.Steal(item));
+    REQUIRE(queue.GetCount() == 0);
+}
+
+namespace
+{
+    class Thief final : public weave::threading::Runnable
+    {
+    public:
+        weave::threading::WorkStealingQueue<size_t>& Queue;
+        std::atomic_bool& Done;
+        std::vector<size_t> Stolen{};
+
+    public:
+        Thief(weave::threading::WorkStealingQueue<size_t>& queue, std::atomic_bool& done)
+            : Queue{queue}
+            , Done{done}
+        {
+        }
+
+    protected:
+        void Execute() override
+        {
+            size_t item{};
+
+            while (not this->Done.load())
+            {
+                if (this->Queue.Steal(item))
+                {
+                    this->Stolen.push_back(item);
+                }
+                else
+                {
+                    weave::threading::YieldThread();
+                }
+            }
+
+            while (this->Queue.Steal(item))
+            {
+                this->Stolen.push_back(item);
+            }
+        }
+    };
+}
+
+TEST_CASE("WorkStealingQueue - every item is taken exactly once")
+{
+    using namespace weave::threading;
+
+    constexpr size_t count = 50000;
+
+    WorkStealingQueue<size_t> queue{256};
+    std::atomic_bool done{false};
+
+    std::vector<Thief> thieves{};
+    thieves.reserve(3);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        thieves.emplace_back(queue, done);
+    }
+
+    std::vector<Thread> threads{};
+
+    for (Thief& thief : thieves)
+    {
+        threads.emplace_back(ThreadStart{.Callback = &thief});
+    }
+
+    std::vector<size_t> popped{};
+
+    for (size_t i = 0; i < count;)
+    {
+        if (queue.Push(i))
+        {
+            ++i;
+        }
+
+        size_t item{};
+
+        if (((i % 3) == 0) and queue.Pop(item))
+        {
+            popped.push_back(item);
+        }
+    }
+
+    done.store(true);
+
+    for (Thread& thread : threads)
+    {
+        thread.Join();
+    }
+
+    std::vector<size_t> seen(count);
+
+    for (size_t item : popped)
+    {
+        ++seen[item];
+    }
+
+    for (Thief const& thief : thieves)
+    {
+        for (size_t item : thief.Stolen)
+        {
+            ++seen[item];
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        REQUIRE(seen[i] == 1);
+    }
+}
@@ -616,23 +616,6 @@ namespace weave::unicode
 
 namespace weave::unicode
 {
-    bool Validate(
-        const uint8_t* first,
-        const uint8_t* last)
-    {
-        char32_t ch;
-
-        while (first < last)
-        {
-            if (Decode(ch, first, last) != ConversionResult::Success)
-            {
-                return false;
-            }
-        }
-
-        return first == last;
-    }
-
     bool Validate(
         const char16_t* first,
         const char16_t* last)
@@ -0,0 +1,531 @@
+#include "weave/Unicode.hxx"
+#include "weave/bugcheck/Assert.hxx"
+#include "weave/platform/Compiler.hxx"
+
+#include <cstring>
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#if defined(_M_AMD64) || defined(__x86_64__)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#define WEAVE_UNICODE_VALIDATE_X64 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define WEAVE_UNICODE_VALIDATE_NEON 1
+#endif
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WEAVE_UNICODE_TARGET_SSSE3 __attribute__((__target__("ssse3")))
+#define WEAVE_UNICODE_TARGET_AVX2 __attribute__((__target__("avx2")))
+#else
+#define WEAVE_UNICODE_TARGET_SSSE3
+#define WEAVE_UNICODE_TARGET_AVX2
+#endif
+
+namespace weave::unicode::impl
+{
+    bool ValidateScalar(const uint8_t* first, const uint8_t* last)
+    {
+        constexpr uint64_t NonAsciiMask = 0x8080'8080'8080'8080u;
+
+        char32_t ch;
+
+        while (first < last)
+        {
+            // Skip ASCII characters in bulk. Decoder always stops at sequence boundary, so it may be resumed later.
+            while ((last - first) >= static_cast<ptrdiff_t>(sizeof(uint64_t)))
+            {
+                uint64_t block;
+                std::memcpy(&block, first, sizeof(block));
+
+                if ((block & NonAsciiMask) != 0)
+                {
+                    break;
+                }
+
+                first += sizeof(block);
+            }
+
+            if ((first < last) and (Decode(ch, first, last) != ConversionResult::Success))
+            {
+                return false;
+            }
+        }
+
+        return first == last;
+    }
+}
+
+namespace weave::unicode::impl
+{
+    // Vector validators implement the lookup algorithm described in "Validating UTF-8 In Less Than One Instruction
+    // Per Byte" by John Keiser and Daniel Lemire. Each byte is classified by three table lookups - high and low nibble
+    // of the previous byte and high nibble of the current byte. Bitwise AND of the results is non-zero only for
+    // invalid two-byte combinations. Remaining errors, missing or excess continuation bytes of 3- and 4-byte
+    // sequences, are detected by comparing expected continuation bytes with the actual ones.
+    //
+    // This accepts exactly the same inputs as the scalar decoder: overlong encodings, surrogates and code points
+    // above U+10FFFF are rejected.
+
+    inline constexpr uint8_t Utf8TooShort = 1u << 0u;
+    inline constexpr uint8_t Utf8TooLong = 1u << 1u;
+    inline constexpr uint8_t Utf8Overlong3 = 1u << 2u;
+    inline constexpr uint8_t Utf8TooLarge = 1u << 3u;
+    inline constexpr uint8_t Utf8Surrogate = 1u << 4u;
+    inline constexpr uint8_t Utf8Overlong2 = 1u << 5u;
+    inline constexpr uint8_t Utf8TooLarge1000 = 1u << 6u;
+    inline constexpr uint8_t Utf8Overlong4 = 1u << 6u;
+    inline constexpr uint8_t Utf8TwoConts = 1u << 7u;
+    inline constexpr uint8_t Utf8Carry = Utf8TooShort | Utf8TooLong | Utf8TwoConts;
+
+    // clang-format off
+    alignas(16) inline constexpr uint8_t Utf8Byte1High[16]{
+        // 0_______ ________ <ASCII in byte 1>
+        Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong,
+        Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong,
+        // 10______ ________ <continuation in byte 1>
+        Utf8TwoConts, Utf8TwoConts, Utf8TwoConts, Utf8TwoConts,
+        // 1100____ ________ <two byte lead in byte 1>
+        Utf8TooShort | Utf8Overlong2,
+        // 1101____ ________ <two byte lead in byte 1>
+        Utf8TooShort,
+        // 1110____ ________ <three byte lead in byte 1>
+        Utf8TooShort | Utf8Overlong3 | Utf8Surrogate,
+        // 1111____ ________ <four+ byte lead in byte 1>
+        Utf8TooShort | Utf8TooLarge | Utf8TooLarge1000 | Utf8Overlong4,
+    };
+
+    alignas(16) inline constexpr uint8_t Utf8Byte1Low[16]{
+        // ____0000 ________
+        Utf8Carry | Utf8Overlong3 | Utf8Overlong2 | Utf8Overlong4,
+        // ____0001 ________
+        Utf8Carry | Utf8Overlong2,
+        // ____001_ ________
+        Utf8Carry,
+        Utf8Carry,
+        // ____0100 ________
+        Utf8Carry | Utf8TooLarge,
+        // ____0101 ________
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+        // ____011_ ________
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+        // ____10__ ________
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+        // ____1100 ________
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+        // ____1101 ________
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000 | Utf8Surrogate,
+        // ____111_ ________
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+        Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+    };
+
+    alignas(16) inline constexpr uint8_t Utf8Byte2High[16]{
+        // ________ 0_______ <ASCII in byte 2>
+        Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort,
+        Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort,
+        // ________ 1000____
+        Utf8TooLong | Utf8Overlong2 | Utf8TwoConts | Utf8Overlong3 | Utf8TooLarge1000 | Utf8Overlong4,
+        // ________ 1001____
+        Utf8TooLong | Utf8Overlong2 | Utf8TwoConts | Utf8Overlong3 | Utf8TooLarge,
+        // ________ 101_____
+        Utf8TooLong | Utf8Overlong2 | Utf8TwoConts | Utf8Surrogate | Utf8TooLarge,
+        Utf8TooLong | Utf8Overlong2 | Utf8TwoConts | Utf8Surrogate | Utf8TooLarge,
+        // ________ 11______ <lead in byte 2>
+        Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort,
+    };
+
+    // Lead bytes in the last 3 positions of a block which require continuation bytes from the next block.
+    alignas(32) inline constexpr uint8_t Utf8IncompleteLimit[32]{
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+    };
+    // clang-format on
+
+#if defined(WEAVE_UNICODE_VALIDATE_X64)
+
+    struct Utf8StateSsse3 final
+    {
+        __m128i Error;
+        __m128i PreviousInput;
+        __m128i PreviousIncomplete;
+    };
+
+    WEAVE_UNICODE_TARGET_SSSE3
+    inline void Utf8CheckBlockSsse3(Utf8StateSsse3& state, __m128i input)
+    {
+        if (_mm_movemask_epi8(input) == 0)
+        {
+            // ASCII only block - the only possible error is a sequence left incomplete by the previous block.
+            state.Error = _mm_or_si128(state.Error, state.PreviousIncomplete);
+        }
+        else
+        {
+            __m128i const nibble = _mm_set1_epi8(0x0F);
+
+            __m128i const prev1 = _mm_alignr_epi8(input, state.PreviousInput, 16 - 1);
+            __m128i const prev2 = _mm_alignr_epi8(input, state.PreviousInput, 16 - 2);
+            __m128i const prev3 = _mm_alignr_epi8(input, state.PreviousInput, 16 - 3);
+
+            __m128i const byte1High = _mm_shuffle_epi8(
+                _mm_load_si128(reinterpret_cast<__m128i const*>(Utf8Byte1High)),
+                _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+
+            __m128i const byte1Low = _mm_shuffle_epi8(
+                _mm_load_si128(reinterpret_cast<__m128i const*>(Utf8Byte1Low)),
+                _mm_and_si128(prev1, nibble));
+
+            __m128i const byte2High = _mm_shuffle_epi8(
+                _mm_load_si128(reinterpret_cast<__m128i const*>(Utf8Byte2High)),
+                _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+
+            __m128i const special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+            // Third and fourth bytes of 3- and 4-byte sequences must be continuation bytes.
+            __m128i const third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+            __m128i const fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            __m128i const must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+
+            state.Error = _mm_or_si128(state.Error, _mm_xor_si128(must23, special));
+            state.PreviousIncomplete = _mm_subs_epu8(input, _mm_loadu_si128(reinterpret_cast<__m128i const*>(Utf8IncompleteLimit + 16)));
+        }
+
+        state.PreviousInput = input;
+    }
+
+    WEAVE_UNICODE_TARGET_SSSE3
+    bool ValidateSsse3(const uint8_t* first, const uint8_t* last)
+    {
+        constexpr size_t BlockSize = sizeof(__m128i);
+
+        Utf8StateSsse3 state{
+            .Error = _mm_setzero_si128(),
+            .PreviousInput = _mm_setzero_si128(),
+            .PreviousIncomplete = _mm_setzero_si128(),
+        };
+
+        for (; static_cast<size_t>(last - first) >= BlockSize; first += BlockSize)
+        {
+            Utf8CheckBlockSsse3(state, _mm_loadu_si128(reinterpret_cast<__m128i const*>(first)));
+        }
+
+        // Tail is padded with zeros; this also catches sequences truncated by the end of input.
+        alignas(16) uint8_t buffer[BlockSize]{};
+        std::memcpy(buffer, first, static_cast<size_t>(last - first));
+        Utf8CheckBlockSsse3(state, _mm_load_si128(reinterpret_cast<__m128i const*>(buffer)));
+
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(state.Error, _mm_setzero_si128())) == 0xFFFF;
+    }
+
+    struct Utf8StateAvx2 final
+    {
+        __m256i Error;
+        __m256i PreviousInput;
+        __m256i PreviousIncomplete;
+    };
+
+    WEAVE_UNICODE_TARGET_AVX2
+    inline __m256i Utf8LoadTableAvx2(uint8_t const* table)
+    {
+        return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<__m128i const*>(table)));
+    }
+
+    WEAVE_UNICODE_TARGET_AVX2
+    inline void Utf8CheckBlockAvx2(Utf8StateAvx2& state, __m256i input)
+    {
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            // ASCII only block - the only possible error is a sequence left incomplete by the previous block.
+            state.Error = _mm256_or_si256(state.Error, state.PreviousIncomplete);
+        }
+        else
+        {
+            __m256i const nibble = _mm256_set1_epi8(0x0F);
+
+            // Shifts operate on 128-bit lanes, so upper half of previous block is combined with lower half of input.
+            __m256i const shifted = _mm256_permute2x128_si256(state.PreviousInput, input, 0x21);
+            __m256i const prev1 = _mm256_alignr_epi8(input, shifted, 16 - 1);
+            __m256i const prev2 = _mm256_alignr_epi8(input, shifted, 16 - 2);
+            __m256i const prev3 = _mm256_alignr_epi8(input, shifted, 16 - 3);
+
+            __m256i const byte1High = _mm256_shuffle_epi8(
+                Utf8LoadTableAvx2(Utf8Byte1High),
+                _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+
+            __m256i const byte1Low = _mm256_shuffle_epi8(
+                Utf8LoadTableAvx2(Utf8Byte1Low),
+                _mm256_and_si256(prev1, nibble));
+
+            __m256i const byte2High = _mm256_shuffle_epi8(
+                Utf8LoadTableAvx2(Utf8Byte2High),
+                _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+
+            __m256i const special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+            // Third and fourth bytes of 3- and 4-byte sequences must be continuation bytes.
+            __m256i const third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+            __m256i const fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            __m256i const must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+            state.Error = _mm256_or_si256(state.Error, _mm256_xor_si256(must23, special));
+            state.PreviousIncomplete = _mm256_subs_epu8(input, _mm256_load_si256(reinterpret_cast<__m256i const*>(Utf8IncompleteLimit)));
+        }
+
+        state.PreviousInput = input;
+    }
+
+    WEAVE_UNICODE_TARGET_AVX2
+    bool ValidateAvx2(const uint8_t* first, const uint8_t* last)
+    {
+        constexpr size_t BlockSize = sizeof(__m256i);
+
+        Utf8StateAvx2 state{
+            .Error = _mm256_setzero_si256(),
+            .PreviousInput = _mm256_setzero_si256(),
+            .PreviousIncomplete = _mm256_setzero_si256(),
+        };
+
+        for (; static_cast<size_t>(last - first) >= BlockSize; first += BlockSize)
+        {
+            Utf8CheckBlockAvx2(state, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first)));
+        }
+
+        // Tail is padded with zeros; this also catches sequences truncated by the end of input.
+        alignas(32) uint8_t buffer[BlockSize]{};
+        std::memcpy(buffer, first, static_cast<size_t>(last - first));
+        Utf8CheckBlockAvx2(state, _mm256_load_si256(reinterpret_cast<__m256i const*>(buffer)));
+
+        return _mm256_testz_si256(state.Error, state.Error) != 0;
+    }
+
+    bool IsSsse3Supported()
+    {
+#if defined(_MSC_VER)
+        int registers[4]{};
+        __cpuid(registers, 1);
+        return (registers[2] & (1 << 9)) != 0;
+#else
+        return __builtin_cpu_supports("ssse3");
+#endif
+    }
+
+    bool IsAvx2Supported()
+    {
+#if defined(_MSC_VER)
+        int registers[4]{};
+        __cpuid(registers, 0);
+
+        if (registers[0] < 7)
+        {
+            return false;
+        }
+
+        __cpuid(registers, 1);
+
+        // OS has to save YMM registers on context switch.
+        bool const osxsave = (registers[2] & (1 << 27)) != 0;
+
+        if (not osxsave or ((_xgetbv(0) & 0x6) != 0x6))
+        {
+            return false;
+        }
+
+        __cpuidex(registers, 7, 0);
+        return (registers[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+#endif
+
+#if defined(WEAVE_UNICODE_VALIDATE_NEON)
+
+    struct Utf8StateNeon final
+    {
+        uint8x16_t Error;
+        uint8x16_t PreviousInput;
+        uint8x16_t PreviousIncomplete;
+    };
+
+    inline void Utf8CheckBlockNeon(Utf8StateNeon& state, uint8x16_t input)
+    {
+        if (vmaxvq_u8(input) < 0x80)
+        {
+            // ASCII only block - the only possible error is a sequence left incomplete by the previous block.
+            state.Error = vorrq_u8(state.Error, state.PreviousIncomplete);
+        }
+        else
+        {
+            uint8x16_t const nibble = vdupq_n_u8(0x0F);
+
+            uint8x16_t const prev1 = vextq_u8(state.PreviousInput, input, 16 - 1);
+            uint8x16_t const prev2 = vextq_u8(state.PreviousInput, input, 16 - 2);
+            uint8x16_t const prev3 = vextq_u8(state.PreviousInput, input, 16 - 3);
+
+            uint8x16_t const byte1High = vqtbl1q_u8(vld1q_u8(Utf8Byte1High), vshrq_n_u8(prev1, 4));
+            uint8x16_t const byte1Low = vqtbl1q_u8(vld1q_u8(Utf8Byte1Low), vandq_u8(prev1, nibble));
+            uint8x16_t const byte2High = vqtbl1q_u8(vld1q_u8(Utf8Byte2High), vshrq_n_u8(input, 4));
+
+            uint8x16_t const special = vandq_u8(vandq_u8(byte1High, byte1Low), byte2High);
+
+            // Third and fourth bytes of 3- and 4-byte sequences must be continuation bytes.
+            uint8x16_t const third = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+            uint8x16_t const fourth = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+            uint8x16_t const must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+
+            state.Error = vorrq_u8(state.Error, veorq_u8(must23, special));
+            state.PreviousIncomplete = vqsubq_u8(input, vld1q_u8(Utf8IncompleteLimit + 16));
+        }
+
+        state.PreviousInput = input;
+    }
+
+    bool ValidateNeon(const uint8_t* first, const uint8_t* last)
+    {
+        constexpr size_t BlockSize = sizeof(uint8x16_t);
+
+        Utf8StateNeon state{
+            .Error = vdupq_n_u8(0),
+            .PreviousInput = vdupq_n_u8(0),
+            .PreviousIncomplete = vdupq_n_u8(0),
+        };
+
+        for (; static_cast<size_t>(last - first) >= BlockSize; first += BlockSize)
+        {
+            Utf8CheckBlockNeon(state, vld1q_u8(first));
+        }
+
+        // Tail is padded with zeros; this also catches sequences truncated by the end of input.
+        alignas(16) uint8_t buffer[BlockSize]{};
+        std::memcpy(buffer, first, static_cast<size_t>(last - first));
+        Utf8CheckBlockNeon(state, vld1q_u8(buffer));
+
+        return vmaxvq_u8(state.Error) == 0;
+    }
+
+#endif
+}
+
+namespace weave::unicode
+{
+    bool IsSupported(ValidatorKind kind)
+    {
+        switch (kind)
+        {
+        case ValidatorKind::Scalar:
+            return true;
+
+#if defined(WEAVE_UNICODE_VALIDATE_X64)
+        case ValidatorKind::Ssse3:
+        {
+            static bool const supported = impl::IsSsse3Supported();
+            return supported;
+        }
+
+        case ValidatorKind::Avx2:
+        {
+            static bool const supported = impl::IsAvx2Supported();
+            return supported;
+        }
+#endif
+
+#if defined(WEAVE_UNICODE_VALIDATE_NEON)
+        case ValidatorKind::Neon:
+            return true;
+#endif
+
+        default:
+            return false;
+        }
+    }
+
+    ValidatorKind GetBestValidator()
+    {
+        static ValidatorKind const best = []
+        {
+            for (ValidatorKind const kind : {ValidatorKind::Avx2, ValidatorKind::Neon, ValidatorKind::Ssse3})
+            {
+                if (IsSupported(kind))
+                {
+                    return kind;
+                }
+            }
+
+            return ValidatorKind::Scalar;
+        }();
+
+        return best;
+    }
+
+    bool Validate(
+        const uint8_t* first,
+        const uint8_t* last,
+        ValidatorKind kind)
+    {
+        WEAVE_ASSERT(IsSupported(kind));
+        WEAVE_ASSERT(first <= last);
+
+        switch (kind)
+        {
+#if defined(WEAVE_UNICODE_VALIDATE_X64)
+        case ValidatorKind::Ssse3:
+            return impl::ValidateSsse3(first, last);
+
+        case ValidatorKind::Avx2:
+            return impl::ValidateAvx2(first, last);
+#endif
+
+#if defined(WEAVE_UNICODE_VALIDATE_NEON)
+        case ValidatorKind::Neon:
+            return impl::ValidateNeon(first, last);
+#endif
+
+        default:
+            return impl::ValidateScalar(first, last);
+        }
+    }
+
+    bool Validate(
+        const uint8_t* first,
+        const uint8_t* last)
+    {
+        return Validate(first, last, GetBestValidator());
+    }
+
+    const uint8_t* FindInvalid(
+        const uint8_t* first,
+        const uint8_t* last)
+    {
+        if (Validate(first, last))
+        {
+            return last;
+        }
+
+        // Invalid input is rare; locate the error with the scalar decoder.
+        char32_t ch;
+
+        while (first < last)
+        {
+            const uint8_t* const current = first;
+
+            if (Decode(ch, first, last) != ConversionResult::Success)
+            {
+                return current;
+            }
+        }
+
+        return last;
+    }
+}
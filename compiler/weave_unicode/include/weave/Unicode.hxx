@@ -1,6 +1,8 @@
 #pragma once
+#include <array>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <expected>
 
 namespace weave::unicode
@@ -362,6 +364,22 @@ namespace weave::unicode
         const uint8_t* first,
         const uint8_t* last);
 
+    /// \brief Finds first byte which does not start a valid UTF-8 sequence.
+    ///
+    /// \return The pointer to invalid byte, or `last` when whole range is valid.
+    const uint8_t* FindInvalid(
+        const uint8_t* first,
+        const uint8_t* last);
+
+    inline const char* FindInvalid(
+        const char* first,
+        const char* last)
+    {
+        return reinterpret_cast<const char*>(FindInvalid(
+            reinterpret_cast<const uint8_t*>(first),
+            reinterpret_cast<const uint8_t*>(last)));
+    }
+
     inline bool Validate(
         const char* first,
         const char* last)
@@ -412,3 +430,31 @@ namespace weave::unicode
         return Validate(first, last);
     }
 }
+
+namespace weave::unicode
+{
+    /// \brief Implementations of UTF-8 validation.
+    ///
+    /// \note All implementations accept exactly the same inputs.
+    enum class ValidatorKind
+    {
+        Scalar,
+        Ssse3,
+        Avx2,
+        Neon,
+    };
+
+    /// \brief Checks whether the current processor supports given validator.
+    bool IsSupported(ValidatorKind kind);
+
+    /// \brief Gets the fastest validator supported by the current processor. Used by `Validate` for UTF-8 input.
+    ValidatorKind GetBestValidator();
+
+    /// \brief Validates UTF-8 input using specific validator.
+    ///
+    /// \note Validator must be supported by the current processor.
+    bool Validate(
+        const uint8_t* first,
+        const uint8_t* last,
+        ValidatorKind kind);
+}
@@ -0,0 +1,277 @@
+#include "weave/platform/Compiler.hxx"
+
+WEAVE_EXTERNAL_HEADERS_BEGIN
+
+#include <catch_amalgamated.hpp>
+
+WEAVE_EXTERNAL_HEADERS_END
+
+#include "weave/Unicode.hxx"
+
+#include <random>
+#include <span>
+#include <vector>
+
+namespace
+{
+    constexpr weave::unicode::ValidatorKind AllValidators[]{
+        weave::unicode::ValidatorKind::Scalar,
+        weave::unicode::ValidatorKind::Ssse3,
+        weave::unicode::ValidatorKind::Avx2,
+        weave::unicode::ValidatorKind::Neon,
+    };
+
+    constexpr std::string_view GetName(weave::unicode::ValidatorKind kind)
+    {
+        switch (kind)
+        {
+        case weave::unicode::ValidatorKind::Scalar:
+            return "scalar";
+        case weave::unicode::ValidatorKind::Ssse3:
+            return "ssse3";
+        case weave::unicode::ValidatorKind::Avx2:
+            return "avx2";
+        case weave::unicode::ValidatorKind::Neon:
+            return "neon";
+        }
+
+        return "unknown";
+    }
+
+    // Reference implementation - decodes input one code point at a time.
+    bool ValidateReference(std::span<uint8_t const> input)
+    {
+        uint8_t const* first = input.data();
+        uint8_t const* const last = first + input.size();
+
+        char32_t ch;
+
+        while (first < last)
+        {
+            if (weave::unicode::Decode(ch, first, last) != weave::unicode::ConversionResult::Success)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void CheckAllValidators(std::span<uint8_t const> input)
+    {
+        using namespace weave::unicode;
+
+        bool const expected = ValidateReference(input);
+
+        for (ValidatorKind const kind : AllValidators)
+        {
+            if (IsSupported(kind))
+            {
+                CAPTURE(GetName(kind), input.size());
+                REQUIRE(Validate(input.data(), input.data() + input.size(), kind) == expected);
+            }
+        }
+    }
+
+    void AppendCodePoint(std::vector<uint8_t>& buffer, char32_t codepoint)
+    {
+        uint8_t encoded[8];
+        uint8_t* it = encoded;
+
+        if (weave::unicode::Encode(it, encoded + std::size(encoded), codepoint) == weave::unicode::ConversionResult::Success)
+        {
+            buffer.insert(buffer.end(), encoded, it);
+        }
+    }
+}
+
+TEST_CASE("UTF8 Validation - known sequences")
+{
+    using namespace weave::unicode;
+
+    std::vector<std::vector<uint8_t>> const cases{
+        {},
+        {0x00},
+        {0x7F},
+        {0xC2, 0x80},
+        {0xDF, 0xBF},
+        {0xE0, 0xA0, 0x80},
+        {0xED, 0x9F, 0xBF},
+        {0xEE, 0x80, 0x80},
+        {0xEF, 0xBF, 0xBF},
+        {0xF0, 0x90, 0x80, 0x80},
+        {0xF4, 0x8F, 0xBF, 0xBF},
+
+        // Unexpected continuation bytes
+        {0x80},
+        {0xBF},
+        {0xC2, 0x80, 0x80},
+
+        // Truncated sequences
+        {0xC2},
+        {0xE0, 0xA0},
+        {0xF0, 0x90, 0x80},
+        {0xC2, 0x41},
+        {0xE0, 0xA0, 0x41},
+
+        // Overlong encodings
+        {0xC0, 0x80},
+        {0xC1, 0xBF},
+        {0xE0, 0x80, 0x80},
+        {0xE0, 0x9F, 0xBF},
+        {0xF0, 0x80, 0x80, 0x80},
+        {0xF0, 0x8F, 0xBF, 0xBF},
+
+        // Surrogates
+        {0xED, 0xA0, 0x80},
+        {0xED, 0xBF, 0xBF},
+        {0xED, 0xA0, 0x80, 0xED, 0xB0, 0x80},
+
+        // Code points above U+10FFFF and invalid lead bytes
+        {0xF4, 0x90, 0x80, 0x80},
+        {0xF5, 0x80, 0x80, 0x80},
+        {0xF8, 0x88, 0x80, 0x80, 0x80},
+        {0xFC, 0x84, 0x80, 0x80, 0x80, 0x80},
+        {0xFE},
+        {0xFF},
+    };
+
+    for (std::vector<uint8_t> const& sequence : cases)
+    {
+        // Place sequence at every position of vector blocks, surrounded by ASCII and multibyte text.
+        for (size_t prefix = 0; prefix < 70; ++prefix)
+        {
+            std::vector<uint8_t> input(prefix, 'a');
+            input.insert(input.end(), sequence.begin(), sequence.end());
+            CheckAllValidators(input);
+
+            AppendCodePoint(input, U'ż');
+            input.resize(input.size() + 40, 'b');
+            CheckAllValidators(input);
+        }
+    }
+}
+
+TEST_CASE("UTF8 Validation - find invalid")
+{
+    using namespace weave::unicode;
+
+    std::string_view const valid = "za\xC5\xBC\xC3\xB3\xC5\x82\xC4\x87 g\xC4\x99\xC5\x9Bl\xC4\x85 ja\xC5\xBA\xC5\x84";
+    CHECK(FindInvalid(valid.data(), valid.data() + valid.size()) == valid.data() + valid.size());
+
+    std::string const invalid = std::string(100, 'x') + "\xC5\xBC\xED\xA0\x80" + std::string(100, 'y');
+    CHECK(FindInvalid(invalid.data(), invalid.data() + invalid.size()) == invalid.data() + 102);
+
+    std::string const truncated = std::string(100, 'x') + "\xF0\x90\x80";
+    CHECK(FindInvalid(truncated.data(), truncated.data() + truncated.size()) == truncated.data() + 100);
+}
+
+TEST_CASE("UTF8 Validation - fuzzing")
+{
+    using namespace weave::unicode;
+
+    std::mt19937 random{2137};
+
+    // Bytes around boundaries of lead and continuation byte ranges.
+    constexpr uint8_t interesting[]{
+        0x00, 0x41, 0x7F, 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC0, 0xC1, 0xC2,
+        0xDF, 0xE0, 0xE1, 0xEC, 0xED, 0xEE, 0xEF, 0xF0, 0xF1, 0xF3, 0xF4, 0xF5, 0xFF};
+
+    std::uniform_int_distribution<uint32_t> codepoints{0, 0x10FFFF};
+    std::uniform_int_distribution<size_t> interestingIndex{0, std::size(interesting) - 1};
+    std::uniform_int_distribution<uint32_t> bytes{0, 255};
+
+    for (size_t iteration = 0; iteration < 20000; ++iteration)
+    {
+        std::vector<uint8_t> input{};
+
+        size_t const count = std::uniform_int_distribution<size_t>{0, 64}(random);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            // Mostly ASCII, like real source files.
+            if ((random() % 4) != 0)
+            {
+                input.push_back(static_cast<uint8_t>(random() % 0x80));
+            }
+            else
+            {
+                AppendCodePoint(input, codepoints(random));
+            }
+        }
+
+        // Mutate valid input.
+        size_t const mutations = random() % 3;
+
+        for (size_t i = 0; (i < mutations) and not input.empty(); ++i)
+        {
+            size_t const position = random() % input.size();
+
+            switch (random() % 4)
+            {
+            case 0:
+                input[position] = interesting[interestingIndex(random)];
+                break;
+
+            case 1:
+                input[position] = static_cast<uint8_t>(bytes(random));
+                break;
+
+            case 2:
+                input.erase(input.begin() + static_cast<ptrdiff_t>(position));
+                break;
+
+            default:
+                input.insert(input.begin() + static_cast<ptrdiff_t>(position), interesting[interestingIndex(random)]);
+                break;
+            }
+        }
+
+        CheckAllValidators(input);
+    }
+}
+
+TEST_CASE("UTF8 Validation - throughput", "[.benchmark]")
+{
+    using namespace weave::unicode;
+
+    std::mt19937 random{2137};
+
+    std::vector<uint8_t> ascii{};
+    std::vector<uint8_t> mixed{};
+
+    while (ascii.size() < (16u << 20u))
+    {
+        ascii.push_back(static_cast<uint8_t>('a' + (random() % 26)));
+    }
+
+    while (mixed.size() < (16u << 20u))
+    {
+        if ((random() % 8) != 0)
+        {
+            mixed.push_back(static_cast<uint8_t>('a' + (random() % 26)));
+        }
+        else
+        {
+            AppendCodePoint(mixed, static_cast<char32_t>(0x80 + (random() % 0xFF00)));
+        }
+    }
+
+    for (ValidatorKind const kind : AllValidators)
+    {
+        if (not IsSupported(kind))
+        {
+            continue;
+        }
+
+        BENCHMARK(std::string{"16 MiB ascii, "} + std::string{GetName(kind)})
+        {
+            return Validate(ascii.data(), ascii.data() + ascii.size(), kind);
+        };
+
+        BENCHMARK(std::string{"16 MiB mixed, "} + std::string{GetName(kind)})
+        {
+            return Validate(mixed.data(), mixed.data() + mixed.size(), kind);
+        };
+    }
+}